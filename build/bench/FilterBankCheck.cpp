@@ -0,0 +1,185 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ https://github.com/0x4d52/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+/*
+ Checks that multichannel filters processed by the filter bank (see
+ FilterBankChannelInternal) give bit-identical output to the same filters
+ processed one channel at a time.
+
+ Each case renders a multichannel filter, which uses the filter bank, then
+ renders each of its channels as a mono filter, which uses the scalar
+ FilterChannelInternal, and compares the outputs sample for sample. The cases
+ cover the P2Z2 (RLPF) and B2 (LPF) forms with fixed and modulated
+ coefficients, and a channel count that leaves channels outside the lanes.
+ It also checks that an input with mixed sample rates doesn't use the bank.
+
+ Build this with all the Plank .c and Plonk .cpp files, e.g., on Linux:
+
+   g++ -O2 -DNDEBUG=1 -D_NDEBUG=1 -mcx16 -I../../plnk FilterBankCheck.cpp <plank and plonk objects> -lpthread
+
+ Usage: FilterBankCheck [blockSize] [seconds]
+ */
+
+#include "../../plnk/plonk/plonk.h"
+
+enum Cases
+{
+    FixedRLPF,
+    ModulatedRLPF,
+    FixedLPF,
+    ModulatedLPF,
+    NumCases
+};
+
+static const char* caseNames[NumCases] = { "fixed RLPF", "modulated RLPF", "fixed LPF", "modulated LPF" };
+
+static Unit filter (const int filterCase, Unit const& input, Unit const& frequency) throw()
+{
+    switch (filterCase)
+    {
+        case FixedRLPF:
+        case ModulatedRLPF: return RLPF::ar (input, frequency, 4.0f);
+        default:            return LPF::ar (input, frequency);
+    }
+}
+
+class CheckHost : public OfflineAudioHost
+{
+public:
+    CheckHost (const int filterCaseToUse, const int numChannelsToUse, const int channelToUse) throw()
+    :   filterCase (filterCaseToUse),
+        numChannels (numChannelsToUse),
+        channel (channelToUse)
+    {
+        setNumOutputs (channel < 0 ? numChannels : 1);
+    }
+
+    Unit constructGraph()
+    {
+        Unit input (Unit::withSize (numChannels));
+        Unit frequency (Unit::withSize (numChannels));
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            input.put (i, Saw::ar (55.0f * (i + 1), 0.5f)[0]);
+
+            if ((filterCase == ModulatedRLPF) || (filterCase == ModulatedLPF))
+                frequency.put (i, Sine::ar (0.5f + i, 800.0f, 1200.0f + 100.0f * i)[0]);
+            else
+                frequency.put (i, Unit (1200.0f + 100.0f * i)[0]);
+        }
+
+        if (channel < 0)
+            return filter (filterCase, input, frequency);
+
+        return filter (filterCase, input.getChannel (channel), frequency.getChannel (channel));
+    }
+
+private:
+    const int filterCase;
+    const int numChannels;
+    const int channel;
+};
+
+static bool check (const int filterCase, const int numChannels, const int blockSize, const double seconds) throw()
+{
+    CheckHost bank (filterCase, numChannels, -1);
+    bank.setPreferredHostBlockSize (blockSize);
+    bank.setRenderDuration (seconds);
+    bank.startHost();
+
+    const FloatArray2D bankOutput = bank.getOutput();
+    int numDiffering = 0;
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        CheckHost single (filterCase, numChannels, i);
+        single.setPreferredHostBlockSize (blockSize);
+        single.setRenderDuration (seconds);
+        single.startHost();
+
+        if (single.getOutput().atUnchecked (0) != bankOutput.atUnchecked (i))
+            ++numDiffering;
+    }
+
+    printf ("%-16s %d channels: %s\n", caseNames[filterCase], numChannels,
+            numDiffering == 0 ? "identical" : "DIFFERS");
+
+    return numDiffering == 0;
+}
+
+static bool usesBank (Unit const& input) throw()
+{
+    Unit filtered = LPF::ar (input, 1200.0f);
+    return filtered.getNames().atUnchecked (0).containsIgnoreCase ("Filter Bank");
+}
+
+static bool checkMixedRates() throw()
+{
+    Unit uniform (Unit::withSize (4));
+    Unit mixed (Unit::withSize (4));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        uniform.put (i, Saw::ar (55.0f)[0]);
+        mixed.put (i, (i & 1) ? Saw::kr (1.0f)[0] : Saw::ar (55.0f)[0]);
+    }
+
+    const bool ok = usesBank (uniform) && ! usesBank (mixed);
+
+    printf ("mixed rates:      %s\n", ok ? "per channel" : "WRONG");
+
+    return ok;
+}
+
+int main (int argc, char* argv[])
+{
+    const int blockSize = argc > 1 ? atoi (argv[1]) : 64;
+    const double seconds = argc > 2 ? atof (argv[2]) : 1.0;
+    bool ok = true;
+
+    for (int filterCase = 0; filterCase < NumCases; ++filterCase)
+    {
+        ok = check (filterCase, 8, blockSize, seconds) && ok;
+        ok = check (filterCase, 6, blockSize, seconds) && ok;
+    }
+
+    ok = checkMixedRates() && ok;
+
+    return ok ? 0 : 1;
+}
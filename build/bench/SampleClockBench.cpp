@@ -0,0 +1,121 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ https://github.com/0x4d52/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+/*
+ Times the per-pull overhead of channel processing with and without the
+ integer sample clock (see AudioHostBase::setUseSampleClock()).
+
+ The graph is a Sine followed by a long chain of binary ops with constants so
+ the render time is dominated by the cost of pulling channels rather than by
+ DSP. Each op pulls two inputs per block. The graph is rendered offline with
+ the clock off then on and the output of the two renders is compared.
+
+ Build this with all the Plank .c and Plonk .cpp files, e.g., on Linux:
+
+   g++ -O2 -DNDEBUG=1 -D_NDEBUG=1 -mcx16 -I../../plnk SampleClockBench.cpp <plank and plonk objects> -lpthread
+
+ Usage: SampleClockBench [numOps] [blockSize] [seconds] [repeats]
+ */
+
+#include "../../plnk/plonk/plonk.h"
+
+class BenchHost : public OfflineAudioHost
+{
+public:
+    BenchHost (const int numOpsToUse) throw()
+    :   numOps (numOpsToUse)
+    {
+        setNumOutputs (1);
+    }
+
+    Unit constructGraph()
+    {
+        Unit unit = Sine::ar (440, 0.5);
+
+        for (int i = 0; i < numOps; ++i)
+            unit = (i & 1) ? unit + 0.0001f : unit * 0.9999f;
+
+        return unit;
+    }
+
+private:
+    const int numOps;
+};
+
+static double render (BenchHost& host, const bool useSampleClock, Floats& output) throw()
+{
+    host.setUseSampleClock (useSampleClock);
+    host.startHost();
+    output = host.getOutput().atUnchecked (0);
+    return host.getCpuUsage() * host.getNumFramesRendered() / host.getPreferredHostSampleRate();
+}
+
+int main (int argc, char* argv[])
+{
+    const int numOps    = argc > 1 ? atoi (argv[1]) : 4000;
+    const int blockSize = argc > 2 ? atoi (argv[2]) : 16;
+    const double seconds = argc > 3 ? atof (argv[3]) : 2.0;
+    const int repeats   = argc > 4 ? atoi (argv[4]) : 5;
+
+    BenchHost host (numOps);
+    host.setPreferredHostBlockSize (blockSize);
+    host.setRenderDuration (seconds);
+
+    const double numBlocks = seconds * host.getPreferredHostSampleRate() / blockSize;
+    const double numPulls = numBlocks * numOps * 2.0;
+
+    double best[2] = { 0.0, 0.0 };
+    Floats outputs[2];
+
+    // alternate the modes so that both see the same machine conditions
+    for (int repeat = 0; repeat < repeats; ++repeat)
+    {
+        for (int mode = 0; mode < 2; ++mode)
+        {
+            const double time = render (host, mode == 1, outputs[mode]);
+            best[mode] = (repeat == 0) ? time : plonk::min (best[mode], time);
+        }
+    }
+
+    printf ("%d ops, block size %d, %g s, best of %d\n", numOps, blockSize, seconds, repeats);
+    printf ("time stamp:   %8.2f ns per pull\n", best[0] * 1.0e9 / numPulls);
+    printf ("sample clock: %8.2f ns per pull\n", best[1] * 1.0e9 / numPulls);
+    printf ("output %s\n", (outputs[0] == outputs[1]) ? "identical" : "DIFFERS");
+
+    return (outputs[0] == outputs[1]) ? 0 : 1;
+}
@@ -59,6 +59,9 @@
  - PLANK_VEC_VDSP=1 : Use Apple's Accelerate vDSP library for vector processing where possible 
                       (the default is to use scalar code). You must also link to the 
                       Accelerate framework.
+ - PLANK_VEC_SIMD=1 : Use SSE2/AVX/AVX2 intrinsics on x86 or NEON on AArch64 for vector processing
+                      where possible (e.g., on Linux and Windows). The instruction set is chosen from the
+                      compiler's target flags (e.g., -mavx2 -mfma) and other operations use scalar code.
  - PLANK_FFT_VDSP=1 : Use Apple's Accelerate vDSP library for FFT processing 
                       (the default is to use FFTReal which is included in the source tree).
                       You must also link to the Accelerate framework.
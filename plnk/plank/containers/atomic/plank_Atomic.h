@@ -51,6 +51,14 @@ PLANK_BEGIN_C_LINKAGE
 /** A crossplatform read/write memory barrier. */
 static void pl_AtomicMemoryBarrier();
 
+/** A crossplatform acquire barrier.
+ Reads and writes after this can't be moved before any read before it. */
+static void pl_AtomicMemoryBarrierAcquire();
+
+/** A crossplatform release barrier.
+ Reads and writes before this can't be moved after any write after it. */
+static void pl_AtomicMemoryBarrierRelease();
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -101,6 +109,13 @@ static PlankI pl_AtomicI_Get (PlankAtomicIRef p);
  @return The value. */
 static PlankI pl_AtomicI_GetUnchecked (PlankAtomicIRef p);
 
+/** Get the current value with acquire ordering.
+ Reads and writes after this can't be moved before it. Use this to read a value
+ written with pl_AtomicI_SetRelease() before reading the data it publishes.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @return The value. */
+static PlankI pl_AtomicI_GetAcquire (PlankAtomicIRef p);
+
 /** Not used for this class. 
  @param p The <i>Plank %AtomicI</i> object. 
  @return Always returns 0. */
@@ -130,6 +145,13 @@ static void pl_AtomicI_Set (PlankAtomicIRef p, PlankI newValue);
 
 void pl_AtomicI_SetUnchecked (PlankAtomicIRef p, PlankI newValue);
 
+/** Set the current value with release ordering.
+ Reads and writes before this can't be moved after it. This is cheaper than
+ pl_AtomicI_Set() which is a full barrier.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicI_SetRelease (PlankAtomicIRef p, PlankI newValue);
+
 
 /** Add a value to the current value. 
  @param p The <i>Plank %AtomicI</i> object. 
@@ -137,6 +159,13 @@ void pl_AtomicI_SetUnchecked (PlankAtomicIRef p, PlankI newValue);
  @return The new value. */
 static PlankI pl_AtomicI_Add (PlankAtomicIRef p, PlankI operand);
 
+/** Add a value to the current value without ordering other memory accesses. 
+ This is still atomic and suits statistics and counters that don't guard other data.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankI pl_AtomicI_AddRelaxed (PlankAtomicIRef p, PlankI operand);
+
 /** Subtract a value from the current value. 
  @param p The <i>Plank %AtomicI</i> object. 
  @param operand The value to subtract. 
@@ -216,6 +245,13 @@ static PlankL pl_AtomicL_Get (PlankAtomicLRef p);
  @return The value. */
 static PlankL pl_AtomicL_GetUnchecked (PlankAtomicLRef p);
 
+/** Get the current value with acquire ordering.
+ Reads and writes after this can't be moved before it. Use this to read a value
+ written with pl_AtomicL_SetRelease() before reading the data it publishes.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @return The value. */
+static PlankL pl_AtomicL_GetAcquire (PlankAtomicLRef p);
+
 /** Not used for this class. 
  @param p The <i>Plank %AtomicL</i> object. 
  @return Always returns 0. */
@@ -245,12 +281,26 @@ static void pl_AtomicL_Set (PlankAtomicLRef p, PlankL newValue);
 
 void pl_AtomicL_SetUnchecked (PlankAtomicLRef p, PlankL newValue);
 
+/** Set the current value with release ordering.
+ Reads and writes before this can't be moved after it. This is cheaper than
+ pl_AtomicL_Set() which is a full barrier.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicL_SetRelease (PlankAtomicLRef p, PlankL newValue);
+
 /** Add a value to the current value. 
  @param p The <i>Plank %AtomicL</i> object. 
  @param operand The value to add. 
  @return The new value. */
 static PlankL pl_AtomicL_Add (PlankAtomicLRef p, PlankL operand);
 
+/** Add a value to the current value without ordering other memory accesses. 
+ This is still atomic and suits statistics and counters that don't guard other data.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankL pl_AtomicL_AddRelaxed (PlankAtomicLRef p, PlankL operand);
+
 /** Subtract a value from the current value. 
  @param p The <i>Plank %AtomicL</i> object. 
  @param operand The value to subtract. 
@@ -331,6 +381,13 @@ static PlankLL pl_AtomicLL_Get (PlankAtomicLLRef p);
  @return The value. */
 static PlankLL pl_AtomicLL_GetUnchecked (PlankAtomicLLRef p);
 
+/** Get the current value with acquire ordering.
+ Reads and writes after this can't be moved before it. Use this to read a value
+ written with pl_AtomicLL_SetRelease() before reading the data it publishes.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @return The value. */
+static PlankLL pl_AtomicLL_GetAcquire (PlankAtomicLLRef p);
+
 /** Not used for this class. 
  @param p The <i>Plank %AtomicLL</i> object. 
  @return Always returns 0. */
@@ -360,12 +417,26 @@ static void pl_AtomicLL_Set (PlankAtomicLLRef p, PlankLL newValue);
 
 void pl_AtomicLL_SetUnchecked (PlankAtomicLLRef p, PlankLL newValue);
 
+/** Set the current value with release ordering.
+ Reads and writes before this can't be moved after it. This is cheaper than
+ pl_AtomicLL_Set() which is a full barrier.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicLL_SetRelease (PlankAtomicLLRef p, PlankLL newValue);
+
 /** Add a value to the current value. 
  @param p The <i>Plank %AtomicLL</i> object. 
  @param operand The value to add. 
  @return The new value. */
 static PlankLL pl_AtomicLL_Add (PlankAtomicLLRef p, PlankLL operand);
 
+/** Add a value to the current value without ordering other memory accesses. 
+ This is still atomic and suits statistics and counters that don't guard other data.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankLL pl_AtomicLL_AddRelaxed (PlankAtomicLLRef p, PlankLL operand);
+
 /** Subtract a value from the current value. 
  @param p The <i>Plank %AtomicLL</i> object. 
  @param operand The value to subtract. 
@@ -446,6 +517,13 @@ static PlankF pl_AtomicF_Get (PlankAtomicFRef p);
  @return The value. */
 static PlankF pl_AtomicF_GetUnchecked (PlankAtomicFRef p);
 
+/** Get the current value with acquire ordering.
+ Reads and writes after this can't be moved before it. Use this to read a value
+ written with pl_AtomicF_SetRelease() before reading the data it publishes.
+ @param p The <i>Plank %AtomicF</i> object. 
+ @return The value. */
+static PlankF pl_AtomicF_GetAcquire (PlankAtomicFRef p);
+
 /** Not used for this class. 
  @param p The <i>Plank %AtomicF</i> object. 
  @return Always returns 0. */
@@ -475,6 +553,13 @@ static void pl_AtomicF_Set (PlankAtomicFRef p, PlankF newValue);
 
 void pl_AtomicF_SetUnchecked (PlankAtomicFRef p, PlankF newValue);
 
+/** Set the current value with release ordering.
+ Reads and writes before this can't be moved after it. This is cheaper than
+ pl_AtomicF_Set() which is a full barrier.
+ @param p The <i>Plank %AtomicF</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicF_SetRelease (PlankAtomicFRef p, PlankF newValue);
+
 /** Add a value to the current value. 
  @param p The <i>Plank %AtomicF</i> object. 
  @param operand The value to add. 
@@ -567,6 +652,13 @@ static PlankD pl_AtomicD_Get (PlankAtomicDRef p);
  @return The value. */
 static PlankD pl_AtomicD_GetUnchecked (PlankAtomicDRef p);
 
+/** Get the current value with acquire ordering.
+ Reads and writes after this can't be moved before it. Use this to read a value
+ written with pl_AtomicD_SetRelease() before reading the data it publishes.
+ @param p The <i>Plank %AtomicD</i> object. 
+ @return The value. */
+static PlankD pl_AtomicD_GetAcquire (PlankAtomicDRef p);
+
 /** Not used for this class. 
  @param p The <i>Plank %AtomicD</i> object. 
  @return Always returns 0. */
@@ -596,6 +688,13 @@ static void pl_AtomicD_Set (PlankAtomicDRef p, PlankD newValue);
 
 void pl_AtomicD_SetUnchecked (PlankAtomicDRef p, PlankD newValue);
 
+/** Set the current value with release ordering.
+ Reads and writes before this can't be moved after it. This is cheaper than
+ pl_AtomicD_Set() which is a full barrier.
+ @param p The <i>Plank %AtomicD</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicD_SetRelease (PlankAtomicDRef p, PlankD newValue);
+
 /** Add a value to the current value. 
  @param p The <i>Plank %AtomicD</i> object. 
  @param operand The value to add. 
@@ -687,6 +786,13 @@ static PlankP pl_AtomicP_Get (PlankAtomicPRef p);
  @return The value. */
 static PlankP pl_AtomicP_GetUnchecked (PlankAtomicPRef p);
 
+/** Get the current pointer with acquire ordering.
+ Reads and writes after this can't be moved before it. Use this to read a pointer
+ written with pl_AtomicP_SetRelease() before reading the data it publishes.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @return The pointer. */
+static PlankP pl_AtomicP_GetAcquire (PlankAtomicPRef p);
+
 /** Not used for this class. 
  Use @link PlankAtomicPXClass AtomicPX @endlink for safer pointer storage.
  @param p The <i>Plank %AtomicI</i> object. 
@@ -718,6 +824,13 @@ static void pl_AtomicP_Set (PlankAtomicPRef p, PlankP newPtr);
 
 void pl_AtomicP_SetUnchecked (PlankAtomicPRef p, PlankP newPtr);
 
+/** Set the current pointer with release ordering.
+ Reads and writes before this can't be moved after it. This is cheaper than
+ pl_AtomicP_Set() which is a full barrier.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @param newPtr The new pointer to store. */
+static void pl_AtomicP_SetRelease (PlankAtomicPRef p, PlankP newPtr);
+
 /** Offset current pointer. 
  @param p The <i>Plank %AtomicP</i> object. 
  @param operand The number of bytes by which to offset. 
@@ -752,6 +865,15 @@ static PlankP pl_AtomicP_Decrement (PlankAtomicPRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicP_CompareAndSwap (PlankAtomicPRef p, PlankP oldPtr, PlankP newPtr);
 
+/** Swap the current pointer with a new pointer if a specified old pointer is still current.
+ This is the same as pl_AtomicP_CompareAndSwap() but with release ordering only, 
+ e.g., for publishing a newly linked element.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @param oldPtr The expected old pointer being currently stored.
+ @param newPtr The new pointer to attempt to store.
+ @return @c true if the swap was successful, otherwise @c false. */
+static PlankB pl_AtomicP_CompareAndSwapRelease (PlankAtomicPRef p, PlankP oldPtr, PlankP newPtr);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -905,8 +1027,39 @@ static PlankP pl_AtomicPX_Decrement (PlankAtomicPXRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicPX_CompareAndSwap (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra);
 
+/** Swap the current values with new values if specified old values are still current.
+ This is the same as pl_AtomicPX_CompareAndSwap() but doesn't order other memory 
+ accesses, e.g., for incrementing a reference count.
+ @param p The <i>Plank %AtomicPX</i> object. 
+ @param oldPtr The expected old pointer being currently stored.
+ @param oldExtra The expected old extra tag being currently stored.
+ @param newPtr The new pointer to attempt to store.
+ @param newExtra The new extra tag to attempt to store.
+ @return @c true if the swap was successful, otherwise @c false. */
+static PlankB pl_AtomicPX_CompareAndSwapRelaxed (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra);
+
+/** Swap the current values with new values if specified old values are still current.
+ This is the same as pl_AtomicPX_CompareAndSwap() but with release ordering only, 
+ e.g., for decrementing a reference count. The thread that then frees the 
+ object should call pl_AtomicMemoryBarrierAcquire() first.
+ @param p The <i>Plank %AtomicPX</i> object. 
+ @param oldPtr The expected old pointer being currently stored.
+ @param oldExtra The expected old extra tag being currently stored.
+ @param newPtr The new pointer to attempt to store.
+ @param newExtra The new extra tag to attempt to store.
+ @return @c true if the swap was successful, otherwise @c false. */
+static PlankB pl_AtomicPX_CompareAndSwapRelease (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra);
+
 static PlankB pl_AtomicPX_CompareAndSwapP (PlankAtomicPXRef p, PlankP oldPtr, PlankP newPtr);
 
+/** Swap the current pointer with a new pointer if a specified old pointer is still current.
+ This ignores the extra tag and has release ordering only, see pl_AtomicP_CompareAndSwapRelease().
+ @param p The <i>Plank %AtomicPX</i> object. 
+ @param oldPtr The expected old pointer being currently stored.
+ @param newPtr The new pointer to attempt to store.
+ @return @c true if the swap was successful, otherwise @c false. */
+static PlankB pl_AtomicPX_CompareAndSwapPRelease (PlankAtomicPXRef p, PlankP oldPtr, PlankP newPtr);
+
 
 /** @} */
 
@@ -36,8 +36,19 @@
  -------------------------------------------------------------------------------
  */
 
+// Use the C11/C++11 memory model on GCC and Clang if 64-bit atomics are lock
+// free, define PLANK_ATOMICS_STD as 0 to use the platform specific code below
+#ifndef PLANK_ATOMICS_STD
+    #if PLANK_GCC && defined(__ATOMIC_ACQUIRE) && (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+        #define PLANK_ATOMICS_STD 1
+    #else
+        #define PLANK_ATOMICS_STD 0
+    #endif
+#endif
 
-#if PLANK_APPLE && PLANK_X86 && PLANK_32BIT
+#if PLANK_ATOMICS_STD
+#include "arch/plank_AtomicInline_StdAtomic.h"
+#elif PLANK_APPLE && PLANK_X86 && PLANK_32BIT
 #include "arch/plank_AtomicInline_Mac_X86_32.h"
 #elif PLANK_APPLE && PLANK_X86 && PLANK_64BIT
 #include "arch/plank_AtomicInline_Mac_X86_64.h"
@@ -68,3 +79,125 @@
 #if !PLANK_ATOMICS_DEFINED
 #include "arch/plank_AtomicInline_Lock.h"
 #endif
+
+#if !PLANK_ATOMICS_ORDERED
+// backends without explicit memory orders use their full barrier operations
+
+static PLANK_INLINE_LOW void pl_AtomicMemoryBarrierAcquire()
+{
+    pl_AtomicMemoryBarrier();
+}
+
+static PLANK_INLINE_LOW void pl_AtomicMemoryBarrierRelease()
+{
+    pl_AtomicMemoryBarrier();
+}
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_GetAcquire (PlankAtomicIRef p)
+{
+    const PlankI value = pl_AtomicI_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicI_SetRelease (PlankAtomicIRef p, PlankI newValue)
+{
+    pl_AtomicI_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_AddRelaxed (PlankAtomicIRef p, PlankI operand)
+{
+    return pl_AtomicI_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_GetAcquire (PlankAtomicLRef p)
+{
+    const PlankL value = pl_AtomicL_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicL_SetRelease (PlankAtomicLRef p, PlankL newValue)
+{
+    pl_AtomicL_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_AddRelaxed (PlankAtomicLRef p, PlankL operand)
+{
+    return pl_AtomicL_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_GetAcquire (PlankAtomicLLRef p)
+{
+    const PlankLL value = pl_AtomicLL_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicLL_SetRelease (PlankAtomicLLRef p, PlankLL newValue)
+{
+    pl_AtomicLL_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_AddRelaxed (PlankAtomicLLRef p, PlankLL operand)
+{
+    return pl_AtomicLL_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_GetAcquire (PlankAtomicFRef p)
+{
+    const PlankF value = pl_AtomicF_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicF_SetRelease (PlankAtomicFRef p, PlankF newValue)
+{
+    pl_AtomicF_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_GetAcquire (PlankAtomicDRef p)
+{
+    const PlankD value = pl_AtomicD_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicD_SetRelease (PlankAtomicDRef p, PlankD newValue)
+{
+    pl_AtomicD_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_GetAcquire (PlankAtomicPRef p)
+{
+    const PlankP ptr = pl_AtomicP_Get (p);
+    pl_AtomicMemoryBarrier();
+    return ptr;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicP_SetRelease (PlankAtomicPRef p, PlankP newPtr)
+{
+    pl_AtomicP_Set (p, newPtr);
+}
+
+static PLANK_INLINE_LOW PlankB pl_AtomicPX_CompareAndSwapRelaxed (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra)
+{
+    return pl_AtomicPX_CompareAndSwap (p, oldPtr, oldExtra, newPtr, newExtra);
+}
+
+static PLANK_INLINE_LOW PlankB pl_AtomicPX_CompareAndSwapRelease (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra)
+{
+    return pl_AtomicPX_CompareAndSwap (p, oldPtr, oldExtra, newPtr, newExtra);
+}
+
+static PLANK_INLINE_LOW PlankB pl_AtomicP_CompareAndSwapRelease (PlankAtomicPRef p, PlankP oldPtr, PlankP newPtr)
+{
+    return pl_AtomicP_CompareAndSwap (p, oldPtr, newPtr);
+}
+
+static PLANK_INLINE_LOW PlankB pl_AtomicPX_CompareAndSwapPRelease (PlankAtomicPXRef p, PlankP oldPtr, PlankP newPtr)
+{
+    return pl_AtomicPX_CompareAndSwapP (p, oldPtr, newPtr);
+}
+
+#endif
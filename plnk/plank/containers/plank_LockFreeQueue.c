@@ -217,7 +217,7 @@ PlankResult pl_LockFreeQueue_Push (PlankLockFreeQueueRef p, const PlankLockFreeQ
 {
     PlankResult result;
     PlankUL tailExtra;
-    PlankLockFreeQueueElementRef tailElement;
+    PlankLockFreeQueueElementRef tailElement, nextElement;
     PlankAtomicPXRef tailElementNextAtom;
     PlankB success;
 
@@ -229,28 +229,35 @@ PlankResult pl_LockFreeQueue_Push (PlankLockFreeQueueRef p, const PlankLockFreeQ
 
     pl_LockFreeQueueElement_SetNext (element, (PlankLockFreeQueueElementRef)p);
 
+    // elements are linked and the tail moved on with release swaps, the pointers
+    // read before dereferencing them or passing them on are followed by an
+    // acquire barrier, see also pl_LockFreeQueue_Pop()
     while (! success)
     {
         tailExtra = pl_AtomicPX_GetExtraUnchecked ((PlankAtomicPXRef)&(p->tail));                            // changed to unchecked
         tailElement = (PlankLockFreeQueueElementRef)pl_AtomicPX_GetUnchecked ((PlankAtomicPXRef)&(p->tail)); // changed to unchecked
+        pl_AtomicMemoryBarrierAcquire();
 
         tailElementNextAtom = pl_LockFreeQueueElement_GetNextAtom (tailElement);
-        success = pl_AtomicPX_CompareAndSwapP (tailElementNextAtom,
-                                               (PlankLockFreeQueueElementRef)p, element);
+        success = pl_AtomicPX_CompareAndSwapPRelease (tailElementNextAtom,
+                                                      (PlankLockFreeQueueElementRef)p, element);
 
         if (! success)
         {
-            pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->tail),
-                                        tailElement, tailExtra,
-                                        pl_LockFreeQueueElement_GetNext (tailElement), tailExtra + 1);
+            nextElement = pl_LockFreeQueueElement_GetNext (tailElement);
+            pl_AtomicMemoryBarrierAcquire();
+
+            pl_AtomicPX_CompareAndSwapRelease ((PlankAtomicPXRef)&(p->tail),
+                                               tailElement, tailExtra,
+                                               nextElement, tailExtra + 1);
         }
     }
 
-    pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->tail),
-                                tailElement, tailExtra,
-                                element, tailExtra + 1);
+    pl_AtomicPX_CompareAndSwapRelease ((PlankAtomicPXRef)&(p->tail),
+                                       tailElement, tailExtra,
+                                       element, tailExtra + 1);
 
-    pl_AtomicI_Increment (&p->count);
+    pl_AtomicI_AddRelaxed (&p->count, 1); // the count is only a hint
 
     return result;
 }
@@ -400,6 +407,7 @@ PlankResult pl_LockFreeQueue_Pop (PlankLockFreeQueueRef p, PlankLockFreeQueueEle
         tailExtra = pl_AtomicPX_GetExtraUnchecked ((PlankAtomicPXRef)&(p->tail));       // changed to unchecked
         headElement = pl_AtomicPX_GetUnchecked ((PlankAtomicPXRef)&(p->head));          // changed to unchecked
         nextElement = pl_LockFreeQueueElement_GetNext (headElement);
+        pl_AtomicMemoryBarrierAcquire();
         
         if (headExtra == pl_AtomicPX_GetExtraUnchecked ((PlankAtomicPXRef)&(p->head)))  // changed to unchecked
         {
@@ -411,20 +419,20 @@ PlankResult pl_LockFreeQueue_Pop (PlankLockFreeQueueRef p, PlankLockFreeQueueEle
                     goto exit;
                 }
                 
-                pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->tail), 
-                                            headElement, tailExtra, 
-                                            nextElement, tailExtra + 1);
+                pl_AtomicPX_CompareAndSwapRelease ((PlankAtomicPXRef)&(p->tail), 
+                                                   headElement, tailExtra, 
+                                                   nextElement, tailExtra + 1);
             }
             else if (nextElement != (PlankLockFreeQueueElementRef)p)
             {                
-                success = pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->head), 
-                                                      headElement, headExtra, 
-                                                      nextElement, headExtra + 1);
+                success = pl_AtomicPX_CompareAndSwapRelease ((PlankAtomicPXRef)&(p->head), 
+                                                             headElement, headExtra, 
+                                                             nextElement, headExtra + 1);
             }
         }
     }
     
-    pl_AtomicI_Decrement (&p->count);
+    pl_AtomicI_AddRelaxed (&p->count, -1);
     
     if (headElement == &p->dummyElement)
     {
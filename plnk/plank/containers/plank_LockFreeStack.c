@@ -204,10 +204,11 @@ PlankResult pl_LockFreeStack_Push (PlankLockFreeStackRef p, const PlankLockFreeS
         newPtr = element;
         newExtra = oldExtra + 1;
         
-        success = pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->atom), oldPtr, oldExtra, newPtr, newExtra);
+        // release so that a thread popping this element sees its contents
+        success = pl_AtomicPX_CompareAndSwapRelease ((PlankAtomicPXRef)&(p->atom), oldPtr, oldExtra, newPtr, newExtra);
 	} while (! success);
     
-    pl_AtomicLL_Increment (&p->count);
+    pl_AtomicLL_AddRelaxed (&p->count, 1); // the count is only a hint
     
     return result;
 }
@@ -231,16 +232,21 @@ PlankResult pl_LockFreeStack_Pop (PlankLockFreeStackRef p, PlankLockFreeStackEle
         }
         
         headExtra = pl_AtomicPX_GetExtraUnchecked (&p->atom);
+        
+        // pairs with the release in pl_LockFreeStack_Push(), the atom is only 
+        // ever changed by swaps so this sees the elements pushed before the one
+        // read too and the swap below needs no ordering of its own
+        pl_AtomicMemoryBarrierAcquire();
 
         nextPtr = pl_LockFreeStackElement_GetNext (headPtr);
         nextExtra = headExtra + 1;
-        success = pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->atom), 
-                                              headPtr, headExtra, 
-                                              nextPtr, nextExtra);
+        success = pl_AtomicPX_CompareAndSwapRelaxed ((PlankAtomicPXRef)&(p->atom), 
+                                                     headPtr, headExtra, 
+                                                     nextPtr, nextExtra);
 	} while (! success);
     
     *element = headPtr;
-    pl_AtomicLL_Decrement (&p->count);
+    pl_AtomicLL_AddRelaxed (&p->count, -1);
 
 exit:
     return result;    
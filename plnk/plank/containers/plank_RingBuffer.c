@@ -0,0 +1,357 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+/*
+ Bounded MPMC queue
+ Dmitry Vyukov
+ 2010
+ (the multiple producer mode uses the per-slot sequence numbers from this
+ with a single consumer)
+ */
+
+#include "../core/plank_StandardHeader.h"
+#include "plank_RingBuffer.h"
+
+PlankRingBufferRef pl_RingBuffer_CreateAndInit (const PlankL capacity, const PlankL elementSize, const PlankRingBufferMode mode)
+{
+    PlankRingBufferRef p;
+    p = pl_RingBuffer_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_RingBuffer_Init (p, capacity, elementSize, mode) != PlankResult_OK)
+            pl_RingBuffer_Destroy (p);
+        else
+            return p;
+    }
+    
+    return PLANK_NULL;
+}
+
+PlankRingBufferRef pl_RingBuffer_Create()
+{
+    PlankMemoryRef m;
+    PlankRingBufferRef p;
+    
+    m = pl_MemoryGlobal();
+    p = (PlankRingBufferRef)pl_Memory_AllocateBytes (m, sizeof (PlankRingBuffer));
+    
+    if (p != PLANK_NULL)
+        pl_MemoryZero (p, sizeof (PlankRingBuffer));
+    
+    return p;
+}
+
+PlankResult pl_RingBuffer_Init (PlankRingBufferRef p, const PlankL capacity, const PlankL elementSize, const PlankRingBufferMode mode)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    PlankL size, i;
+    
+    m = pl_MemoryGlobal(); // OK, creation of the ring isn't itself lock free
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((capacity < 1) || (elementSize < 1) || (mode < 0) || (mode >= PlankRingBufferMode_Count))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    pl_MemoryZero (p, sizeof (PlankRingBuffer));
+    
+    size = 1;
+    
+    while (size < capacity)
+        size <<= 1;
+    
+    p->capacity     = size;
+    p->mask         = size - 1;
+    p->elementSize  = elementSize;
+    p->mode         = mode;
+    
+    pl_AtomicL_Init (&p->writeIndex);
+    pl_AtomicL_Init (&p->readIndex);
+    
+    p->slots = (PlankUC*)pl_Memory_AllocateBytes (m, size * elementSize);
+    
+    if (p->slots == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    pl_MemoryZero (p->slots, size * elementSize);
+    
+    if (mode == PlankRingBufferMode_MPSC)
+    {
+        p->sequences = (PlankAtomicL*)pl_Memory_AllocateBytes (m, size * sizeof (PlankAtomicL));
+        
+        if (p->sequences == PLANK_NULL)
+        {
+            result = PlankResult_MemoryError;
+            goto exit;
+        }
+        
+        for (i = 0; i < size; ++i)
+        {
+            pl_AtomicL_Init (&p->sequences[i]);
+            pl_AtomicL_SetUnchecked (&p->sequences[i], i);
+        }
+    }
+    
+    pl_AtomicMemoryBarrier();
+    
+exit:
+    return result;    
+}
+
+PlankResult pl_RingBuffer_DeInit (PlankRingBufferRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if (p->sequences != PLANK_NULL)
+    {
+        if ((result = pl_Memory_Free (m, p->sequences)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    if (p->slots != PLANK_NULL)
+    {
+        if ((result = pl_Memory_Free (m, p->slots)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    pl_AtomicL_DeInit (&p->writeIndex);
+    pl_AtomicL_DeInit (&p->readIndex);
+    pl_MemoryZero (p, sizeof (PlankRingBuffer));
+    
+exit:
+    return result;    
+}
+
+PlankResult pl_RingBuffer_Destroy (PlankRingBufferRef p)
+{
+    PlankResult result;
+    PlankMemoryRef m;
+    
+    result = PlankResult_OK;
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((result = pl_RingBuffer_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);   
+    
+exit:
+    return result;    
+}
+
+PlankP pl_RingBuffer_BeginPush (PlankRingBufferRef p, PlankL* position)
+{
+    PlankL writePosition, sequence, difference;
+    
+    if (p->mode == PlankRingBufferMode_SPSC)
+    {
+        writePosition = pl_AtomicL_GetUnchecked (&p->writeIndex);
+        
+        // only look at the consumer's index (and its cache line) when the 
+        // last value seen says the ring is full
+        if ((writePosition - p->cachedReadIndex) >= p->capacity)
+        {
+            p->cachedReadIndex = pl_AtomicL_GetAcquire (&p->readIndex);
+            
+            if ((writePosition - p->cachedReadIndex) >= p->capacity)
+                return PLANK_NULL;
+        }
+    }
+    else
+    {
+        writePosition = pl_AtomicL_GetUnchecked (&p->writeIndex);
+        
+        for (;;)
+        {
+            sequence = pl_AtomicL_GetAcquire (&p->sequences[writePosition & p->mask]);
+            difference = sequence - writePosition;
+            
+            if (difference == 0)
+            {
+                if (pl_AtomicL_CompareAndSwap (&p->writeIndex, writePosition, writePosition + 1))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return PLANK_NULL; // full
+            }
+            
+            writePosition = pl_AtomicL_GetUnchecked (&p->writeIndex);
+        }
+    }
+    
+    *position = writePosition;
+    return p->slots + (writePosition & p->mask) * p->elementSize;
+}
+
+void pl_RingBuffer_EndPush (PlankRingBufferRef p, const PlankL position)
+{
+    // release so the slot is written before it is published
+    if (p->mode == PlankRingBufferMode_SPSC)
+        pl_AtomicL_SetRelease (&p->writeIndex, position + 1);
+    else
+        pl_AtomicL_SetRelease (&p->sequences[position & p->mask], position + 1);
+}
+
+PlankP pl_RingBuffer_BeginPop (PlankRingBufferRef p, PlankL* position)
+{
+    PlankL readPosition, sequence;
+    
+    readPosition = pl_AtomicL_GetUnchecked (&p->readIndex);
+
+    if (p->mode == PlankRingBufferMode_SPSC)
+    {
+        if (readPosition == p->cachedWriteIndex)
+        {
+            p->cachedWriteIndex = pl_AtomicL_GetAcquire (&p->writeIndex);
+            
+            if (readPosition == p->cachedWriteIndex)
+                return PLANK_NULL;
+        }
+    }
+    else
+    {
+        sequence = pl_AtomicL_GetAcquire (&p->sequences[readPosition & p->mask]);
+        
+        if ((sequence - (readPosition + 1)) < 0)
+            return PLANK_NULL;
+    }
+    
+    *position = readPosition;
+    return p->slots + (readPosition & p->mask) * p->elementSize;
+}
+
+void pl_RingBuffer_EndPop (PlankRingBufferRef p, const PlankL position)
+{
+    if (p->mode == PlankRingBufferMode_SPSC)
+    {
+        pl_AtomicL_SetRelease (&p->readIndex, position + 1);
+    }
+    else
+    {
+        // the index is only used for the size here, the sequence hands the slot back
+        pl_AtomicL_SetRelease (&p->sequences[position & p->mask], position + p->capacity);
+        pl_AtomicL_SetUnchecked (&p->readIndex, position + 1);
+    }
+}
+
+PlankB pl_RingBuffer_Push (PlankRingBufferRef p, const void* element)
+{
+    PlankL position;
+    PlankP slot;
+    
+    slot = pl_RingBuffer_BeginPush (p, &position);
+    
+    if (slot == PLANK_NULL)
+        return PLANK_FALSE;
+    
+    pl_MemoryCopy (slot, element, p->elementSize);
+    pl_RingBuffer_EndPush (p, position);
+    
+    return PLANK_TRUE;
+}
+
+PlankB pl_RingBuffer_Pop (PlankRingBufferRef p, void* element)
+{
+    PlankL position;
+    PlankP slot;
+    
+    slot = pl_RingBuffer_BeginPop (p, &position);
+    
+    if (slot == PLANK_NULL)
+        return PLANK_FALSE;
+    
+    pl_MemoryCopy (element, slot, p->elementSize);
+    pl_RingBuffer_EndPop (p, position);
+    
+    return PLANK_TRUE;
+}
+
+PlankL pl_RingBuffer_GetCapacity (PlankRingBufferRef p)
+{
+    return p ? p->capacity : 0;
+}
+
+PlankL pl_RingBuffer_GetElementSize (PlankRingBufferRef p)
+{
+    return p ? p->elementSize : 0;
+}
+
+PlankRingBufferMode pl_RingBuffer_GetMode (PlankRingBufferRef p)
+{
+    return p ? p->mode : PlankRingBufferMode_SPSC;
+}
+
+PlankP pl_RingBuffer_GetSlot (PlankRingBufferRef p, const PlankL index)
+{
+    return ((index >= 0) && (index < p->capacity)) ? p->slots + index * p->elementSize : PLANK_NULL;
+}
+
+PlankL pl_RingBuffer_GetSize (PlankRingBufferRef p)
+{
+    const PlankL readPosition = pl_AtomicL_Get (&p->readIndex);
+    const PlankL size = pl_AtomicL_Get (&p->writeIndex) - readPosition;
+    return size < 0 ? 0 : (size > p->capacity ? p->capacity : size);
+}
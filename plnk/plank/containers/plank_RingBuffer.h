@@ -0,0 +1,170 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_RINGBUFFER_H
+#define PLANK_RINGBUFFER_H
+
+#include "atomic/plank_Atomic.h"
+
+PLANK_BEGIN_C_LINKAGE
+
+/** A bounded lock-free FIFO of fixed size elements.
+ 
+ The capacity is rounded up to a power of 2 and all the storage is allocated
+ when the ring is initialised, nothing is allocated by push or pop. The read 
+ and write indices are kept on separate cache lines.
+ 
+ In single producer mode (PlankRingBufferMode_SPSC) both push and pop are 
+ wait-free, only one thread may push and one thread may pop at a time. In 
+ multiple producer mode (PlankRingBufferMode_MPSC) any number of threads may 
+ push, each slot has a sequence number which tells the consumer when the slot's
+ data has been written. Pushing is lock-free and popping is still wait-free but 
+ only one thread may pop at a time.
+ 
+ Elements may be copied in and out with pl_RingBuffer_Push() and 
+ pl_RingBuffer_Pop(), or written and read in place between 
+ pl_RingBuffer_BeginPush()/pl_RingBuffer_EndPush() and 
+ pl_RingBuffer_BeginPop()/pl_RingBuffer_EndPop().
+ 
+ @defgroup PlankRingBufferClass Plank RingBuffer class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** The producer modes for the ring buffer. */
+enum PlankRingBufferModeIdentifiers
+{
+    PlankRingBufferMode_SPSC = 0,   ///< One producer thread and one consumer thread.
+    PlankRingBufferMode_MPSC,       ///< Any number of producer threads and one consumer thread.
+    
+    PlankRingBufferMode_Count
+};
+
+typedef int PlankRingBufferMode;
+
+/** An opaque reference to the <i>Plank RingBuffer</i> object. */
+typedef struct PlankRingBuffer* PlankRingBufferRef; 
+
+/** Create and initialise a <i>Plank RingBuffer</i> object.
+ @param capacity    The minimum number of elements, this is rounded up to a power of 2.
+ @param elementSize The size of each element in bytes.
+ @param mode        PlankRingBufferMode_SPSC or PlankRingBufferMode_MPSC.
+ @return A <i>Plank RingBuffer</i> object as an opaque reference or PLANK_NULL. */
+PlankRingBufferRef pl_RingBuffer_CreateAndInit (const PlankL capacity, const PlankL elementSize, const PlankRingBufferMode mode);
+
+/** Create a <i>Plank RingBuffer</i> object.
+ @return A <i>Plank RingBuffer</i> object as an opaque reference or PLANK_NULL. */
+PlankRingBufferRef pl_RingBuffer_Create();
+
+/** Initialise a <i>Plank RingBuffer</i> object and allocate its storage.
+ @see pl_RingBuffer_CreateAndInit */
+PlankResult pl_RingBuffer_Init (PlankRingBufferRef p, const PlankL capacity, const PlankL elementSize, const PlankRingBufferMode mode);
+
+/** Deinitialise a <i>Plank RingBuffer</i> object.
+ Any elements still in the ring are discarded. */
+PlankResult pl_RingBuffer_DeInit (PlankRingBufferRef p);
+
+/** Destroy a <i>Plank RingBuffer</i> object. */
+PlankResult pl_RingBuffer_Destroy (PlankRingBufferRef p);
+
+/** Copy an element into the ring.
+ @return PLANK_TRUE if the element was added, PLANK_FALSE if the ring was full. */
+PlankB pl_RingBuffer_Push (PlankRingBufferRef p, const void* element);
+
+/** Copy the oldest element out of the ring.
+ @return PLANK_TRUE if an element was removed, PLANK_FALSE if the ring was empty. */
+PlankB pl_RingBuffer_Pop (PlankRingBufferRef p, void* element);
+
+/** Reserve the next slot for writing in place.
+ @param position Receives the position of the slot which must be passed to pl_RingBuffer_EndPush().
+ @return The slot to write or PLANK_NULL if the ring was full. */
+PlankP pl_RingBuffer_BeginPush (PlankRingBufferRef p, PlankL* position);
+
+/** Publish a slot reserved with pl_RingBuffer_BeginPush() to the consumer. */
+void pl_RingBuffer_EndPush (PlankRingBufferRef p, const PlankL position);
+
+/** Get the oldest slot for reading in place.
+ @param position Receives the position of the slot which must be passed to pl_RingBuffer_EndPop().
+ @return The slot to read or PLANK_NULL if the ring was empty. */
+PlankP pl_RingBuffer_BeginPop (PlankRingBufferRef p, PlankL* position);
+
+/** Return a slot read with pl_RingBuffer_BeginPop() to the producers. */
+void pl_RingBuffer_EndPop (PlankRingBufferRef p, const PlankL position);
+
+/** Get the number of elements the ring can hold. */
+PlankL pl_RingBuffer_GetCapacity (PlankRingBufferRef p);
+
+/** Get the size of each element in bytes. */
+PlankL pl_RingBuffer_GetElementSize (PlankRingBufferRef p);
+
+/** Get the producer mode. */
+PlankRingBufferMode pl_RingBuffer_GetMode (PlankRingBufferRef p);
+
+/** Get a pointer to the slot at an index between 0 and the capacity.
+ This is for setting up or tearing down the elements in place, not for use 
+ while other threads are pushing or popping. */
+PlankP pl_RingBuffer_GetSlot (PlankRingBufferRef p, const PlankL index);
+
+/** NB the result of this could be invalid by the time it is returned in a multithreaded context. */
+PlankL pl_RingBuffer_GetSize (PlankRingBufferRef p);
+
+/** @} */
+
+PLANK_END_C_LINKAGE
+
+#define PLANK_RINGBUFFER_PADSIZE 64
+
+#if !DOXYGEN
+typedef struct PlankRingBuffer
+{
+    PLANK_ALIGN(16) PlankAtomicL    writeIndex;
+    PlankL                          cachedReadIndex;        // only used by the producer in SPSC mode
+    PlankUC                         writePad[PLANK_RINGBUFFER_PADSIZE];
+    PLANK_ALIGN(16) PlankAtomicL    readIndex;
+    PlankL                          cachedWriteIndex;       // only used by the consumer in SPSC mode
+    PlankUC                         readPad[PLANK_RINGBUFFER_PADSIZE];
+    PlankUC*                        slots;
+    PlankAtomicL*                   sequences;              // only used in MPSC mode
+    PlankL                          capacity;
+    PlankL                          mask;
+    PlankL                          elementSize;
+    PlankRingBufferMode             mode;
+} PlankRingBuffer;
+#endif
+
+#endif // PLANK_RINGBUFFER_H
@@ -73,6 +73,7 @@ const char* pl_ResultString (PlankResult result)
         "A file operation was attempted when the file was at an invalid position",      //PlankResult_AudioFileInvalidFilePosition
         "The audio file frame format changed mid-stream.",                              //PlankResult_AudioFileFrameFormatChanged
         "The source audio file changed but not the frame format.",                      //PlankResult_AudioFileChanged
+        "The audio file writer's buffer was full and frames were dropped.",             //PlankResult_AudioFileWriterBufferFull
         
         "Setting the Thread function failed",                                           //PlankResult_ThreadSetFunctionFailed
         "Setting the Thread user data failed",                                          //PlankResult_ThreadSetUserDataFailed
@@ -57,6 +57,7 @@
  PLANK_FFT_VDSP=1           -   use vDSP on Mac OS X for FFT routines
  PLANK_FFT_VDSP_FLIPIMAG=1  -   flip the imag part of the FFT to match FFTReal data closely
  PLANK_VEC_VDSP 1           -   use vDSP on Mac OS X for vector ops
+ PLANK_VEC_SIMD 1           -   use SSE2/AVX/AVX2 (x86) or NEON (AArch64) intrinsics for vector ops
 */
 
 #ifndef PLANK_API
@@ -88,6 +88,23 @@ PlankResult pl_ThreadYield()
     return PlankResult_OK;
 }
 
+int pl_ThreadNumCores()
+{
+    int numCores;
+    
+#if PLANK_APPLE || PLANK_LINUX || PLANK_ANDROID
+    numCores = (int)sysconf (_SC_NPROCESSORS_ONLN);
+#elif PLANK_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo (&info);
+    numCores = (int)info.dwNumberOfProcessors;
+#else
+    #error No platform defined to implement threads.
+#endif
+    
+    return numCores > 0 ? numCores : 1;
+}
+
 PlankThreadID pl_ThreadCurrentID()
 {
 #if PLANK_APPLE || PLANK_LINUX || PLANK_ANDROID
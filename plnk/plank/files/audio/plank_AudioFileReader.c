@@ -49,6 +49,7 @@
 
 
 // private structures
+typedef struct PlankOggSeekIndex* PlankOggSeekIndexRef;
 
 // private functions and data
 typedef PlankResult (*PlankAudioFileReaderReadFramesFunction)(PlankAudioFileReaderRef, const PlankB, const int, void*, int *);
@@ -86,9 +87,18 @@ PlankResult pl_AudioFileReader_W64_ParseData (PlankAudioFileReaderRef p, const P
 PlankResult pl_AudioFileReader_Iff_Open (PlankAudioFileReaderRef p);
 PlankResult pl_AudioFileReader_Iff_ParseMain  (PlankAudioFileReaderRef p, const PlankIffID* mainID, const PlankIffID* formatID);
 PlankResult pl_AudioFileReader_Iff_ReadFrames (PlankAudioFileReaderRef p,  const PlankB convertByteOrder, const int numFrames, void* data, int *framesRead);
+PlankResult pl_AudioFileReader_Iff_ReadFramesDirect (PlankAudioFileReaderRef p, const int numFrames, const void** data, int *framesRead);
 PlankResult pl_AudioFileReader_Iff_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex);
 PlankResult pl_AudioFileReader_Iff_GetFramePosition (PlankAudioFileReaderRef p, PlankLL *frameIndex);
 
+PlankResult pl_OggSeekIndex_Init (PlankOggSeekIndexRef p);
+PlankResult pl_OggSeekIndex_DeInit (PlankOggSeekIndexRef p);
+PlankResult pl_OggSeekIndex_Build (PlankOggSeekIndexRef p, PlankFileRef file, const PlankLL granuleOffset);
+PlankB pl_OggSeekIndex_FindPage (PlankOggSeekIndexRef p, const PlankLL frameIndex, PlankLL* pageOffset);
+PlankB pl_OggSeekIndex_IsBuilt (PlankOggSeekIndexRef p);
+PlankResult pl_OggSeekIndex_ToJSON (PlankOggSeekIndexRef p, PlankJSONRef j);
+PlankResult pl_OggSeekIndex_InitFromJSON (PlankOggSeekIndexRef p, PlankFileRef file, PlankJSONRef j);
+
 // cues http://wiki.xiph.org/Chapter_Extension
 PlankResult pl_AudioFileReader_OggVorbis_Open  (PlankAudioFileReaderRef p, const char* filepath);
 PlankResult pl_AudioFileReader_OggVorbis_OpenWithFile  (PlankAudioFileReaderRef p, PlankFileRef file);
@@ -97,6 +107,8 @@ PlankResult pl_AudioFileReader_OggVorbis_ReadFrames (PlankAudioFileReaderRef p,
 PlankResult pl_AudioFileReader_OggVorbis_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex);
 PlankResult pl_AudioFileReader_OggVorbis_GetFramePosition (PlankAudioFileReaderRef p, PlankLL *frameIndex);
 PlankResult pl_AudioFileReader_OggVorbis_ParseMetaData (PlankAudioFileReaderRef p);
+PlankResult pl_AudioFileReader_OggVorbis_BuildSeekIndex (PlankAudioFileReaderRef p);
+PlankOggSeekIndexRef pl_AudioFileReader_OggVorbis_GetSeekIndex (PlankAudioFileReaderRef p);
 
 PlankResult pl_AudioFileReader_Opus_Open  (PlankAudioFileReaderRef p, const char* filepath);
 PlankResult pl_AudioFileReader_Opus_OpenWithFile  (PlankAudioFileReaderRef p, PlankFileRef file);
@@ -105,6 +117,8 @@ PlankResult pl_AudioFileReader_Opus_ReadFrames (PlankAudioFileReaderRef p, const
 PlankResult pl_AudioFileReader_Opus_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex);
 PlankResult pl_AudioFileReader_Opus_GetFramePosition (PlankAudioFileReaderRef p, PlankLL *frameIndex);
 PlankResult pl_AudioFileReader_Opus_ParseMetaData (PlankAudioFileReaderRef p);
+PlankResult pl_AudioFileReader_Opus_BuildSeekIndex (PlankAudioFileReaderRef p);
+PlankOggSeekIndexRef pl_AudioFileReader_Opus_GetSeekIndex (PlankAudioFileReaderRef p);
 
 PlankResult pl_AudioFileReader_Multi_Open (PlankAudioFileReaderRef p, PlankFileRef file);
 PlankResult pl_AudioFileReader_Multi_Close (PlankAudioFileReaderRef p);
@@ -497,6 +511,29 @@ PlankResult pl_AudioFileReader_OpenWithFile (PlankAudioFileReaderRef p, PlankFil
     return pl_AudioFileReader_OpenInternalInternal (p, 0, file, metaDataIOFlags);
 }
 
+PlankResult pl_AudioFileReader_OpenMapped (PlankAudioFileReaderRef p, const char* filepath, const PlankAudioFileMetaDataIOFlags metaDataIOFlags)
+{
+    PlankResult result;
+    PlankFile file;
+    
+    if ((result = pl_File_Init (&file)) != PlankResult_OK) goto exit;
+    
+    if ((result = pl_File_OpenMapped (&file, filepath, PLANKFILE_READ | PLANKFILE_BINARY)) == PlankResult_OK)
+    {
+        // the reader takes ownership of the file
+        if ((result = pl_AudioFileReader_OpenWithFile (p, &file, metaDataIOFlags)) == PlankResult_OK)
+            goto exit;
+    }
+    
+    // unmap here if the reader didn't take the file
+    pl_File_DeInit (&file);
+    
+    result = pl_AudioFileReader_OpenInternal (p, filepath, metaDataIOFlags);
+    
+exit:
+    return result;
+}
+
 PlankResult pl_AudioFileReader_OpenWithAudioFileArray (PlankAudioFileReaderRef p, PlankDynamicArrayRef array, PlankB ownArray, const int multiMode, int* indexRef)
 {
     return pl_AudioFileReader_Array_Open (p, array, ownArray, multiMode, indexRef);
@@ -826,6 +863,135 @@ PlankResult pl_AudioFileReader_ReadFrames (PlankAudioFileReaderRef p, const Plan
     return ((PlankAudioFileReaderReadFramesFunction)p->readFramesFunction)(p, convertByteOrder, numFrames, data, framesRead);
 }
 
+PlankB pl_AudioFileReader_CanReadFramesDirect (PlankAudioFileReaderRef p)
+{
+    return (p->peer != PLANK_NULL) &&
+           (p->readFramesFunction == (PlankM)pl_AudioFileReader_Iff_ReadFrames) &&
+           pl_File_CanReadDirect ((PlankFileRef)p->peer);
+}
+
+PlankResult pl_AudioFileReader_ReadFramesDirect (PlankAudioFileReaderRef p, const int numFrames, const void** data, int* framesRead)
+{
+    if (! pl_AudioFileReader_CanReadFramesDirect (p))
+        return PlankResult_AudioFileNotReady;
+    
+    return pl_AudioFileReader_Iff_ReadFramesDirect (p, numFrames, data, framesRead);
+}
+
+PlankResult pl_AudioFileReader_BuildSeekIndex (PlankAudioFileReaderRef p)
+{
+    PlankResult result = PlankResult_OK;
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+
+    switch (p->format)
+    {
+#if PLANK_OGGVORBIS
+        case PLANKAUDIOFILE_FORMAT_OGGVORBIS:
+            result = pl_AudioFileReader_OggVorbis_BuildSeekIndex (p);
+            break;
+#endif
+#if PLANK_OPUS
+        case PLANKAUDIOFILE_FORMAT_OPUS:
+            result = pl_AudioFileReader_Opus_BuildSeekIndex (p);
+            break;
+#endif
+        default:
+            result = PlankResult_AudioFileUnsupportedType;
+    }
+    
+exit:
+    return result;
+}
+
+PlankResult pl_AudioFileReader_SeekIndexToJSON (PlankAudioFileReaderRef p, PlankJSONRef j)
+{
+    PlankResult result = PlankResult_OK;
+    PlankOggSeekIndexRef index = PLANK_NULL;
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+    
+    switch (p->format)
+    {
+#if PLANK_OGGVORBIS
+        case PLANKAUDIOFILE_FORMAT_OGGVORBIS:
+            index = pl_AudioFileReader_OggVorbis_GetSeekIndex (p);
+            break;
+#endif
+#if PLANK_OPUS
+        case PLANKAUDIOFILE_FORMAT_OPUS:
+            index = pl_AudioFileReader_Opus_GetSeekIndex (p);
+            break;
+#endif
+        default:
+            result = PlankResult_AudioFileUnsupportedType;
+            goto exit;
+    }
+    
+#if PLANK_OGGVORBIS || PLANK_OPUS
+    if (! pl_OggSeekIndex_IsBuilt (index))
+    {
+        if ((result = pl_AudioFileReader_BuildSeekIndex (p)) != PlankResult_OK) goto exit;
+    }
+    
+    result = pl_OggSeekIndex_ToJSON (index, j);
+#else
+    (void)index;
+    (void)j;
+#endif
+    
+exit:
+    return result;
+}
+
+PlankResult pl_AudioFileReader_SeekIndexFromJSON (PlankAudioFileReaderRef p, PlankJSONRef j)
+{
+    PlankResult result = PlankResult_OK;
+    PlankOggSeekIndexRef index = PLANK_NULL;
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+    
+    switch (p->format)
+    {
+#if PLANK_OGGVORBIS
+        case PLANKAUDIOFILE_FORMAT_OGGVORBIS:
+            index = pl_AudioFileReader_OggVorbis_GetSeekIndex (p);
+            break;
+#endif
+#if PLANK_OPUS
+        case PLANKAUDIOFILE_FORMAT_OPUS:
+            index = pl_AudioFileReader_Opus_GetSeekIndex (p);
+            break;
+#endif
+        default:
+            result = PlankResult_AudioFileUnsupportedType;
+            goto exit;
+    }
+    
+#if PLANK_OGGVORBIS || PLANK_OPUS
+    // the Ogg readers' PlankFile is the first member of their peer
+    result = pl_OggSeekIndex_InitFromJSON (index, (PlankFileRef)p->peer, j);
+#else
+    (void)index;
+    (void)j;
+#endif
+    
+exit:
+    return result;
+}
+
 PlankAudioFileMetaDataRef pl_AudioFileReader_GetMetaData (PlankAudioFileReaderRef p)
 {
     return p->metaData;
@@ -2441,6 +2607,50 @@ exit:
     return result;
 }
 
+PlankResult pl_AudioFileReader_Iff_ReadFramesDirect (PlankAudioFileReaderRef p, const int numFrames, const void** data, int *framesRead)
+{
+    PlankResult result = PlankResult_OK;
+    PlankLL startFrame, endFrame;
+    int framesToRead, bytesToRead, bytesRead;
+    
+    bytesRead = 0;
+    
+    if ((p->dataPosition < 0) || (p->formatInfo.bytesPerFrame <= 0))
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+    
+    if ((result = pl_AudioFileReader_GetFramePosition (p, &startFrame)) != PlankResult_OK) goto exit;
+    
+    if (startFrame < 0)
+    {
+        result = PlankResult_AudioFileInvalidFilePosition;
+        goto exit;
+    }
+    
+    endFrame = startFrame + numFrames;
+    
+    framesToRead = ((p->numFrames == -1) || (endFrame <= p->numFrames)) ? (numFrames) : (int)(p->numFrames - startFrame);
+    bytesToRead = framesToRead * p->formatInfo.bytesPerFrame;
+    
+    if (bytesToRead > 0)
+    {
+        result = pl_File_ReadDirect ((PlankFileRef)p->peer, data, bytesToRead, &bytesRead);
+    }
+    else
+    {
+        *data = PLANK_NULL;
+        result = PlankResult_FileEOF;
+    }
+    
+exit:
+    if (framesRead != PLANK_NULL)
+        *framesRead = (p->formatInfo.bytesPerFrame > 0) ? bytesRead / p->formatInfo.bytesPerFrame : 0;
+    
+    return result;
+}
+
 PlankResult pl_AudioFileReader_Iff_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex)
 {
     PlankResult result;
@@ -2712,6 +2922,354 @@ exit:
     return result;
 }
 
+// -- Ogg Seek Index -- ////////////////////////////////////////////////////////
+
+#if PLANK_APPLE
+#pragma mark Ogg Seek Index
+#endif
+
+#define PLANKOGGSEEKINDEX_NOTBUILT      0
+#define PLANKOGGSEEKINDEX_READY         1
+#define PLANKOGGSEEKINDEX_UNUSABLE      2
+#define PLANKOGGSEEKINDEX_SCANSIZE      65536
+
+/* Maps the PCM position at the end of each page to the byte offset where the page starts
+ so a seek can go straight to the right page rather than bisecting the file. Only single
+ stream files are indexed, chained or multiplexed files keep using the library seeks. */
+typedef struct PlankOggSeekIndex
+{
+    PlankDynamicArray frames;
+    PlankDynamicArray offsets;
+    PlankLL fileLength;
+    int state;
+} PlankOggSeekIndex;
+
+static PlankResult pl_OggFile_GetLength (PlankFileRef file, PlankLL* length)
+{
+    PlankResult result;
+    PlankLL original;
+    
+    if ((result = pl_File_GetPosition (file, &original)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_SetPositionEnd (file)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_GetPosition (file, length)) != PlankResult_OK) goto exit;
+    if ((result = pl_File_SetPosition (file, original)) != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_OggSeekIndex_Init (PlankOggSeekIndexRef p)
+{
+    PlankResult result;
+    
+    p->fileLength = 0;
+    p->state = PLANKOGGSEEKINDEX_NOTBUILT;
+    
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->frames, sizeof (PlankLL))) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSize (&p->offsets, sizeof (PlankLL))) != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_OggSeekIndex_DeInit (PlankOggSeekIndexRef p)
+{
+    PlankResult result;
+    
+    if ((result = pl_DynamicArray_DeInit (&p->frames)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_DeInit (&p->offsets)) != PlankResult_OK) goto exit;
+    
+    p->state = PLANKOGGSEEKINDEX_NOTBUILT;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_OggSeekIndex_Build (PlankOggSeekIndexRef p, PlankFileRef file, const PlankLL granuleOffset)
+{
+    PlankResult result;
+    ogg_sync_state sync;
+    ogg_page page;
+    PlankLL original, pageOffset, granule;
+    PlankLL* frames;
+    PlankLL* offsets;
+    PlankL count, capacity;
+    long pageSize;
+    int serialNumber, bytesRead;
+    PlankB atEnd, isFirstPage;
+    char* data;
+    
+    // until the whole file has been scanned seeks fall back to the library
+    p->state = PLANKOGGSEEKINDEX_UNUSABLE;
+    
+    ogg_sync_init (&sync);
+    
+    original     = -1;
+    count        = 0;
+    pageOffset   = 0;
+    serialNumber = 0;
+    atEnd        = PLANK_FALSE;
+    isFirstPage  = PLANK_TRUE;
+    
+    if ((result = pl_File_GetPosition (file, &original)) != PlankResult_OK) goto exit;
+    if ((result = pl_OggFile_GetLength (file, &p->fileLength)) != PlankResult_OK) goto exit;
+    
+    // pages are rarely much smaller than 4k, the arrays grow if they are
+    capacity = (PlankL)(p->fileLength / 4096) + 16;
+    
+    if ((result = pl_DynamicArray_SetSize (&p->frames, capacity)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_SetSize (&p->offsets, capacity)) != PlankResult_OK) goto exit;
+    
+    frames  = (PlankLL*)pl_DynamicArray_GetArray (&p->frames);
+    offsets = (PlankLL*)pl_DynamicArray_GetArray (&p->offsets);
+
+    if ((result = pl_File_SetPosition (file, 0)) != PlankResult_OK) goto exit;
+    
+    while (PLANK_TRUE)
+    {
+        pageSize = ogg_sync_pageseek (&sync, &page);
+        
+        if (pageSize < 0)
+        {
+            // skipped bytes that weren't a valid page
+            pageOffset -= pageSize;
+        }
+        else if (pageSize == 0)
+        {
+            if (atEnd)
+                break;
+            
+            data = ogg_sync_buffer (&sync, PLANKOGGSEEKINDEX_SCANSIZE);
+            result = pl_File_Read (file, data, PLANKOGGSEEKINDEX_SCANSIZE, &bytesRead);
+            
+            if (result == PlankResult_FileEOF)
+                result = PlankResult_OK;
+            else if (result != PlankResult_OK)
+                goto exit;
+            
+            if (bytesRead > 0)
+                ogg_sync_wrote (&sync, bytesRead);
+            else
+                atEnd = PLANK_TRUE;
+        }
+        else
+        {
+            if (isFirstPage)
+            {
+                serialNumber = ogg_page_serialno (&page);
+                isFirstPage = PLANK_FALSE;
+            }
+            else if (ogg_page_serialno (&page) != serialNumber)
+            {
+                // chained or multiplexed
+                goto exit;
+            }
+            
+            granule = ogg_page_granulepos (&page);
+            
+            // header pages and pages with no finished packet have no usable position
+            if (granule > 0)
+            {
+                if ((count > 0) && ((granule - granuleOffset) < frames[count - 1]))
+                {
+                    // positions should never go backwards
+                    goto exit;
+                }
+                
+                if (count == capacity)
+                {
+                    capacity *= 2;
+                    
+                    if ((result = pl_DynamicArray_SetSize (&p->frames, capacity)) != PlankResult_OK) goto exit;
+                    if ((result = pl_DynamicArray_SetSize (&p->offsets, capacity)) != PlankResult_OK) goto exit;
+                    
+                    frames  = (PlankLL*)pl_DynamicArray_GetArray (&p->frames);
+                    offsets = (PlankLL*)pl_DynamicArray_GetArray (&p->offsets);
+                }
+                
+                frames[count]  = granule - granuleOffset;
+                offsets[count] = pageOffset;
+                count++;
+            }
+            
+            pageOffset += pageSize;
+        }
+    }
+    
+    if (count > 0)
+        p->state = PLANKOGGSEEKINDEX_READY;
+    
+exit:
+    if (p->state != PLANKOGGSEEKINDEX_READY)
+        count = 0;
+    
+    pl_DynamicArray_SetSize (&p->frames, count);
+    pl_DynamicArray_SetSize (&p->offsets, count);
+    
+    // the decoder expects the file to be where it left it
+    if (original >= 0)
+    {
+        if (result == PlankResult_OK)
+            result = pl_File_SetPosition (file, original);
+        else
+            pl_File_SetPosition (file, original);
+    }
+    
+    ogg_sync_clear (&sync);
+    return result;
+}
+
+PlankB pl_OggSeekIndex_FindPage (PlankOggSeekIndexRef p, const PlankLL frameIndex, PlankLL* pageOffset)
+{
+    const PlankLL* frames;
+    const PlankLL* offsets;
+    PlankL count, low, high, mid;
+    
+    if (p->state != PLANKOGGSEEKINDEX_READY)
+        return PLANK_FALSE;
+    
+    frames  = (const PlankLL*)pl_DynamicArray_GetArray (&p->frames);
+    offsets = (const PlankLL*)pl_DynamicArray_GetArray (&p->offsets);
+    count   = pl_DynamicArray_GetSize (&p->frames);
+    low     = 0;
+    high    = count;
+    
+    // count the pages that end before the frame
+    while (low < high)
+    {
+        mid = low + ((high - low) >> 1);
+        
+        if (frames[mid] < frameIndex)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    
+    if (low == 0)
+        return PLANK_FALSE;
+    
+    // decoding from the last page ending before the frame never overshoots it
+    *pageOffset = offsets[low - 1];
+    
+    return PLANK_TRUE;
+}
+
+PlankB pl_OggSeekIndex_IsBuilt (PlankOggSeekIndexRef p)
+{
+    return p->state != PLANKOGGSEEKINDEX_NOTBUILT;
+}
+
+PlankResult pl_OggSeekIndex_ToJSON (PlankOggSeekIndexRef p, PlankJSONRef j)
+{
+    PlankResult result;
+    PlankJSONRef jindex;
+    PlankL count;
+    
+    result = PlankResult_OK;
+    
+    if (p->state != PLANKOGGSEEKINDEX_READY)
+    {
+        result = PlankResult_AudioFileUnsupportedType;
+        goto exit;
+    }
+    
+    count = pl_DynamicArray_GetSize (&p->frames);
+    
+    jindex = pl_JSON_Object();
+    
+    pl_JSON_ObjectSetType (jindex, PLANK_OGGSEEKINDEX_JSON_TYPE);
+    pl_JSON_ObjectSetVersionString (jindex, PLANK_OGGSEEKINDEX_JSON_VERSION);
+    
+    pl_JSON_ObjectPutKey (jindex, PLANK_OGGSEEKINDEX_JSON_LENGTH, pl_JSON_Int (p->fileLength));
+    pl_JSON_ObjectPutKey (jindex, PLANK_OGGSEEKINDEX_JSON_FRAMES,
+                          pl_JSON_IntArrayCompressed ((const PlankLL*)pl_DynamicArray_GetArray (&p->frames), count));
+    pl_JSON_ObjectPutKey (jindex, PLANK_OGGSEEKINDEX_JSON_OFFSETS,
+                          pl_JSON_IntArrayCompressed ((const PlankLL*)pl_DynamicArray_GetArray (&p->offsets), count));
+    
+    pl_JSON_ArrayAppend (j, jindex);
+    
+exit:
+    return result;
+}
+
+PlankResult pl_OggSeekIndex_InitFromJSON (PlankOggSeekIndexRef p, PlankFileRef file, PlankJSONRef j)
+{
+    PlankResult result;
+    PlankJSONRef jlength, jframes, joffsets;
+    const PlankLL* frames;
+    const PlankLL* offsets;
+    PlankLL fileLength;
+    PlankL count, i;
+    
+    result = PlankResult_OK;
+    
+    if (! pl_JSON_IsObjectType (j, PLANK_OGGSEEKINDEX_JSON_TYPE))
+    {
+        result = PlankResult_JSONError;
+        goto exit;
+    }
+    
+    if (pl_JSON_ObjectGetVersion (j) > pl_JSON_VersionCode (PLANK_OGGSEEKINDEX_JSON_VERSION))
+    {
+        result = PlankResult_JSONError;
+        goto exit;
+    }
+
+    if (((jlength  = pl_JSON_ObjectAtKey (j, PLANK_OGGSEEKINDEX_JSON_LENGTH)) == 0) ||
+        ((jframes  = pl_JSON_ObjectAtKey (j, PLANK_OGGSEEKINDEX_JSON_FRAMES)) == 0) ||
+        ((joffsets = pl_JSON_ObjectAtKey (j, PLANK_OGGSEEKINDEX_JSON_OFFSETS)) == 0))
+    {
+        result = PlankResult_JSONError;
+        goto exit;
+    }
+    
+    if ((result = pl_OggFile_GetLength (file, &fileLength)) != PlankResult_OK) goto exit;
+    
+    // an index saved for a different version of the file is useless
+    if (pl_JSON_IntGet (jlength) != fileLength)
+    {
+        result = PlankResult_AudioFileChanged;
+        goto exit;
+    }
+    
+    // from here on any existing index is replaced
+    p->state = PLANKOGGSEEKINDEX_NOTBUILT;
+    
+    if ((result = pl_JSON_IntArrayGet (jframes, &p->frames)) != PlankResult_OK) goto exit;
+    if ((result = pl_JSON_IntArrayGet (joffsets, &p->offsets)) != PlankResult_OK) goto exit;
+    
+    count   = pl_DynamicArray_GetSize (&p->frames);
+    frames  = (const PlankLL*)pl_DynamicArray_GetArray (&p->frames);
+    offsets = (const PlankLL*)pl_DynamicArray_GetArray (&p->offsets);
+    
+    if ((count < 1) || (count != pl_DynamicArray_GetSize (&p->offsets)))
+    {
+        result = PlankResult_JSONError;
+        goto exit;
+    }
+    
+    for (i = 0; i < count; ++i)
+    {
+        if ((offsets[i] < 0) || (offsets[i] >= fileLength) || ((i > 0) && (frames[i] < frames[i - 1])))
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+    }
+    
+    p->fileLength = fileLength;
+    p->state = PLANKOGGSEEKINDEX_READY;
+    
+exit:
+    if (p->state == PLANKOGGSEEKINDEX_NOTBUILT)
+    {
+        // leave it to be built from the file instead
+        pl_DynamicArray_SetSize (&p->frames, 0);
+        pl_DynamicArray_SetSize (&p->offsets, 0);
+    }
+    
+    return result;
+}
 
 #endif
 
@@ -2733,6 +3291,10 @@ typedef struct PlankOggVorbisFileReader
     int bufferFrames;
     PlankLL totalFramesRead;
     int bitStream;
+    PlankOggSeekIndex seekIndex;
+    PlankDynamicArray lap;
+    int lapPosition;
+    int lapFrames;
 } PlankOggVorbisFileReader;
 
 typedef PlankOggVorbisFileReader* PlankOggVorbisFileReaderRef;
@@ -2778,6 +3340,8 @@ PlankResult pl_AudioFileReader_OggVorbis_Open  (PlankAudioFileReaderRef p, const
     ogg->bufferFrames    = 0;
     ogg->totalFramesRead = 0;
     ogg->bitStream       = -1;
+    
+    if ((result = pl_OggSeekIndex_Init (&ogg->seekIndex)) != PlankResult_OK) goto exit;
 
     if ((result = pl_File_Init (&ogg->file)) != PlankResult_OK) goto exit;
     
@@ -2816,12 +3380,18 @@ PlankResult pl_AudioFileReader_OggVorbis_Open  (PlankAudioFileReaderRef p, const
     
     if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&ogg->buffer, 1, bufferSize, PLANK_FALSE)) != PlankResult_OK) goto exit;
     
+    // seeks crossfade over half a short block as vorbisfile's lapping seeks do
+    ogg->lapFrames   = vorbis_info_blocksize (info, 0) / 2;
+    ogg->lapPosition = ogg->lapFrames;
+    
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&ogg->lap, 1, ogg->lapFrames * p->formatInfo.bytesPerFrame, PLANK_FALSE)) != PlankResult_OK) goto exit;
+    
     if (numFrames < 0) // could allow this for continuous streams?
     {
         result = PlankResult_UnknownError;
         goto exit;
     }
-        
+    
     p->numFrames = numFrames;
     p->readFramesFunction       = (PlankM)pl_AudioFileReader_OggVorbis_ReadFrames;
     p->setFramePositionFunction = (PlankM)pl_AudioFileReader_OggVorbis_SetFramePosition;
@@ -2872,6 +3442,8 @@ PlankResult pl_AudioFileReader_OggVorbis_OpenWithFile  (PlankAudioFileReaderRef
     ogg->totalFramesRead = 0;
     ogg->bitStream       = -1;
     
+    if ((result = pl_OggSeekIndex_Init (&ogg->seekIndex)) != PlankResult_OK) goto exit;
+    
     if ((result = pl_File_GetMode (file, &mode)) != PlankResult_OK) goto exit;
     
     if (! (mode & PLANKFILE_BINARY))
@@ -2927,6 +3499,12 @@ PlankResult pl_AudioFileReader_OggVorbis_OpenWithFile  (PlankAudioFileReaderRef
     
     if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&ogg->buffer, 1, bufferSize, PLANK_FALSE)) != PlankResult_OK) goto exit;
     
+    // seeks crossfade over half a short block as vorbisfile's lapping seeks do
+    ogg->lapFrames   = vorbis_info_blocksize (info, 0) / 2;
+    ogg->lapPosition = ogg->lapFrames;
+    
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&ogg->lap, 1, ogg->lapFrames * p->formatInfo.bytesPerFrame, PLANK_FALSE)) != PlankResult_OK) goto exit;
+    
     if (numFrames < 0) // could allow this for continuous streams?
     {
         result = PlankResult_UnknownError;
@@ -2971,6 +3549,8 @@ PlankResult pl_AudioFileReader_OggVorbis_Close (PlankAudioFileReaderRef p)
     }
     
     if ((result = pl_DynamicArray_DeInit (&ogg->buffer)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_DeInit (&ogg->lap)) != PlankResult_OK) goto exit;
+    if ((result = pl_OggSeekIndex_DeInit (&ogg->seekIndex)) != PlankResult_OK) goto exit;
 
     pl_Memory_Free (m, ogg);
     p->peer = PLANK_NULL;
@@ -2979,6 +3559,27 @@ exit:
     return result;
 }
 
+static void pl_OggVorbisFileReader_Lap (PlankOggVorbisFileReaderRef ogg, float* dst, const int numFrames, const int numChannels)
+{
+    const float* lap;
+    float window, fadeIn, fadeOut;
+    int numLapFrames, i, j;
+    
+    lap = (const float*)pl_DynamicArray_GetArray (&ogg->lap) + ogg->lapPosition * numChannels;
+    numLapFrames = pl_MinI (numFrames, ogg->lapFrames - ogg->lapPosition);
+    
+    // the same power complementary window vorbisfile splices with
+    for (i = 0; i < numLapFrames; ++i, ++ogg->lapPosition)
+    {
+        window  = pl_SinF (0.5f * PLANK_PI_F * pl_SquaredF (pl_SinF ((ogg->lapPosition + 0.5f) / ogg->lapFrames * 0.5f * PLANK_PI_F)));
+        fadeIn  = window * window;
+        fadeOut = 1.0f - fadeIn;
+        
+        for (j = 0; j < numChannels; ++j, ++dst, ++lap)
+            *dst = *dst * fadeIn + *lap * fadeOut;
+    }
+}
+
 PlankResult pl_AudioFileReader_OggVorbis_ReadFrames (PlankAudioFileReaderRef p, const PlankB convertByteOrder, const int numFrames, void* data, int *framesReadOut)
 {    
     PlankResult result;
@@ -3020,6 +3621,9 @@ PlankResult pl_AudioFileReader_OggVorbis_ReadFrames (PlankAudioFileReaderRef p,
                         
             pl_MemoryCopy (dst, buffer + bufferFramePosition * numChannels, framesThisTime * bytesPerFrame);
             
+            if (ogg->lapPosition < ogg->lapFrames)
+                pl_OggVorbisFileReader_Lap (ogg, dst, framesThisTime, numChannels);
+            
             bufferFramePosition += framesThisTime;
             bufferFramesRemaining -= framesThisTime;
             numFramesRemaining -= framesThisTime;
@@ -3096,20 +3700,70 @@ exit:
 }
 
 
+static PlankResult pl_AudioFileReader_OggVorbis_SeekWithIndex (PlankAudioFileReaderRef p, const PlankLL pageOffset, const PlankLL frameIndex)
+{
+    PlankOggVorbisFileReaderRef ogg;
+    OggVorbis_File* file;
+    PlankLL position;
+    float** pcm;
+    int bufferFrameEnd, framesThisTime, bitStream;
+    
+    ogg            = (PlankOggVorbisFileReaderRef)p->peer;
+    file           = &ogg->oggVorbisFile;
+    bufferFrameEnd = (int)pl_DynamicArray_GetSize (&ogg->buffer) / p->formatInfo.bytesPerFrame;
+    bitStream      = ogg->bitStream;
+    
+    if (ov_raw_seek (file, pageOffset) != 0)
+        return PlankResult_FileSeekFailed;
+    
+    position = ov_pcm_tell (file);
+    
+    if ((position < 0) || (position > frameIndex))
+        return PlankResult_FileSeekFailed;
+    
+    // decode and discard the rest of the way to the frame
+    while (position < frameIndex)
+    {
+        framesThisTime = (int)ov_read_float (file, &pcm, (int)pl_MinLL (frameIndex - position, bufferFrameEnd), &bitStream);
+        
+        if (framesThisTime <= 0)
+            return PlankResult_FileSeekFailed;
+        
+        position += framesThisTime;
+    }
+    
+    return PlankResult_OK;
+}
+
 PlankResult pl_AudioFileReader_OggVorbis_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex)
 {
     PlankOggVorbisFileReaderRef ogg;
-    int err;
+    PlankLL pageOffset;
+    int framesRead;
     
     ogg = (PlankOggVorbisFileReaderRef)p->peer;
-    err = ov_pcm_seek_lap (&ogg->oggVorbisFile, frameIndex); // should probably eventually do my own lapping in readframes?
     
-    if (err != 0)
-        return PlankResult_FileSeekFailed;
+    // keep what would have played next to crossfade from, this is silence at the end of the file
+    ogg->lapPosition = ogg->lapFrames;
+    pl_AudioFileReader_OggVorbis_ReadFrames (p, PLANK_FALSE, ogg->lapFrames, pl_DynamicArray_GetArray (&ogg->lap), &framesRead);
     
     ogg->bufferFrames   = 0;
     ogg->bufferPosition = 0;
     
+    // the index is built by the first seek unless it was restored from a sidecar, 
+    // it only covers single stream files, anything else bisects as before
+    if (ogg->oggVorbisFile.seekable && ! pl_OggSeekIndex_IsBuilt (&ogg->seekIndex))
+        pl_AudioFileReader_OggVorbis_BuildSeekIndex (p);
+    
+    if (! (pl_OggSeekIndex_FindPage (&ogg->seekIndex, frameIndex, &pageOffset) &&
+           (pl_AudioFileReader_OggVorbis_SeekWithIndex (p, pageOffset, frameIndex) == PlankResult_OK)))
+    {
+        if (ov_pcm_seek (&ogg->oggVorbisFile, frameIndex) != 0)
+            return PlankResult_FileSeekFailed;
+    }
+    
+    ogg->lapPosition = 0;
+    
     return PlankResult_OK;
 }
 
@@ -3129,6 +3783,24 @@ PlankResult pl_AudioFileReader_OggVorbis_GetFramePosition (PlankAudioFileReaderR
     return PlankResult_OK;
 }
 
+PlankResult pl_AudioFileReader_OggVorbis_BuildSeekIndex (PlankAudioFileReaderRef p)
+{
+    PlankOggVorbisFileReaderRef ogg;
+    
+    ogg = (PlankOggVorbisFileReaderRef)p->peer;
+    
+    if (! ogg->oggVorbisFile.seekable)
+        return PlankResult_FileSeekFailed;
+    
+    // granule positions are offset by the start of the first link
+    return pl_OggSeekIndex_Build (&ogg->seekIndex, &ogg->file, ogg->oggVorbisFile.pcmlengths[0]);
+}
+
+PlankOggSeekIndexRef pl_AudioFileReader_OggVorbis_GetSeekIndex (PlankAudioFileReaderRef p)
+{
+    return &((PlankOggVorbisFileReaderRef)p->peer)->seekIndex;
+}
+
 PlankResult pl_AudioFileReader_OggVorbis_ParseMetaData (PlankAudioFileReaderRef p)
 {
     PlankResult result = PlankResult_OK;
@@ -3248,6 +3920,7 @@ typedef struct PlankOpusFileReader
     int bufferFrames;    
     PlankLL totalFramesRead;
     int link;
+    PlankOggSeekIndex seekIndex;
 } PlankOpusFileReader;
 
 typedef PlankOpusFileReader* PlankOpusFileReaderRef;
@@ -3294,6 +3967,8 @@ PlankResult pl_AudioFileReader_Opus_Open  (PlankAudioFileReaderRef p, const char
     opus->totalFramesRead = 0;
     opus->link            = -1;
     
+    if ((result = pl_OggSeekIndex_Init (&opus->seekIndex)) != PlankResult_OK) goto exit;
+    
     if ((result = pl_File_Init (&opus->file)) != PlankResult_OK) goto exit;
     
     // open as binary, not writable, litte endian
@@ -3394,6 +4069,8 @@ PlankResult pl_AudioFileReader_Opus_OpenWithFile  (PlankAudioFileReaderRef p, Pl
     opus->totalFramesRead = 0;
     opus->link            = -1;
     
+    if ((result = pl_OggSeekIndex_Init (&opus->seekIndex)) != PlankResult_OK) goto exit;
+    
     if ((result = pl_File_GetMode (file, &mode)) != PlankResult_OK) goto exit;
     
     if (! (mode & PLANKFILE_BINARY))
@@ -3492,6 +4169,7 @@ PlankResult pl_AudioFileReader_Opus_Close (PlankAudioFileReaderRef p)
     opus->oggOpusFile = PLANK_NULL;
     
     if ((result = pl_DynamicArray_DeInit (&opus->buffer)) != PlankResult_OK) goto exit;
+    if ((result = pl_OggSeekIndex_DeInit (&opus->seekIndex)) != PlankResult_OK) goto exit;
     
     pl_Memory_Free (m, opus);
     p->peer = PLANK_NULL;
@@ -3593,12 +4271,64 @@ exit:
     return result;
 }
 
+static PlankResult pl_AudioFileReader_Opus_SeekWithIndex (PlankAudioFileReaderRef p, const PlankLL pageOffset, const PlankLL frameIndex)
+{
+    PlankOpusFileReaderRef opus;
+    OggOpusFile* file;
+    PlankLL position;
+    int numChannels, bufferFrameEnd, framesThisTime, link;
+    float* buffer;
+    
+    opus           = (PlankOpusFileReaderRef)p->peer;
+    file           = opus->oggOpusFile;
+    numChannels    = (int)pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo);
+    bufferFrameEnd = (int)pl_DynamicArray_GetSize (&opus->buffer) / p->formatInfo.bytesPerFrame;
+    buffer         = (float*)pl_DynamicArray_GetArray (&opus->buffer);
+    
+    opus->bufferFrames   = 0;
+    opus->bufferPosition = 0;
+    
+    if (op_raw_seek (file, pageOffset) != 0)
+        return PlankResult_FileSeekFailed;
+    
+    position = op_pcm_tell (file);
+    
+    // the indexed page ends before the pre-roll so this is at most a page of extra decoding
+    if ((position < 0) || (position > frameIndex))
+        return PlankResult_FileSeekFailed;
+    
+    // decode the pre-roll and the rest of the way to the frame
+    while (position < frameIndex)
+    {
+        framesThisTime = op_read_float (file, buffer, (int)pl_MinLL (frameIndex - position, bufferFrameEnd) * numChannels, &link);
+        
+        if (framesThisTime <= 0)
+            return PlankResult_FileSeekFailed;
+        
+        position += framesThisTime;
+    }
+    
+    return PlankResult_OK;
+}
+
 PlankResult pl_AudioFileReader_Opus_SetFramePosition (PlankAudioFileReaderRef p, const PlankLL frameIndex)
 {
     PlankOpusFileReaderRef opus;
+    PlankLL pageOffset, preRoll;
     int err;
     
     opus = (PlankOpusFileReaderRef)p->peer;
+    preRoll = PLANKAUDIOFILE_OPUS_PREROLL_MS * (PLANKAUDIOFILE_OPUS_DEFAULTSAMPLERATE / 1000);
+    
+    // the index is built by the first seek unless it was restored from a sidecar
+    if (op_seekable (opus->oggOpusFile) && ! pl_OggSeekIndex_IsBuilt (&opus->seekIndex))
+        pl_AudioFileReader_Opus_BuildSeekIndex (p);
+    
+    // start far enough back for the decoder to converge, the index only covers single stream files
+    if (pl_OggSeekIndex_FindPage (&opus->seekIndex, frameIndex - preRoll, &pageOffset) &&
+        (pl_AudioFileReader_Opus_SeekWithIndex (p, pageOffset, frameIndex) == PlankResult_OK))
+        return PlankResult_OK;
+    
     err = op_pcm_seek (opus->oggOpusFile, frameIndex);
     
     if (err != 0)
@@ -3626,6 +4356,24 @@ PlankResult pl_AudioFileReader_Opus_GetFramePosition (PlankAudioFileReaderRef p,
     return PlankResult_OK;
 }
 
+PlankResult pl_AudioFileReader_Opus_BuildSeekIndex (PlankAudioFileReaderRef p)
+{
+    PlankOpusFileReaderRef opus;
+    
+    opus = (PlankOpusFileReaderRef)p->peer;
+    
+    if (! op_seekable (opus->oggOpusFile))
+        return PlankResult_FileSeekFailed;
+    
+    // granule positions include the pre-skip
+    return pl_OggSeekIndex_Build (&opus->seekIndex, &opus->file, op_head (opus->oggOpusFile, 0)->pre_skip);
+}
+
+PlankOggSeekIndexRef pl_AudioFileReader_Opus_GetSeekIndex (PlankAudioFileReaderRef p)
+{
+    return &((PlankOpusFileReaderRef)p->peer)->seekIndex;
+}
+
 PlankResult pl_AudioFileReader_Opus_ParseMetaData (PlankAudioFileReaderRef p)
 {
     PlankResult result = PlankResult_OK;
@@ -40,6 +40,13 @@
 #define PLANK_AUDIOFILEREADER_H
 
 #include "plank_AudioFileCommon.h"
+#include "../../misc/json/plank_JSON.h"
+
+#define PLANK_OGGSEEKINDEX_JSON_TYPE         "plank::OggSeekIndex"
+#define PLANK_OGGSEEKINDEX_JSON_VERSION      0, 1, 0, 0
+#define PLANK_OGGSEEKINDEX_JSON_LENGTH       "length"
+#define PLANK_OGGSEEKINDEX_JSON_FRAMES       "frames"
+#define PLANK_OGGSEEKINDEX_JSON_OFFSETS      "offsets"
 
 PLANK_BEGIN_C_LINKAGE
 
@@ -95,6 +102,12 @@ PlankResult pl_AudioFileReader_OpenInternal (PlankAudioFileReaderRef p, const ch
  The AudioFileReader takes ownership of the file and zeros the incomming file object. */
 PlankResult pl_AudioFileReader_OpenWithFile (PlankAudioFileReaderRef p, PlankFileRef file, const PlankAudioFileMetaDataIOFlags metaDataIOFlags);
 
+/** Open a file by mapping it into memory.
+ This is intended for uncompressed IFF formats (WAV, AIFF, CAF, W64) where frames can
+ then be accessed in place using pl_AudioFileReader_ReadFramesDirect(). If the file can't
+ be mapped or opened this way it falls back to pl_AudioFileReader_OpenInternal(). */
+PlankResult pl_AudioFileReader_OpenMapped (PlankAudioFileReaderRef p, const char* filepath, const PlankAudioFileMetaDataIOFlags metaDataIOFlags);
+
 PlankResult pl_AudioFileReader_OpenWithAudioFileArray (PlankAudioFileReaderRef p, PlankDynamicArrayRef array, PlankB ownArray, const int multiMode, int* indexRef);
 
 typedef PlankResult (*PlankAudioFileReaderCustomNextFunction)(PlankP, PlankAudioFileReaderRef, PlankAudioFileReaderRef*);
@@ -184,6 +197,45 @@ PlankResult pl_AudioFileReader_GetFramePosition (PlankAudioFileReaderRef p, Plan
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_AudioFileReader_ReadFrames (PlankAudioFileReaderRef p, const PlankB convertByteOrder, const int numFrames, void* data, int* framesRead);
 
+/** Determine if frames can be accessed in place using pl_AudioFileReader_ReadFramesDirect().
+ This is the case for uncompressed IFF files opened from memory or mapped files.
+ @param p The <i>Plank AudioFileReader</i> object. */
+PlankB pl_AudioFileReader_CanReadFramesDirect (PlankAudioFileReaderRef p);
+
+/** Access frames in place without copying them to an intermediate buffer.
+ The frames are in the file's own encoding and byte order and must be treated as read-only.
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @param numFrames The maximum number of frames to access.
+ @param data On return contains a pointer to the frames.
+ @param framesRead On return contains the number of frames available at @e data. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileReader_ReadFramesDirect (PlankAudioFileReaderRef p, const int numFrames, const void** data, int* framesRead);
+
+/** Build the seek index of an Ogg Vorbis or Opus file.
+ The index maps PCM positions to the pages that contain them so seeks can jump straight
+ to the right page. It is built by the first seek unless it was restored with 
+ pl_AudioFileReader_SeekIndexFromJSON(). Opening the file doesn't scan it, call this (e.g., on a
+ background thread before playback) so that the first seek doesn't have to either.
+ Chained or multiplexed Ogg files are not indexed and seek as before.
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileReader_BuildSeekIndex (PlankAudioFileReaderRef p);
+
+/** Append the seek index of an Ogg Vorbis or Opus file to a JSON array. 
+ This can be saved as a sidecar file and restored with pl_AudioFileReader_SeekIndexFromJSON()
+ the next time the file is opened. The index is built first if necessary.
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @param j The JSON array to append the index to.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileReader_SeekIndexToJSON (PlankAudioFileReaderRef p, PlankJSONRef j);
+
+/** Restore the seek index of an Ogg Vorbis or Opus file from JSON.
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @param j A JSON object previously stored by pl_AudioFileReader_SeekIndexToJSON().
+ @return A result code which will be PlankResult_OK if the operation was completely successful. 
+ This will be PlankResult_AudioFileChanged if the index was saved for a file of a different length. */
+PlankResult pl_AudioFileReader_SeekIndexFromJSON (PlankAudioFileReaderRef p, PlankJSONRef j);
+
 PlankAudioFileMetaDataRef pl_AudioFileReader_GetMetaData (PlankAudioFileReaderRef p);
 
 PlankResult pl_AudioFileReader_SetName (PlankAudioFileReaderRef p, const char* text);
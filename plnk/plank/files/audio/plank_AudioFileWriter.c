@@ -45,8 +45,13 @@
 #include "plank_AudioFileMetaData.h"
 #include "plank_AudioFileCuePoint.h"
 #include "plank_AudioFileRegion.h"
+#include "../../core/plank_Thread.h"
+#include "../../containers/plank_RingBuffer.h"
 
 #define PLANKAUDIOFILEWRITER_BUFFERLENGTH 256
+#define PLANKAUDIOFILEWRITER_ASYNCBLOCKFRAMES 1024
+#define PLANKAUDIOFILEWRITER_ASYNCNUMBLOCKS 32
+#define PLANKAUDIOFILEWRITER_ASYNCHEADERSIZE 16
 
 // private
 
@@ -100,6 +105,29 @@ PlankResult pl_AudioFileWriter_W64_WriteMetaData (PlankAudioFileWriterRef p);
 PlankResult pl_AudioFileWriter_OggVorbis_WriteMetaData (PlankAudioFileWriterRef p);
 PlankResult pl_AudioFileWriter_Opus_WriteMetaData (PlankAudioFileWriterRef p);
 
+// the frames follow this in each block, PLANKAUDIOFILEWRITER_ASYNCHEADERSIZE keeps them aligned
+typedef struct PlankAudioFileWriterAsyncBlock
+{
+    int numFrames;
+    int convertByteOrder;
+} PlankAudioFileWriterAsyncBlock;
+
+typedef struct PlankAudioFileWriterAsync* PlankAudioFileWriterAsyncRef;
+typedef struct PlankAudioFileWriterAsync
+{
+    PlankRingBuffer ring;
+    PlankThread thread;
+    PlankAtomicLL droppedFrames;
+    PlankAtomicI result;
+    PlankUC* block;             // the block being filled by the caller or null
+    PlankL blockPosition;
+    int blockFrames;
+    double sleepDuration;
+} PlankAudioFileWriterAsync;
+
+static PlankResult pl_AudioFileWriter_StopAsync (PlankAudioFileWriterRef p);
+static PlankResult pl_AudioFileWriter_WriteFramesAsync (PlankAudioFileWriterRef p, const PlankB convertByteOrder, const int numFrames, const void* data);
+
 typedef struct PlankIffAudioFileWriter* PlankIffAudioFileWriterRef;
 typedef struct PlankIffAudioFileWriter
 {
@@ -237,6 +265,8 @@ PlankResult pl_AudioFileWriter_Init (PlankAudioFileWriterRef p)
     p->writeFramesFunction         = PLANK_NULL;
     p->writeHeaderFunction         = PLANK_NULL;
     
+    p->async                       = PLANK_NULL;
+    
     return result;
 }
 
@@ -760,6 +790,11 @@ PlankResult pl_AudioFileWriter_Close (PlankAudioFileWriterRef p)
         goto exit;
     }
     
+    if (p->async != PLANK_NULL)
+    {
+        if ((result = pl_AudioFileWriter_StopAsync (p)) != PlankResult_OK) goto exit;
+    }
+    
     if (p->peer == PLANK_NULL)
         return PlankResult_OK;
     
@@ -811,6 +846,12 @@ PlankResult pl_AudioFileWriter_WriteFrames (PlankAudioFileWriterRef p, const Pla
         goto exit;
     }
     
+    if (p->async != PLANK_NULL)
+    {
+        result = pl_AudioFileWriter_WriteFramesAsync (p, convertByteOrder, numFrames, data);
+        goto exit;
+    }
+    
     result = ((PlankAudioFileWriterWriteFramesFunction)p->writeFramesFunction) (p, convertByteOrder, numFrames, data);
     
     if (result == PlankResult_OK)
@@ -871,6 +912,245 @@ PlankResult pl_AudioFileWriter_GetChannelLayout (PlankAudioFileWriterRef p, Plan
     return PlankResult_OK;
 }
 
+///--- Async
+
+static PlankResult pl_AudioFileWriter_AsyncThreadFunction (PlankThreadRef thread)
+{
+    PlankAudioFileWriterRef p;
+    PlankAudioFileWriterAsyncRef async;
+    PlankAudioFileWriterAsyncBlock* block;
+    PlankResult result;
+    PlankL position;
+    PlankB shouldExit;
+    
+    p = (PlankAudioFileWriterRef)pl_Thread_GetUserData (thread);
+    async = (PlankAudioFileWriterAsyncRef)p->async;
+    
+    do
+    {
+        // read this before draining so every block pushed before the exit request is written
+        shouldExit = pl_Thread_GetShouldExit (thread);
+        
+        while ((block = (PlankAudioFileWriterAsyncBlock*)pl_RingBuffer_BeginPop (&async->ring, &position)) != PLANK_NULL)
+        {
+            result = ((PlankAudioFileWriterWriteFramesFunction)p->writeFramesFunction) (p, block->convertByteOrder, block->numFrames,
+                                                                                          (PlankUC*)block + PLANKAUDIOFILEWRITER_ASYNCHEADERSIZE);
+            
+            if (result == PlankResult_OK)
+                p->numFrames += block->numFrames;
+            else
+                pl_AtomicI_Set (&async->result, result);
+            
+            pl_RingBuffer_EndPop (&async->ring, position);
+        }
+        
+        if (! shouldExit)
+            pl_ThreadSleep (async->sleepDuration);
+    } while (! shouldExit);
+    
+    return PlankResult_OK;
+}
+
+PlankResult pl_AudioFileWriter_StartAsync (PlankAudioFileWriterRef p, const int blockFrames, const int numBlocks)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m = pl_MemoryGlobal();
+    PlankAudioFileWriterAsyncRef async = PLANK_NULL;
+    
+    if (p->async != PLANK_NULL)
+    {
+        result = PlankResult_ThreadAlreadyRunning;
+        goto exit;
+    }
+    
+    if ((p->peer == PLANK_NULL) || (p->formatInfo.bytesPerFrame <= 0))
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+    
+    if (! p->writeFramesFunction)
+    {
+        result = PlankResult_FunctionsInvalid;
+        goto exit;
+    }
+    
+    async = (PlankAudioFileWriterAsyncRef)pl_Memory_AllocateBytes (m, sizeof (PlankAudioFileWriterAsync));
+    
+    if (async == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    pl_MemoryZero (async, sizeof (PlankAudioFileWriterAsync));
+    
+    async->blockFrames   = blockFrames > 0 ? blockFrames : PLANKAUDIOFILEWRITER_ASYNCBLOCKFRAMES;
+    async->sleepDuration = p->formatInfo.sampleRate > 0.0 ? async->blockFrames / p->formatInfo.sampleRate * 0.25 : 0.001;
+    
+    if ((result = pl_RingBuffer_Init (&async->ring, numBlocks > 0 ? numBlocks : PLANKAUDIOFILEWRITER_ASYNCNUMBLOCKS,
+                                      PLANKAUDIOFILEWRITER_ASYNCHEADERSIZE + async->blockFrames * p->formatInfo.bytesPerFrame,
+                                      PlankRingBufferMode_SPSC)) != PlankResult_OK)
+    {
+        pl_Memory_Free (m, async);
+        async = PLANK_NULL;
+        goto exit;
+    }
+    
+    pl_AtomicLL_Init (&async->droppedFrames);
+    pl_AtomicI_Init (&async->result);
+    pl_Thread_Init (&async->thread);
+    pl_Thread_SetName (&async->thread, "AudioFileWriter");
+    pl_Thread_SetFunction (&async->thread, pl_AudioFileWriter_AsyncThreadFunction);
+    pl_Thread_SetUserData (&async->thread, p);
+    
+    p->async = async;
+    
+    if ((result = pl_Thread_Start (&async->thread)) != PlankResult_OK)
+    {
+        p->async = PLANK_NULL;
+        pl_Thread_DeInit (&async->thread);
+        pl_RingBuffer_DeInit (&async->ring);
+        pl_AtomicLL_DeInit (&async->droppedFrames);
+        pl_AtomicI_DeInit (&async->result);
+        pl_Memory_Free (m, async);
+    }
+    
+exit:
+    return result;
+}
+
+static PlankResult pl_AudioFileWriter_StopAsync (PlankAudioFileWriterRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankAudioFileWriterAsyncRef async = (PlankAudioFileWriterAsyncRef)p->async;
+    
+    pl_AudioFileWriter_FlushAsync (p);
+    pl_Thread_SetShouldExit (&async->thread);
+    
+    // the thread resets itself if it has already returned
+    result = pl_Thread_Wait (&async->thread);
+    
+    if (result == PlankResult_ThreadInvalid)
+        result = PlankResult_OK;
+    
+    if (result != PlankResult_OK)
+        goto exit;
+    
+    p->async = PLANK_NULL;
+    
+    pl_Thread_DeInit (&async->thread);
+    pl_RingBuffer_DeInit (&async->ring);
+    pl_AtomicLL_DeInit (&async->droppedFrames);
+    pl_AtomicI_DeInit (&async->result);
+    
+    result = pl_Memory_Free (pl_MemoryGlobal(), async);
+    
+exit:
+    return result;
+}
+
+static PlankResult pl_AudioFileWriter_WriteFramesAsync (PlankAudioFileWriterRef p, const PlankB convertByteOrder, const int numFrames, const void* data)
+{
+    PlankResult result = PlankResult_OK;
+    PlankAudioFileWriterAsyncRef async = (PlankAudioFileWriterAsyncRef)p->async;
+    PlankAudioFileWriterAsyncBlock* block;
+    const PlankUC* source = (const PlankUC*)data;
+    const int bytesPerFrame = p->formatInfo.bytesPerFrame;
+    int numFramesRemaining = numFrames;
+    int framesThisTime;
+    
+    while (numFramesRemaining > 0)
+    {
+        block = (PlankAudioFileWriterAsyncBlock*)async->block;
+        
+        // a block holds frames in one byte order only
+        if ((block != PLANK_NULL) && (block->numFrames > 0) && (block->convertByteOrder != (int)convertByteOrder))
+        {
+            pl_AudioFileWriter_FlushAsync (p);
+            block = PLANK_NULL;
+        }
+        
+        if (block == PLANK_NULL)
+        {
+            block = (PlankAudioFileWriterAsyncBlock*)pl_RingBuffer_BeginPush (&async->ring, &async->blockPosition);
+            
+            if (block == PLANK_NULL)
+            {
+                pl_AtomicLL_Add (&async->droppedFrames, numFramesRemaining);
+                result = PlankResult_AudioFileWriterBufferFull;
+                goto exit;
+            }
+            
+            block->numFrames = 0;
+            block->convertByteOrder = convertByteOrder;
+            async->block = (PlankUC*)block;
+        }
+        
+        framesThisTime = pl_MinI (numFramesRemaining, async->blockFrames - block->numFrames);
+        
+        pl_MemoryCopy ((PlankUC*)block + PLANKAUDIOFILEWRITER_ASYNCHEADERSIZE + block->numFrames * bytesPerFrame,
+                       source, framesThisTime * bytesPerFrame);
+        
+        block->numFrames += framesThisTime;
+        source += framesThisTime * bytesPerFrame;
+        numFramesRemaining -= framesThisTime;
+        
+        if (block->numFrames == async->blockFrames)
+        {
+            pl_RingBuffer_EndPush (&async->ring, async->blockPosition);
+            async->block = PLANK_NULL;
+        }
+    }
+    
+exit:
+    return result;
+}
+
+PlankB pl_AudioFileWriter_IsAsync (PlankAudioFileWriterRef p)
+{
+    return p->async != PLANK_NULL;
+}
+
+PlankResult pl_AudioFileWriter_FlushAsync (PlankAudioFileWriterRef p)
+{
+    PlankAudioFileWriterAsyncRef async = (PlankAudioFileWriterAsyncRef)p->async;
+    
+    if (async == PLANK_NULL)
+        return PlankResult_AudioFileNotReady;
+    
+    // an empty block stays reserved for the next write
+    if ((async->block != PLANK_NULL) && (((PlankAudioFileWriterAsyncBlock*)async->block)->numFrames > 0))
+    {
+        pl_RingBuffer_EndPush (&async->ring, async->blockPosition);
+        async->block = PLANK_NULL;
+    }
+    
+    return PlankResult_OK;
+}
+
+float pl_AudioFileWriter_GetAsyncLoad (PlankAudioFileWriterRef p)
+{
+    PlankAudioFileWriterAsyncRef async = (PlankAudioFileWriterAsyncRef)p->async;
+    
+    if (async == PLANK_NULL)
+        return 0.f;
+    
+    return (float)pl_RingBuffer_GetSize (&async->ring) / (float)pl_RingBuffer_GetCapacity (&async->ring);
+}
+
+PlankLL pl_AudioFileWriter_GetAsyncDroppedFrames (PlankAudioFileWriterRef p)
+{
+    PlankAudioFileWriterAsyncRef async = (PlankAudioFileWriterAsyncRef)p->async;
+    return async == PLANK_NULL ? 0 : pl_AtomicLL_Get (&async->droppedFrames);
+}
+
+PlankResult pl_AudioFileWriter_GetAsyncResult (PlankAudioFileWriterRef p)
+{
+    PlankAudioFileWriterAsyncRef async = (PlankAudioFileWriterAsyncRef)p->async;
+    return async == PLANK_NULL ? PlankResult_OK : (PlankResult)pl_AtomicI_Get (&async->result);
+}
+
 static PlankResult pl_AudioFileWriter_WAV_OpenInternal (PlankAudioFileWriterRef p, const char* filepath, PlankFileRef file)
 {
     PlankResult result = PlankResult_OK;
@@ -1958,7 +2238,7 @@ PlankResult pl_AudioFileWriter_Iff_WriteFrames (PlankAudioFileWriterRef p, const
     numChannels    = pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo);
     bytesPerSample = p->formatInfo.bytesPerFrame / numChannels;
 
-    if ((bytesPerSample == 1) || pl_AudioFileWriter_IsEncodingNativeEndian (p))
+    if ((bytesPerSample == 1) || ! convertByteOrder || pl_AudioFileWriter_IsEncodingNativeEndian (p))
     {
         result = pl_IffFileWriter_WriteChunk (iff, 0, chunkID, data, numFrames * p->formatInfo.bytesPerFrame, PLANKIFFFILEWRITER_MODEAPPEND);
         if (result != PlankResult_OK) goto exit;
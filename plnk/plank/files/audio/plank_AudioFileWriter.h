@@ -116,6 +116,40 @@ PlankResult pl_AudioFileWriter_WriteHeader (PlankAudioFileWriterRef p);
 
 PlankResult pl_AudioFileWriter_WriteFrames (PlankAudioFileWriterRef p, const PlankB convertByteOrder, const int numFrames, const void* data);
 
+/** Hand the conversion, encoding and file writes to a background thread.
+ This must be called after the file is opened. From then on 
+ pl_AudioFileWriter_WriteFrames() only copies the frames into a preallocated 
+ ring of blocks, each full block is written by a thread owned by this writer.
+ Writers started this way each have their own thread so several files encode 
+ in parallel. If the ring is full the frames that don't fit are dropped and 
+ pl_AudioFileWriter_WriteFrames() returns PlankResult_AudioFileWriterBufferFull.
+ Only one thread may call pl_AudioFileWriter_WriteFrames() at a time and the 
+ header should not be written until the file is closed. 
+ pl_AudioFileWriter_Close() waits for the queued frames to be written.
+ @param p The <i>Plank AudioFileWriter</i> object.
+ @param blockFrames The number of frames in each block, or 0 for the default.
+ @param numBlocks The number of blocks in the ring, or 0 for the default. This is rounded up to a power of 2.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileWriter_StartAsync (PlankAudioFileWriterRef p, const int blockFrames, const int numBlocks);
+
+/** Determines if frames are being written on a background thread. */
+PlankB pl_AudioFileWriter_IsAsync (PlankAudioFileWriterRef p);
+
+/** Pass a partly filled block to the background thread.
+ Otherwise frames are only handed over in full blocks. */
+PlankResult pl_AudioFileWriter_FlushAsync (PlankAudioFileWriterRef p);
+
+/** Get the proportion of the background ring in use.
+ This is 0 when the writer thread is keeping up and approaches 1 before frames are dropped. */
+float pl_AudioFileWriter_GetAsyncLoad (PlankAudioFileWriterRef p);
+
+/** Get the number of frames dropped because the background ring was full. */
+PlankLL pl_AudioFileWriter_GetAsyncDroppedFrames (PlankAudioFileWriterRef p);
+
+/** Get the result of the last failed write on the background thread.
+ This is PlankResult_OK if all the blocks so far have been written successfully. */
+PlankResult pl_AudioFileWriter_GetAsyncResult (PlankAudioFileWriterRef p);
+
 PlankB pl_AudioFileWriter_IsEncodingNativeEndian (PlankAudioFileWriterRef p);
 
 PlankResult pl_AudioFileWriter_SetHeaderPad (PlankAudioFileWriterRef p, const PlankUI headerPad);
@@ -151,6 +185,8 @@ typedef struct PlankAudioFileWriter
     
     PlankM writeFramesFunction;
     PlankM writeHeaderFunction;
+    
+    PlankP async;
 
 } PlankAudioFileWriter;
 #endif
@@ -42,6 +42,11 @@
 #include "../maths/plank_Maths.h"
 #include "plank_MultiFileReader.h"
 
+#if !PLANK_WIN
+    #include <fcntl.h>
+    #include <sys/mman.h>
+#endif
+
 // file callbacks
 
 PlankResult pl_FileDefaultOpenCallback (PlankFileRef p)
@@ -370,6 +375,99 @@ static PlankResult pl_FileMemoryGetPositionCallback (PlankFileRef p, PlankLL* po
     return PlankResult_OK;
 }
 
+// mapped callbacks (read-only memory stream backed by a file mapping)
+
+static PlankResult pl_FileMappedOpenCallback (PlankFileRef p)
+{
+#if PLANK_WIN
+    HANDLE file, mapping;
+    LARGE_INTEGER fileSize;
+    void* view;
+    
+    file = CreateFileA (p->path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    
+    if (file == INVALID_HANDLE_VALUE)
+        return PlankResult_FileOpenFailed;
+    
+    if (! GetFileSizeEx (file, &fileSize) || (fileSize.QuadPart <= 0) || ((PlankLL)(SIZE_T)fileSize.QuadPart != fileSize.QuadPart))
+    {
+        CloseHandle (file);
+        return PlankResult_FileOpenFailed;
+    }
+    
+    // the view keeps the mapping and file alive so the handles can be closed now
+    mapping = CreateFileMappingA (file, 0, PAGE_READONLY, 0, 0, 0);
+    CloseHandle (file);
+    
+    if (mapping == 0)
+        return PlankResult_FileOpenFailed;
+    
+    view = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle (mapping);
+    
+    if (view == 0)
+        return PlankResult_FileOpenFailed;
+    
+    p->stream = view;
+    p->size = (PlankLL)fileSize.QuadPart;
+#else
+    int fd;
+    struct stat st;
+    void* view;
+    
+    fd = open (p->path, O_RDONLY);
+    
+    if (fd < 0)
+        return PlankResult_FileOpenFailed;
+    
+    if ((fstat (fd, &st) != 0) || (st.st_size <= 0) || ((PlankLL)(size_t)st.st_size != (PlankLL)st.st_size))
+    {
+        close (fd);
+        return PlankResult_FileOpenFailed;
+    }
+    
+    // the mapping remains valid after the descriptor is closed
+    view = mmap (0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    
+    if (view == MAP_FAILED)
+        return PlankResult_FileOpenFailed;
+    
+    p->stream = view;
+    p->size = (PlankLL)st.st_size;
+#endif
+    
+    p->position = 0;
+    return PlankResult_OK;
+}
+
+static PlankResult pl_FileMappedCloseCallback (PlankFileRef p)
+{
+#if PLANK_WIN
+    if (! UnmapViewOfFile (p->stream))
+        return PlankResult_FileCloseFailed;
+#else
+    if (munmap (p->stream, (size_t)p->size) != 0)
+        return PlankResult_FileCloseFailed;
+#endif
+    
+    return pl_File_Init (p);
+}
+
+static PlankResult pl_FileMappedClearCallback (PlankFileRef p)
+{
+    (void)p;
+    return PlankResult_FileModeInvalid;
+}
+
+static PlankResult pl_FileMappedWriteCallback (PlankFileRef p, const void* data, const int maximumBytes)
+{
+    (void)p;
+    (void)data;
+    (void)maximumBytes;
+    return PlankResult_FileWriteError;
+}
+
 // dynamic array callbacks
 
 static PlankResult pl_FileDynamicArrayOpenCallback (PlankFileRef p)
@@ -1118,6 +1216,54 @@ exit:
     return result;    
 }
 
+PlankResult pl_File_OpenMapped (PlankFileRef p, const char* filepath, const int mode)
+{
+    PlankResult result;
+    
+    if (mode & (PLANKFILE_WRITE | PLANKFILE_APPEND | PLANKFILE_NEW))
+    {
+        result = PlankResult_FileModeInvalid; // mappings are read-only
+        goto exit;
+    }
+    
+    if (p->stream != 0)
+    {
+        if ((result = pl_File_Close (p)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    if ((filepath == 0) || (filepath[0] == 0))
+    {
+        result = PlankResult_FilePathInvalid;
+        goto exit;
+    }
+    
+    strncpy (p->path, filepath, PLANKPATH_MAXLENGTH);
+    
+    p->stream = 0;
+    p->size = 0;
+    p->mode = mode & PLANKFILE_ALL;
+    p->type = PLANKFILE_STREAMTYPE_MAPPED;
+    
+    result = pl_File_SetFunction (p,
+                                  pl_FileMappedOpenCallback,
+                                  pl_FileMappedCloseCallback,
+                                  pl_FileMappedClearCallback,
+                                  pl_FileMemoryGetStatusCallback,
+                                  pl_FileMemoryReadCallback,
+                                  pl_FileMappedWriteCallback,
+                                  pl_FileMemorySetPositionCallback,
+                                  pl_FileMemoryGetPositionCallback);
+    
+    if (result != PlankResult_OK) goto exit;
+    
+    if ((result = (p->openFunction) (p)) != PlankResult_OK)
+        pl_File_Init (p);
+    
+exit:
+    return result;
+}
+
 #define PLANKFILE_COPYCHUNKSIZE 512
 
 PlankResult pl_File_Copy (PlankFileRef p, PlankFileRef source, const PlankLL size)
@@ -1336,6 +1482,58 @@ PlankResult pl_File_Read (PlankFileRef p, PlankP data, const int maximumBytes, i
     return (p->readFunction) (p, data, maximumBytes, bytesRead);    
 }
 
+PlankB pl_File_CanReadDirect (PlankFileRef p)
+{
+    return (p->stream != 0) &&
+           ((p->type == PLANKFILE_STREAMTYPE_MEMORY) || (p->type == PLANKFILE_STREAMTYPE_MAPPED));
+}
+
+PlankResult pl_File_ReadDirect (PlankFileRef p, const void** data, const int maximumBytes, int* bytesRead)
+{
+    PlankResult result;
+    int bytesAvailable;
+    
+    result = PlankResult_OK;
+    bytesAvailable = 0;
+    *data = PLANK_NULL;
+    
+    if (p->stream == 0)
+    {
+        result = PlankResult_FileInvalid;
+        goto exit;
+    }
+    
+    if (! (p->mode & PLANKFILE_READ))
+    {
+        result = PlankResult_FileReadError;
+        goto exit;
+    }
+    
+    if (! pl_File_CanReadDirect (p))
+    {
+        result = PlankResult_FileModeInvalid;
+        goto exit;
+    }
+    
+    bytesAvailable = (int)pl_MinLL (maximumBytes, p->size - p->position);
+    
+    if (bytesAvailable <= 0)
+    {
+        bytesAvailable = 0;
+        result = PlankResult_FileEOF;
+        goto exit;
+    }
+    
+    *data = (const PlankUC*)p->stream + p->position;
+    p->position += bytesAvailable;
+    
+exit:
+    if (bytesRead)
+        *bytesRead = bytesAvailable;
+    
+    return result;
+}
+
 PlankResult pl_File_ReadC (PlankFileRef p, char* data)
 {
     PlankResult result;
@@ -105,6 +105,7 @@ typedef struct PlankFile* PlankFileRef;
 #define PLANKFILE_STREAMTYPE_DYNAMICARRAY   3
 #define PLANKFILE_STREAMTYPE_NETWORK        4
 #define PLANKFILE_STREAMTYPE_MULTI          5
+#define PLANKFILE_STREAMTYPE_MAPPED         6
 #define PLANKFILE_STREAMTYPE_OTHER          999
 
 #define PLANKFILE_SETPOSITION_ABSOLUTE       SEEK_SET
@@ -231,6 +232,17 @@ PlankResult pl_File_OpenDynamicArray (PlankFileRef p, PlankDynamicArrayRef memor
 
 PlankResult pl_File_OpenMulti (PlankFileRef p, PlankMulitFileReaderRef multi, const int mode);
 
+/** Open a file for reading by mapping it into memory.
+ The file is mapped read-only (using mmap() or MapViewOfFile()) and is then 
+ accessed in the same way as a memory stream. The mapping is released when
+ the file is closed. Files larger than the address space (i.e., over 4GB on
+ 32-bit systems) and empty files can't be mapped.
+ @param p The <i>Plank %File</i> object. 
+ @param filepath The filepath of the file to open.
+ @param mode A bit mask code to identify the mode, this must not include PLANKFILE_WRITE.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_File_OpenMapped (PlankFileRef p, const char* filepath, const int mode);
+
 PlankResult pl_File_Copy (PlankFileRef p, PlankFileRef source, const PlankLL size);
 
 PlankResult pl_File_Clear (PlankFileRef p);
@@ -334,6 +346,24 @@ PlankResult pl_File_Read (PlankFileRef p, PlankP data, const int maximumBytes, i
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_File_ReadC (PlankFileRef p, char* data);
 
+/** Determine if the file supports direct reads using pl_File_ReadDirect().
+ This is the case for memory and mapped stream types. 
+ @param p The <i>Plank %File</i> object. 
+ @return @c true if the data can be accessed in place. */
+PlankB pl_File_CanReadDirect (PlankFileRef p);
+
+/** Access an array of bytes from the file in place without copying.
+ On success @e data points at the current position in the underlying memory
+ and the position is advanced by the number of bytes available. The data must
+ be treated as read-only and is valid only while the file remains open.
+ @param p The <i>Plank %File</i> object. 
+ @param data On return contains a pointer to the data (or PLANK_NULL at the end of the file).
+ @param maximumBytes The maximum number of bytes to access.
+ @param bytesRead On return contains the number of bytes available at @e data (pass PLANK_NULL to ignore this).
+ @return A result code which will be PlankResult_OK if the operation was completely successful,
+         PlankResult_FileModeInvalid if the stream type doesn't support direct reads. */
+PlankResult pl_File_ReadDirect (PlankFileRef p, const void** data, const int maximumBytes, int* bytesRead);
+
 /** Read a short from the file (16-bit int).
  @param p The <i>Plank %File</i> object. 
  @param data A pointer to the memory location that will receive the data.
@@ -0,0 +1,578 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plank_StandardHeader.h"
+#include "../../containers/atomic/plank_Atomic.h"
+#include "../plank_Maths.h"
+#include "plank_Vectors.h"
+#include "plank_VectorDispatch.h"
+
+// x86 kernels are compiled for their own target regardless of the build flags
+// and are only installed in the table if the host CPU reports support.
+// Vendor libraries already do their own dispatch so are left in charge.
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && !defined(PLANK_VEC_VDSP) && !defined(PLANK_VEC_IPP)
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #if _MSC_VER >= 1910
+            #define PLANK_VECTORDISPATCH_X86 1
+            #define PLANK_VECTORDISPATCH_TARGET(TARGET)
+        #endif
+    #elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 7))
+        #define PLANK_VECTORDISPATCH_X86 1
+        #define PLANK_VECTORDISPATCH_TARGET(TARGET) __attribute__((target(TARGET)))
+    #endif
+#endif
+
+#if PLANK_VECTORDISPATCH_X86
+#include <immintrin.h>
+
+#define PLANK_VD(LEVEL,NAME,TYPECODE) PLANK_VECTORDISPATCH_##LEVEL##_##NAME##TYPECODE
+
+//------------------------------------------------------------------------------
+// SSE2
+
+#define PLANK_VECTORDISPATCH_TARGET_SSE2                PLANK_VECTORDISPATCH_TARGET("sse2")
+
+#define PLANK_VECTORDISPATCH_SSE2_TypeF                 __m128
+#define PLANK_VECTORDISPATCH_SSE2_LengthF               4
+#define PLANK_VECTORDISPATCH_SSE2_LoadF(P)              _mm_loadu_ps (P)
+#define PLANK_VECTORDISPATCH_SSE2_StoreF(P,A)           _mm_storeu_ps ((P), (A))
+#define PLANK_VECTORDISPATCH_SSE2_SetF(S)               _mm_set1_ps (S)
+#define PLANK_VECTORDISPATCH_SSE2_AddF(A,B)             _mm_add_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_SubF(A,B)             _mm_sub_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_MulF(A,B)             _mm_mul_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_DivF(A,B)             _mm_div_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_SqrtF(A)              _mm_sqrt_ps (A)
+#define PLANK_VECTORDISPATCH_SSE2_MinF(A,B)             _mm_min_ps ((B), (A))
+#define PLANK_VECTORDISPATCH_SSE2_MaxF(A,B)             _mm_max_ps ((B), (A))
+#define PLANK_VECTORDISPATCH_SSE2_AbsF(A)               _mm_andnot_ps (_mm_set1_ps (-0.f), (A))
+#define PLANK_VECTORDISPATCH_SSE2_NegF(A)               _mm_xor_ps (_mm_set1_ps (-0.f), (A))
+#define PLANK_VECTORDISPATCH_SSE2_MulAddF(A,B,C)        _mm_add_ps (_mm_mul_ps ((A), (B)), (C))
+#define PLANK_VECTORDISPATCH_SSE2_EQF(A,B)              _mm_and_ps (_mm_cmpeq_ps ((A), (B)), _mm_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_SSE2_NEF(A,B)              _mm_and_ps (_mm_cmpneq_ps ((A), (B)), _mm_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_SSE2_GTF(A,B)              _mm_and_ps (_mm_cmpgt_ps ((A), (B)), _mm_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_SSE2_GEF(A,B)              _mm_and_ps (_mm_cmpge_ps ((A), (B)), _mm_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_SSE2_LTF(A,B)              _mm_and_ps (_mm_cmplt_ps ((A), (B)), _mm_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_SSE2_LEF(A,B)              _mm_and_ps (_mm_cmple_ps ((A), (B)), _mm_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_SSE2_ThreshF(A,B)          _mm_andnot_ps (_mm_cmplt_ps ((A), (B)), (A))
+
+#define PLANK_VECTORDISPATCH_SSE2_TypeD                 __m128d
+#define PLANK_VECTORDISPATCH_SSE2_LengthD               2
+#define PLANK_VECTORDISPATCH_SSE2_LoadD(P)              _mm_loadu_pd (P)
+#define PLANK_VECTORDISPATCH_SSE2_StoreD(P,A)           _mm_storeu_pd ((P), (A))
+#define PLANK_VECTORDISPATCH_SSE2_SetD(S)               _mm_set1_pd (S)
+#define PLANK_VECTORDISPATCH_SSE2_AddD(A,B)             _mm_add_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_SubD(A,B)             _mm_sub_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_MulD(A,B)             _mm_mul_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_DivD(A,B)             _mm_div_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_SSE2_SqrtD(A)              _mm_sqrt_pd (A)
+#define PLANK_VECTORDISPATCH_SSE2_MinD(A,B)             _mm_min_pd ((B), (A))
+#define PLANK_VECTORDISPATCH_SSE2_MaxD(A,B)             _mm_max_pd ((B), (A))
+#define PLANK_VECTORDISPATCH_SSE2_AbsD(A)               _mm_andnot_pd (_mm_set1_pd (-0.0), (A))
+#define PLANK_VECTORDISPATCH_SSE2_NegD(A)               _mm_xor_pd (_mm_set1_pd (-0.0), (A))
+#define PLANK_VECTORDISPATCH_SSE2_MulAddD(A,B,C)        _mm_add_pd (_mm_mul_pd ((A), (B)), (C))
+#define PLANK_VECTORDISPATCH_SSE2_EQD(A,B)              _mm_and_pd (_mm_cmpeq_pd ((A), (B)), _mm_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_SSE2_NED(A,B)              _mm_and_pd (_mm_cmpneq_pd ((A), (B)), _mm_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_SSE2_GTD(A,B)              _mm_and_pd (_mm_cmpgt_pd ((A), (B)), _mm_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_SSE2_GED(A,B)              _mm_and_pd (_mm_cmpge_pd ((A), (B)), _mm_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_SSE2_LTD(A,B)              _mm_and_pd (_mm_cmplt_pd ((A), (B)), _mm_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_SSE2_LED(A,B)              _mm_and_pd (_mm_cmple_pd ((A), (B)), _mm_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_SSE2_ThreshD(A,B)          _mm_andnot_pd (_mm_cmplt_pd ((A), (B)), (A))
+
+//------------------------------------------------------------------------------
+// AVX2 + FMA
+
+#define PLANK_VECTORDISPATCH_TARGET_AVX2                PLANK_VECTORDISPATCH_TARGET("avx2,fma")
+
+#define PLANK_VECTORDISPATCH_AVX2_TypeF                 __m256
+#define PLANK_VECTORDISPATCH_AVX2_LengthF               8
+#define PLANK_VECTORDISPATCH_AVX2_LoadF(P)              _mm256_loadu_ps (P)
+#define PLANK_VECTORDISPATCH_AVX2_StoreF(P,A)           _mm256_storeu_ps ((P), (A))
+#define PLANK_VECTORDISPATCH_AVX2_SetF(S)               _mm256_set1_ps (S)
+#define PLANK_VECTORDISPATCH_AVX2_AddF(A,B)             _mm256_add_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_SubF(A,B)             _mm256_sub_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_MulF(A,B)             _mm256_mul_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_DivF(A,B)             _mm256_div_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_SqrtF(A)              _mm256_sqrt_ps (A)
+#define PLANK_VECTORDISPATCH_AVX2_MinF(A,B)             _mm256_min_ps ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX2_MaxF(A,B)             _mm256_max_ps ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX2_AbsF(A)               _mm256_andnot_ps (_mm256_set1_ps (-0.f), (A))
+#define PLANK_VECTORDISPATCH_AVX2_NegF(A)               _mm256_xor_ps (_mm256_set1_ps (-0.f), (A))
+#define PLANK_VECTORDISPATCH_AVX2_MulAddF(A,B,C)        _mm256_fmadd_ps ((A), (B), (C))
+#define PLANK_VECTORDISPATCH_AVX2_CmpF(A,B,PRED)        _mm256_and_ps (_mm256_cmp_ps ((A), (B), PRED), _mm256_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_AVX2_EQF(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpF ((A), (B), _CMP_EQ_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_NEF(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpF ((A), (B), _CMP_NEQ_UQ)
+#define PLANK_VECTORDISPATCH_AVX2_GTF(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpF ((A), (B), _CMP_GT_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_GEF(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpF ((A), (B), _CMP_GE_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_LTF(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpF ((A), (B), _CMP_LT_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_LEF(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpF ((A), (B), _CMP_LE_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_ThreshF(A,B)          _mm256_andnot_ps (_mm256_cmp_ps ((A), (B), _CMP_LT_OQ), (A))
+
+#define PLANK_VECTORDISPATCH_AVX2_TypeD                 __m256d
+#define PLANK_VECTORDISPATCH_AVX2_LengthD               4
+#define PLANK_VECTORDISPATCH_AVX2_LoadD(P)              _mm256_loadu_pd (P)
+#define PLANK_VECTORDISPATCH_AVX2_StoreD(P,A)           _mm256_storeu_pd ((P), (A))
+#define PLANK_VECTORDISPATCH_AVX2_SetD(S)               _mm256_set1_pd (S)
+#define PLANK_VECTORDISPATCH_AVX2_AddD(A,B)             _mm256_add_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_SubD(A,B)             _mm256_sub_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_MulD(A,B)             _mm256_mul_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_DivD(A,B)             _mm256_div_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX2_SqrtD(A)              _mm256_sqrt_pd (A)
+#define PLANK_VECTORDISPATCH_AVX2_MinD(A,B)             _mm256_min_pd ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX2_MaxD(A,B)             _mm256_max_pd ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX2_AbsD(A)               _mm256_andnot_pd (_mm256_set1_pd (-0.0), (A))
+#define PLANK_VECTORDISPATCH_AVX2_NegD(A)               _mm256_xor_pd (_mm256_set1_pd (-0.0), (A))
+#define PLANK_VECTORDISPATCH_AVX2_MulAddD(A,B,C)        _mm256_fmadd_pd ((A), (B), (C))
+#define PLANK_VECTORDISPATCH_AVX2_CmpD(A,B,PRED)        _mm256_and_pd (_mm256_cmp_pd ((A), (B), PRED), _mm256_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_AVX2_EQD(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpD ((A), (B), _CMP_EQ_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_NED(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpD ((A), (B), _CMP_NEQ_UQ)
+#define PLANK_VECTORDISPATCH_AVX2_GTD(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpD ((A), (B), _CMP_GT_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_GED(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpD ((A), (B), _CMP_GE_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_LTD(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpD ((A), (B), _CMP_LT_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_LED(A,B)              PLANK_VECTORDISPATCH_AVX2_CmpD ((A), (B), _CMP_LE_OQ)
+#define PLANK_VECTORDISPATCH_AVX2_ThreshD(A,B)          _mm256_andnot_pd (_mm256_cmp_pd ((A), (B), _CMP_LT_OQ), (A))
+
+//------------------------------------------------------------------------------
+// AVX-512F
+
+#define PLANK_VECTORDISPATCH_TARGET_AVX512F             PLANK_VECTORDISPATCH_TARGET("avx512f")
+
+#define PLANK_VECTORDISPATCH_AVX512F_TypeF              __m512
+#define PLANK_VECTORDISPATCH_AVX512F_LengthF            16
+#define PLANK_VECTORDISPATCH_AVX512F_LoadF(P)           _mm512_loadu_ps (P)
+#define PLANK_VECTORDISPATCH_AVX512F_StoreF(P,A)        _mm512_storeu_ps ((P), (A))
+#define PLANK_VECTORDISPATCH_AVX512F_SetF(S)            _mm512_set1_ps (S)
+#define PLANK_VECTORDISPATCH_AVX512F_AddF(A,B)          _mm512_add_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_SubF(A,B)          _mm512_sub_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_MulF(A,B)          _mm512_mul_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_DivF(A,B)          _mm512_div_ps ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_SqrtF(A)           _mm512_sqrt_ps (A)
+#define PLANK_VECTORDISPATCH_AVX512F_MinF(A,B)          _mm512_min_ps ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX512F_MaxF(A,B)          _mm512_max_ps ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX512F_AbsF(A)            _mm512_abs_ps (A)
+#define PLANK_VECTORDISPATCH_AVX512F_NegF(A)            _mm512_castsi512_ps (_mm512_xor_si512 (_mm512_castps_si512 (_mm512_set1_ps (-0.f)), _mm512_castps_si512 (A)))
+#define PLANK_VECTORDISPATCH_AVX512F_MulAddF(A,B,C)     _mm512_fmadd_ps ((A), (B), (C))
+#define PLANK_VECTORDISPATCH_AVX512F_CmpF(A,B,PRED)     _mm512_maskz_mov_ps (_mm512_cmp_ps_mask ((A), (B), PRED), _mm512_set1_ps (1.f))
+#define PLANK_VECTORDISPATCH_AVX512F_EQF(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpF ((A), (B), _CMP_EQ_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_NEF(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpF ((A), (B), _CMP_NEQ_UQ)
+#define PLANK_VECTORDISPATCH_AVX512F_GTF(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpF ((A), (B), _CMP_GT_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_GEF(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpF ((A), (B), _CMP_GE_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_LTF(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpF ((A), (B), _CMP_LT_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_LEF(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpF ((A), (B), _CMP_LE_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_ThreshF(A,B)       _mm512_maskz_mov_ps (_mm512_cmp_ps_mask ((A), (B), _CMP_NLT_UQ), (A))
+
+#define PLANK_VECTORDISPATCH_AVX512F_TypeD              __m512d
+#define PLANK_VECTORDISPATCH_AVX512F_LengthD            8
+#define PLANK_VECTORDISPATCH_AVX512F_LoadD(P)           _mm512_loadu_pd (P)
+#define PLANK_VECTORDISPATCH_AVX512F_StoreD(P,A)        _mm512_storeu_pd ((P), (A))
+#define PLANK_VECTORDISPATCH_AVX512F_SetD(S)            _mm512_set1_pd (S)
+#define PLANK_VECTORDISPATCH_AVX512F_AddD(A,B)          _mm512_add_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_SubD(A,B)          _mm512_sub_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_MulD(A,B)          _mm512_mul_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_DivD(A,B)          _mm512_div_pd ((A), (B))
+#define PLANK_VECTORDISPATCH_AVX512F_SqrtD(A)           _mm512_sqrt_pd (A)
+#define PLANK_VECTORDISPATCH_AVX512F_MinD(A,B)          _mm512_min_pd ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX512F_MaxD(A,B)          _mm512_max_pd ((B), (A))
+#define PLANK_VECTORDISPATCH_AVX512F_AbsD(A)            _mm512_abs_pd (A)
+#define PLANK_VECTORDISPATCH_AVX512F_NegD(A)            _mm512_castsi512_pd (_mm512_xor_si512 (_mm512_castpd_si512 (_mm512_set1_pd (-0.0)), _mm512_castpd_si512 (A)))
+#define PLANK_VECTORDISPATCH_AVX512F_MulAddD(A,B,C)     _mm512_fmadd_pd ((A), (B), (C))
+#define PLANK_VECTORDISPATCH_AVX512F_CmpD(A,B,PRED)     _mm512_maskz_mov_pd (_mm512_cmp_pd_mask ((A), (B), PRED), _mm512_set1_pd (1.0))
+#define PLANK_VECTORDISPATCH_AVX512F_EQD(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpD ((A), (B), _CMP_EQ_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_NED(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpD ((A), (B), _CMP_NEQ_UQ)
+#define PLANK_VECTORDISPATCH_AVX512F_GTD(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpD ((A), (B), _CMP_GT_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_GED(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpD ((A), (B), _CMP_GE_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_LTD(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpD ((A), (B), _CMP_LT_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_LED(A,B)           PLANK_VECTORDISPATCH_AVX512F_CmpD ((A), (B), _CMP_LE_OQ)
+#define PLANK_VECTORDISPATCH_AVX512F_ThreshD(A,B)       _mm512_maskz_mov_pd (_mm512_cmp_pd_mask ((A), (B), _CMP_NLT_UQ), (A))
+
+//------------------------------------------------------------------------------
+// Operators in terms of the primitives above, these must match plank_Maths.h
+
+#define PLANK_VECTORDISPATCH_OP_Move(L,T,A)                     (A)
+#define PLANK_VECTORDISPATCH_OP_Inc(L,T,A)                      PLANK_VD(L,Add,T) ((A), PLANK_VD(L,Set,T) ((Plank##T)1))
+#define PLANK_VECTORDISPATCH_OP_Neg(L,T,A)                      PLANK_VD(L,Neg,T) (A)
+#define PLANK_VECTORDISPATCH_OP_Abs(L,T,A)                      PLANK_VD(L,Abs,T) (A)
+#define PLANK_VECTORDISPATCH_OP_Reciprocal(L,T,A)               PLANK_VD(L,Div,T) (PLANK_VD(L,Set,T) ((Plank##T)1), (A))
+#define PLANK_VECTORDISPATCH_OP_Sqrt(L,T,A)                     PLANK_VD(L,Sqrt,T) (A)
+#define PLANK_VECTORDISPATCH_OP_Squared(L,T,A)                  PLANK_VD(L,Mul,T) ((A), (A))
+#define PLANK_VECTORDISPATCH_OP_Cubed(L,T,A)                    PLANK_VD(L,Mul,T) (PLANK_VD(L,Mul,T) ((A), (A)), (A))
+
+#define PLANK_VECTORDISPATCH_OP_Add(L,T,A,B)                    PLANK_VD(L,Add,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_Sub(L,T,A,B)                    PLANK_VD(L,Sub,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_Mul(L,T,A,B)                    PLANK_VD(L,Mul,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_Div(L,T,A,B)                    PLANK_VD(L,Div,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_Min(L,T,A,B)                    PLANK_VD(L,Min,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_Max(L,T,A,B)                    PLANK_VD(L,Max,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_IsEqualTo(L,T,A,B)              PLANK_VD(L,EQ,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_IsNotEqualTo(L,T,A,B)           PLANK_VD(L,NE,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_IsGreaterThan(L,T,A,B)          PLANK_VD(L,GT,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_IsGreaterThanOrEqualTo(L,T,A,B) PLANK_VD(L,GE,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_IsLessThan(L,T,A,B)             PLANK_VD(L,LT,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_IsLessThanOrEqualTo(L,T,A,B)    PLANK_VD(L,LE,T) ((A), (B))
+#define PLANK_VECTORDISPATCH_OP_SumSqr(L,T,A,B)                 PLANK_VD(L,Add,T) (PLANK_VD(L,Mul,T) ((A), (A)), PLANK_VD(L,Mul,T) ((B), (B)))
+#define PLANK_VECTORDISPATCH_OP_DifSqr(L,T,A,B)                 PLANK_VD(L,Sub,T) (PLANK_VD(L,Mul,T) ((A), (A)), PLANK_VD(L,Mul,T) ((B), (B)))
+#define PLANK_VECTORDISPATCH_OP_SqrSum(L,T,A,B)                 PLANK_VD(L,Mul,T) (PLANK_VD(L,Add,T) ((A), (B)), PLANK_VD(L,Add,T) ((A), (B)))
+#define PLANK_VECTORDISPATCH_OP_SqrDif(L,T,A,B)                 PLANK_VD(L,Mul,T) (PLANK_VD(L,Sub,T) ((A), (B)), PLANK_VD(L,Sub,T) ((A), (B)))
+#define PLANK_VECTORDISPATCH_OP_AbsDif(L,T,A,B)                 PLANK_VD(L,Abs,T) (PLANK_VD(L,Sub,T) ((A), (B)))
+#define PLANK_VECTORDISPATCH_OP_Thresh(L,T,A,B)                 PLANK_VD(L,Thresh,T) ((A), (B))
+
+#define PLANK_VECTORDISPATCH_UNARYOPS_SIMD(MACRO,LEVEL,TYPECODE)\
+    MACRO(Move,LEVEL,TYPECODE)\
+    MACRO(Inc,LEVEL,TYPECODE)\
+    MACRO(Neg,LEVEL,TYPECODE)\
+    MACRO(Abs,LEVEL,TYPECODE)\
+    MACRO(Reciprocal,LEVEL,TYPECODE)\
+    MACRO(Sqrt,LEVEL,TYPECODE)\
+    MACRO(Squared,LEVEL,TYPECODE)\
+    MACRO(Cubed,LEVEL,TYPECODE)
+
+#define PLANK_VECTORDISPATCH_BINARYOPS_SIMD(MACRO,LEVEL,TYPECODE)\
+    MACRO(Add,LEVEL,TYPECODE)\
+    MACRO(Sub,LEVEL,TYPECODE)\
+    MACRO(Mul,LEVEL,TYPECODE)\
+    MACRO(Div,LEVEL,TYPECODE)\
+    MACRO(Min,LEVEL,TYPECODE)\
+    MACRO(Max,LEVEL,TYPECODE)\
+    MACRO(IsEqualTo,LEVEL,TYPECODE)\
+    MACRO(IsNotEqualTo,LEVEL,TYPECODE)\
+    MACRO(IsGreaterThan,LEVEL,TYPECODE)\
+    MACRO(IsGreaterThanOrEqualTo,LEVEL,TYPECODE)\
+    MACRO(IsLessThan,LEVEL,TYPECODE)\
+    MACRO(IsLessThanOrEqualTo,LEVEL,TYPECODE)\
+    MACRO(SumSqr,LEVEL,TYPECODE)\
+    MACRO(DifSqr,LEVEL,TYPECODE)\
+    MACRO(SqrSum,LEVEL,TYPECODE)\
+    MACRO(SqrDif,LEVEL,TYPECODE)\
+    MACRO(AbsDif,LEVEL,TYPECODE)\
+    MACRO(Thresh,LEVEL,TYPECODE)
+
+//------------------------------------------------------------------------------
+// Kernel generators, the remainder after the last full vector is processed with the scalar functions
+
+#define PLANK_VECTORDISPATCH_UNARYOP_DEFINE(OP,LEVEL,TYPECODE)\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatch##OP##TYPECODE##_NN_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* a, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) va;\
+        PlankUL i;\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE)) {\
+            va = PLANK_VD(LEVEL,Load,TYPECODE) (a + i);\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VECTORDISPATCH_OP_##OP (LEVEL, TYPECODE, va));\
+        }\
+        for (; i < N; ++i) result[i] = pl_##OP##TYPECODE (a[i]);\
+    }
+
+#define PLANK_VECTORDISPATCH_BINARYOP_DEFINE(OP,LEVEL,TYPECODE)\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatch##OP##TYPECODE##_NNN_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* a, const Plank##TYPECODE* b, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) va, vb;\
+        PlankUL i;\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE)) {\
+            va = PLANK_VD(LEVEL,Load,TYPECODE) (a + i);\
+            vb = PLANK_VD(LEVEL,Load,TYPECODE) (b + i);\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VECTORDISPATCH_OP_##OP (LEVEL, TYPECODE, va, vb));\
+        }\
+        for (; i < N; ++i) result[i] = pl_##OP##TYPECODE (a[i], b[i]);\
+    }\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatch##OP##TYPECODE##_NN1_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* a, Plank##TYPECODE b, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) va, vb;\
+        PlankUL i;\
+        vb = PLANK_VD(LEVEL,Set,TYPECODE) (b);\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE)) {\
+            va = PLANK_VD(LEVEL,Load,TYPECODE) (a + i);\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VECTORDISPATCH_OP_##OP (LEVEL, TYPECODE, va, vb));\
+        }\
+        for (; i < N; ++i) result[i] = pl_##OP##TYPECODE (a[i], b);\
+    }\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatch##OP##TYPECODE##_N1N_##LEVEL (Plank##TYPECODE *result, Plank##TYPECODE a, const Plank##TYPECODE* b, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) va, vb;\
+        PlankUL i;\
+        va = PLANK_VD(LEVEL,Set,TYPECODE) (a);\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE)) {\
+            vb = PLANK_VD(LEVEL,Load,TYPECODE) (b + i);\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VECTORDISPATCH_OP_##OP (LEVEL, TYPECODE, va, vb));\
+        }\
+        for (; i < N; ++i) result[i] = pl_##OP##TYPECODE (a, b[i]);\
+    }
+
+#define PLANK_VECTORDISPATCH_MULADD_DEFINE(LEVEL,TYPECODE)\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatchMulAdd##TYPECODE##_NNNN_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PlankUL i;\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE))\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VD(LEVEL,MulAdd,TYPECODE) (PLANK_VD(LEVEL,Load,TYPECODE) (input + i), PLANK_VD(LEVEL,Load,TYPECODE) (mul + i), PLANK_VD(LEVEL,Load,TYPECODE) (add + i)));\
+        for (; i < N; ++i) result[i] = input[i] * mul[i] + add[i];\
+    }\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatchMulAdd##TYPECODE##_NNN1_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, Plank##TYPECODE add, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) vadd;\
+        PlankUL i;\
+        vadd = PLANK_VD(LEVEL,Set,TYPECODE) (add);\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE))\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VD(LEVEL,MulAdd,TYPECODE) (PLANK_VD(LEVEL,Load,TYPECODE) (input + i), PLANK_VD(LEVEL,Load,TYPECODE) (mul + i), vadd));\
+        for (; i < N; ++i) result[i] = input[i] * mul[i] + add;\
+    }\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatchMulAdd##TYPECODE##_NN11_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, Plank##TYPECODE add, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) vmul, vadd;\
+        PlankUL i;\
+        vmul = PLANK_VD(LEVEL,Set,TYPECODE) (mul);\
+        vadd = PLANK_VD(LEVEL,Set,TYPECODE) (add);\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE))\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VD(LEVEL,MulAdd,TYPECODE) (PLANK_VD(LEVEL,Load,TYPECODE) (input + i), vmul, vadd));\
+        for (; i < N; ++i) result[i] = input[i] * mul + add;\
+    }\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatchMulAdd##TYPECODE##_NN1N_##LEVEL (Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) vmul;\
+        PlankUL i;\
+        vmul = PLANK_VD(LEVEL,Set,TYPECODE) (mul);\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE))\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, PLANK_VD(LEVEL,MulAdd,TYPECODE) (PLANK_VD(LEVEL,Load,TYPECODE) (input + i), vmul, PLANK_VD(LEVEL,Load,TYPECODE) (add + i)));\
+        for (; i < N; ++i) result[i] = input[i] * mul + add[i];\
+    }
+
+#define PLANK_VECTORDISPATCH_FILL_DEFINE(LEVEL,TYPECODE)\
+    static PLANK_VECTORDISPATCH_TARGET_##LEVEL void pl_VectorDispatchFill##TYPECODE##_N1_##LEVEL (Plank##TYPECODE *result, Plank##TYPECODE value, PlankUL N) {\
+        PLANK_VD(LEVEL,Type,TYPECODE) v;\
+        PlankUL i;\
+        v = PLANK_VD(LEVEL,Set,TYPECODE) (value);\
+        for (i = 0; (i + PLANK_VD(LEVEL,Length,TYPECODE)) <= N; i += PLANK_VD(LEVEL,Length,TYPECODE))\
+            PLANK_VD(LEVEL,Store,TYPECODE) (result + i, v);\
+        for (; i < N; ++i) result[i] = value;\
+    }
+
+#define PLANK_VECTORDISPATCH_LEVEL_DEFINE(LEVEL,TYPECODE)\
+    PLANK_VECTORDISPATCH_FILL_DEFINE(LEVEL,TYPECODE)\
+    PLANK_VECTORDISPATCH_MULADD_DEFINE(LEVEL,TYPECODE)\
+    PLANK_VECTORDISPATCH_UNARYOPS_SIMD(PLANK_VECTORDISPATCH_UNARYOP_DEFINE,LEVEL,TYPECODE)\
+    PLANK_VECTORDISPATCH_BINARYOPS_SIMD(PLANK_VECTORDISPATCH_BINARYOP_DEFINE,LEVEL,TYPECODE)
+
+PLANK_VECTORDISPATCH_LEVEL_DEFINE(SSE2,F)
+PLANK_VECTORDISPATCH_LEVEL_DEFINE(SSE2,D)
+PLANK_VECTORDISPATCH_LEVEL_DEFINE(AVX2,F)
+PLANK_VECTORDISPATCH_LEVEL_DEFINE(AVX2,D)
+PLANK_VECTORDISPATCH_LEVEL_DEFINE(AVX512F,F)
+PLANK_VECTORDISPATCH_LEVEL_DEFINE(AVX512F,D)
+
+#define PLANK_VECTORDISPATCH_UNARYOP_SET(OP,LEVEL,TYPECODE)\
+    p->OP##TYPECODE##_NN = pl_VectorDispatch##OP##TYPECODE##_NN_##LEVEL;
+
+#define PLANK_VECTORDISPATCH_BINARYOP_SET(OP,LEVEL,TYPECODE)\
+    p->OP##TYPECODE##_NNN = pl_VectorDispatch##OP##TYPECODE##_NNN_##LEVEL;\
+    p->OP##TYPECODE##_NN1 = pl_VectorDispatch##OP##TYPECODE##_NN1_##LEVEL;\
+    p->OP##TYPECODE##_N1N = pl_VectorDispatch##OP##TYPECODE##_N1N_##LEVEL;
+
+#define PLANK_VECTORDISPATCH_LEVEL_SET(LEVEL,TYPECODE)\
+    p->Fill##TYPECODE##_N1 = pl_VectorDispatchFill##TYPECODE##_N1_##LEVEL;\
+    p->MulAdd##TYPECODE##_NNNN = pl_VectorDispatchMulAdd##TYPECODE##_NNNN_##LEVEL;\
+    p->MulAdd##TYPECODE##_NNN1 = pl_VectorDispatchMulAdd##TYPECODE##_NNN1_##LEVEL;\
+    p->MulAdd##TYPECODE##_NN11 = pl_VectorDispatchMulAdd##TYPECODE##_NN11_##LEVEL;\
+    p->MulAdd##TYPECODE##_NN1N = pl_VectorDispatchMulAdd##TYPECODE##_NN1N_##LEVEL;\
+    PLANK_VECTORDISPATCH_UNARYOPS_SIMD(PLANK_VECTORDISPATCH_UNARYOP_SET,LEVEL,TYPECODE)\
+    PLANK_VECTORDISPATCH_BINARYOPS_SIMD(PLANK_VECTORDISPATCH_BINARYOP_SET,LEVEL,TYPECODE)
+
+static PlankVectorDispatchLevel pl_VectorDispatch_DetectLevel()
+{
+    PlankVectorDispatchLevel level = PlankVectorDispatchLevel_Generic;
+    
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    PlankB osSavesYMM, osSavesZMM;
+    unsigned long long xcr0;
+    
+    __cpuid (info, 0);
+    
+    if (info[0] < 1)
+        return level;
+    
+    __cpuid (info, 1);
+    
+    if (info[3] & (1 << 26))
+        level = PlankVectorDispatchLevel_SSE2;
+    
+    // AVX state must be enabled by the OS as well as supported by the CPU
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || !(info[2] & (1 << 12)))
+        return level;
+    
+    xcr0 = _xgetbv (0);
+    osSavesYMM = (xcr0 & 0x06) == 0x06;
+    osSavesZMM = (xcr0 & 0xE6) == 0xE6;
+    
+    __cpuid (info, 0);
+    
+    if (!osSavesYMM || (info[0] < 7))
+        return level;
+    
+    __cpuidex (info, 7, 0);
+    
+    if (info[1] & (1 << 5))
+        level = PlankVectorDispatchLevel_AVX2;
+    
+    if (osSavesZMM && (info[1] & (1 << 16)))
+        level = PlankVectorDispatchLevel_AVX512F;
+#else
+    __builtin_cpu_init();
+    
+    if (__builtin_cpu_supports ("sse2"))
+        level = PlankVectorDispatchLevel_SSE2;
+    
+    if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+        level = PlankVectorDispatchLevel_AVX2;
+    
+    if (__builtin_cpu_supports ("avx512f"))
+        level = PlankVectorDispatchLevel_AVX512F;
+#endif
+    
+    return level;
+}
+
+#endif // PLANK_VECTORDISPATCH_X86
+
+#define PLANK_VECTORDISPATCH_UNARYOP_SETGENERIC(OP,TYPECODE)\
+    p->OP##TYPECODE##_NN = PLANK_VECTORUNARYOP_NAME(OP,TYPECODE);
+
+#define PLANK_VECTORDISPATCH_BINARYOP_SETGENERIC(OP,TYPECODE)\
+    p->OP##TYPECODE##_NNN = PLANK_VECTORBINARYOPVECTOR_NAME(OP,TYPECODE);\
+    p->OP##TYPECODE##_NN1 = PLANK_VECTORBINARYOPSCALAR_NAME(OP,TYPECODE);\
+    p->OP##TYPECODE##_N1N = PLANK_SCALARBINARYOPVECTOR_NAME(OP,TYPECODE);
+
+#define PLANK_VECTORDISPATCH_GENERIC_SET(TYPECODE)\
+    p->Fill##TYPECODE##_N1 = PLANK_VECTORFILL_NAME(TYPECODE);\
+    p->MulAdd##TYPECODE##_NNNN = PLANK_VECTORMULADD_NAME(TYPECODE);\
+    p->MulAdd##TYPECODE##_NNN1 = PLANK_VECTORMULSCALARADD_NAME(TYPECODE);\
+    p->MulAdd##TYPECODE##_NN11 = PLANK_VECTORSCALARMULSCALARADD_NAME(TYPECODE);\
+    p->MulAdd##TYPECODE##_NN1N = PLANK_VECTORSCALARMULADD_NAME(TYPECODE);\
+    PLANK_VECTORDISPATCH_UNARYOPS_ALL(PLANK_VECTORDISPATCH_UNARYOP_SETGENERIC,TYPECODE)\
+    PLANK_VECTORDISPATCH_BINARYOPS_ALL(PLANK_VECTORDISPATCH_BINARYOP_SETGENERIC,TYPECODE)
+
+#define PLANK_VECTORDISPATCH_GLOBAL_EMPTY   0
+#define PLANK_VECTORDISPATCH_GLOBAL_BUSY    1
+#define PLANK_VECTORDISPATCH_GLOBAL_READY   2
+
+PlankVectorDispatchRef pl_VectorDispatchGlobal()
+{
+    static PlankVectorDispatch global;
+    static PlankAtomicI state; // zero, i.e. PLANK_VECTORDISPATCH_GLOBAL_EMPTY
+    
+    if (pl_AtomicI_GetAcquire (&state) != PLANK_VECTORDISPATCH_GLOBAL_READY)
+    {
+        // the first caller fills in the table, others wait rather than read it half done
+        if (pl_AtomicI_CompareAndSwap (&state, PLANK_VECTORDISPATCH_GLOBAL_EMPTY, PLANK_VECTORDISPATCH_GLOBAL_BUSY))
+        {
+            pl_VectorDispatch_Init (&global, PlankVectorDispatchLevel_Count);
+            pl_AtomicI_SetRelease (&state, PLANK_VECTORDISPATCH_GLOBAL_READY);
+        }
+        else
+        {
+            while (pl_AtomicI_GetAcquire (&state) != PLANK_VECTORDISPATCH_GLOBAL_READY) { }
+        }
+    }
+    
+    return &global;
+}
+
+PlankVectorDispatchLevel pl_VectorDispatch_GetHostLevel()
+{
+#if PLANK_VECTORDISPATCH_X86
+    static PlankAtomicI hostLevel; // zero until detected, then the level plus one
+    PlankI level;
+    
+    level = pl_AtomicI_GetAcquire (&hostLevel);
+    
+    if (level == 0)
+    {
+        // every thread detects the same level so racing callers just store the same value
+        level = (PlankI)pl_VectorDispatch_DetectLevel() + 1;
+        pl_AtomicI_SetRelease (&hostLevel, level);
+    }
+    
+    return (PlankVectorDispatchLevel)(level - 1);
+#else
+    return PlankVectorDispatchLevel_Generic;
+#endif
+}
+
+const char* pl_VectorDispatchLevel_GetName (PlankVectorDispatchLevel level)
+{
+    switch (level)
+    {
+        case PlankVectorDispatchLevel_Generic:  return "Generic";
+        case PlankVectorDispatchLevel_SSE2:     return "SSE2";
+        case PlankVectorDispatchLevel_AVX2:     return "AVX2";
+        case PlankVectorDispatchLevel_AVX512F:  return "AVX512F";
+        default: return "Unknown";
+    }
+}
+
+PlankResult pl_VectorDispatch_Init (PlankVectorDispatchRef p, PlankVectorDispatchLevel level)
+{
+    PlankVectorDispatchLevel hostLevel;
+    
+    if (p == PLANK_NULL)
+        return PlankResult_MemoryError;
+    
+    hostLevel = pl_VectorDispatch_GetHostLevel();
+    
+    if ((level < PlankVectorDispatchLevel_Generic) || (level > hostLevel))
+        level = hostLevel;
+    
+    PLANK_VECTORDISPATCH_GENERIC_SET(F)
+    PLANK_VECTORDISPATCH_GENERIC_SET(D)
+    
+#if PLANK_VECTORDISPATCH_X86
+    switch (level)
+    {
+        case PlankVectorDispatchLevel_SSE2:
+            PLANK_VECTORDISPATCH_LEVEL_SET(SSE2,F)
+            PLANK_VECTORDISPATCH_LEVEL_SET(SSE2,D)
+            break;
+        case PlankVectorDispatchLevel_AVX2:
+            PLANK_VECTORDISPATCH_LEVEL_SET(AVX2,F)
+            PLANK_VECTORDISPATCH_LEVEL_SET(AVX2,D)
+            break;
+        case PlankVectorDispatchLevel_AVX512F:
+            PLANK_VECTORDISPATCH_LEVEL_SET(AVX512F,F)
+            PLANK_VECTORDISPATCH_LEVEL_SET(AVX512F,D)
+            break;
+        default:
+            break;
+    }
+#endif
+    
+    p->level = level;
+    
+    return PlankResult_OK;
+}
+
+PlankVectorDispatchLevel pl_VectorDispatch_GetLevel (PlankVectorDispatchRef p)
+{
+    return p->level;
+}
@@ -0,0 +1,204 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_VECTORDISPATCH_H
+#define PLANK_VECTORDISPATCH_H
+
+PLANK_BEGIN_C_LINKAGE
+
+/** Runtime CPU dispatch for the vector functions.
+ 
+ The pl_Vector functions in plank_Vectors.h are selected at compile time so a 
+ build for a generic target can only use the instructions that target allows.
+ The dispatch table holds function pointers for the most commonly used vector 
+ operations and is filled in at first use with the widest kernels the host CPU
+ supports (SSE2, AVX2+FMA or AVX-512F on x86). Entries without a wider kernel 
+ simply point at the compile-time pl_Vector function.
+ 
+ When a vendor library (vDSP or IPP) is compiled in the table always uses that
+ library since it already does its own CPU dispatch.
+ 
+ @code
+ pl_VectorDispatchGlobal()->AddF_NNN (result, a, b, N);
+ @endcode
+ 
+ @defgroup PlankVectorDispatchClass Plank VectorDispatch class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** The instruction set levels used by the vector dispatch table. */
+enum PlankVectorDispatchLevelIdentifiers
+{
+    PlankVectorDispatchLevel_Generic = 0,   ///< The compile-time pl_Vector functions.
+    PlankVectorDispatchLevel_SSE2,          ///< 128-bit SSE2 kernels.
+    PlankVectorDispatchLevel_AVX2,          ///< 256-bit AVX2 kernels using FMA for multiply-add.
+    PlankVectorDispatchLevel_AVX512F,       ///< 512-bit AVX-512F kernels.
+    
+    PlankVectorDispatchLevel_Count
+};
+
+typedef int PlankVectorDispatchLevel;
+
+/** An opaque reference to the <i>Plank VectorDispatch</i> object. */
+typedef struct PlankVectorDispatch* PlankVectorDispatchRef; 
+
+/** Get the global vector dispatch table.
+ This is initialised on first use to the best level supported by the host.
+ @return The <i>Plank VectorDispatch</i> object. */
+PlankVectorDispatchRef pl_VectorDispatchGlobal();
+
+/** Get the widest instruction set level supported by this build and the host CPU. */
+PlankVectorDispatchLevel pl_VectorDispatch_GetHostLevel();
+
+/** Get a human readable name for a dispatch level. */
+const char* pl_VectorDispatchLevel_GetName (PlankVectorDispatchLevel level);
+
+/** Initialise a <i>Plank VectorDispatch</i> object.
+ The level is limited to that returned by pl_VectorDispatch_GetHostLevel() so 
+ this can be used to force a narrower set of kernels (e.g., for comparison) but
+ never to select instructions the host cannot execute.
+ @param p The <i>Plank VectorDispatch</i> object. 
+ @param level The requested level.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_VectorDispatch_Init (PlankVectorDispatchRef p, PlankVectorDispatchLevel level);
+
+/** Get the level the table was initialised to. */
+PlankVectorDispatchLevel pl_VectorDispatch_GetLevel (PlankVectorDispatchRef p);
+
+/** @} */
+
+PLANK_END_C_LINKAGE
+
+/** Applies MACRO(OP,TYPECODE) to each unary operator held in the dispatch table.
+ These match the unary operators used by the Plink processes. */
+#define PLANK_VECTORDISPATCH_UNARYOPS_ALL(MACRO,TYPECODE)\
+    MACRO(Move,TYPECODE)\
+    MACRO(Inc,TYPECODE)\
+    MACRO(Neg,TYPECODE)\
+    MACRO(Abs,TYPECODE)\
+    MACRO(Log2,TYPECODE)\
+    MACRO(Reciprocal,TYPECODE)\
+    MACRO(Sin,TYPECODE)\
+    MACRO(Cos,TYPECODE)\
+    MACRO(Tan,TYPECODE)\
+    MACRO(Asin,TYPECODE)\
+    MACRO(Acos,TYPECODE)\
+    MACRO(Atan,TYPECODE)\
+    MACRO(Sinh,TYPECODE)\
+    MACRO(Cosh,TYPECODE)\
+    MACRO(Tanh,TYPECODE)\
+    MACRO(Sqrt,TYPECODE)\
+    MACRO(Log,TYPECODE)\
+    MACRO(Log10,TYPECODE)\
+    MACRO(Exp,TYPECODE)\
+    MACRO(Squared,TYPECODE)\
+    MACRO(Cubed,TYPECODE)\
+    MACRO(Ceil,TYPECODE)\
+    MACRO(Floor,TYPECODE)\
+    MACRO(Frac,TYPECODE)\
+    MACRO(Sign,TYPECODE)\
+    MACRO(M2F,TYPECODE)\
+    MACRO(F2M,TYPECODE)\
+    MACRO(A2dB,TYPECODE)\
+    MACRO(dB2A,TYPECODE)\
+    MACRO(D2R,TYPECODE)\
+    MACRO(R2D,TYPECODE)\
+    MACRO(Distort,TYPECODE)\
+    MACRO(Zap,TYPECODE)
+
+/** Applies MACRO(OP,TYPECODE) to each binary operator held in the dispatch table.
+ These match the binary operators used by the Plink processes. */
+#define PLANK_VECTORDISPATCH_BINARYOPS_ALL(MACRO,TYPECODE)\
+    MACRO(Add,TYPECODE)\
+    MACRO(Sub,TYPECODE)\
+    MACRO(Mul,TYPECODE)\
+    MACRO(Div,TYPECODE)\
+    MACRO(Mod,TYPECODE)\
+    MACRO(Min,TYPECODE)\
+    MACRO(Max,TYPECODE)\
+    MACRO(Pow,TYPECODE)\
+    MACRO(IsEqualTo,TYPECODE)\
+    MACRO(IsNotEqualTo,TYPECODE)\
+    MACRO(IsGreaterThan,TYPECODE)\
+    MACRO(IsGreaterThanOrEqualTo,TYPECODE)\
+    MACRO(IsLessThan,TYPECODE)\
+    MACRO(IsLessThanOrEqualTo,TYPECODE)\
+    MACRO(Hypot,TYPECODE)\
+    MACRO(Atan2,TYPECODE)\
+    MACRO(SumSqr,TYPECODE)\
+    MACRO(DifSqr,TYPECODE)\
+    MACRO(SqrSum,TYPECODE)\
+    MACRO(SqrDif,TYPECODE)\
+    MACRO(AbsDif,TYPECODE)\
+    MACRO(Thresh,TYPECODE)
+
+#define PLANK_VECTORDISPATCH_UNARYOP_DECLARE(OP,TYPECODE)\
+    void (*OP##TYPECODE##_NN)(Plank##TYPECODE *result, const Plank##TYPECODE* a, PlankUL N);
+
+#define PLANK_VECTORDISPATCH_BINARYOP_DECLARE(OP,TYPECODE)\
+    void (*OP##TYPECODE##_NNN)(Plank##TYPECODE *result, const Plank##TYPECODE* a, const Plank##TYPECODE* b, PlankUL N);\
+    void (*OP##TYPECODE##_NN1)(Plank##TYPECODE *result, const Plank##TYPECODE* a, Plank##TYPECODE b, PlankUL N);\
+    void (*OP##TYPECODE##_N1N)(Plank##TYPECODE *result, Plank##TYPECODE a, const Plank##TYPECODE* b, PlankUL N);
+
+#define PLANK_VECTORDISPATCH_OPS_DECLARE(TYPECODE)\
+    void (*Fill##TYPECODE##_N1)(Plank##TYPECODE *result, Plank##TYPECODE value, PlankUL N);\
+    void (*MulAdd##TYPECODE##_NNNN)(Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, const Plank##TYPECODE* add, PlankUL N);\
+    void (*MulAdd##TYPECODE##_NNN1)(Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, Plank##TYPECODE add, PlankUL N);\
+    void (*MulAdd##TYPECODE##_NN11)(Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, Plank##TYPECODE add, PlankUL N);\
+    void (*MulAdd##TYPECODE##_NN1N)(Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, const Plank##TYPECODE* add, PlankUL N);\
+    PLANK_VECTORDISPATCH_UNARYOPS_ALL(PLANK_VECTORDISPATCH_UNARYOP_DECLARE,TYPECODE)\
+    PLANK_VECTORDISPATCH_BINARYOPS_ALL(PLANK_VECTORDISPATCH_BINARYOP_DECLARE,TYPECODE)
+
+/** Dispatched equivalents of the names in plank_Vectors.h using the global table. */
+#define PLANK_VECTORDISPATCH_UNARYOP(OP,TYPECODE)               pl_VectorDispatchGlobal()->OP##TYPECODE##_NN
+#define PLANK_VECTORDISPATCH_BINARYOPVECTOR(OP,TYPECODE)        pl_VectorDispatchGlobal()->OP##TYPECODE##_NNN
+#define PLANK_VECTORDISPATCH_BINARYOPSCALAR(OP,TYPECODE)        pl_VectorDispatchGlobal()->OP##TYPECODE##_NN1
+#define PLANK_VECTORDISPATCH_SCALARBINARYOPVECTOR(OP,TYPECODE)  pl_VectorDispatchGlobal()->OP##TYPECODE##_N1N
+#define PLANK_VECTORDISPATCH_FILL(TYPECODE)                     pl_VectorDispatchGlobal()->Fill##TYPECODE##_N1
+
+#if !DOXYGEN
+typedef struct PlankVectorDispatch
+{
+    PlankVectorDispatchLevel level;
+    PLANK_VECTORDISPATCH_OPS_DECLARE(F)
+    PLANK_VECTORDISPATCH_OPS_DECLARE(D)
+} PlankVectorDispatch;
+#endif
+
+#endif // PLANK_VECTORDISPATCH_H
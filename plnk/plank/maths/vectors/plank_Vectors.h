@@ -488,6 +488,8 @@
         #include "plank_vDSP.h"
     #elif defined(PLANK_VEC_IPP)
         #include "plank_vIPP.h"
+    #elif defined(PLANK_VEC_SIMD)
+        #include "plank_vSIMD.h"
     #elif defined(PLANK_VEC_OTHERLIB)
         #include "some other vector lib" // must define PLANK_VEC_CUSTOM
     #endif
@@ -499,7 +501,8 @@
  These process vectors (arrays) of data applying common maths functions to the inputs.
  The default is to use the scalar processing functions (implmented with a loop in C)
  but many of these operations can be performed with faster, optimised libraries on some
- platforms (e.g., vDSP on Mac OS X and iOS).
+ platforms (e.g., vDSP on Mac OS X and iOS) or with the SSE2/AVX/NEON intrinsics backend
+ (PLANK_VEC_SIMD) on other platforms.
  
  The naming convention is to prefix all functions with 'pl_Vector'. This is followed by
  the name of the operation which is commonly the name of an equivalent scalar function.
@@ -656,6 +659,9 @@ static PLANK_INLINE_MID void pl_VectorSwapEndianLL (PlankLL* data, PlankUL N)
     pl_VectorSwapEndianULL ((PlankULL*)data, N);
 }
 
+#include "plank_VectorsPCM.h"
+#include "plank_VectorsFilter.h"
+#include "plank_VectorsTable.h"
 
 #endif // PLANK_VECTORS_H
 
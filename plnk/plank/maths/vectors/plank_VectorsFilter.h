@@ -0,0 +1,301 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_VECTORSFILTER_H
+#define PLANK_VECTORSFILTER_H
+
+// Multichannel second order IIR sections. 
+// Recursive filters can't be vectorised along time, instead these step four
+// independent filters together, one per lane. Each lane has its own input and
+// output vector, these are transposed in registers four samples at a time.
+// There are 20 coefficient vectors, a0, a1, a2, b1 and b2 for each lane in
+// turn (i.e., coeffs[coeff * 4 + lane]). A coefficient stride of 0 uses the 
+// first value of each for the whole block, a stride of 1 uses one per sample.
+// The state is packed as y1[4], y2[4]. The arithmetic is done in the same 
+// order as the scalar forms in plonk_FilterForms.h so the results are identical
+// to those. Like plank_VectorsPCM.h these don't depend on the vector backend 
+// selected in plank_Vectors.h, SSE2 or AArch64 NEON is used where the compiler
+// targets it otherwise a scalar loop is used. Outputs may be the same as inputs.
+
+#if !defined(PLANK_VFILTER_SCALAR)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define PLANK_VFILTER_SSE2 1
+        #include <emmintrin.h>
+    #elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+        #define PLANK_VFILTER_NEON 1
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#define PLANK_VFILTER_LANES         4
+#define PLANK_VFILTER_NUMCOEFFS     5
+
+#if PLANK_VFILTER_SSE2
+typedef __m128 PlankVFilterF;
+#define PLANK_VFILTER_LOAD(p)       _mm_loadu_ps (p)
+#define PLANK_VFILTER_STORE(p,x)    _mm_storeu_ps (p, x)
+#define PLANK_VFILTER_ADD(a,b)      _mm_add_ps (a, b)
+#define PLANK_VFILTER_MUL(a,b)      _mm_mul_ps (a, b)
+
+static PLANK_INLINE_LOW void pl_VFilter_Transpose (PlankVFilterF* r)
+{
+    _MM_TRANSPOSE4_PS (r[0], r[1], r[2], r[3]);
+}
+#elif PLANK_VFILTER_NEON
+typedef float32x4_t PlankVFilterF;
+#define PLANK_VFILTER_LOAD(p)       vld1q_f32 (p)
+#define PLANK_VFILTER_STORE(p,x)    vst1q_f32 (p, x)
+#define PLANK_VFILTER_ADD(a,b)      vaddq_f32 (a, b)
+#define PLANK_VFILTER_MUL(a,b)      vmulq_f32 (a, b)
+
+static PLANK_INLINE_LOW void pl_VFilter_Transpose (PlankVFilterF* r)
+{
+    const float32x4_t t0 = vtrn1q_f32 (r[0], r[1]);
+    const float32x4_t t1 = vtrn2q_f32 (r[0], r[1]);
+    const float32x4_t t2 = vtrn1q_f32 (r[2], r[3]);
+    const float32x4_t t3 = vtrn2q_f32 (r[2], r[3]);
+    r[0] = vreinterpretq_f32_f64 (vtrn1q_f64 (vreinterpretq_f64_f32 (t0), vreinterpretq_f64_f32 (t2)));
+    r[1] = vreinterpretq_f32_f64 (vtrn1q_f64 (vreinterpretq_f64_f32 (t1), vreinterpretq_f64_f32 (t3)));
+    r[2] = vreinterpretq_f32_f64 (vtrn2q_f64 (vreinterpretq_f64_f32 (t0), vreinterpretq_f64_f32 (t2)));
+    r[3] = vreinterpretq_f32_f64 (vtrn2q_f64 (vreinterpretq_f64_f32 (t1), vreinterpretq_f64_f32 (t3)));
+}
+#endif
+
+#if PLANK_VFILTER_SSE2 || PLANK_VFILTER_NEON
+static PLANK_INLINE_LOW PlankVFilterF pl_VFilter_Step (const PlankVFilterF x, const PlankVFilterF* c, PlankVFilterF* y1, PlankVFilterF* y2, const PlankB isB2)
+{
+    const PlankVFilterF y0 = PLANK_VFILTER_ADD (PLANK_VFILTER_ADD (x, PLANK_VFILTER_MUL (c[3], *y1)), PLANK_VFILTER_MUL (c[4], *y2));
+    const PlankVFilterF output = isB2 ? PLANK_VFILTER_MUL (c[0], PLANK_VFILTER_ADD (PLANK_VFILTER_ADD (y0, PLANK_VFILTER_MUL (c[1], *y1)), PLANK_VFILTER_MUL (c[2], *y2)))
+                                      : PLANK_VFILTER_ADD (PLANK_VFILTER_ADD (PLANK_VFILTER_MUL (c[0], y0), PLANK_VFILTER_MUL (c[1], *y1)), PLANK_VFILTER_MUL (c[2], *y2));
+    *y2 = *y1;
+    *y1 = y0;
+    return output;
+}
+
+// gathers one sample from each of the four vectors starting at index
+static PLANK_INLINE_LOW PlankVFilterF pl_VFilter_Gather (const PlankF* const* vectors, const PlankUL index)
+{
+    PlankF temp[PLANK_VFILTER_LANES];
+    temp[0] = vectors[0][index];
+    temp[1] = vectors[1][index];
+    temp[2] = vectors[2][index];
+    temp[3] = vectors[3][index];
+    return PLANK_VFILTER_LOAD (temp);
+}
+#endif
+
+static PLANK_INLINE_MID void pl_VFilter_Biquadx4F (PlankF* const* results, const PlankF* const* inputs, const PlankF* const* coeffs, const PlankUL coeffStride, PlankF* state, PlankUL N, const PlankB isB2)
+{
+    PlankUL i;
+    
+#if PLANK_VFILTER_SSE2 || PLANK_VFILTER_NEON
+    PlankVFilterF x[PLANK_VFILTER_LANES];
+    PlankVFilterF c[PLANK_VFILTER_LANES][PLANK_VFILTER_NUMCOEFFS];
+    PlankVFilterF y1, y2;
+    PlankF temp[PLANK_VFILTER_LANES];
+    int j, k;
+    
+    y1 = PLANK_VFILTER_LOAD (state);
+    y2 = PLANK_VFILTER_LOAD (state + 4);
+    
+    if (coeffStride == 0)
+    {
+        for (k = 0; k < PLANK_VFILTER_NUMCOEFFS; ++k)
+            c[0][k] = pl_VFilter_Gather (coeffs + k * 4, 0);
+        
+        for (j = 1; j < PLANK_VFILTER_LANES; ++j)
+            for (k = 0; k < PLANK_VFILTER_NUMCOEFFS; ++k)
+                c[j][k] = c[0][k];
+    }
+    
+    for (i = 0; (i + 4) <= N; i += 4)
+    {
+        for (j = 0; j < PLANK_VFILTER_LANES; ++j)
+            x[j] = PLANK_VFILTER_LOAD (inputs[j] + i);
+        
+        pl_VFilter_Transpose (x);
+        
+        if (coeffStride != 0)
+        {
+            PlankVFilterF r[PLANK_VFILTER_LANES];
+            
+            for (k = 0; k < PLANK_VFILTER_NUMCOEFFS; ++k)
+            {
+                for (j = 0; j < PLANK_VFILTER_LANES; ++j)
+                    r[j] = PLANK_VFILTER_LOAD (coeffs[k * 4 + j] + i);
+                
+                pl_VFilter_Transpose (r);
+                
+                for (j = 0; j < PLANK_VFILTER_LANES; ++j)
+                    c[j][k] = r[j];
+            }
+        }
+        
+        for (j = 0; j < PLANK_VFILTER_LANES; ++j)
+            x[j] = pl_VFilter_Step (x[j], c[j], &y1, &y2, isB2);
+        
+        pl_VFilter_Transpose (x);
+        
+        for (j = 0; j < PLANK_VFILTER_LANES; ++j)
+            PLANK_VFILTER_STORE (results[j] + i, x[j]);
+    }
+    
+    for (; i < N; ++i)
+    {
+        if (coeffStride != 0)
+        {
+            for (k = 0; k < PLANK_VFILTER_NUMCOEFFS; ++k)
+                c[0][k] = pl_VFilter_Gather (coeffs + k * 4, i);
+        }
+        
+        PLANK_VFILTER_STORE (temp, pl_VFilter_Step (pl_VFilter_Gather (inputs, i), c[0], &y1, &y2, isB2));
+        
+        for (j = 0; j < PLANK_VFILTER_LANES; ++j)
+            results[j][i] = temp[j];
+    }
+    
+    PLANK_VFILTER_STORE (state, y1);
+    PLANK_VFILTER_STORE (state + 4, y2);
+#else
+    PlankF y0, y1, y2, a0, a1, a2, b1, b2;
+    PlankUL l, n;
+    
+    for (l = 0; l < PLANK_VFILTER_LANES; ++l)
+    {
+        const PlankF* const input = inputs[l];
+        PlankF* const result = results[l];
+        
+        y1 = state[l];
+        y2 = state[l + 4];
+        
+        for (i = 0, n = 0; i < N; ++i, n += coeffStride)
+        {
+            a0 = coeffs[l][n];
+            a1 = coeffs[4 + l][n];
+            a2 = coeffs[8 + l][n];
+            b1 = coeffs[12 + l][n];
+            b2 = coeffs[16 + l][n];
+            
+            y0 = input[i] + b1 * y1 + b2 * y2;
+            result[i] = isB2 ? a0 * (y0 + a1 * y1 + a2 * y2) : a0 * y0 + a1 * y1 + a2 * y2;
+            y2 = y1;
+            y1 = y0;
+        }
+        
+        state[l] = y1;
+        state[l + 4] = y2;
+    }
+#endif
+}
+
+/** Determine whether all N values in a vector are equal.
+ This allows fixed coefficients to be detected in a block of coefficients
+ so a coefficient stride of 0 may be used.
+ @param input   The input vector.
+ @param N       The number of values.
+ @return @c true if all values are equal to the first, otherwise @c false.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID PlankB pl_VectorIsConstantF_N (const PlankF* input, PlankUL N)
+{
+    const PlankF first = input[0];
+    PlankUL i = 1;
+
+#if PLANK_VFILTER_SSE2
+    {
+        const __m128 x = _mm_set1_ps (first);
+        
+        for (; (i + 8) <= N; i += 8)
+        {
+            const __m128 ne = _mm_or_ps (_mm_cmpneq_ps (_mm_loadu_ps (input + i), x),
+                                         _mm_cmpneq_ps (_mm_loadu_ps (input + i + 4), x));
+            
+            if (_mm_movemask_ps (ne) != 0)
+                return PLANK_FALSE;
+        }
+    }
+#elif PLANK_VFILTER_NEON
+    {
+        const float32x4_t x = vdupq_n_f32 (first);
+        
+        for (; (i + 8) <= N; i += 8)
+        {
+            const uint32x4_t eq = vandq_u32 (vceqq_f32 (vld1q_f32 (input + i), x),
+                                             vceqq_f32 (vld1q_f32 (input + i + 4), x));
+            
+            if (vminvq_u32 (eq) == 0)
+                return PLANK_FALSE;
+        }
+    }
+#endif
+    
+    for (; i < N; ++i)
+        if (input[i] != first)
+            return PLANK_FALSE;
+    
+    return PLANK_TRUE;
+}
+
+/** Process four two-pole, two-zero (Direct Form II) filters together.
+ y0 = x + b1 * y1 + b2 * y2 then output = a0 * y0 + a1 * y1 + a2 * y2.
+ @param results     The four output vectors.
+ @param inputs      The four input vectors.
+ @param coeffs      The 20 coefficient vectors, a0, a1, a2, b1 and b2 for each lane.
+ @param coeffStride 0 for fixed coefficients or 1 for per-sample coefficients.
+ @param state       The packed filter state (8 values), updated on return.
+ @param N           The number of samples in each vector.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorBiquadP2Z2x4F_NN (PlankF* const* results, const PlankF* const* inputs, const PlankF* const* coeffs, const PlankUL coeffStride, PlankF* state, PlankUL N)
+{
+    pl_VFilter_Biquadx4F (results, inputs, coeffs, coeffStride, state, N, PLANK_FALSE);
+}
+
+/** Process four Butterworth 2nd order (Direct Form II) filters together.
+ y0 = x + b1 * y1 + b2 * y2 then output = a0 * (y0 + a1 * y1 + a2 * y2).
+ @param results     The four output vectors.
+ @param inputs      The four input vectors.
+ @param coeffs      The 20 coefficient vectors, a0, a1, a2, b1 and b2 for each lane.
+ @param coeffStride 0 for fixed coefficients or 1 for per-sample coefficients.
+ @param state       The packed filter state (8 values), updated on return.
+ @param N           The number of samples in each vector.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorBiquadB2x4F_NN (PlankF* const* results, const PlankF* const* inputs, const PlankF* const* coeffs, const PlankUL coeffStride, PlankF* state, PlankUL N)
+{
+    pl_VFilter_Biquadx4F (results, inputs, coeffs, coeffStride, state, N, PLANK_TRUE);
+}
+
+#endif // PLANK_VECTORSFILTER_H
@@ -0,0 +1,491 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_VECTORSPCM_H
+#define PLANK_VECTORSPCM_H
+
+// Fused PCM sample format conversion for audio file reading and writing.
+// Each function converts between packed integer PCM data in either byte order
+// and floats in a single pass: byte swapping, sign extension (including packed
+// 24-bit data) and scaling. These don't depend on the vector backend selected 
+// in plank_Vectors.h, SSE2 or AArch64 NEON is used where the compiler targets it
+// otherwise a scalar loop is used. The PCM data need not be aligned and no bytes
+// outside the N samples are accessed.
+
+#if PLANK_LITTLEENDIAN && !defined(PLANK_VPCM_SCALAR)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define PLANK_VPCM_SSE2 1
+        #include <emmintrin.h>
+    #elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+        #define PLANK_VPCM_NEON 1
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#define PLANK_VPCM_INT24MIN_F   (-8388608.0f)
+#define PLANK_VPCM_INT24MAX_F   (8388607.0f)
+#define PLANK_VPCM_INTMIN_F     (-2147483648.0f)
+#define PLANK_VPCM_INTMAX_F     (2147483520.0f)  // the largest float below 2^31
+
+#if PLANK_VPCM_SSE2
+static PLANK_INLINE_LOW __m128i pl_VPCM_Swap16 (const __m128i x)
+{
+    return _mm_or_si128 (_mm_slli_epi16 (x, 8), _mm_srli_epi16 (x, 8));
+}
+
+static PLANK_INLINE_LOW __m128i pl_VPCM_Swap32 (const __m128i x)
+{
+    const __m128i mask = _mm_set1_epi32 (0x0000ff00);
+    return _mm_or_si128 (_mm_or_si128 (_mm_slli_epi32 (x, 24), _mm_srli_epi32 (x, 24)),
+                         _mm_or_si128 (_mm_slli_epi32 (_mm_and_si128 (x, mask), 8), _mm_and_si128 (_mm_srli_epi32 (x, 8), mask)));
+}
+#endif
+
+/** Convert 16-bit PCM data to floats.
+ @param result      The output vector.
+ @param data        The PCM data containing N 16-bit samples.
+ @param isBigEndian Whether the PCM data is big endian.
+ @param scale       The factor applied to each sample (e.g., 1/32767 to normalise).
+ @param N           The number of samples.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorDecodePCM16F_NN (PlankF *result, const void* data, const PlankB isBigEndian, const PlankF scale, PlankUL N)
+{
+    const PlankUC* src;
+    PlankUL i;
+    
+    src = (const PlankUC*)data;
+    i = 0;
+    
+#if PLANK_VPCM_SSE2
+    {
+        const __m128 s = _mm_set1_ps (scale);
+        
+        for (; (i + 8) <= N; i += 8)
+        {
+            __m128i x = _mm_loadu_si128 ((const __m128i*)(src + i * 2));
+            
+            if (isBigEndian)
+                x = pl_VPCM_Swap16 (x);
+            
+            _mm_storeu_ps (result + i,     _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (x, x), 16)), s));
+            _mm_storeu_ps (result + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpackhi_epi16 (x, x), 16)), s));
+        }
+    }
+#elif PLANK_VPCM_NEON
+    {
+        for (; (i + 8) <= N; i += 8)
+        {
+            uint8x16_t b = vld1q_u8 (src + i * 2);
+            int16x8_t x;
+            
+            if (isBigEndian)
+                b = vrev16q_u8 (b);
+            
+            x = vreinterpretq_s16_u8 (b);
+            vst1q_f32 (result + i,     vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_low_s16 (x))), scale));
+            vst1q_f32 (result + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vmovl_high_s16 (x)), scale));
+        }
+    }
+#endif
+    
+    src += i * 2;
+    
+    if (isBigEndian)
+    {
+        for (; i < N; ++i, src += 2)
+            result[i] = (PlankF)(PlankS)(((PlankUS)src[0] << 8) | (PlankUS)src[1]) * scale;
+    }
+    else
+    {
+        for (; i < N; ++i, src += 2)
+            result[i] = (PlankF)(PlankS)(((PlankUS)src[1] << 8) | (PlankUS)src[0]) * scale;
+    }
+}
+
+/** Convert packed 24-bit PCM data to floats.
+ @param result      The output vector.
+ @param data        The PCM data containing N 3-byte samples.
+ @param isBigEndian Whether the PCM data is big endian.
+ @param scale       The factor applied to each sample (e.g., 1/8388607 to normalise).
+ @param N           The number of samples.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorDecodePCM24F_NN (PlankF *result, const void* data, const PlankB isBigEndian, const PlankF scale, PlankUL N)
+{
+    const PlankUC* src;
+    PlankUL i;
+    PlankI value;
+    
+    src = (const PlankUC*)data;
+    i = 0;
+    
+#if PLANK_VPCM_SSE2
+    {
+        const __m128 s = _mm_set1_ps (scale);
+        
+        // each load reads 16 bytes for 4 samples (12 bytes) so stop before the last 2 samples
+        for (; (i + 6) <= N; i += 4)
+        {
+            const __m128i x = _mm_loadu_si128 ((const __m128i*)(src + i * 3));
+            
+            // gather the 3-byte groups into the low bytes of each 32-bit lane
+            const __m128i lo = _mm_unpacklo_epi32 (x, _mm_srli_si128 (x, 3));
+            const __m128i hi = _mm_unpacklo_epi32 (_mm_srli_si128 (x, 6), _mm_srli_si128 (x, 9));
+            __m128i v = _mm_unpacklo_epi64 (lo, hi);
+            
+            // move the sample to the top 3 bytes then sign extend
+            v = isBigEndian ? pl_VPCM_Swap32 (v) : _mm_slli_epi32 (v, 8);
+            _mm_storeu_ps (result + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (v, 8)), s));
+        }
+    }
+#elif PLANK_VPCM_NEON
+    {
+        const uint8x16_t zero = vdupq_n_u8 (0);
+        
+        for (; (i + 16) <= N; i += 16)
+        {
+            const uint8x16x3_t b = vld3q_u8 (src + i * 3);
+            const uint8x16_t b0 = isBigEndian ? b.val[2] : b.val[0];
+            const uint8x16_t b2 = isBigEndian ? b.val[0] : b.val[2];
+            
+            // build 32-bit lanes with the sample in the top 3 bytes then sign extend
+            const uint16x8_t l0 = vreinterpretq_u16_u8 (vzip1q_u8 (zero, b0));
+            const uint16x8_t h0 = vreinterpretq_u16_u8 (vzip2q_u8 (zero, b0));
+            const uint16x8_t l1 = vreinterpretq_u16_u8 (vzip1q_u8 (b.val[1], b2));
+            const uint16x8_t h1 = vreinterpretq_u16_u8 (vzip2q_u8 (b.val[1], b2));
+            
+            vst1q_f32 (result + i,      vmulq_n_f32 (vcvtq_f32_s32 (vshrq_n_s32 (vreinterpretq_s32_u16 (vzip1q_u16 (l0, l1)), 8)), scale));
+            vst1q_f32 (result + i + 4,  vmulq_n_f32 (vcvtq_f32_s32 (vshrq_n_s32 (vreinterpretq_s32_u16 (vzip2q_u16 (l0, l1)), 8)), scale));
+            vst1q_f32 (result + i + 8,  vmulq_n_f32 (vcvtq_f32_s32 (vshrq_n_s32 (vreinterpretq_s32_u16 (vzip1q_u16 (h0, h1)), 8)), scale));
+            vst1q_f32 (result + i + 12, vmulq_n_f32 (vcvtq_f32_s32 (vshrq_n_s32 (vreinterpretq_s32_u16 (vzip2q_u16 (h0, h1)), 8)), scale));
+        }
+    }
+#endif
+    
+    src += i * 3;
+    
+    if (isBigEndian)
+    {
+        for (; i < N; ++i, src += 3)
+        {
+            value = (PlankI)(((PlankUI)src[0] << 16) | ((PlankUI)src[1] << 8) | (PlankUI)src[2]);
+            result[i] = (PlankF)((value ^ 0x800000) - 0x800000) * scale;
+        }
+    }
+    else
+    {
+        for (; i < N; ++i, src += 3)
+        {
+            value = (PlankI)(((PlankUI)src[2] << 16) | ((PlankUI)src[1] << 8) | (PlankUI)src[0]);
+            result[i] = (PlankF)((value ^ 0x800000) - 0x800000) * scale;
+        }
+    }
+}
+
+/** Convert 32-bit PCM data to floats.
+ @param result      The output vector.
+ @param data        The PCM data containing N 32-bit samples.
+ @param isBigEndian Whether the PCM data is big endian.
+ @param scale       The factor applied to each sample (e.g., 1/2147483647 to normalise).
+ @param N           The number of samples.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorDecodePCM32F_NN (PlankF *result, const void* data, const PlankB isBigEndian, const PlankF scale, PlankUL N)
+{
+    const PlankUC* src;
+    PlankUL i;
+    
+    src = (const PlankUC*)data;
+    i = 0;
+    
+#if PLANK_VPCM_SSE2
+    {
+        const __m128 s = _mm_set1_ps (scale);
+        
+        for (; (i + 4) <= N; i += 4)
+        {
+            __m128i x = _mm_loadu_si128 ((const __m128i*)(src + i * 4));
+            
+            if (isBigEndian)
+                x = pl_VPCM_Swap32 (x);
+            
+            _mm_storeu_ps (result + i, _mm_mul_ps (_mm_cvtepi32_ps (x), s));
+        }
+    }
+#elif PLANK_VPCM_NEON
+    {
+        for (; (i + 4) <= N; i += 4)
+        {
+            uint8x16_t b = vld1q_u8 (src + i * 4);
+            
+            if (isBigEndian)
+                b = vrev32q_u8 (b);
+            
+            vst1q_f32 (result + i, vmulq_n_f32 (vcvtq_f32_s32 (vreinterpretq_s32_u8 (b)), scale));
+        }
+    }
+#endif
+    
+    src += i * 4;
+    
+    if (isBigEndian)
+    {
+        for (; i < N; ++i, src += 4)
+            result[i] = (PlankF)(PlankI)(((PlankUI)src[0] << 24) | ((PlankUI)src[1] << 16) | ((PlankUI)src[2] << 8) | (PlankUI)src[3]) * scale;
+    }
+    else
+    {
+        for (; i < N; ++i, src += 4)
+            result[i] = (PlankF)(PlankI)(((PlankUI)src[3] << 24) | ((PlankUI)src[2] << 16) | ((PlankUI)src[1] << 8) | (PlankUI)src[0]) * scale;
+    }
+}
+
+/** Convert floats to 16-bit PCM data.
+ Values are scaled, clipped to the range of the format and truncated towards zero.
+ @param result      The output PCM data with space for N 16-bit samples.
+ @param a           The input vector.
+ @param isBigEndian Whether the PCM data should be big endian.
+ @param scale       The factor applied to each sample (e.g., 32767 for normalised input).
+ @param N           The number of samples.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorEncodePCM16F_NN (void* result, const PlankF *a, const PlankB isBigEndian, const PlankF scale, PlankUL N)
+{
+    PlankUC* dst;
+    PlankUL i;
+    PlankS value;
+    
+    dst = (PlankUC*)result;
+    i = 0;
+    
+#if PLANK_VPCM_SSE2
+    {
+        const __m128 s = _mm_set1_ps (scale);
+        const __m128 lower = _mm_set1_ps (-32768.0f);
+        const __m128 upper = _mm_set1_ps (32767.0f);
+        
+        // clip before converting as out of range values (and inf) convert to 
+        // 0x80000000 which _mm_packs_epi32 would saturate to -32768
+        for (; (i + 8) <= N; i += 8)
+        {
+            const __m128i lo = _mm_cvttps_epi32 (_mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (a + i), s), lower), upper));
+            const __m128i hi = _mm_cvttps_epi32 (_mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (a + i + 4), s), lower), upper));
+            __m128i x = _mm_packs_epi32 (lo, hi);
+            
+            if (isBigEndian)
+                x = pl_VPCM_Swap16 (x);
+            
+            _mm_storeu_si128 ((__m128i*)(dst + i * 2), x);
+        }
+    }
+#elif PLANK_VPCM_NEON
+    {
+        for (; (i + 8) <= N; i += 8)
+        {
+            const int16x4_t lo = vqmovn_s32 (vcvtq_s32_f32 (vmulq_n_f32 (vld1q_f32 (a + i), scale)));
+            uint8x16_t b = vreinterpretq_u8_s16 (vqmovn_high_s32 (lo, vcvtq_s32_f32 (vmulq_n_f32 (vld1q_f32 (a + i + 4), scale))));
+            
+            if (isBigEndian)
+                b = vrev16q_u8 (b);
+            
+            vst1q_u8 (dst + i * 2, b);
+        }
+    }
+#endif
+    
+    dst += i * 2;
+    
+    for (; i < N; ++i, dst += 2)
+    {
+        value = (PlankS)pl_ClipF (a[i] * scale, -32768.0f, 32767.0f);
+        
+        if (isBigEndian)
+        {
+            dst[0] = (PlankUC)((PlankUS)value >> 8);
+            dst[1] = (PlankUC)value;
+        }
+        else
+        {
+            dst[0] = (PlankUC)value;
+            dst[1] = (PlankUC)((PlankUS)value >> 8);
+        }
+    }
+}
+
+/** Convert floats to packed 24-bit PCM data.
+ Values are scaled, clipped to the range of the format and truncated towards zero.
+ @param result      The output PCM data with space for N 3-byte samples.
+ @param a           The input vector.
+ @param isBigEndian Whether the PCM data should be big endian.
+ @param scale       The factor applied to each sample (e.g., 8388607 for normalised input).
+ @param N           The number of samples.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorEncodePCM24F_NN (void* result, const PlankF *a, const PlankB isBigEndian, const PlankF scale, PlankUL N)
+{
+    PlankUC* dst;
+    PlankUL i;
+    PlankUI value;
+    
+    dst = (PlankUC*)result;
+    i = 0;
+    
+#if PLANK_VPCM_SSE2
+    {
+        PLANK_ALIGN(16) PlankI temp[4];
+        const __m128 s = _mm_set1_ps (scale);
+        const __m128 lower = _mm_set1_ps (PLANK_VPCM_INT24MIN_F);
+        const __m128 upper = _mm_set1_ps (PLANK_VPCM_INT24MAX_F);
+        int j;
+        
+        // SSE2 has no byte shuffle so the packing is scalar
+        for (; (i + 4) <= N; i += 4)
+        {
+            _mm_store_si128 ((__m128i*)temp, _mm_cvttps_epi32 (_mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (a + i), s), lower), upper)));
+            
+            for (j = 0; j < 4; ++j, dst += 3)
+            {
+                value = (PlankUI)temp[j];
+                dst[isBigEndian ? 2 : 0] = (PlankUC)value;
+                dst[1]                   = (PlankUC)(value >> 8);
+                dst[isBigEndian ? 0 : 2] = (PlankUC)(value >> 16);
+            }
+        }
+    }
+#elif PLANK_VPCM_NEON
+    {
+        const float32x4_t lower = vdupq_n_f32 (PLANK_VPCM_INT24MIN_F);
+        const float32x4_t upper = vdupq_n_f32 (PLANK_VPCM_INT24MAX_F);
+        uint8x16x3_t b;
+        uint32x4_t v0, v1, v2, v3;
+        
+        for (; (i + 16) <= N; i += 16, dst += 48)
+        {
+            v0 = vreinterpretq_u32_s32 (vcvtq_s32_f32 (vminq_f32 (vmaxq_f32 (vmulq_n_f32 (vld1q_f32 (a + i),      scale), lower), upper)));
+            v1 = vreinterpretq_u32_s32 (vcvtq_s32_f32 (vminq_f32 (vmaxq_f32 (vmulq_n_f32 (vld1q_f32 (a + i + 4),  scale), lower), upper)));
+            v2 = vreinterpretq_u32_s32 (vcvtq_s32_f32 (vminq_f32 (vmaxq_f32 (vmulq_n_f32 (vld1q_f32 (a + i + 8),  scale), lower), upper)));
+            v3 = vreinterpretq_u32_s32 (vcvtq_s32_f32 (vminq_f32 (vmaxq_f32 (vmulq_n_f32 (vld1q_f32 (a + i + 12), scale), lower), upper)));
+            
+            b.val[isBigEndian ? 2 : 0] = vcombine_u8 (vmovn_u16 (vcombine_u16 (vmovn_u32 (v0), vmovn_u32 (v1))),
+                                                      vmovn_u16 (vcombine_u16 (vmovn_u32 (v2), vmovn_u32 (v3))));
+            b.val[1] = vcombine_u8 (vmovn_u16 (vcombine_u16 (vmovn_u32 (vshrq_n_u32 (v0, 8)), vmovn_u32 (vshrq_n_u32 (v1, 8)))),
+                                    vmovn_u16 (vcombine_u16 (vmovn_u32 (vshrq_n_u32 (v2, 8)), vmovn_u32 (vshrq_n_u32 (v3, 8)))));
+            b.val[isBigEndian ? 0 : 2] = vcombine_u8 (vmovn_u16 (vcombine_u16 (vmovn_u32 (vshrq_n_u32 (v0, 16)), vmovn_u32 (vshrq_n_u32 (v1, 16)))),
+                                                      vmovn_u16 (vcombine_u16 (vmovn_u32 (vshrq_n_u32 (v2, 16)), vmovn_u32 (vshrq_n_u32 (v3, 16)))));
+            vst3q_u8 (dst, b);
+        }
+    }
+#endif
+    
+    for (; i < N; ++i, dst += 3)
+    {
+        value = (PlankUI)(PlankI)pl_ClipF (a[i] * scale, PLANK_VPCM_INT24MIN_F, PLANK_VPCM_INT24MAX_F);
+        dst[isBigEndian ? 2 : 0] = (PlankUC)value;
+        dst[1]                   = (PlankUC)(value >> 8);
+        dst[isBigEndian ? 0 : 2] = (PlankUC)(value >> 16);
+    }
+}
+
+/** Convert floats to 32-bit PCM data.
+ Values are scaled, clipped to the range of the format and truncated towards zero.
+ @param result      The output PCM data with space for N 32-bit samples.
+ @param a           The input vector.
+ @param isBigEndian Whether the PCM data should be big endian.
+ @param scale       The factor applied to each sample (e.g., 2147483647 for normalised input).
+ @param N           The number of samples.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorEncodePCM32F_NN (void* result, const PlankF *a, const PlankB isBigEndian, const PlankF scale, PlankUL N)
+{
+    PlankUC* dst;
+    PlankUL i;
+    PlankUI value;
+    
+    dst = (PlankUC*)result;
+    i = 0;
+    
+#if PLANK_VPCM_SSE2
+    {
+        const __m128 s = _mm_set1_ps (scale);
+        const __m128 lower = _mm_set1_ps (PLANK_VPCM_INTMIN_F);
+        const __m128 upper = _mm_set1_ps (PLANK_VPCM_INTMAX_F);
+        
+        for (; (i + 4) <= N; i += 4)
+        {
+            __m128i x = _mm_cvttps_epi32 (_mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (a + i), s), lower), upper));
+            
+            if (isBigEndian)
+                x = pl_VPCM_Swap32 (x);
+            
+            _mm_storeu_si128 ((__m128i*)(dst + i * 4), x);
+        }
+    }
+#elif PLANK_VPCM_NEON
+    {
+        // vcvtq_s32_f32 saturates so there is no need to clip first
+        for (; (i + 4) <= N; i += 4)
+        {
+            uint8x16_t b = vreinterpretq_u8_s32 (vcvtq_s32_f32 (vmulq_n_f32 (vld1q_f32 (a + i), scale)));
+            
+            if (isBigEndian)
+                b = vrev32q_u8 (b);
+            
+            vst1q_u8 (dst + i * 4, b);
+        }
+    }
+#endif
+    
+    dst += i * 4;
+    
+    for (; i < N; ++i, dst += 4)
+    {
+        value = (PlankUI)(PlankI)pl_ClipF (a[i] * scale, PLANK_VPCM_INTMIN_F, PLANK_VPCM_INTMAX_F);
+        
+        if (isBigEndian)
+        {
+            dst[0] = (PlankUC)(value >> 24);
+            dst[1] = (PlankUC)(value >> 16);
+            dst[2] = (PlankUC)(value >> 8);
+            dst[3] = (PlankUC)value;
+        }
+        else
+        {
+            dst[0] = (PlankUC)value;
+            dst[1] = (PlankUC)(value >> 8);
+            dst[2] = (PlankUC)(value >> 16);
+            dst[3] = (PlankUC)(value >> 24);
+        }
+    }
+}
+
+#endif // PLANK_VECTORSPCM_H
@@ -0,0 +1,225 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_VECTORSTABLE_H
+#define PLANK_VECTORSTABLE_H
+
+// Wavetable lookup with linear interpolation.
+// The phase is a running sum so it has to be stepped one sample at a time,
+// but that is only an add and a wrap. The positions are stepped four at a 
+// time into a small buffer then the table reads, which are the expensive part,
+// are gathered and interpolated four lanes at a time. Tables must be stored
+// with at least one guard sample past the end (plonk's Wavetable stores the
+// table twice) so index + 1 is always valid. The arithmetic matches InterpLinear
+// in plonk_InlineMiscOps.h so results are identical to the scalar Table unit.
+// Like plank_VectorsFilter.h these don't depend on the vector backend selected
+// in plank_Vectors.h, SSE2 or AArch64 NEON is used where the compiler targets 
+// it otherwise a scalar loop is used.
+
+#if !defined(PLANK_VTABLE_SCALAR)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define PLANK_VTABLE_SSE2 1
+        #include <emmintrin.h>
+    #elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+        #define PLANK_VTABLE_NEON 1
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#define PLANK_VTABLE_LANES 4
+
+static PLANK_INLINE_LOW PlankF pl_VTable_LookupLinearF (const PlankF* table, const PlankF position)
+{
+    const int index0 = (int)position;
+    const PlankF frac = position - (PlankF)index0;
+    const PlankF value0 = table[index0];
+    return value0 + (table[index0 + 1] - value0) * frac;
+}
+
+static PLANK_INLINE_LOW PlankF pl_VTable_WrapF (PlankF position, const PlankF tableLength)
+{
+    if (position >= tableLength)
+        position -= tableLength;
+    else if (position < 0.f)
+        position += tableLength;
+    
+    return position;
+}
+
+static PLANK_INLINE_MID void pl_VTable_LinearF (PlankF* result, const PlankF* table, const PlankUL tableLength, PlankF* position, const PlankF* frequencies, const PlankUL frequencyStride, const PlankF scale, PlankUL N)
+{
+    const PlankF length = (PlankF)tableLength;
+    PlankF current = *position;
+    PlankUL i = 0;
+    
+#if PLANK_VTABLE_SSE2 || PLANK_VTABLE_NEON
+    // the positions and table values are kept in registers, going through 
+    // memory here would stall on store forwarding
+    PlankF p0, p1, p2, p3;
+    int i0, i1, i2, i3;
+    
+    for (; (i + PLANK_VTABLE_LANES) <= N; i += PLANK_VTABLE_LANES)
+    {
+        p0 = current;
+        p1 = pl_VTable_WrapF (p0 + frequencies[i * frequencyStride] * scale, length);
+        p2 = pl_VTable_WrapF (p1 + frequencies[(i + 1) * frequencyStride] * scale, length);
+        p3 = pl_VTable_WrapF (p2 + frequencies[(i + 2) * frequencyStride] * scale, length);
+        current = pl_VTable_WrapF (p3 + frequencies[(i + 3) * frequencyStride] * scale, length);
+        
+        i0 = (int)p0;
+        i1 = (int)p1;
+        i2 = (int)p2;
+        i3 = (int)p3;
+        
+    #if PLANK_VTABLE_SSE2
+        {
+            const __m128 p = _mm_set_ps (p3, p2, p1, p0);
+            const __m128 frac = _mm_sub_ps (p, _mm_cvtepi32_ps (_mm_set_epi32 (i3, i2, i1, i0)));
+            const __m128 v0 = _mm_set_ps (table[i3], table[i2], table[i1], table[i0]);
+            const __m128 v1 = _mm_set_ps (table[i3 + 1], table[i2 + 1], table[i1 + 1], table[i0 + 1]);
+            _mm_storeu_ps (result + i, _mm_add_ps (v0, _mm_mul_ps (_mm_sub_ps (v1, v0), frac)));
+        }
+    #else
+        {
+            float32x4_t p, v0, v1, frac;
+            int32x4_t index;
+            
+            p = vsetq_lane_f32 (p0, vdupq_n_f32 (0.f), 0);
+            p = vsetq_lane_f32 (p1, p, 1);
+            p = vsetq_lane_f32 (p2, p, 2);
+            p = vsetq_lane_f32 (p3, p, 3);
+            
+            index = vsetq_lane_s32 (i0, vdupq_n_s32 (0), 0);
+            index = vsetq_lane_s32 (i1, index, 1);
+            index = vsetq_lane_s32 (i2, index, 2);
+            index = vsetq_lane_s32 (i3, index, 3);
+            frac = vsubq_f32 (p, vcvtq_f32_s32 (index));
+            
+            v0 = vsetq_lane_f32 (table[i0], vdupq_n_f32 (0.f), 0);
+            v0 = vsetq_lane_f32 (table[i1], v0, 1);
+            v0 = vsetq_lane_f32 (table[i2], v0, 2);
+            v0 = vsetq_lane_f32 (table[i3], v0, 3);
+            
+            v1 = vsetq_lane_f32 (table[i0 + 1], vdupq_n_f32 (0.f), 0);
+            v1 = vsetq_lane_f32 (table[i1 + 1], v1, 1);
+            v1 = vsetq_lane_f32 (table[i2 + 1], v1, 2);
+            v1 = vsetq_lane_f32 (table[i3 + 1], v1, 3);
+            
+            vst1q_f32 (result + i, vaddq_f32 (v0, vmulq_f32 (vsubq_f32 (v1, v0), frac)));
+        }
+    #endif
+    }
+#endif
+    
+    for (; i < N; ++i)
+    {
+        result[i] = pl_VTable_LookupLinearF (table, current);
+        current = pl_VTable_WrapF (current + frequencies[i * frequencyStride] * scale, length);
+    }
+    
+    *position = current;
+}
+
+/** Find the largest absolute value in a vector.
+ This is used to choose a band-limited table for a block of frequencies.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID PlankF pl_VectorMaxAbsF_N (const PlankF* input, PlankUL N)
+{
+    PlankF maximum = 0.f;
+    PlankUL i = 0;
+    
+#if PLANK_VTABLE_SSE2
+    {
+        const __m128 mask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+        PLANK_ALIGN(16) PlankF lanes[PLANK_VTABLE_LANES];
+        __m128 x = _mm_setzero_ps();
+        
+        for (; (i + PLANK_VTABLE_LANES) <= N; i += PLANK_VTABLE_LANES)
+            x = _mm_max_ps (x, _mm_and_ps (_mm_loadu_ps (input + i), mask));
+        
+        _mm_store_ps (lanes, x);
+        maximum = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+        maximum = maximum > lanes[2] ? maximum : lanes[2];
+        maximum = maximum > lanes[3] ? maximum : lanes[3];
+    }
+#elif PLANK_VTABLE_NEON
+    {
+        float32x4_t x = vdupq_n_f32 (0.f);
+        
+        for (; (i + PLANK_VTABLE_LANES) <= N; i += PLANK_VTABLE_LANES)
+            x = vmaxq_f32 (x, vabsq_f32 (vld1q_f32 (input + i)));
+        
+        maximum = vmaxvq_f32 (x);
+    }
+#endif
+    
+    for (; i < N; ++i)
+    {
+        const PlankF value = input[i] < 0.f ? -input[i] : input[i];
+        
+        if (value > maximum)
+            maximum = value;
+    }
+    
+    return maximum;
+}
+
+/** Wavetable oscillator with linear interpolation and a frequency per sample.
+ The position advances by frequency * scale each sample and wraps to the table length.
+ @param result      The output vector.
+ @param table       The table, this must be readable to index tableLength (inclusive).
+ @param tableLength The table length.
+ @param position    The current table position, this is updated on return.
+ @param frequencies The frequency vector.
+ @param scale       The table length divided by the sample rate.
+ @param N           The number of samples to process.
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorTableLinearF_NN (PlankF* result, const PlankF* table, const PlankUL tableLength, PlankF* position, const PlankF* frequencies, const PlankF scale, PlankUL N)
+{
+    pl_VTable_LinearF (result, table, tableLength, position, frequencies, 1, scale, N);
+}
+
+/** Wavetable oscillator with linear interpolation and a fixed frequency.
+ @see pl_VectorTableLinearF_NN
+ @ingroup PlankVectorFunctions */
+static PLANK_INLINE_MID void pl_VectorTableLinearF_N1 (PlankF* result, const PlankF* table, const PlankUL tableLength, PlankF* position, const PlankF frequency, const PlankF scale, PlankUL N)
+{
+    pl_VTable_LinearF (result, table, tableLength, position, &frequency, 0, scale, N);
+}
+
+#endif // PLANK_VECTORSTABLE_H
@@ -0,0 +1,1083 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_VSIMD_H
+#define PLANK_VSIMD_H
+
+#if !DOXYGEN
+
+#ifdef PLANK_VEC_CUSTOM
+    #error only one custom vectorised libary may be specified
+#endif
+
+#define PLANK_VEC_CUSTOM
+
+// Portable SIMD vector backend using compiler intrinsics.
+// The instruction set is chosen at compile time from the compiler's target flags:
+// AVX (+AVX2 for integers, +FMA for multiply-add) then SSE2 on x86, or NEON on AArch64.
+// Operations without a SIMD implementation here use the scalar macros from plank_Vectors.h.
+// All loads and stores are unaligned and any remainder is processed with the scalar functions.
+
+#if defined(__AVX__)
+    #define PLANK_VSIMD_AVX 1
+    #if defined(__AVX2__)
+        #define PLANK_VSIMD_AVX2 1
+    #endif
+    #if defined(__FMA__)
+        #define PLANK_VSIMD_FMA 1
+    #endif
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define PLANK_VSIMD_SSE2 1
+    #include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+    #define PLANK_VSIMD_NEON 1
+    #include <arm_neon.h>
+#else
+    #error PLANK_VEC_SIMD requires a target with SSE2, AVX or AArch64 NEON
+#endif
+
+#if PLANK_VSIMD_AVX || PLANK_VSIMD_SSE2
+    #define PLANK_VSIMD_X86 1
+#endif
+
+//------------------------------- float ----------------------------------------
+
+#if PLANK_VSIMD_AVX
+    #define PLANK_SIMDF_LENGTH  8   // vector 8 floats
+    #define PLANK_SIMDF_SIZE   32
+    #define PLANK_SIMDF_SHIFT   3   // divide by 8 for length
+    #define PLANK_SIMDF_MASK    7   // remainder mask for non-multiples of 8
+    typedef __m256 PlankVF;
+
+    #define PLANK_SIMDF_Load(P)         _mm256_loadu_ps(P)
+    #define PLANK_SIMDF_Store(P,A)      _mm256_storeu_ps(P,A)
+    #define PLANK_SIMDF_Set(A)          _mm256_set1_ps(A)
+    #define PLANK_SIMDF_Add(A,B)        _mm256_add_ps(A,B)
+    #define PLANK_SIMDF_Sub(A,B)        _mm256_sub_ps(A,B)
+    #define PLANK_SIMDF_Mul(A,B)        _mm256_mul_ps(A,B)
+    #define PLANK_SIMDF_Div(A,B)        _mm256_div_ps(A,B)
+    #define PLANK_SIMDF_Sqrt(A)         _mm256_sqrt_ps(A)
+    #define PLANK_SIMDF_Min(A,B)        _mm256_min_ps(B,A) // operand order matches pl_MinF()
+    #define PLANK_SIMDF_Max(A,B)        _mm256_max_ps(B,A) // operand order matches pl_MaxF()
+    #define PLANK_SIMDF_And(A,B)        _mm256_and_ps(A,B)
+    #define PLANK_SIMDF_AndNot(A,B)     _mm256_andnot_ps(A,B)
+    #define PLANK_SIMDF_Xor(A,B)        _mm256_xor_ps(A,B)
+    #define PLANK_SIMDF_CmpEQ(A,B)      _mm256_cmp_ps(A,B,_CMP_EQ_OQ)
+    #define PLANK_SIMDF_CmpNE(A,B)      _mm256_cmp_ps(A,B,_CMP_NEQ_UQ)
+    #define PLANK_SIMDF_CmpGT(A,B)      _mm256_cmp_ps(A,B,_CMP_GT_OQ)
+    #define PLANK_SIMDF_CmpGE(A,B)      _mm256_cmp_ps(A,B,_CMP_GE_OQ)
+    #define PLANK_SIMDF_CmpLT(A,B)      _mm256_cmp_ps(A,B,_CMP_LT_OQ)
+    #define PLANK_SIMDF_CmpLE(A,B)      _mm256_cmp_ps(A,B,_CMP_LE_OQ)
+    #if PLANK_VSIMD_FMA
+        #define PLANK_SIMDF_MulAdd(A,B,C)   _mm256_fmadd_ps(A,B,C)
+    #endif
+#elif PLANK_VSIMD_SSE2
+    #define PLANK_SIMDF_LENGTH  4   // vector 4 floats
+    #define PLANK_SIMDF_SIZE   16
+    #define PLANK_SIMDF_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDF_MASK    3   // remainder mask for non-multiples of 4
+    typedef __m128 PlankVF;
+
+    #define PLANK_SIMDF_Load(P)         _mm_loadu_ps(P)
+    #define PLANK_SIMDF_Store(P,A)      _mm_storeu_ps(P,A)
+    #define PLANK_SIMDF_Set(A)          _mm_set1_ps(A)
+    #define PLANK_SIMDF_Add(A,B)        _mm_add_ps(A,B)
+    #define PLANK_SIMDF_Sub(A,B)        _mm_sub_ps(A,B)
+    #define PLANK_SIMDF_Mul(A,B)        _mm_mul_ps(A,B)
+    #define PLANK_SIMDF_Div(A,B)        _mm_div_ps(A,B)
+    #define PLANK_SIMDF_Sqrt(A)         _mm_sqrt_ps(A)
+    #define PLANK_SIMDF_Min(A,B)        _mm_min_ps(B,A) // operand order matches pl_MinF()
+    #define PLANK_SIMDF_Max(A,B)        _mm_max_ps(B,A) // operand order matches pl_MaxF()
+    #define PLANK_SIMDF_And(A,B)        _mm_and_ps(A,B)
+    #define PLANK_SIMDF_AndNot(A,B)     _mm_andnot_ps(A,B)
+    #define PLANK_SIMDF_Xor(A,B)        _mm_xor_ps(A,B)
+    #define PLANK_SIMDF_CmpEQ(A,B)      _mm_cmpeq_ps(A,B)
+    #define PLANK_SIMDF_CmpNE(A,B)      _mm_cmpneq_ps(A,B)
+    #define PLANK_SIMDF_CmpGT(A,B)      _mm_cmpgt_ps(A,B)
+    #define PLANK_SIMDF_CmpGE(A,B)      _mm_cmpge_ps(A,B)
+    #define PLANK_SIMDF_CmpLT(A,B)      _mm_cmplt_ps(A,B)
+    #define PLANK_SIMDF_CmpLE(A,B)      _mm_cmple_ps(A,B)
+#elif PLANK_VSIMD_NEON
+    #define PLANK_SIMDF_LENGTH  4   // vector 4 floats
+    #define PLANK_SIMDF_SIZE   16
+    #define PLANK_SIMDF_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDF_MASK    3   // remainder mask for non-multiples of 4
+    typedef float32x4_t PlankVF;
+
+    #define PLANK_SIMDF_Bits(A)         vreinterpretq_u32_f32(A)
+    #define PLANK_SIMDF_Mask(A)         vreinterpretq_f32_u32(A)
+
+    #define PLANK_SIMDF_Load(P)         vld1q_f32(P)
+    #define PLANK_SIMDF_Store(P,A)      vst1q_f32(P,A)
+    #define PLANK_SIMDF_Set(A)          vdupq_n_f32(A)
+    #define PLANK_SIMDF_Add(A,B)        vaddq_f32(A,B)
+    #define PLANK_SIMDF_Sub(A,B)        vsubq_f32(A,B)
+    #define PLANK_SIMDF_Mul(A,B)        vmulq_f32(A,B)
+    #define PLANK_SIMDF_Div(A,B)        vdivq_f32(A,B)
+    #define PLANK_SIMDF_Sqrt(A)         vsqrtq_f32(A)
+    #define PLANK_SIMDF_Min(A,B)        vminq_f32(A,B)
+    #define PLANK_SIMDF_Max(A,B)        vmaxq_f32(A,B)
+    #define PLANK_SIMDF_Abs(A)          vabsq_f32(A)
+    #define PLANK_SIMDF_Neg(A)          vnegq_f32(A)
+    #define PLANK_SIMDF_And(A,B)        PLANK_SIMDF_Mask(vandq_u32(PLANK_SIMDF_Bits(A),PLANK_SIMDF_Bits(B)))
+    #define PLANK_SIMDF_AndNot(A,B)     PLANK_SIMDF_Mask(vbicq_u32(PLANK_SIMDF_Bits(B),PLANK_SIMDF_Bits(A)))
+    #define PLANK_SIMDF_CmpEQ(A,B)      PLANK_SIMDF_Mask(vceqq_f32(A,B))
+    #define PLANK_SIMDF_CmpNE(A,B)      PLANK_SIMDF_Mask(vmvnq_u32(vceqq_f32(A,B)))
+    #define PLANK_SIMDF_CmpGT(A,B)      PLANK_SIMDF_Mask(vcgtq_f32(A,B))
+    #define PLANK_SIMDF_CmpGE(A,B)      PLANK_SIMDF_Mask(vcgeq_f32(A,B))
+    #define PLANK_SIMDF_CmpLT(A,B)      PLANK_SIMDF_Mask(vcltq_f32(A,B))
+    #define PLANK_SIMDF_CmpLE(A,B)      PLANK_SIMDF_Mask(vcleq_f32(A,B))
+    #define PLANK_SIMDF_MulAdd(A,B,C)   vfmaq_f32(C,A,B)
+#endif
+
+#if PLANK_VSIMD_X86
+    #define PLANK_SIMDF_Abs(A)          PLANK_SIMDF_AndNot(PLANK_SIMDF_Set(-0.0f),A)
+    #define PLANK_SIMDF_Neg(A)          PLANK_SIMDF_Xor(PLANK_SIMDF_Set(-0.0f),A)
+#endif
+
+#ifndef PLANK_SIMDF_MulAdd
+    #define PLANK_SIMDF_MulAdd(A,B,C)   PLANK_SIMDF_Add(PLANK_SIMDF_Mul(A,B),C)
+#endif
+
+//------------------------------- double ---------------------------------------
+
+#if PLANK_VSIMD_AVX
+    #define PLANK_SIMDD_LENGTH  4   // vector 4 doubles
+    #define PLANK_SIMDD_SIZE   32
+    #define PLANK_SIMDD_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDD_MASK    3   // remainder mask for non-multiples of 4
+    typedef __m256d PlankVD;
+
+    #define PLANK_SIMDD_Load(P)         _mm256_loadu_pd(P)
+    #define PLANK_SIMDD_Store(P,A)      _mm256_storeu_pd(P,A)
+    #define PLANK_SIMDD_Set(A)          _mm256_set1_pd(A)
+    #define PLANK_SIMDD_Add(A,B)        _mm256_add_pd(A,B)
+    #define PLANK_SIMDD_Sub(A,B)        _mm256_sub_pd(A,B)
+    #define PLANK_SIMDD_Mul(A,B)        _mm256_mul_pd(A,B)
+    #define PLANK_SIMDD_Div(A,B)        _mm256_div_pd(A,B)
+    #define PLANK_SIMDD_Sqrt(A)         _mm256_sqrt_pd(A)
+    #define PLANK_SIMDD_Min(A,B)        _mm256_min_pd(B,A) // operand order matches pl_MinD()
+    #define PLANK_SIMDD_Max(A,B)        _mm256_max_pd(B,A) // operand order matches pl_MaxD()
+    #define PLANK_SIMDD_And(A,B)        _mm256_and_pd(A,B)
+    #define PLANK_SIMDD_AndNot(A,B)     _mm256_andnot_pd(A,B)
+    #define PLANK_SIMDD_Xor(A,B)        _mm256_xor_pd(A,B)
+    #define PLANK_SIMDD_CmpEQ(A,B)      _mm256_cmp_pd(A,B,_CMP_EQ_OQ)
+    #define PLANK_SIMDD_CmpNE(A,B)      _mm256_cmp_pd(A,B,_CMP_NEQ_UQ)
+    #define PLANK_SIMDD_CmpGT(A,B)      _mm256_cmp_pd(A,B,_CMP_GT_OQ)
+    #define PLANK_SIMDD_CmpGE(A,B)      _mm256_cmp_pd(A,B,_CMP_GE_OQ)
+    #define PLANK_SIMDD_CmpLT(A,B)      _mm256_cmp_pd(A,B,_CMP_LT_OQ)
+    #define PLANK_SIMDD_CmpLE(A,B)      _mm256_cmp_pd(A,B,_CMP_LE_OQ)
+    #if PLANK_VSIMD_FMA
+        #define PLANK_SIMDD_MulAdd(A,B,C)   _mm256_fmadd_pd(A,B,C)
+    #endif
+#elif PLANK_VSIMD_SSE2
+    #define PLANK_SIMDD_LENGTH  2   // vector 2 doubles
+    #define PLANK_SIMDD_SIZE   16
+    #define PLANK_SIMDD_SHIFT   1   // divide by 2 for length
+    #define PLANK_SIMDD_MASK    1   // remainder mask for non-even lengths
+    typedef __m128d PlankVD;
+
+    #define PLANK_SIMDD_Load(P)         _mm_loadu_pd(P)
+    #define PLANK_SIMDD_Store(P,A)      _mm_storeu_pd(P,A)
+    #define PLANK_SIMDD_Set(A)          _mm_set1_pd(A)
+    #define PLANK_SIMDD_Add(A,B)        _mm_add_pd(A,B)
+    #define PLANK_SIMDD_Sub(A,B)        _mm_sub_pd(A,B)
+    #define PLANK_SIMDD_Mul(A,B)        _mm_mul_pd(A,B)
+    #define PLANK_SIMDD_Div(A,B)        _mm_div_pd(A,B)
+    #define PLANK_SIMDD_Sqrt(A)         _mm_sqrt_pd(A)
+    #define PLANK_SIMDD_Min(A,B)        _mm_min_pd(B,A) // operand order matches pl_MinD()
+    #define PLANK_SIMDD_Max(A,B)        _mm_max_pd(B,A) // operand order matches pl_MaxD()
+    #define PLANK_SIMDD_And(A,B)        _mm_and_pd(A,B)
+    #define PLANK_SIMDD_AndNot(A,B)     _mm_andnot_pd(A,B)
+    #define PLANK_SIMDD_Xor(A,B)        _mm_xor_pd(A,B)
+    #define PLANK_SIMDD_CmpEQ(A,B)      _mm_cmpeq_pd(A,B)
+    #define PLANK_SIMDD_CmpNE(A,B)      _mm_cmpneq_pd(A,B)
+    #define PLANK_SIMDD_CmpGT(A,B)      _mm_cmpgt_pd(A,B)
+    #define PLANK_SIMDD_CmpGE(A,B)      _mm_cmpge_pd(A,B)
+    #define PLANK_SIMDD_CmpLT(A,B)      _mm_cmplt_pd(A,B)
+    #define PLANK_SIMDD_CmpLE(A,B)      _mm_cmple_pd(A,B)
+#elif PLANK_VSIMD_NEON
+    #define PLANK_SIMDD_LENGTH  2   // vector 2 doubles
+    #define PLANK_SIMDD_SIZE   16
+    #define PLANK_SIMDD_SHIFT   1   // divide by 2 for length
+    #define PLANK_SIMDD_MASK    1   // remainder mask for non-even lengths
+    typedef float64x2_t PlankVD;
+
+    #define PLANK_SIMDD_Bits(A)         vreinterpretq_u64_f64(A)
+    #define PLANK_SIMDD_Mask(A)         vreinterpretq_f64_u64(A)
+
+    #define PLANK_SIMDD_Load(P)         vld1q_f64(P)
+    #define PLANK_SIMDD_Store(P,A)      vst1q_f64(P,A)
+    #define PLANK_SIMDD_Set(A)          vdupq_n_f64(A)
+    #define PLANK_SIMDD_Add(A,B)        vaddq_f64(A,B)
+    #define PLANK_SIMDD_Sub(A,B)        vsubq_f64(A,B)
+    #define PLANK_SIMDD_Mul(A,B)        vmulq_f64(A,B)
+    #define PLANK_SIMDD_Div(A,B)        vdivq_f64(A,B)
+    #define PLANK_SIMDD_Sqrt(A)         vsqrtq_f64(A)
+    #define PLANK_SIMDD_Min(A,B)        vminq_f64(A,B)
+    #define PLANK_SIMDD_Max(A,B)        vmaxq_f64(A,B)
+    #define PLANK_SIMDD_Abs(A)          vabsq_f64(A)
+    #define PLANK_SIMDD_Neg(A)          vnegq_f64(A)
+    #define PLANK_SIMDD_And(A,B)        PLANK_SIMDD_Mask(vandq_u64(PLANK_SIMDD_Bits(A),PLANK_SIMDD_Bits(B)))
+    #define PLANK_SIMDD_AndNot(A,B)     PLANK_SIMDD_Mask(vbicq_u64(PLANK_SIMDD_Bits(B),PLANK_SIMDD_Bits(A)))
+    #define PLANK_SIMDD_CmpEQ(A,B)      PLANK_SIMDD_Mask(vceqq_f64(A,B))
+    #define PLANK_SIMDD_CmpNE(A,B)      vreinterpretq_f64_u32(vmvnq_u32(vreinterpretq_u32_u64(vceqq_f64(A,B))))
+    #define PLANK_SIMDD_CmpGT(A,B)      PLANK_SIMDD_Mask(vcgtq_f64(A,B))
+    #define PLANK_SIMDD_CmpGE(A,B)      PLANK_SIMDD_Mask(vcgeq_f64(A,B))
+    #define PLANK_SIMDD_CmpLT(A,B)      PLANK_SIMDD_Mask(vcltq_f64(A,B))
+    #define PLANK_SIMDD_CmpLE(A,B)      PLANK_SIMDD_Mask(vcleq_f64(A,B))
+    #define PLANK_SIMDD_MulAdd(A,B,C)   vfmaq_f64(C,A,B)
+#endif
+
+#if PLANK_VSIMD_X86
+    #define PLANK_SIMDD_Abs(A)          PLANK_SIMDD_AndNot(PLANK_SIMDD_Set(-0.0),A)
+    #define PLANK_SIMDD_Neg(A)          PLANK_SIMDD_Xor(PLANK_SIMDD_Set(-0.0),A)
+#endif
+
+#ifndef PLANK_SIMDD_MulAdd
+    #define PLANK_SIMDD_MulAdd(A,B,C)   PLANK_SIMDD_Add(PLANK_SIMDD_Mul(A,B),C)
+#endif
+
+//------------------------------- int/short ------------------------------------
+
+#if PLANK_VSIMD_AVX2
+    #define PLANK_SIMDI_LENGTH  8   // vector 8 ints
+    #define PLANK_SIMDI_SIZE   32
+    #define PLANK_SIMDI_SHIFT   3   // divide by 8 for length
+    #define PLANK_SIMDI_MASK    7   // remainder mask for non-multiples of 8
+    typedef __m256i PlankVI;
+
+    #define PLANK_SIMDS_LENGTH 16   // vector 16 shorts
+    #define PLANK_SIMDS_SIZE   32
+    #define PLANK_SIMDS_SHIFT   4   // divide by 16 for length
+    #define PLANK_SIMDS_MASK   15   // remainder mask for non-multiples of 16
+    typedef __m256i PlankVS;
+
+    #define PLANK_SIMDI_Load(P)         _mm256_loadu_si256((const __m256i*)(P))
+    #define PLANK_SIMDI_Store(P,A)      _mm256_storeu_si256((__m256i*)(P),A)
+    #define PLANK_SIMDI_Set(A)          _mm256_set1_epi32(A)
+    #define PLANK_SIMDI_Add(A,B)        _mm256_add_epi32(A,B)
+    #define PLANK_SIMDI_Sub(A,B)        _mm256_sub_epi32(A,B)
+
+    #define PLANK_SIMDS_Load(P)         _mm256_loadu_si256((const __m256i*)(P))
+    #define PLANK_SIMDS_Store(P,A)      _mm256_storeu_si256((__m256i*)(P),A)
+    #define PLANK_SIMDS_Set(A)          _mm256_set1_epi16(A)
+    #define PLANK_SIMDS_Add(A,B)        _mm256_add_epi16(A,B)
+    #define PLANK_SIMDS_Sub(A,B)        _mm256_sub_epi16(A,B)
+#elif PLANK_VSIMD_X86
+    #define PLANK_SIMDI_LENGTH  4   // vector 4 ints
+    #define PLANK_SIMDI_SIZE   16
+    #define PLANK_SIMDI_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDI_MASK    3   // remainder mask for non-multiples of 4
+    typedef __m128i PlankVI;
+
+    #define PLANK_SIMDS_LENGTH  8   // vector 8 shorts
+    #define PLANK_SIMDS_SIZE   16
+    #define PLANK_SIMDS_SHIFT   3   // divide by 8 for length
+    #define PLANK_SIMDS_MASK    7   // remainder mask for non-multiples of 8
+    typedef __m128i PlankVS;
+
+    #define PLANK_SIMDI_Load(P)         _mm_loadu_si128((const __m128i*)(P))
+    #define PLANK_SIMDI_Store(P,A)      _mm_storeu_si128((__m128i*)(P),A)
+    #define PLANK_SIMDI_Set(A)          _mm_set1_epi32(A)
+    #define PLANK_SIMDI_Add(A,B)        _mm_add_epi32(A,B)
+    #define PLANK_SIMDI_Sub(A,B)        _mm_sub_epi32(A,B)
+
+    #define PLANK_SIMDS_Load(P)         _mm_loadu_si128((const __m128i*)(P))
+    #define PLANK_SIMDS_Store(P,A)      _mm_storeu_si128((__m128i*)(P),A)
+    #define PLANK_SIMDS_Set(A)          _mm_set1_epi16(A)
+    #define PLANK_SIMDS_Add(A,B)        _mm_add_epi16(A,B)
+    #define PLANK_SIMDS_Sub(A,B)        _mm_sub_epi16(A,B)
+#elif PLANK_VSIMD_NEON
+    #define PLANK_SIMDI_LENGTH  4   // vector 4 ints
+    #define PLANK_SIMDI_SIZE   16
+    #define PLANK_SIMDI_SHIFT   2   // divide by 4 for length
+    #define PLANK_SIMDI_MASK    3   // remainder mask for non-multiples of 4
+    typedef int32x4_t PlankVI;
+
+    #define PLANK_SIMDS_LENGTH  8   // vector 8 shorts
+    #define PLANK_SIMDS_SIZE   16
+    #define PLANK_SIMDS_SHIFT   3   // divide by 8 for length
+    #define PLANK_SIMDS_MASK    7   // remainder mask for non-multiples of 8
+    typedef int16x8_t PlankVS;
+
+    #define PLANK_SIMDI_Load(P)         vld1q_s32(P)
+    #define PLANK_SIMDI_Store(P,A)      vst1q_s32(P,A)
+    #define PLANK_SIMDI_Set(A)          vdupq_n_s32(A)
+    #define PLANK_SIMDI_Add(A,B)        vaddq_s32(A,B)
+    #define PLANK_SIMDI_Sub(A,B)        vsubq_s32(A,B)
+
+    #define PLANK_SIMDS_Load(P)         vld1q_s16(P)
+    #define PLANK_SIMDS_Store(P,A)      vst1q_s16(P,A)
+    #define PLANK_SIMDS_Set(A)          vdupq_n_s16(A)
+    #define PLANK_SIMDS_Add(A,B)        vaddq_s16(A,B)
+    #define PLANK_SIMDS_Sub(A,B)        vsubq_s16(A,B)
+#endif
+
+// no 64-bit int SIMD here
+#define PLANK_SIMDLL_LENGTH  1   // vector 1 LongLong
+#define PLANK_SIMDLL_SIZE    8
+#define PLANK_SIMDLL_SHIFT   0   // no shift
+#define PLANK_SIMDLL_MASK    0   // no remainder
+typedef PlankLL PlankVLL;
+
+//------------------------------- operations -----------------------------------
+
+// these mirror the scalar pl_XXX() functions in plank_Maths.h, TYPECODE is F, D, I or S
+#define PLANK_VSIMD_Move(TYPECODE,A)                    (A)
+#define PLANK_VSIMD_Inc(TYPECODE,A)                     PLANK_SIMD##TYPECODE##_Add(A,PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_Dec(TYPECODE,A)                     PLANK_SIMD##TYPECODE##_Sub(A,PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_Neg(TYPECODE,A)                     PLANK_SIMD##TYPECODE##_Neg(A)
+#define PLANK_VSIMD_Abs(TYPECODE,A)                     PLANK_SIMD##TYPECODE##_Abs(A)
+#define PLANK_VSIMD_Squared(TYPECODE,A)                 PLANK_SIMD##TYPECODE##_Mul(A,A)
+#define PLANK_VSIMD_Cubed(TYPECODE,A)                   PLANK_SIMD##TYPECODE##_Mul(PLANK_SIMD##TYPECODE##_Mul(A,A),A)
+#define PLANK_VSIMD_Reciprocal(TYPECODE,A)              PLANK_SIMD##TYPECODE##_Div(PLANK_SIMD##TYPECODE##_Set(1),A)
+#define PLANK_VSIMD_Sqrt(TYPECODE,A)                    PLANK_SIMD##TYPECODE##_Sqrt(A)
+
+#define PLANK_VSIMD_Add(TYPECODE,A,B)                   PLANK_SIMD##TYPECODE##_Add(A,B)
+#define PLANK_VSIMD_Sub(TYPECODE,A,B)                   PLANK_SIMD##TYPECODE##_Sub(A,B)
+#define PLANK_VSIMD_Mul(TYPECODE,A,B)                   PLANK_SIMD##TYPECODE##_Mul(A,B)
+#define PLANK_VSIMD_Div(TYPECODE,A,B)                   PLANK_SIMD##TYPECODE##_Div(A,B)
+#define PLANK_VSIMD_Min(TYPECODE,A,B)                   PLANK_SIMD##TYPECODE##_Min(A,B)
+#define PLANK_VSIMD_Max(TYPECODE,A,B)                   PLANK_SIMD##TYPECODE##_Max(A,B)
+#define PLANK_VSIMD_IsEqualTo(TYPECODE,A,B)             PLANK_SIMD##TYPECODE##_And(PLANK_SIMD##TYPECODE##_CmpEQ(A,B),PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_IsNotEqualTo(TYPECODE,A,B)          PLANK_SIMD##TYPECODE##_And(PLANK_SIMD##TYPECODE##_CmpNE(A,B),PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_IsGreaterThan(TYPECODE,A,B)         PLANK_SIMD##TYPECODE##_And(PLANK_SIMD##TYPECODE##_CmpGT(A,B),PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_IsGreaterThanOrEqualTo(TYPECODE,A,B) PLANK_SIMD##TYPECODE##_And(PLANK_SIMD##TYPECODE##_CmpGE(A,B),PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_IsLessThan(TYPECODE,A,B)            PLANK_SIMD##TYPECODE##_And(PLANK_SIMD##TYPECODE##_CmpLT(A,B),PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_IsLessThanOrEqualTo(TYPECODE,A,B)   PLANK_SIMD##TYPECODE##_And(PLANK_SIMD##TYPECODE##_CmpLE(A,B),PLANK_SIMD##TYPECODE##_Set(1))
+#define PLANK_VSIMD_SumSqr(TYPECODE,A,B)                PLANK_SIMD##TYPECODE##_Add(PLANK_SIMD##TYPECODE##_Mul(A,A),PLANK_SIMD##TYPECODE##_Mul(B,B))
+#define PLANK_VSIMD_DifSqr(TYPECODE,A,B)                PLANK_SIMD##TYPECODE##_Sub(PLANK_SIMD##TYPECODE##_Mul(A,A),PLANK_SIMD##TYPECODE##_Mul(B,B))
+#define PLANK_VSIMD_SqrSum(TYPECODE,A,B)                PLANK_SIMD##TYPECODE##_Mul(PLANK_SIMD##TYPECODE##_Add(A,B),PLANK_SIMD##TYPECODE##_Add(A,B))
+#define PLANK_VSIMD_SqrDif(TYPECODE,A,B)                PLANK_SIMD##TYPECODE##_Mul(PLANK_SIMD##TYPECODE##_Sub(A,B),PLANK_SIMD##TYPECODE##_Sub(A,B))
+#define PLANK_VSIMD_AbsDif(TYPECODE,A,B)                PLANK_SIMD##TYPECODE##_Abs(PLANK_SIMD##TYPECODE##_Sub(A,B))
+#define PLANK_VSIMD_Thresh(TYPECODE,A,B)                PLANK_SIMD##TYPECODE##_AndNot(PLANK_SIMD##TYPECODE##_CmpLT(A,B),A)
+
+//------------------------------- generators -----------------------------------
+
+// loop over the whole vectors then process any remaining items with the scalar function
+
+#define PLANK_VSIMD_UNARYOP_DEFINE(OP,TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORUNARYOP_NAME(OP,TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vA;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vA = PLANK_SIMD##TYPECODE##_Load (a + i);\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_VSIMD_##OP (TYPECODE, vA));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_##OP##TYPECODE (a[i]); }\
+    }
+
+#define PLANK_VSIMD_BINARYOPVECTOR_DEFINE(OP,TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORBINARYOPVECTOR_NAME(OP,TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, const Plank##TYPECODE* b, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vA, vB;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vA = PLANK_SIMD##TYPECODE##_Load (a + i);\
+            vB = PLANK_SIMD##TYPECODE##_Load (b + i);\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_VSIMD_##OP (TYPECODE, vA, vB));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_##OP##TYPECODE (a[i], b[i]); }\
+    }
+
+#define PLANK_VSIMD_BINARYOPSCALAR_DEFINE(OP,TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORBINARYOPSCALAR_NAME(OP,TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, Plank##TYPECODE b, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vA, vB;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vB = PLANK_SIMD##TYPECODE##_Set (b);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vA = PLANK_SIMD##TYPECODE##_Load (a + i);\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_VSIMD_##OP (TYPECODE, vA, vB));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_##OP##TYPECODE (a[i], b); }\
+    }
+
+#define PLANK_VSIMD_SCALARBINARYOPVECTOR_DEFINE(OP,TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_SCALARBINARYOPVECTOR_NAME(OP,TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE a, const Plank##TYPECODE* b, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vA, vB;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vA = PLANK_SIMD##TYPECODE##_Set (a);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vB = PLANK_SIMD##TYPECODE##_Load (b + i);\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_VSIMD_##OP (TYPECODE, vA, vB));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_##OP##TYPECODE (a, b[i]); }\
+    }
+
+#define PLANK_VSIMD_BINARYOP_DEFINE(OP,TYPECODE) \
+    PLANK_VSIMD_BINARYOPVECTOR_DEFINE(OP,TYPECODE)\
+    PLANK_VSIMD_BINARYOPSCALAR_DEFINE(OP,TYPECODE)\
+    PLANK_VSIMD_SCALARBINARYOPVECTOR_DEFINE(OP,TYPECODE)
+
+#define PLANK_VSIMD_FILL_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORFILL_NAME(TYPECODE) (Plank##TYPECODE *result, Plank##TYPECODE value, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vValue;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vValue = PLANK_SIMD##TYPECODE##_Set (value);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) { PLANK_SIMD##TYPECODE##_Store (result + i, vValue); }\
+        for (; i < N; PLANK_INC(i)) { result[i] = value; }\
+    }
+
+#define PLANK_VSIMD_CLEAR_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORCLEAR_NAME(TYPECODE) (Plank##TYPECODE *result, PlankUL N) {\
+        PLANK_VECTORFILL_NAME(TYPECODE) (result, (Plank##TYPECODE)0, N);\
+    }
+
+#define PLANK_VSIMD_MULADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORMULADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PlankUL vN, i;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_SIMD##TYPECODE##_MulAdd (PLANK_SIMD##TYPECODE##_Load (input + i),\
+                                                                                    PLANK_SIMD##TYPECODE##_Load (mul + i),\
+                                                                                    PLANK_SIMD##TYPECODE##_Load (add + i)));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul[i]), add[i]); }\
+    }
+
+#define PLANK_VSIMD_MULADDINPLACE_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORMULADDINPLACE_NAME(TYPECODE) (Plank##TYPECODE *io, const Plank##TYPECODE* mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PLANK_VECTORMULADD_NAME(TYPECODE) (io, io, mul, add, N);\
+    }
+
+#define PLANK_VSIMD_MULSCALARADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORMULSCALARADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, const Plank##TYPECODE* mul, Plank##TYPECODE add, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vAdd;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vAdd = PLANK_SIMD##TYPECODE##_Set (add);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_SIMD##TYPECODE##_MulAdd (PLANK_SIMD##TYPECODE##_Load (input + i),\
+                                                                                    PLANK_SIMD##TYPECODE##_Load (mul + i),\
+                                                                                    vAdd));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul[i]), add); }\
+    }
+
+#define PLANK_VSIMD_SCALARMULSCALARADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORSCALARMULSCALARADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, Plank##TYPECODE add, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vMul, vAdd;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vMul = PLANK_SIMD##TYPECODE##_Set (mul);\
+        vAdd = PLANK_SIMD##TYPECODE##_Set (add);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_SIMD##TYPECODE##_MulAdd (PLANK_SIMD##TYPECODE##_Load (input + i), vMul, vAdd));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul), add); }\
+    }
+
+#define PLANK_VSIMD_SCALARMULADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORSCALARMULADD_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* input, Plank##TYPECODE mul, const Plank##TYPECODE* add, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vMul;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vMul = PLANK_SIMD##TYPECODE##_Set (mul);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            PLANK_SIMD##TYPECODE##_Store (result + i, PLANK_SIMD##TYPECODE##_MulAdd (PLANK_SIMD##TYPECODE##_Load (input + i),\
+                                                                                    vMul,\
+                                                                                    PLANK_SIMD##TYPECODE##_Load (add + i)));\
+        }\
+        for (; i < N; PLANK_INC(i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul), add[i]); }\
+    }
+
+// horizontal sum of the lanes in a vector
+#define PLANK_VSIMD_SUM_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID Plank##TYPECODE pl_VSIMDSum##TYPECODE (PlankV##TYPECODE v) {\
+        PLANK_ALIGN(PLANK_SIMD##TYPECODE##_SIZE) Plank##TYPECODE temp[PLANK_SIMD##TYPECODE##_LENGTH];\
+        Plank##TYPECODE sum; PlankUL i;\
+        PLANK_SIMD##TYPECODE##_Store (temp, v);\
+        sum = temp[0];\
+        for (i = 1; i < PLANK_SIMD##TYPECODE##_LENGTH; PLANK_INC(i)) { sum += temp[i]; }\
+        return sum;\
+    }
+
+#define PLANK_VSIMD_ADDVECTORMUL_DEFINE(TYPECODE)\
+    static PLANK_INLINE_MID void PLANK_VECTORADDVECTORMUL_NAME(TYPECODE) (Plank##TYPECODE *result, const Plank##TYPECODE* a, const Plank##TYPECODE* b, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vSum; Plank##TYPECODE sum;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vSum = PLANK_SIMD##TYPECODE##_Set (0);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vSum = PLANK_SIMD##TYPECODE##_MulAdd (PLANK_SIMD##TYPECODE##_Load (a + i), PLANK_SIMD##TYPECODE##_Load (b + i), vSum);\
+        }\
+        sum = pl_VSIMDSum##TYPECODE (vSum);\
+        for (; i < N; PLANK_INC(i)) { sum = pl_Add##TYPECODE (pl_Mul##TYPECODE (a[i], b[i]), sum); }\
+        *result = sum;\
+    }
+
+#define PLANK_VSIMD_MEAN_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID Plank##TYPECODE PLANK_VECTORMEAN_NAME(TYPECODE) (const Plank##TYPECODE* a, PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vSum; Plank##TYPECODE sum;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        vSum = PLANK_SIMD##TYPECODE##_Set (0);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vSum = PLANK_SIMD##TYPECODE##_Add (vSum, PLANK_SIMD##TYPECODE##_Load (a + i));\
+        }\
+        sum = pl_VSIMDSum##TYPECODE (vSum);\
+        for (; i < N; PLANK_INC(i)) { sum += a[i]; }\
+        return sum / N;\
+    }
+
+#define PLANK_VSIMD_ZMUL_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORZMUL_NAME(TYPECODE) (Plank##TYPECODE *resultReal, Plank##TYPECODE *resultImag,\
+                                                                  const Plank##TYPECODE* leftReal, const Plank##TYPECODE* leftImag,\
+                                                                  const Plank##TYPECODE* rightReal, const Plank##TYPECODE* rightImag,\
+                                                                  PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vLR, vLI, vRR, vRI;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vLR = PLANK_SIMD##TYPECODE##_Load (leftReal + i);\
+            vLI = PLANK_SIMD##TYPECODE##_Load (leftImag + i);\
+            vRR = PLANK_SIMD##TYPECODE##_Load (rightReal + i);\
+            vRI = PLANK_SIMD##TYPECODE##_Load (rightImag + i);\
+            PLANK_SIMD##TYPECODE##_Store (resultReal + i, PLANK_SIMD##TYPECODE##_Sub (PLANK_SIMD##TYPECODE##_Mul (vLR, vRR), PLANK_SIMD##TYPECODE##_Mul (vLI, vRI)));\
+            PLANK_SIMD##TYPECODE##_Store (resultImag + i, PLANK_SIMD##TYPECODE##_Add (PLANK_SIMD##TYPECODE##_Mul (vLR, vRI), PLANK_SIMD##TYPECODE##_Mul (vLI, vRR)));\
+        }\
+        for (; i < N; PLANK_INC(i)) {\
+            const Plank##TYPECODE lr = leftReal[i], li = leftImag[i], rr = rightReal[i], ri = rightImag[i];\
+            resultReal[i] = lr * rr - li * ri;\
+            resultImag[i] = lr * ri + li * rr;\
+        }\
+    }
+
+#define PLANK_VSIMD_ZMULADD_DEFINE(TYPECODE) \
+    static PLANK_INLINE_MID void PLANK_VECTORZMULADD_NAME(TYPECODE) (Plank##TYPECODE *resultReal, Plank##TYPECODE *resultImag,\
+                                                                     const Plank##TYPECODE* inputReal, const Plank##TYPECODE* inputImag,\
+                                                                     const Plank##TYPECODE* mulReal, const Plank##TYPECODE* mulImag,\
+                                                                     const Plank##TYPECODE* addReal, const Plank##TYPECODE* addImag,\
+                                                                     PlankUL N) {\
+        PlankUL vN, i; PlankV##TYPECODE vIR, vII, vMR, vMI;\
+        vN = N & ~((PlankUL)PLANK_SIMD##TYPECODE##_MASK);\
+        for (i = 0; i < vN; i += PLANK_SIMD##TYPECODE##_LENGTH) {\
+            vIR = PLANK_SIMD##TYPECODE##_Load (inputReal + i);\
+            vII = PLANK_SIMD##TYPECODE##_Load (inputImag + i);\
+            vMR = PLANK_SIMD##TYPECODE##_Load (mulReal + i);\
+            vMI = PLANK_SIMD##TYPECODE##_Load (mulImag + i);\
+            PLANK_SIMD##TYPECODE##_Store (resultReal + i, PLANK_SIMD##TYPECODE##_Add (PLANK_SIMD##TYPECODE##_Sub (PLANK_SIMD##TYPECODE##_Mul (vIR, vMR), PLANK_SIMD##TYPECODE##_Mul (vII, vMI)),\
+                                                                                      PLANK_SIMD##TYPECODE##_Load (addReal + i)));\
+            PLANK_SIMD##TYPECODE##_Store (resultImag + i, PLANK_SIMD##TYPECODE##_Add (PLANK_SIMD##TYPECODE##_Add (PLANK_SIMD##TYPECODE##_Mul (vIR, vMI), PLANK_SIMD##TYPECODE##_Mul (vII, vMR)),\
+                                                                                      PLANK_SIMD##TYPECODE##_Load (addImag + i)));\
+        }\
+        for (; i < N; PLANK_INC(i)) {\
+            const Plank##TYPECODE ir = inputReal[i], ii = inputImag[i], mr = mulReal[i], mi = mulImag[i];\
+            resultReal[i] = ir * mr - ii * mi + addReal[i];\
+            resultImag[i] = ir * mi + ii * mr + addImag[i];\
+        }\
+    }
+
+// float and double
+#define PLANK_VSIMD_OPS_ALL(TYPECODE)\
+    PLANK_VSIMD_SUM_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_FILL_DEFINE(TYPECODE)\
+    PLANK_VSIMD_CLEAR_DEFINE(TYPECODE)\
+    PLANK_VECTORRAMP_DEFINE(TYPECODE)\
+    PLANK_VECTORRAMPMUL_DEFINE(TYPECODE)\
+    PLANK_VECTORLINE_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_UNARYOP_DEFINE(Move,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Inc,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Dec,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Neg,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Abs,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Squared,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Cubed,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sign,TYPECODE)\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(Add,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Sub,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Mul,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Div,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Mod,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Min,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Max,TYPECODE)\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(IsEqualTo,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsNotEqualTo,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsGreaterThan,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsGreaterThanOrEqualTo,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsLessThan,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(IsLessThanOrEqualTo,TYPECODE)\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(SumSqr,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(DifSqr,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(SqrSum,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(SqrDif,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(AbsDif,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Thresh,TYPECODE)\
+    \
+    PLANK_VSIMD_MULADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_MULADDINPLACE_DEFINE(TYPECODE)\
+    PLANK_VSIMD_MULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_SCALARMULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_SCALARMULADD_DEFINE(TYPECODE)\
+    PLANK_VSIMD_ADDVECTORMUL_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORLOOKUP_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_MEAN_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORUNARYOP_DEFINE(Log2,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Reciprocal,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sin,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Cos,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Tan,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Asin,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Acos,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Atan,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sinh,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Cosh,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Tanh,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Sqrt,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Log,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Log10,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Exp,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Ceil,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Floor,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Frac,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(M2F,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(F2M,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(A2dB,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(dB2A,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(D2R,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(R2D,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Distort,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Zap,TYPECODE)\
+    \
+    PLANK_VECTORBINARYOP_DEFINE(Pow,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Hypot,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Atan2,TYPECODE)\
+    \
+    PLANK_VSIMD_ZMUL_DEFINE(TYPECODE)\
+    PLANK_VSIMD_ZMULADD_DEFINE(TYPECODE)
+
+// int and short: only the moves and add/sub are vectorised
+#define PLANK_VSIMD_OPS_COMMON(TYPECODE)\
+    PLANK_VSIMD_FILL_DEFINE(TYPECODE)\
+    PLANK_VSIMD_CLEAR_DEFINE(TYPECODE)\
+    PLANK_VECTORRAMP_DEFINE(TYPECODE)\
+    PLANK_VECTORRAMPMUL_DEFINE(TYPECODE)\
+    PLANK_VECTORLINE_DEFINE(TYPECODE)\
+    \
+    PLANK_VSIMD_UNARYOP_DEFINE(Move,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Inc,TYPECODE)\
+    PLANK_VSIMD_UNARYOP_DEFINE(Dec,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Neg,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Abs,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Squared,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Cubed,TYPECODE)\
+    PLANK_VECTORUNARYOP_DEFINE(Sign,TYPECODE)\
+    \
+    PLANK_VSIMD_BINARYOP_DEFINE(Add,TYPECODE)\
+    PLANK_VSIMD_BINARYOP_DEFINE(Sub,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Mul,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Div,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Mod,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Min,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Max,TYPECODE)\
+    \
+    PLANK_VECTORBINARYOP_DEFINE(IsEqualTo,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsNotEqualTo,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsGreaterThan,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsGreaterThanOrEqualTo,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsLessThan,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(IsLessThanOrEqualTo,TYPECODE)\
+    \
+    PLANK_VECTORBINARYOP_DEFINE(SumSqr,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(DifSqr,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(SqrSum,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(SqrDif,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(AbsDif,TYPECODE)\
+    PLANK_VECTORBINARYOP_DEFINE(Thresh,TYPECODE)\
+    \
+    PLANK_VECTORMULADD_DEFINE(TYPECODE)\
+    PLANK_VECTORMULADDINPLACE_DEFINE(TYPECODE)\
+    PLANK_VECTORMULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VECTORSCALARMULSCALARADD_DEFINE(TYPECODE)\
+    PLANK_VECTORSCALARMULADD_DEFINE(TYPECODE)\
+    PLANK_VECTORADDVECTORMUL_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORLOOKUP_DEFINE(TYPECODE)\
+    \
+    PLANK_VECTORMEAN_DEFINE(TYPECODE)
+
+
+//------------------------------- float ----------------------------------------
+
+PLANK_VSIMD_OPS_ALL(F)
+
+static PLANK_INLINE_MID void pl_VectorInterleave2F_Nnn (float *result, const float *splitA, const float *splitB, PlankUL n)
+{
+    PlankUL vN, i;
+    
+    vN = n & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4, result += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 a = _mm_loadu_ps (splitA + i);
+        const __m128 b = _mm_loadu_ps (splitB + i);
+        _mm_storeu_ps (result,     _mm_unpacklo_ps (a, b));
+        _mm_storeu_ps (result + 4, _mm_unpackhi_ps (a, b));
+#elif PLANK_VSIMD_NEON
+        float32x4x2_t ab;
+        ab.val[0] = vld1q_f32 (splitA + i);
+        ab.val[1] = vld1q_f32 (splitB + i);
+        vst2q_f32 (result, ab);
+#endif
+    }
+    
+    for (; i < n; ++i)
+    {
+        *result++ = splitA[i];
+        *result++ = splitB[i];
+    }
+}
+
+static PLANK_INLINE_MID void pl_VectorDeinterleave2F_nnN (float *resultA, float *resultB, const float *input, PlankUL n)
+{
+    PlankUL vN, i;
+    
+    vN = n & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4, input += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 x = _mm_loadu_ps (input);
+        const __m128 y = _mm_loadu_ps (input + 4);
+        _mm_storeu_ps (resultA + i, _mm_shuffle_ps (x, y, _MM_SHUFFLE (2, 0, 2, 0)));
+        _mm_storeu_ps (resultB + i, _mm_shuffle_ps (x, y, _MM_SHUFFLE (3, 1, 3, 1)));
+#elif PLANK_VSIMD_NEON
+        const float32x4x2_t ab = vld2q_f32 (input);
+        vst1q_f32 (resultA + i, ab.val[0]);
+        vst1q_f32 (resultB + i, ab.val[1]);
+#endif
+    }
+    
+    for (; i < n; ++i)
+    {
+        resultA[i] = *input++;
+        resultB[i] = *input++;
+    }
+}
+
+//------------------------------- double ---------------------------------------
+
+PLANK_VSIMD_OPS_ALL(D)
+
+static PLANK_INLINE_MID void pl_VectorInterleave2D_Nnn (double *result, const double *splitA, const double *splitB, PlankUL n)
+{
+    PlankUL vN, i;
+    
+    vN = n & ~((PlankUL)1);
+    
+    for (i = 0; i < vN; i += 2, result += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128d a = _mm_loadu_pd (splitA + i);
+        const __m128d b = _mm_loadu_pd (splitB + i);
+        _mm_storeu_pd (result,     _mm_unpacklo_pd (a, b));
+        _mm_storeu_pd (result + 2, _mm_unpackhi_pd (a, b));
+#elif PLANK_VSIMD_NEON
+        float64x2x2_t ab;
+        ab.val[0] = vld1q_f64 (splitA + i);
+        ab.val[1] = vld1q_f64 (splitB + i);
+        vst2q_f64 (result, ab);
+#endif
+    }
+    
+    for (; i < n; ++i)
+    {
+        *result++ = splitA[i];
+        *result++ = splitB[i];
+    }
+}
+
+static PLANK_INLINE_MID void pl_VectorDeinterleave2D_nnN (double *resultA, double *resultB, const double *input, PlankUL n)
+{
+    PlankUL vN, i;
+    
+    vN = n & ~((PlankUL)1);
+    
+    for (i = 0; i < vN; i += 2, input += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128d x = _mm_loadu_pd (input);
+        const __m128d y = _mm_loadu_pd (input + 2);
+        _mm_storeu_pd (resultA + i, _mm_unpacklo_pd (x, y));
+        _mm_storeu_pd (resultB + i, _mm_unpackhi_pd (x, y));
+#elif PLANK_VSIMD_NEON
+        const float64x2x2_t ab = vld2q_f64 (input);
+        vst1q_f64 (resultA + i, ab.val[0]);
+        vst1q_f64 (resultB + i, ab.val[1]);
+#endif
+    }
+    
+    for (; i < n; ++i)
+    {
+        resultA[i] = *input++;
+        resultB[i] = *input++;
+    }
+}
+
+//------------------------------- conversions ----------------------------------
+
+// these use 128-bit registers on all targets since the source and destination widths differ
+
+static PLANK_INLINE_MID void pl_VectorConvertD2F_NN (float *result, const double* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 lo = _mm_cvtpd_ps (_mm_loadu_pd (a + i));
+        const __m128 hi = _mm_cvtpd_ps (_mm_loadu_pd (a + i + 2));
+        _mm_storeu_ps (result + i, _mm_movelh_ps (lo, hi));
+#elif PLANK_VSIMD_NEON
+        const float32x2_t lo = vcvt_f32_f64 (vld1q_f64 (a + i));
+        vst1q_f32 (result + i, vcvt_high_f32_f64 (lo, vld1q_f64 (a + i + 2)));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (float)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertF2D_NN (double *result, const float* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128 x = _mm_loadu_ps (a + i);
+        _mm_storeu_pd (result + i,     _mm_cvtps_pd (x));
+        _mm_storeu_pd (result + i + 2, _mm_cvtps_pd (_mm_movehl_ps (x, x)));
+#elif PLANK_VSIMD_NEON
+        const float32x4_t x = vld1q_f32 (a + i);
+        vst1q_f64 (result + i,     vcvt_f64_f32 (vget_low_f32 (x)));
+        vst1q_f64 (result + i + 2, vcvt_high_f64_f32 (x));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (double)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertI2F_NN (float *result, const int* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storeu_ps (result + i, _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*)(a + i))));
+#elif PLANK_VSIMD_NEON
+        vst1q_f32 (result + i, vcvtq_f32_s32 (vld1q_s32 (a + i)));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (float)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertF2I_NN (int *result, const float* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4)
+    {
+#if PLANK_VSIMD_X86
+        _mm_storeu_si128 ((__m128i*)(result + i), _mm_cvttps_epi32 (_mm_loadu_ps (a + i)));
+#elif PLANK_VSIMD_NEON
+        vst1q_s32 (result + i, vcvtq_s32_f32 (vld1q_f32 (a + i)));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (int)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertS2F_NN (float *result, const short* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)7);
+    
+    for (i = 0; i < vN; i += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i x = _mm_loadu_si128 ((const __m128i*)(a + i));
+        _mm_storeu_ps (result + i,     _mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (x, x), 16)));
+        _mm_storeu_ps (result + i + 4, _mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpackhi_epi16 (x, x), 16)));
+#elif PLANK_VSIMD_NEON
+        const int16x8_t x = vld1q_s16 (a + i);
+        vst1q_f32 (result + i,     vcvtq_f32_s32 (vmovl_s16 (vget_low_s16 (x))));
+        vst1q_f32 (result + i + 4, vcvtq_f32_s32 (vmovl_high_s16 (x)));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (float)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertF2S_NN (short *result, const float* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)7);
+    
+    for (i = 0; i < vN; i += 8)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i lo = _mm_cvttps_epi32 (_mm_loadu_ps (a + i));
+        const __m128i hi = _mm_cvttps_epi32 (_mm_loadu_ps (a + i + 4));
+        _mm_storeu_si128 ((__m128i*)(result + i), _mm_packs_epi32 (lo, hi));
+#elif PLANK_VSIMD_NEON
+        const int16x4_t lo = vqmovn_s32 (vcvtq_s32_f32 (vld1q_f32 (a + i)));
+        vst1q_s16 (result + i, vqmovn_high_s32 (lo, vcvtq_s32_f32 (vld1q_f32 (a + i + 4))));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (short)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertI2D_NN (double *result, const int* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i x = _mm_loadu_si128 ((const __m128i*)(a + i));
+        _mm_storeu_pd (result + i,     _mm_cvtepi32_pd (x));
+        _mm_storeu_pd (result + i + 2, _mm_cvtepi32_pd (_mm_unpackhi_epi64 (x, x)));
+#elif PLANK_VSIMD_NEON
+        const int32x4_t x = vld1q_s32 (a + i);
+        vst1q_f64 (result + i,     vcvtq_f64_s64 (vmovl_s32 (vget_low_s32 (x))));
+        vst1q_f64 (result + i + 2, vcvtq_f64_s64 (vmovl_high_s32 (x)));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (double)a[i];
+}
+
+static PLANK_INLINE_MID void pl_VectorConvertD2I_NN (int *result, const double* a, PlankUL N)
+{
+    PlankUL vN, i;
+    
+    vN = N & ~((PlankUL)3);
+    
+    for (i = 0; i < vN; i += 4)
+    {
+#if PLANK_VSIMD_X86
+        const __m128i lo = _mm_cvttpd_epi32 (_mm_loadu_pd (a + i));
+        const __m128i hi = _mm_cvttpd_epi32 (_mm_loadu_pd (a + i + 2));
+        _mm_storeu_si128 ((__m128i*)(result + i), _mm_unpacklo_epi64 (lo, hi));
+#elif PLANK_VSIMD_NEON
+        const int32x2_t lo = vmovn_s64 (vcvtq_s64_f64 (vld1q_f64 (a + i)));
+        vst1q_s32 (result + i, vmovn_high_s64 (lo, vcvtq_s64_f64 (vld1q_f64 (a + i + 2))));
+#endif
+    }
+    
+    for (; i < N; ++i)
+        result[i] = (int)a[i];
+}
+
+PLANK_VECTORCONVERT_DEFINE(C,F)
+PLANK_VECTORCONVERT_DEFINE(C,D)
+PLANK_VECTORCONVERT_DEFINE(C,I)
+PLANK_VECTORCONVERT_DEFINE(C,S)
+
+PLANK_VECTORCONVERT_DEFINE(I,C)
+PLANK_VECTORCONVERT_DEFINE(I,S)
+
+PLANK_VECTORCONVERT_DEFINE(S,C)
+PLANK_VECTORCONVERT_DEFINE(S,I)
+PLANK_VECTORCONVERT_DEFINE(S,D)
+
+PLANK_VECTORCONVERT_DEFINE(F,C)
+PLANK_VECTORCONVERT_DEFINE(D,C)
+PLANK_VECTORCONVERT_DEFINE(D,S)
+
+PLANK_VECTORCONVERT_DEFINE(LL,C)
+PLANK_VECTORCONVERT_DEFINE(LL,I)
+PLANK_VECTORCONVERT_DEFINE(LL,S)
+PLANK_VECTORCONVERT_DEFINE(LL,F)
+PLANK_VECTORCONVERT_DEFINE(LL,D)
+PLANK_VECTORCONVERT_DEFINE(C,LL)
+PLANK_VECTORCONVERT_DEFINE(I,LL)
+PLANK_VECTORCONVERT_DEFINE(S,LL)
+PLANK_VECTORCONVERT_DEFINE(F,LL)
+PLANK_VECTORCONVERT_DEFINE(D,LL)
+
+PLANK_VECTORCONVERTROUNDF_DEFINE(C)
+PLANK_VECTORCONVERTROUNDF_DEFINE(I)
+PLANK_VECTORCONVERTROUNDF_DEFINE(S)
+PLANK_VECTORCONVERTROUNDF_DEFINE(LL)
+PLANK_VECTORCONVERTROUNDD_DEFINE(C)
+PLANK_VECTORCONVERTROUNDD_DEFINE(I)
+PLANK_VECTORCONVERTROUNDD_DEFINE(S)
+PLANK_VECTORCONVERTROUNDD_DEFINE(LL)
+
+//------------------------------- short ----------------------------------------
+
+PLANK_VSIMD_OPS_COMMON(S)
+
+//------------------------------- int ------------------------------------------
+
+PLANK_VSIMD_OPS_COMMON(I)
+
+//------------------------------- longlong -------------------------------------
+
+PLANK_VECTOR_OPS_COMMON(LL)
+
+
+#endif // !DOXYGEN
+#endif // PLANK_VSIMD_H
@@ -69,6 +69,7 @@
 #include "containers/plank_DynamicArray.h"
 #include "containers/plank_LockFreeDynamicArray.h"
 #include "containers/plank_LockFreeQueue.h"
+#include "containers/plank_RingBuffer.h"
 #include "containers/plank_LockFreeStack.h"
 #include "containers/plank_SimpleQueue.h"
 #include "containers/plank_SimpleStack.h"
@@ -79,6 +80,7 @@
 
 #include "maths/plank_Maths.h"
 #include "maths/vectors/plank_Vectors.h"
+#include "maths/vectors/plank_VectorDispatch.h"
 
 #include "misc/nn/plank_NeuralNode.h"
 #include "misc/nn/plank_NeuralLayer.h"
@@ -59,7 +59,7 @@
         output = pp->buffers[0].buffer;\
         left = pp->buffers[1].buffer;\
         right = pp->buffers[2].buffer;\
-        PLANK_VECTORBINARYOPVECTOR_NAME(OPNAME,TYPECODE) (output, left, right, N);\
+        PLANK_VECTORDISPATCH_BINARYOPVECTOR(OPNAME,TYPECODE) (output, left, right, N);\
     }
 
 #define PLINK_BINARYOPPROCESS_DEFINE_NN1(OPNAME, TYPECODE)\
@@ -72,7 +72,7 @@
         output = pp->buffers[0].buffer;\
         left = pp->buffers[1].buffer;\
         right = pp->buffers[2].buffer[0];\
-        PLANK_VECTORBINARYOPSCALAR_NAME(OPNAME,TYPECODE) (output, left, right, N);\
+        PLANK_VECTORDISPATCH_BINARYOPSCALAR(OPNAME,TYPECODE) (output, left, right, N);\
     }
 
 #define PLINK_BINARYOPPROCESS_DEFINE_N1N(OPNAME, TYPECODE)\
@@ -85,7 +85,7 @@
         output = pp->buffers[0].buffer;\
         left = pp->buffers[1].buffer[0];\
         right = pp->buffers[2].buffer;\
-        PLANK_SCALARBINARYOPVECTOR_NAME(OPNAME,TYPECODE) (output, left, right, N);\
+        PLANK_VECTORDISPATCH_SCALARBINARYOPVECTOR(OPNAME,TYPECODE) (output, left, right, N);\
     }
 
 #define PLINK_BINARYOPPROCESS_DEFINE_N11(OPNAME, TYPECODE)\
@@ -99,7 +99,7 @@
         left = pp->buffers[1].buffer[0];\
         right = pp->buffers[2].buffer[0];\
         value = pl_##OPNAME##TYPECODE (left, right);\
-        PLANK_VECTORFILL_NAME(TYPECODE) (output, value, N);\
+        PLANK_VECTORDISPATCH_FILL(TYPECODE) (output, value, N);\
     }
 
 #define PLINK_BINARYOPPROCESS_DEFINE_NNn(OPNAME, TYPECODE)\
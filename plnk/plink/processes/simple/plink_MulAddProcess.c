@@ -54,7 +54,7 @@ void plink_MulAddProcessF_NNNN (void* ppv, MulAddProcessState* state)
     mul    = pp->buffers[2].buffer;
     add    = pp->buffers[3].buffer;
     
-    pl_VectorMulAddF_NNNN (output, input, mul, add, N);
+    pl_VectorDispatchGlobal()->MulAddF_NNNN (output, input, mul, add, N);
 }
 
 void plink_MulAddProcessF_NN11 (void* ppv, MulAddProcessState* state)
@@ -73,7 +73,7 @@ void plink_MulAddProcessF_NN11 (void* ppv, MulAddProcessState* state)
     mul    = pp->buffers[2].buffer[0];
     add    = pp->buffers[3].buffer[0];
             
-    pl_VectorMulAddF_NN11(output, input, mul, add, N);
+    pl_VectorDispatchGlobal()->MulAddF_NN11 (output, input, mul, add, N);
 }
 
 void plink_MulAddProcessF_NNN1 (void* ppv, MulAddProcessState* state)
@@ -92,7 +92,7 @@ void plink_MulAddProcessF_NNN1 (void* ppv, MulAddProcessState* state)
     mul    = pp->buffers[2].buffer;
     add    = pp->buffers[3].buffer[0];
         
-    pl_VectorMulAddF_NNN1 (output, input, mul, add, N);
+    pl_VectorDispatchGlobal()->MulAddF_NNN1 (output, input, mul, add, N);
 }
 
 void plink_MulAddProcessF_NN1N (void* ppv, MulAddProcessState* state)
@@ -111,7 +111,7 @@ void plink_MulAddProcessF_NN1N (void* ppv, MulAddProcessState* state)
     mul    = pp->buffers[2].buffer[0];
     add    = pp->buffers[3].buffer;
         
-    pl_VectorMulAddF_NN1N (output, input, mul, add, N);
+    pl_VectorDispatchGlobal()->MulAddF_NN1N (output, input, mul, add, N);
 }
 
 void plink_MulAddProcessF_Nnnn (void* ppv, MulAddProcessState* state)
@@ -57,7 +57,7 @@
         N = pp->buffers[0].bufferSize;\
         output = pp->buffers[0].buffer;\
         input = pp->buffers[1].buffer;\
-        PLANK_VECTORUNARYOP_NAME(OPNAME,TYPECODE) (output, input, N);\
+        PLANK_VECTORDISPATCH_UNARYOP(OPNAME,TYPECODE) (output, input, N);\
     }
 
 #define PLINK_UNARYOPPROCESS_DEFINE_N1(OPNAME, TYPECODE)\
@@ -68,7 +68,7 @@
         N = pp->buffers[0].bufferSize;\
         output = pp->buffers[0].buffer;\
         value = pl_##OPNAME##TYPECODE (pp->buffers[1].buffer[0]);\
-        PLANK_VECTORFILL_NAME(TYPECODE) (output, value, N);\
+        PLANK_VECTORDISPATCH_FILL(TYPECODE) (output, value, N);\
     }
 
 #define PLINK_UNARYOPPROCESS_DEFINE_Nn(OPNAME, TYPECODE)\
@@ -47,6 +47,18 @@ public:
     {
         pl_AtomicMemoryBarrier();
     }
+    
+    /** Reads and writes after this can't be moved before any read before it. */
+    PLONK_INLINE_MID static void memoryBarrierAcquire() throw()
+    {
+        pl_AtomicMemoryBarrierAcquire();
+    }
+    
+    /** Reads and writes before this can't be moved after any write after it. */
+    PLONK_INLINE_MID static void memoryBarrierRelease() throw()
+    {
+        pl_AtomicMemoryBarrierRelease();
+    }
 };
 
 template<class Type>
@@ -148,6 +160,8 @@ class AtomicExtended : public AtomicBase<Type>
         PLONK_INLINE_MID void setValue (const Plank##TYPECODE other) throw() { pl_Atomic##FUNCCODE##_Set (getAtomicRef(), other); }\
         PLONK_INLINE_MID Plank##TYPECODE getValue() const throw() { return pl_Atomic##FUNCCODE##_Get (getAtomicRef()); }\
         PLONK_INLINE_MID Plank##TYPECODE getValueUnchecked() const throw() { return pl_Atomic##FUNCCODE##_GetUnchecked (getAtomicRef()); }\
+        PLONK_INLINE_MID Plank##TYPECODE getValueAcquire() const throw() { return pl_Atomic##FUNCCODE##_GetAcquire (getAtomicRef()); }\
+        PLONK_INLINE_MID void setValueRelease (const Plank##TYPECODE other) throw() { pl_Atomic##FUNCCODE##_SetRelease (getAtomicRef(), other); }\
         \
         template<class OtherType> operator OtherType () const throw() { return static_cast<OtherType> (pl_Atomic##FUNCCODE##_Get (getAtomicRef())); }\
         PLONK_INLINE_MID operator Plank##TYPECODE () const throw() { return pl_Atomic##FUNCCODE##_Get (getAtomicRef()); }\
@@ -299,6 +313,8 @@ public:
 
     PLONK_INLINE_MID Type* getValueUnchecked() const throw()          { return static_cast<Type*> (pl_AtomicP_GetUnchecked (getAtomicRef())); }
     PLONK_INLINE_MID Type* getPtrUnchecked() const throw()            { return static_cast<Type*> (pl_AtomicP_GetUnchecked (getAtomicRef())); }
+    PLONK_INLINE_MID Type* getPtrAcquire() const throw()              { return static_cast<Type*> (pl_AtomicP_GetAcquire (getAtomicRef())); }
+    PLONK_INLINE_MID void setPtrRelease (Type* other) throw()         { pl_AtomicP_SetRelease (getAtomicRef(), static_cast<void*> (other)); }
     PLONK_INLINE_MID Long getExtra() const throw()                    { return pl_AtomicP_GetExtra (getAtomicRef()); }
     PLONK_INLINE_MID Long getExtraUnchecked() const throw()           { return pl_AtomicP_GetExtraUnchecked (getAtomicRef()); }
 
@@ -446,6 +462,8 @@ public:
     
     PLONK_INLINE_MID void* getValueUnchecked() const throw()          { return pl_AtomicP_GetUnchecked (getAtomicRef()); }
     PLONK_INLINE_MID void* getPtrUnchecked() const throw()            { return pl_AtomicP_GetUnchecked (getAtomicRef()); }
+    PLONK_INLINE_MID void* getPtrAcquire() const throw()              { return pl_AtomicP_GetAcquire (getAtomicRef()); }
+    PLONK_INLINE_MID void setPtrRelease (void* other) throw()         { pl_AtomicP_SetRelease (getAtomicRef(), other); }
     PLONK_INLINE_MID UnsignedLong getExtra() const throw()                    { return pl_AtomicP_GetExtra (getAtomicRef()); }
     PLONK_INLINE_MID UnsignedLong getExtraUnchecked() const throw()           { return pl_AtomicP_GetExtraUnchecked (getAtomicRef()); }
     
@@ -628,6 +646,20 @@ public:
         return pl_AtomicPX_CompareAndSwap (getAtomicRef(), this->getValueUnchecked(), this->getExtraUnchecked(), newValue, newExtra);
     }
     
+    /** As compareAndSwap() but without ordering any other reads or writes. */
+    PLONK_INLINE_MID bool compareAndSwapRelaxed (Type* const oldValue, const UnsignedLong oldExtra, Type* const newValue, const UnsignedLong newExtra) throw()
+    {
+        plonk_assert (ptrUsesValidBits (newValue));
+        return pl_AtomicPX_CompareAndSwapRelaxed (getAtomicRef(), oldValue, oldExtra, newValue, newExtra);
+    }
+    
+    /** As compareAndSwap() but only stopping earlier reads and writes moving after it. */
+    PLONK_INLINE_MID bool compareAndSwapRelease (Type* const oldValue, const UnsignedLong oldExtra, Type* const newValue, const UnsignedLong newExtra) throw()
+    {
+        plonk_assert (ptrUsesValidBits (newValue));
+        return pl_AtomicPX_CompareAndSwapRelease (getAtomicRef(), oldValue, oldExtra, newValue, newExtra);
+    }
+    
     PLONK_INLINE_MID Type* swap (Type* const newValue) throw() 
     {
         plonk_assert (ptrUsesValidBits (newValue));
@@ -70,6 +70,8 @@ template<class ValueType>                                                   clas
 
 template<class ValueType>                                                   class LockFreeQueue;
 template<class ValueType>                                                   class LockFreeStack;
+template<class ValueType>                                                   class RingBufferInternal;
+template<class ValueType>                                                   class RingBuffer;
 
 template<class ValueType>                                                   class SimpleQueue;
 template<class ValueType>                                                   class SimpleStack;
@@ -81,6 +83,8 @@ template<class SampleType>                                                  clas
 template<class SampleType>                                                  class BreakpointsInternal;
 template<class SampleType>                                                  class BreakpointsBase;
 template<class SampleType>                                                  class WavetableBase;
+template<class SampleType>                                                  class WavetableBankInternal;
+template<class SampleType>                                                  class WavetableBankBase;
 template<class SampleType>                                                  class SignalBase;
 template<class SampleType>                                                  class FFTBuffersBase;
 
@@ -222,6 +226,10 @@ typedef WavetableBase<Int24>                 Int24Wavetable;
 typedef WavetableBase<Long>                  LongWavetable;
 typedef WavetableBase<PLONK_TYPE_DEFAULT>    Wavetable;
 
+typedef WavetableBankBase<Float>                 FloatWavetableBank;
+typedef WavetableBankBase<Double>                DoubleWavetableBank;
+typedef WavetableBankBase<PLONK_TYPE_DEFAULT>    WavetableBank;
+
 typedef SignalBase<Float>                 FloatSignal;
 typedef SignalBase<Double>                DoubleSignal;
 typedef SignalBase<Short>                 ShortSignal;
@@ -44,27 +44,58 @@
 
 #include "../core/plonk_SmartPointer.h"
 #include "../core/plonk_WeakPointer.h"
+#include "plonk_RingBuffer.h"
 
 template<class ValueType>                                               
 class LockFreeQueueInternal : public SmartPointer
 {
 public:
     typedef LockFreeQueue<ValueType>        QueueType;
+    typedef RingBuffer<ValueType>           RingBufferType;
+    typedef RingBufferInternal<ValueType>   RingBufferInternalType;
     
     LockFreeQueueInternal() throw()
+    :   ring (static_cast<RingBufferInternalType*> (0)),
+        held (getNullValue()),
+        hasHeld (false)
     {
         initQueue (liveQueue);
         initQueue (deadQueue);
+        pl_AtomicI_Init (&overflow);
+    }
+    
+    LockFreeQueueInternal (const int capacity, const bool singleProducer) throw()
+    :   ring (capacity, singleProducer),
+        held (getNullValue()),
+        hasHeld (false)
+    {
+        initQueue (liveQueue);
+        initQueue (deadQueue);
+        pl_AtomicI_Init (&overflow);
     }
     
     ~LockFreeQueueInternal()
     {
         deInitQueue (liveQueue);
         deInitQueue (deadQueue);
+        pl_AtomicI_DeInit (&overflow);
     }
     
     PLONK_INLINE_LOW void push (ValueType const& value) throw()
     {
+        RingBufferInternalType* const ringInternal = ring.getInternal();
+        
+        if (ringInternal != 0)
+        {
+            // values only go to the ring while nothing is waiting in the list,
+            // overflowed values are counted before they are linked in so a 
+            // producer never sees the count drop while one of its own is queued
+            if ((pl_AtomicI_Get (&overflow) == 0) && ringInternal->push (value))
+                return;
+            
+            pl_AtomicI_Increment (&overflow);
+        }
+        
         PlankLockFreeQueueElementRef element = createElement (value);
         ResultCode result = pl_LockFreeQueue_Push (&liveQueue, element);
         plonk_assert (result == PlankResult_OK);
@@ -96,6 +127,13 @@ public:
 
     void clear() throw()
     {
+        if (ring.isNotNull())
+        {
+            ValueType tmp (getNullValue());
+            while (popInternal (&tmp) != 0) { }
+            return;
+        }
+        
         ValueType* valuePtr;
         do 
         {
@@ -114,6 +152,14 @@ public:
     
     void clearAll() throw()
     {
+        if (ring.isNotNull())
+        {
+            ring.clear();
+            held = getNullValue();
+            hasHeld = false;
+            pl_AtomicI_Set (&overflow, 0);
+        }
+        
         ResultCode result = pl_LockFreeQueue_Clear (&liveQueue);
         plonk_assert (result == PlankResult_OK);
         
@@ -126,14 +172,28 @@ public:
     
     PLONK_INLINE_LOW int length() throw()
     {
+        // with a ring the overflow count covers the list and the held value, 
+        // hasHeld belongs to the consumer so can't be read here
+        if (ring.isNotNull())
+            return ring.length() + pl_AtomicI_Get (&overflow);
+        
         return pl_LockFreeQueue_GetSize (&liveQueue);
     }
     
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return ring.isNotNull() ? ring.getCapacity() : 0;
+    }
+    
     friend class LockFreeQueue<ValueType>;
     
 private:
     PLONK_ALIGN(16) PlankLockFreeQueue liveQueue;
     PLONK_ALIGN(16) PlankLockFreeQueue deadQueue;
+    RingBufferType ring;
+    ValueType held;
+    bool hasHeld;
+    PlankAtomicI overflow;
     
     static void initQueue (PlankLockFreeQueue& queue) throw()
     {
@@ -198,6 +258,14 @@ private:
     {
         ValueType* valuePtr = 0;
         
+        RingBufferInternalType* const ringInternal = ring.getInternal();
+        
+        if (ringInternal != 0)
+        {
+            plonk_assert (value != 0);
+            return popRing (ringInternal, *value) ? value : 0;
+        }
+        
         PlankLockFreeQueueElementRef element;
         ResultCode result = pl_LockFreeQueue_Pop (&liveQueue, &element);
         plonk_assert (result == PlankResult_OK);
@@ -223,6 +291,61 @@ private:
         return valuePtr;
     }
     
+    bool popRing (RingBufferInternalType* const ringInternal, ValueType& value) throw()
+    {
+        if (ringInternal->pop (value))
+            return true;
+        
+        if (! hasHeld)
+        {
+            if (popInternalList (held) == false)
+                return false;
+            
+            hasHeld = true;
+            
+            // anything now in the ring from the producer of the held value
+            // was pushed before it so that must come out first
+            if (ringInternal->pop (value))
+                return true;
+        }
+        
+        // a multiple producer ring can have slots claimed but not yet written
+        if (ringInternal->length() > 0)
+            return false;
+        
+        value = held;
+        held = getNullValue();
+        hasHeld = false;
+        pl_AtomicI_Decrement (&overflow);
+        
+        return true;
+    }
+    
+    bool popInternalList (ValueType& value) throw()
+    {
+        PlankLockFreeQueueElementRef element;
+        ResultCode result = pl_LockFreeQueue_Pop (&liveQueue, &element);
+        plonk_assert (result == PlankResult_OK);
+        
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+        
+        if (element == 0)
+            return false;
+        
+        ValueType* const valuePtr = static_cast <ValueType*> (pl_LockFreeQueueElement_GetData (element));
+        plonk_assert (valuePtr != 0);
+        
+        value = *valuePtr;
+        *valuePtr = getNullValue();
+        
+        result = pl_LockFreeQueue_Push (&deadQueue, element);
+        plonk_assert (result == PlankResult_OK);
+        
+        return true;
+    }
+    
 };
 
 
@@ -342,6 +465,19 @@ public:
 	{
 	}
     
+    /** Creates a queue that uses a preallocated RingBuffer while it has space.
+     Pushing and popping then need no allocation or double-width atomics. 
+     If the ring fills up values go to the usual linked list until the consumer
+     has caught up, so push() never fails and values from each producer are 
+     still popped in order. 
+     @param capacity        The capacity of the ring, this is rounded up to a power of 2.
+     @param singleProducer  If only one thread at a time will push. Only one 
+                            thread may pop either way. */
+    static LockFreeQueue withCapacity (const int capacity, const bool singleProducer = false) throw()
+    {
+        return LockFreeQueue (new Internal (capacity, singleProducer));
+    }
+    
     /** Get a weakly linked copy of this object. 
      This will return a blank/empty/null object of this type if
      the original has already been deleted. */    
@@ -423,6 +559,12 @@ public:
         return this->getInternal()->length();
     }
     
+    /** The number of slots in the ring or 0 if this doesn't use one. */
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return this->getInternal()->getCapacity();
+    }
+    
     PLONK_OBJECTARROWOPERATOR(LockFreeQueue);
 
 };
@@ -367,14 +367,12 @@ class NumericalArrayConverterBase<float, Int24>
 public:
     static PLONK_INLINE_MID void convertDirect (float* const dst, const Int24* const src, const UnsignedLong numItems) throw()
     {
-        for (UnsignedLong i = 0; i < numItems; ++i)
-            dst[i] = float (src[i]);
+        pl_VectorDecodePCM24F_NN (dst, src, PLANK_BIGENDIAN, 1.0f, numItems);
     }
     
     static PLONK_INLINE_MID void convertScaled (float* const dst, const Int24* const src, const UnsignedLong numItems) throw()
     {
-        convertDirect (dst, src, numItems);
-        pl_VectorMulF_NN1 (dst, dst, 1.0f / PLANK_INT24PEAK_F, numItems);
+        pl_VectorDecodePCM24F_NN (dst, src, PLANK_BIGENDIAN, 1.0f / PLANK_INT24PEAK_F, numItems);
     }    
 };
 
@@ -576,13 +574,12 @@ class NumericalArrayConverterBase<Int24, float>
 public:
     static PLONK_INLINE_MID void convertDirect (Int24* const dst, const float* const src, const UnsignedLong numItems) throw()
     {
-        for (UnsignedLong i = 0; i < numItems; ++i)
-            dst[i] = Int24 (src[i]);
+        pl_VectorEncodePCM24F_NN (dst, src, PLANK_BIGENDIAN, 1.0f, numItems);
     }
     
     static PLONK_INLINE_MID void convertScaled (Int24* const dst, const float* const src, const UnsignedLong numItems) throw()
     {
-        NumericalArrayConverterSIMD<float>::convertScaled (dst, src, numItems);
+        pl_VectorEncodePCM24F_NN (dst, src, PLANK_BIGENDIAN, PLANK_INT24PEAK_F, numItems);
     }    
 };
 
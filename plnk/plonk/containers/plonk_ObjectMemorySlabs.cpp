@@ -0,0 +1,830 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../core/plonk_Headers.h"
+
+/** A free block, the first block in a batch also links to the next batch. */
+class ObjectMemorySlabs::FreeBlock
+{
+public:
+    FreeBlock* next;
+    FreeBlock* nextBatch;
+};
+
+/** The header at the start of each arena, this must fit in ArenaHeaderSize. */
+class ObjectMemorySlabs::Arena
+{
+public:
+    void* raw;
+    Arena* next;
+    int classIndex;
+    UnsignedLong blockSize;
+    UnsignedLong capacity;
+    UnsignedLong numCarved;
+    UnsignedLong numTrimFree;   // only used by the trim thread
+};
+
+class ObjectMemorySlabs::SizeClass
+{
+public:
+    PlankSpinLock lock;
+    FreeBlock* batches;
+    Arena* arenas;              // the head is the arena currently being carved
+    Arena* spare;               // the next arena to carve, allocated in advance
+    UnsignedLong numArenas;
+    AtomicLong numFree;
+    UnsignedLong blockSize;
+    int batchSize;
+};
+
+class ObjectMemorySlabs::ThreadCache
+{
+public:
+    class Bin
+    {
+    public:
+        FreeBlock* head;
+        int count;
+        UnsignedLong numAllocations;
+        UnsignedLong numDeallocations;
+    };
+    
+    PlankSpinLock lock;
+    AtomicLong owner;           // the owner thread ID or 0 if the cache is unused
+    UnsignedLong activity;      // changes whenever the owner uses the cache
+    UnsignedLong lastActivity;  // only used by the trim thread
+    Bin bins[ObjectMemorySlabs::NumClasses];
+};
+
+static void* const registryRemoved = reinterpret_cast<void*> (1);
+
+static PLONK_INLINE_LOW void* staticDoAlloc (void* userData, UnsignedLong requestedSize) throw()
+{    
+    const UnsignedLong align = PLONK_WORDSIZE * 2;
+    const UnsignedLong size = requestedSize + align;
+    UnsignedChar* raw = static_cast<UnsignedChar*> (pl_MemoryDefaultAllocateBytes (userData, size));
+    
+    if (raw == 0)
+        return 0;
+    
+    *reinterpret_cast<UnsignedLong*> (raw) = size;
+    return raw + align;
+}
+
+static PLONK_INLINE_LOW void staticDoFree (void* userData, void* ptr) throw()
+{
+    if (ptr != 0)
+    {
+        const UnsignedLong align = PLONK_WORDSIZE * 2;
+        UnsignedChar* const raw = static_cast<UnsignedChar*> (ptr) - align;
+        pl_MemoryDefaultFree (userData, raw);
+    }
+}
+
+static PLONK_INLINE_LOW int countBlocks (void* head) throw()
+{
+    int count = 0;
+    
+    for (void* block = head; block != 0; block = *static_cast<void**> (block))
+        ++count;
+    
+    return count;
+}
+
+void* ObjectMemorySlabs::staticAlloc (void* userData, UnsignedLong size)
+{
+    ObjectMemorySlabs& om = *static_cast<ObjectMemorySlabs*> (userData);
+    return om.allocateBytes (size);
+}
+
+void ObjectMemorySlabs::staticFree (void* userData, void* ptr)
+{
+    ObjectMemorySlabs& om = *static_cast<ObjectMemorySlabs*> (userData);
+    om.free (ptr);
+}
+
+UnsignedLong ObjectMemorySlabs::getClassSize (const int classIndex) throw()
+{
+    plonk_assert ((classIndex >= 0) && (classIndex < NumClasses));
+    
+    if (classIndex < NumSmallClasses)
+        return (classIndex + 1) * 16;
+    
+    const int group = (classIndex - NumSmallClasses) / NumClassesPerDoubling;
+    const int step = (classIndex - NumSmallClasses) % NumClassesPerDoubling;
+    return UnsignedLong (NumClassesPerDoubling + 1 + step) << (group + 5);
+}
+
+int ObjectMemorySlabs::getClassIndex (const UnsignedLong size) throw()
+{
+    if (size <= (NumSmallClasses * 16))
+        return size > 0 ? int ((size - 1) >> 4) : 0;
+    
+    if (size > MaxClassSize)
+        return -1;
+    
+    // size is in (2**log2, 2**(log2 + 1)] which is split into 4 classes
+    const int log2 = int (Bits::numBitsRequired (size - 1)) - 1;
+    const int shift = log2 - 2;
+    return NumSmallClasses + (log2 - 7) * NumClassesPerDoubling + int ((size - 1) >> shift) - NumClassesPerDoubling;
+}
+
+ObjectMemorySlabs::ObjectMemorySlabs (Memory& m) throw()
+:   ObjectMemoryBase (m),
+    Threading::Thread ("Memory Slab Thread")
+{
+    int i;
+    
+    setPriority (0);
+    
+    getMemory().resetUserData();
+    getMemory().setFunctions (staticDoAlloc, staticDoFree); 
+    
+    AtomicOps::memoryBarrier();
+    
+    classes = new SizeClass[NumClasses];
+    caches = new ThreadCache[MaxThreadCaches];
+    registry = new AtomicValue<void*>[RegistrySize];
+    
+    for (i = 0; i < NumClasses; ++i)
+    {
+        SizeClass& sc = classes[i];
+        pl_SpinLock_Init (&sc.lock);
+        sc.batches = 0;
+        sc.arenas = 0;
+        sc.spare = 0;
+        sc.numArenas = 0;
+        sc.blockSize = getClassSize (i);
+        sc.batchSize = plonk::clip (int (4096 / sc.blockSize), 4, 32);
+    }
+    
+    for (i = 0; i < MaxThreadCaches; ++i)
+    {
+        ThreadCache& cache = caches[i];
+        pl_SpinLock_Init (&cache.lock);
+        cache.activity = 0;
+        cache.lastActivity = 0;
+        Memory::zero (cache.bins, sizeof (cache.bins));
+    }
+    
+    AtomicOps::memoryBarrier();
+    
+    getMemory().setUserData (this);
+    getMemory().setFunctions (staticAlloc, staticFree); 
+}
+
+ObjectMemorySlabs::~ObjectMemorySlabs()
+{
+    setShouldExitAndWait();
+    //<-- something could happen here on another thread but we should be shut down by now..?
+    getMemory().resetUserData();
+    getMemory().setFunctions (staticDoAlloc, staticDoFree); 
+    
+    releaseAll();
+    
+    for (int i = 0; i < NumClasses; ++i)
+        pl_SpinLock_DeInit (&classes[i].lock);
+
+    for (int i = 0; i < MaxThreadCaches; ++i)
+        pl_SpinLock_DeInit (&caches[i].lock);
+    
+    delete [] registry;
+    delete [] caches;
+    delete [] classes;
+}
+
+void* ObjectMemorySlabs::allocateBytes (UnsignedLong requestedSize)
+{
+    const int classIndex = getClassIndex (requestedSize);
+    
+    if (classIndex < 0)
+    {
+        void* const ptr = staticDoAlloc (this, requestedSize);
+        
+        if (ptr != 0)
+        {
+            // tag the spare header word so only blocks counted here are uncounted in free()
+            static_cast<void**> (ptr)[-1] = this;
+            largeBytes += requestedSize + PLONK_WORDSIZE * 2;
+        }
+        
+        return ptr;
+    }
+    
+    ThreadCache* const cache = getThreadCache();
+    FreeBlock* block;
+    
+    if (cache != 0)
+    {
+        ThreadCache::Bin& bin = cache->bins[classIndex];
+        
+        if (bin.head == 0)
+        {
+            bin.head = popBatch (classIndex);
+            bin.count = countBlocks (bin.head);
+        }
+        
+        block = bin.head;
+        
+        if (block != 0)
+        {
+            bin.head = block->next;
+            --bin.count;
+            ++bin.numAllocations;
+        }
+        
+        ++cache->activity;
+        pl_SpinLock_Unlock (&cache->lock);
+    }
+    else
+    {
+        // no cache for this thread so take a batch and return the rest
+        block = popBatch (classIndex);
+        
+        if ((block != 0) && (block->next != 0))
+            pushBatch (classIndex, block->next, countBlocks (block->next));
+    }
+    
+    return block;
+}
+
+void ObjectMemorySlabs::free (void* ptr)
+{
+    if (ptr == 0)
+        return;
+    
+    Arena* const arena = findArena (ptr);
+    
+    if (arena == 0)
+    {
+        const UnsignedLong align = PLONK_WORDSIZE * 2;
+        void** const tag = static_cast<void**> (ptr) - 1;
+        
+        // blocks allocated before this was installed weren't counted
+        if (*tag == this)
+        {
+            *tag = 0;
+            largeBytes -= *reinterpret_cast<UnsignedLong*> (static_cast<UnsignedChar*> (ptr) - align);
+        }
+        
+        staticDoFree (this, ptr);
+        return;
+    }
+    
+    const int classIndex = arena->classIndex;
+    FreeBlock* const block = static_cast<FreeBlock*> (ptr);
+    ThreadCache* const cache = getThreadCache();
+    
+    if (cache != 0)
+    {
+        ThreadCache::Bin& bin = cache->bins[classIndex];
+        const int batchSize = classes[classIndex].batchSize;
+        
+        block->next = bin.head;
+        bin.head = block;
+        ++bin.count;
+        ++bin.numDeallocations;
+        
+        if (bin.count > batchSize * 2)
+            flushCache (cache, classIndex, batchSize);
+        
+        ++cache->activity;
+        pl_SpinLock_Unlock (&cache->lock);
+    }
+    else
+    {
+        block->next = 0;
+        pushBatch (classIndex, block, 1);
+    }
+}
+
+ObjectMemorySlabs::Stats ObjectMemorySlabs::getStats (const int classIndex) const throw()
+{
+    Stats stats;
+    
+    if ((classIndex < 0) || (classIndex >= NumClasses))
+        return stats;
+    
+    SizeClass& sc = classes[classIndex];
+    
+    stats.blockSize = sc.blockSize;
+    stats.numFreeBlocks = sc.numFree.getValue();
+    
+    pl_SpinLock_Lock (&sc.lock);
+    
+    stats.numArenas = sc.numArenas + (sc.spare != 0 ? 1 : 0);
+    
+    for (Arena* arena = sc.arenas; arena != 0; arena = arena->next)
+        stats.numBlocks += arena->numCarved;
+    
+    pl_SpinLock_Unlock (&sc.lock);
+    
+    for (int i = 0; i < MaxThreadCaches; ++i)
+    {
+        stats.numAllocations += caches[i].bins[classIndex].numAllocations;
+        stats.numDeallocations += caches[i].bins[classIndex].numDeallocations;
+    }
+    
+    return stats;
+}
+
+ObjectMemorySlabs::Arena* ObjectMemorySlabs::findArena (void* ptr) const throw()
+{
+    void* const base = reinterpret_cast<void*> (reinterpret_cast<UnsignedLong> (ptr) & ~UnsignedLong (ArenaSize - 1));
+    const UnsignedLong hash = (reinterpret_cast<UnsignedLong> (base) >> ArenaSizeLog2) * 2654435761u;
+    
+    for (int i = 0; i < RegistrySize; ++i)
+    {
+        void* const value = registry[(hash + i) & (RegistrySize - 1)].getValueUnchecked();
+        
+        if (value == base)
+            return static_cast<Arena*> (base);
+        
+        if (value == 0)
+            break;
+    }
+    
+    return 0;
+}
+
+void ObjectMemorySlabs::registerArena (Arena* arena) throw()
+{
+    const UnsignedLong hash = (reinterpret_cast<UnsignedLong> (arena) >> ArenaSizeLog2) * 2654435761u;
+    
+    for (int i = 0; i < RegistrySize; ++i)
+    {
+        AtomicValue<void*>& slot = registry[(hash + i) & (RegistrySize - 1)];
+        void* const value = slot.getValueUnchecked();
+        
+        if (((value == 0) || (value == registryRemoved)) && slot.compareAndSwap (value, arena))
+            return;
+    }
+    
+    plonk_assertfalse; // too many arenas
+}
+
+void ObjectMemorySlabs::unregisterArena (Arena* arena) throw()
+{
+    const UnsignedLong hash = (reinterpret_cast<UnsignedLong> (arena) >> ArenaSizeLog2) * 2654435761u;
+    
+    for (int i = 0; i < RegistrySize; ++i)
+    {
+        AtomicValue<void*>& slot = registry[(hash + i) & (RegistrySize - 1)];
+        
+        if (slot.getValueUnchecked() == arena)
+        {
+            slot.setValue (registryRemoved);
+            return;
+        }
+    }
+    
+    plonk_assertfalse;
+}
+
+ObjectMemorySlabs::Arena* ObjectMemorySlabs::createArena (const int classIndex) throw()
+{
+    // over allocate so the arena can be aligned to its size, the unused pages are never touched
+    void* const raw = pl_MemoryDefaultAllocateBytes (this, ArenaSize * 2);
+    
+    if (raw == 0)
+        return 0;
+    
+    const UnsignedLong base = (reinterpret_cast<UnsignedLong> (raw) + ArenaSize - 1) & ~UnsignedLong (ArenaSize - 1);
+    Arena* const arena = reinterpret_cast<Arena*> (base);
+    
+    arena->raw = raw;
+    arena->next = 0;
+    arena->classIndex = classIndex;
+    arena->blockSize = classes[classIndex].blockSize;
+    arena->capacity = (ArenaSize - ArenaHeaderSize) / arena->blockSize;
+    arena->numCarved = 0;
+    arena->numTrimFree = 0;
+    
+    registerArena (arena);
+    
+    return arena;
+}
+
+void ObjectMemorySlabs::destroyArena (Arena* arena) throw()
+{
+    unregisterArena (arena);
+    pl_MemoryDefaultFree (this, arena->raw);
+}
+
+ObjectMemorySlabs::ThreadCache* ObjectMemorySlabs::getThreadCache() throw()
+{
+    const Long threadID = Long (Threading::getCurrentThreadID());
+    int i;
+    
+    for (i = 0; i < MaxThreadCaches; ++i)
+    {
+        ThreadCache* const cache = &caches[i];
+        
+        if (cache->owner.getValueUnchecked() == threadID)
+        {
+            if (! pl_SpinLock_TryLock (&cache->lock))
+                return 0; // being trimmed
+            
+            if (cache->owner.getValueUnchecked() == threadID)
+                return cache;
+            
+            pl_SpinLock_Unlock (&cache->lock);
+            break;
+        }
+    }
+    
+    for (i = 0; i < MaxThreadCaches; ++i)
+    {
+        ThreadCache* const cache = &caches[i];
+        
+        if ((cache->owner.getValueUnchecked() == 0) && cache->owner.compareAndSwap (0, threadID))
+        {
+            if (pl_SpinLock_TryLock (&cache->lock))
+                return cache;
+            
+            return 0;
+        }
+    }
+    
+    return 0; // more threads than caches
+}
+
+ObjectMemorySlabs::FreeBlock* ObjectMemorySlabs::popBatch (const int classIndex) throw()
+{
+    SizeClass& sc = classes[classIndex];
+    FreeBlock* batch;
+    
+    pl_SpinLock_Lock (&sc.lock);
+    
+    batch = sc.batches;
+    
+    if (batch != 0)
+    {
+        sc.batches = batch->nextBatch;
+        pl_SpinLock_Unlock (&sc.lock);
+        sc.numFree -= countBlocks (batch);
+        return batch;
+    }
+    
+    // carve a new batch from the current arena
+    Arena* arena = sc.arenas;
+    
+    while ((arena == 0) || (arena->numCarved == arena->capacity))
+    {
+        if (sc.spare != 0)
+        {
+            arena = sc.spare;
+            sc.spare = 0;
+            arena->next = sc.arenas;
+            sc.arenas = arena;
+            ++sc.numArenas;
+            break;
+        }
+        
+        // the trim thread hasn't made a spare in time so make one without holding the lock
+        pl_SpinLock_Unlock (&sc.lock);
+        
+        Arena* const created = createArena (classIndex);
+        
+        if (created == 0)
+            return 0;
+        
+        pl_SpinLock_Lock (&sc.lock);
+        
+        if (sc.spare == 0)
+        {
+            sc.spare = created;
+        }
+        else
+        {
+            pl_SpinLock_Unlock (&sc.lock);
+            destroyArena (created);
+            pl_SpinLock_Lock (&sc.lock);
+        }
+        
+        // another thread may have added an arena in the meantime
+        arena = sc.arenas;
+    }
+    
+    const UnsignedLong count = plonk::min (UnsignedLong (sc.batchSize), arena->capacity - arena->numCarved);
+    UnsignedChar* const start = reinterpret_cast<UnsignedChar*> (arena) + ArenaHeaderSize + arena->numCarved * arena->blockSize;
+    arena->numCarved += count;
+    
+    pl_SpinLock_Unlock (&sc.lock);
+    
+    for (UnsignedLong i = 0; i < count; ++i)
+    {
+        FreeBlock* const block = reinterpret_cast<FreeBlock*> (start + i * sc.blockSize);
+        block->next = (i + 1) < count ? reinterpret_cast<FreeBlock*> (start + (i + 1) * sc.blockSize) : 0;
+    }
+    
+    return reinterpret_cast<FreeBlock*> (start);
+}
+
+void ObjectMemorySlabs::pushBatch (const int classIndex, FreeBlock* batch, const int count) throw()
+{
+    SizeClass& sc = classes[classIndex];
+    
+    sc.numFree += count;
+    
+    pl_SpinLock_Lock (&sc.lock);
+    batch->nextBatch = sc.batches;
+    sc.batches = batch;
+    pl_SpinLock_Unlock (&sc.lock);
+}
+
+void ObjectMemorySlabs::flushCache (ThreadCache* cache, const int classIndex, const int count) throw()
+{
+    ThreadCache::Bin& bin = cache->bins[classIndex];
+    
+    if ((bin.head == 0) || (count <= 0))
+        return;
+    
+    FreeBlock* const batch = bin.head;
+    FreeBlock* last = batch;
+    int numBlocks = 1;
+    
+    while ((numBlocks < count) && (last->next != 0))
+    {
+        last = last->next;
+        ++numBlocks;
+    }
+    
+    bin.head = last->next;
+    bin.count -= numBlocks;
+    last->next = 0;
+    
+    pushBatch (classIndex, batch, numBlocks);
+}
+
+void ObjectMemorySlabs::trimCaches() throw()
+{
+    for (int i = 0; i < MaxThreadCaches; ++i)
+    {
+        ThreadCache& cache = caches[i];
+        
+        if (cache.owner.getValueUnchecked() == 0)
+            continue;
+        
+        if (cache.activity != cache.lastActivity)
+        {
+            cache.lastActivity = cache.activity;
+            continue;
+        }
+        
+        // idle since the last pass so return the blocks and free the cache for another thread
+        if (pl_SpinLock_TryLock (&cache.lock))
+        {
+            for (int classIndex = 0; classIndex < NumClasses; ++classIndex)
+                flushCache (&cache, classIndex, cache.bins[classIndex].count);
+            
+            cache.owner.setValue (0);
+            pl_SpinLock_Unlock (&cache.lock);
+        }
+    }
+}
+
+void ObjectMemorySlabs::trimClass (const int classIndex) throw()
+{
+    SizeClass& sc = classes[classIndex];
+    
+    // only worth trying if a whole arena could be free
+    if (UnsignedLong (sc.numFree.getValue()) < (ArenaSize - ArenaHeaderSize) / sc.blockSize)
+        return;
+    
+    pl_SpinLock_Lock (&sc.lock);
+    FreeBlock* batches = sc.batches;
+    Arena* const current = sc.arenas;
+    sc.batches = 0;
+    pl_SpinLock_Unlock (&sc.lock);
+    
+    FreeBlock* batch;
+    FreeBlock* block;
+    
+    for (batch = batches; batch != 0; batch = batch->nextBatch)
+        for (block = batch; block != 0; block = block->next)
+            ++findArena (block)->numTrimFree;
+    
+    // rebuild the batches from the blocks in arenas that are still in use
+    FreeBlock* keep = 0;
+    FreeBlock* keepTail = 0;
+    FreeBlock* rebuild = 0;
+    int rebuildCount = 0;
+    int numReleased = 0;
+    
+    for (batch = batches; batch != 0; )
+    {
+        FreeBlock* const nextBatch = batch->nextBatch;
+        
+        for (block = batch; block != 0; )
+        {
+            FreeBlock* const next = block->next;
+            Arena* const arena = findArena (block);
+            
+            if ((arena == current) || (arena->numTrimFree != arena->numCarved))
+            {
+                block->next = rebuild;
+                rebuild = block;
+                
+                if (++rebuildCount == sc.batchSize)
+                {
+                    rebuild->nextBatch = keep;
+                    keep = rebuild;
+                    
+                    if (keepTail == 0)
+                        keepTail = keep;
+                    
+                    rebuild = 0;
+                    rebuildCount = 0;
+                }
+            }
+            else
+            {
+                ++numReleased;
+            }
+            
+            block = next;
+        }
+        
+        batch = nextBatch;
+    }
+    
+    if (rebuild != 0)
+    {
+        rebuild->nextBatch = keep;
+        keep = rebuild;
+        
+        if (keepTail == 0)
+            keepTail = keep;
+    }
+    
+    // unlink the free arenas and return the remaining blocks
+    Arena* released = 0;
+    
+    pl_SpinLock_Lock (&sc.lock);
+    
+    for (Arena** link = &sc.arenas; *link != 0; )
+    {
+        Arena* const arena = *link;
+        
+        if ((arena != current) && (arena->numTrimFree == arena->numCarved))
+        {
+            *link = arena->next;
+            arena->next = released;
+            released = arena;
+            --sc.numArenas;
+        }
+        else
+        {
+            arena->numTrimFree = 0;
+            link = &arena->next;
+        }
+    }
+    
+    if (keep != 0)
+    {
+        keepTail->nextBatch = sc.batches;
+        sc.batches = keep;
+    }
+    
+    pl_SpinLock_Unlock (&sc.lock);
+    
+    sc.numFree -= numReleased;
+    
+    while (released != 0)
+    {
+        Arena* const arena = released;
+        released = arena->next;
+        destroyArena (arena);
+    }
+}
+
+void ObjectMemorySlabs::growClass (const int classIndex) throw()
+{
+    SizeClass& sc = classes[classIndex];
+    
+    pl_SpinLock_Lock (&sc.lock);
+    const bool needsSpare = (sc.spare == 0) && (sc.arenas != 0) && (sc.arenas->numCarved >= sc.arenas->capacity / 2);
+    pl_SpinLock_Unlock (&sc.lock);
+    
+    if (! needsSpare)
+        return;
+    
+    Arena* arena = createArena (classIndex);
+    
+    if (arena == 0)
+        return;
+    
+    pl_SpinLock_Lock (&sc.lock);
+    
+    if (sc.spare == 0)
+    {
+        sc.spare = arena;
+        arena = 0;
+    }
+    
+    pl_SpinLock_Unlock (&sc.lock);
+    
+    if (arena != 0)
+        destroyArena (arena);
+}
+
+void ObjectMemorySlabs::releaseAll() throw()
+{
+    for (int classIndex = 0; classIndex < NumClasses; ++classIndex)
+    {
+        SizeClass& sc = classes[classIndex];
+        
+        while (sc.arenas != 0)
+        {
+            Arena* const arena = sc.arenas;
+            sc.arenas = arena->next;
+            destroyArena (arena);
+        }
+        
+        if (sc.spare != 0)
+        {
+            destroyArena (sc.spare);
+            sc.spare = 0;
+        }
+        
+        sc.batches = 0;
+        sc.numArenas = 0;
+        sc.numFree.setValue (0);
+    }
+    
+    for (int i = 0; i < MaxThreadCaches; ++i)
+    {
+        caches[i].owner.setValue (0);
+        
+        for (int classIndex = 0; classIndex < NumClasses; ++classIndex)
+        {
+            caches[i].bins[classIndex].head = 0;
+            caches[i].bins[classIndex].count = 0;
+        }
+    }
+}
+
+ResultCode ObjectMemorySlabs::run() throw()
+{
+    const double duration = 0.5;
+    
+    while (! getShouldExit())
+    {
+        plonk_assert (getMemory().getUserData() == this);
+        
+        trimCaches();
+        
+        for (int i = 0; i < NumClasses; ++i)
+        {
+            trimClass (i);
+            growClass (i);
+        }
+        
+        Threading::sleep (duration);
+    }
+    
+    return 0;
+}
+
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,180 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_OBJECTMEMORYSLABS_H
+#define PLONK_OBJECTMEMORYSLABS_H
+
+/** Slab allocated memory for objects and raw arrays.
+ This replaces memory allocation functions for objects in the library
+ and raw arrays of simple types.
+ 
+ This is an alternative to ObjectMemoryPools that wastes much less memory on
+ rounding. Requests are rounded up to one of a series of size classes: steps of 16
+ bytes up to 128 bytes then four classes per power of 2 (160, 192, 224, 256, 320 etc)
+ up to 16K. Blocks carry no header, each size class carves its blocks from 1MB 
+ arenas aligned to their size so the size class of a block is found from its
+ address. Larger requests go directly to the system allocator.
+ 
+ Each thread that allocates or frees memory gets its own cache of free blocks for 
+ each size class. The shared free lists (one for each size class) are only used when
+ a cache runs empty or overflows, and then in batches, so most allocations and 
+ deallocations (including those on the audio thread) don't touch any shared state.
+ 
+ A background thread periodically returns the blocks from idle thread caches to the
+ shared lists and releases any arenas that have become completely free back to the
+ operating system. It also allocates a spare arena for each size class whose current
+ arena is half used so that other threads (in particular the audio thread) rarely 
+ need to allocate one. Arenas are never allocated while holding a shared lock.
+ 
+ Statistics for each size class are available via getStats().
+ 
+ To use this allocate one in your application set up code making sure that this happens
+ before any other Plonk/Plank objects:
+ 
+ In your class members or a global variable:
+ @code
+ ScopedPointerContainer<ObjectMemoryBase> memoryManager;
+ @endcode
+ 
+ In the set-up code:
+ @code
+ memoryManager = new ObjectMemorySlabs (Memory::global());
+ @endcode
+ 
+ Then after all objects have been deleted (in your application tear down):
+ @code
+ memoryManager = nullptr;
+ @endcode
+ 
+ @warning Only use one ObjectMemoryBase subclass for the entire lifetime of your application!
+ */
+class ObjectMemorySlabs :   public ObjectMemoryBase,
+                            public Threading::Thread
+{
+public:   
+    
+    enum Constants
+    {
+        NumSmallClasses = 8,            ///< The 16 byte spaced classes up to 128 bytes.
+        NumClassesPerDoubling = 4,
+        NumClasses = 36,
+        MaxClassSize = 16384,           ///< Larger requests use the system allocator.
+        ArenaSizeLog2 = 20,
+        ArenaSize = 1 << ArenaSizeLog2,
+        ArenaHeaderSize = 64,
+        MaxThreadCaches = 32,
+        RegistrySize = 4096             ///< The maximum number of arenas (i.e., 4GB).
+    };
+    
+    /** Statistics for one size class. */
+    class Stats
+    {
+    public:
+        Stats() throw()
+        :   blockSize (0),
+            numArenas (0),
+            numBlocks (0),
+            numFreeBlocks (0),
+            numAllocations (0),
+            numDeallocations (0)
+        {
+        }
+        
+        UnsignedLong blockSize;         ///< The size of the blocks in this class.
+        UnsignedLong numArenas;         ///< The number of arenas currently allocated.
+        UnsignedLong numBlocks;         ///< The number of blocks carved from the arenas.
+        UnsignedLong numFreeBlocks;     ///< The number of blocks in the shared free list (excludes thread caches).
+        UnsignedLong numAllocations;    ///< The total number of allocations served by thread caches.
+        UnsignedLong numDeallocations;  ///< The total number of deallocations served by thread caches.
+    };
+            
+    ObjectMemorySlabs (Memory& memory) throw();
+    ~ObjectMemorySlabs();
+    
+    PLONK_INLINE_LOW void init() throw() { start(); }
+    ResultCode run() throw();
+    
+    static void* staticAlloc (void* userData, PlankUL size);
+    static void staticFree (void* userData, void* ptr);
+    
+    void* allocateBytes (PlankUL size);
+    void free (void* ptr);
+    
+    /** Get the statistics for a size class.
+     The counts are gathered without locking so are only approximate while
+     other threads are allocating. */
+    Stats getStats (const int classIndex) const throw();
+    
+    /** Get the number of bytes currently allocated for requests above MaxClassSize. */
+    PLONK_INLINE_LOW UnsignedLong getLargeBytes() const throw() { return largeBytes.getValue(); }
+    
+    /** Get the block size of a size class. */
+    static UnsignedLong getClassSize (const int classIndex) throw();
+    
+    /** Get the size class for a request of a given size.
+     Returns -1 if it is too large for the size classes. */
+    static int getClassIndex (const UnsignedLong size) throw();
+    
+private:
+    class FreeBlock;
+    class Arena;
+    class SizeClass;
+    class ThreadCache;
+    
+    Arena* findArena (void* ptr) const throw();
+    void registerArena (Arena* arena) throw();
+    void unregisterArena (Arena* arena) throw();
+    Arena* createArena (const int classIndex) throw();
+    void destroyArena (Arena* arena) throw();
+    
+    ThreadCache* getThreadCache() throw();
+    FreeBlock* popBatch (const int classIndex) throw();
+    void pushBatch (const int classIndex, FreeBlock* batch, const int count) throw();
+    void flushCache (ThreadCache* cache, const int classIndex, const int count) throw();
+    void trimCaches() throw();
+    void trimClass (const int classIndex) throw();
+    void growClass (const int classIndex) throw();
+    void releaseAll() throw();
+    
+    SizeClass* classes;
+    ThreadCache* caches;
+    AtomicValue<void*>* registry;
+    AtomicLong largeBytes;
+};
+
+#endif // PLONK_OBJECTMEMORYSLABS_H
@@ -0,0 +1,255 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_RINGBUFFER_H
+#define PLONK_RINGBUFFER_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+
+#include "../core/plonk_SmartPointer.h"
+#include "../core/plonk_WeakPointer.h"
+
+template<class ValueType>                                               
+class RingBufferInternal : public SmartPointer
+{
+public:
+    typedef RingBuffer<ValueType>   RingBufferType;
+    
+    RingBufferInternal (const int capacity, const bool singleProducer) throw()
+    {
+        ResultCode result = pl_RingBuffer_Init (&ring, capacity, sizeof (ValueType), 
+                                                singleProducer ? PlankRingBufferMode_SPSC : PlankRingBufferMode_MPSC);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+        
+        // the slots are constructed once and assigned to after that so pushing 
+        // and popping never constructs or destroys a value
+        const int numSlots = getCapacity();
+        
+        for (int i = 0; i < numSlots; ++i)
+            ::new (pl_RingBuffer_GetSlot (&ring, i)) ValueType (getNullValue());
+    }
+    
+    ~RingBufferInternal()
+    {
+        const int numSlots = getCapacity();
+        
+        for (int i = 0; i < numSlots; ++i)
+            static_cast<ValueType*> (pl_RingBuffer_GetSlot (&ring, i))->~ValueType();
+        
+        ResultCode result = pl_RingBuffer_DeInit (&ring);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        PlankL position;
+        ValueType* const slot = static_cast<ValueType*> (pl_RingBuffer_BeginPush (&ring, &position));
+        
+        if (slot == 0)
+            return false;
+        
+        *slot = value;
+        pl_RingBuffer_EndPush (&ring, position);
+        return true;
+    }
+    
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        PlankL position;
+        ValueType* const slot = static_cast<ValueType*> (pl_RingBuffer_BeginPop (&ring, &position));
+        
+        if (slot == 0)
+            return false;
+        
+        value = *slot;
+        *slot = getNullValue(); // release any reference the slot holds
+        pl_RingBuffer_EndPop (&ring, position);
+        return true;
+    }
+    
+    PLONK_INLINE_LOW ValueType pop() throw()
+    {
+        ValueType value (getNullValue());
+        return pop (value) ? value : getNullValue();
+    }
+    
+    void clear() throw()
+    {
+        ValueType value (getNullValue());
+        while (pop (value)) { }
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return (int)pl_RingBuffer_GetSize (&ring);
+    }
+    
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return (int)pl_RingBuffer_GetCapacity (&ring);
+    }
+    
+    PLONK_INLINE_LOW bool isSingleProducer() throw()
+    {
+        return pl_RingBuffer_GetMode (&ring) == PlankRingBufferMode_SPSC;
+    }
+
+    static PLONK_INLINE_LOW ValueType getNullValue() throw()
+    {
+        static ValueType null = ValueType();
+        return null;
+    }
+    
+private:
+    PLONK_ALIGN(16) PlankRingBuffer ring;
+};
+
+//------------------------------------------------------------------------------
+
+/** A bounded lock-free FIFO.
+ This preallocates a power of 2 number of slots (at least the capacity 
+ requested) so pushing and popping never allocate memory. With a single 
+ producer (the default) only one thread may push and one thread may pop at a 
+ time, both are wait-free. Otherwise any number of threads may push but still
+ only one may pop. Unlike LockFreeQueue push() fails and returns false if the 
+ ring is full. 
+ @see LockFreeQueue::withCapacity()
+ @ingroup PlonkContainerClasses */
+template<class ValueType>                                               
+class RingBuffer : public SmartPointerContainer<RingBufferInternal<ValueType> >
+{
+public:
+    typedef RingBufferInternal<ValueType>       Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef WeakPointerContainer<RingBuffer>    Weak;
+    typedef ValueType                           Value;
+
+    PLONK_INLINE_LOW RingBuffer (const int capacity = 64, const bool singleProducer = true)
+    :   Base (new Internal (capacity, singleProducer))
+    {
+    }
+    
+    PLONK_INLINE_LOW explicit RingBuffer (Internal* internalToUse) throw() 
+	:	Base (internalToUse)
+	{
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */    
+    static RingBuffer fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }    
+    
+    /** Copy constructor. */
+    PLONK_INLINE_LOW RingBuffer (RingBuffer const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    PLONK_INLINE_LOW RingBuffer& operator= (RingBuffer const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    static ValueType getNullValue() throw()
+    {
+        return Internal::getNullValue();
+    }
+    
+    /** Add a value to the ring.
+     @return true if the value was added, false if the ring was full. */
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        return this->getInternal()->push (value);
+    }
+    
+    /** Remove the oldest value from the ring.
+     This returns the null value if the ring was empty. */
+    PLONK_INLINE_LOW ValueType pop() throw()
+    {
+        return this->getInternal()->pop();
+    }
+    
+    /** Remove the oldest value from the ring.
+     @return true if a value was removed, false if the ring was empty. */
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        return this->getInternal()->pop (value);
+    }
+    
+    PLONK_INLINE_LOW void clear() throw()
+    {
+        this->getInternal()->clear();
+    }
+    
+    /** NB the result of this could be invalid by the time it is returned in a multithreaded context. */
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return this->getInternal()->length();
+    }
+    
+    /** The number of slots, this may be larger than the capacity requested. */
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return this->getInternal()->getCapacity();
+    }
+    
+    PLONK_INLINE_LOW bool isSingleProducer() throw()
+    {
+        return this->getInternal()->isSingleProducer();
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(RingBuffer);
+};
+
+#endif // PLONK_RINGBUFFER_H
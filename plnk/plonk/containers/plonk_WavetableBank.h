@@ -0,0 +1,333 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_WAVETABLEBANK_H
+#define PLONK_WAVETABLEBANK_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+
+#include "../core/plonk_SmartPointer.h"
+#include "plonk_Wavetable.h"
+#include "../fft/plonk_FFTEngine.h"
+
+
+template<class SampleType>
+class WavetableBankInternal : public SmartPointer
+{
+public:
+    typedef NumericalArray<SampleType> Buffer;
+    
+    WavetableBankInternal() throw()
+    :   tableLength (0),
+        numTables (0),
+        numHarmonics (0)
+    {
+    }
+    
+    WavetableBankInternal (Buffer const& tablesToUse,
+                           const int tableLengthToUse,
+                           const int numTablesToUse,
+                           const int numHarmonicsToUse) throw()
+    :   tables (tablesToUse),
+        tableLength (tableLengthToUse),
+        numTables (numTablesToUse),
+        numHarmonics (numHarmonicsToUse)
+    {
+        plonk_assert (tables.length() == (tableLength * 2 * numTables));
+    }
+    
+    friend class WavetableBankBase<SampleType>;
+    
+private:
+    Buffer tables;
+    int tableLength;
+    int numTables;
+    int numHarmonics;
+};
+
+//------------------------------------------------------------------------------
+
+/** A set of band-limited wavetables, one per octave.
+ Table 0 contains all of the harmonics, each subsequent table has half as many
+ as the one before until the last which is a single sine. An oscillator using 
+ the bank chooses the table with the most harmonics that stay below the Nyquist
+ frequency for the frequency it is playing, so high notes don't alias.
+ The tables are built with an inverse FFT (so the size must be a power of 2) and
+ all are scaled by the peak of table 0 so the level stays the same from one
+ table to the next. Like Wavetable each table is stored twice in succession so
+ interpolated lookups never need to wrap the index.
+ @ingroup PlonkContainerClasses */
+template<class SampleType>
+class WavetableBankBase : public SmartPointerContainer< WavetableBankInternal<SampleType> >
+{
+public:
+    typedef WavetableBankInternal<SampleType>   Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef NumericalArray<SampleType>          Buffer;
+    typedef WavetableBase<SampleType>           WavetableType;
+    
+    WavetableBankBase() throw()
+    :   Base (new Internal())
+    {
+    }
+    
+    explicit WavetableBankBase (Internal* internalToUse) throw() 
+    :   Base (internalToUse)
+    {
+    } 
+    
+    /** Copy constructor.
+	 Note that a deep copy is not made, the copy will refer to exactly the same data. */
+    WavetableBankBase (WavetableBankBase const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    WavetableBankBase& operator= (WavetableBankBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    static const WavetableBankBase& getNull() throw()
+    {
+        static WavetableBankBase null;        
+        return null;
+    }
+    
+    /** Get the length of each table. */
+    PLONK_INLINE_LOW int getTableLength() const throw()
+    {
+        return this->getInternal()->tableLength;
+    }
+    
+    /** Get the number of tables. */
+    PLONK_INLINE_LOW int getNumTables() const throw()
+    {
+        return this->getInternal()->numTables;
+    }
+    
+    /** Get the number of harmonics in table 0. */
+    PLONK_INLINE_LOW int getNumHarmonics() const throw()
+    {
+        return this->getInternal()->numHarmonics;
+    }
+    
+    /** Get the number of harmonics in a particular table. */
+    PLONK_INLINE_LOW int getNumHarmonics (const int index) const throw()
+    {
+        return plonk::max (1, this->getNumHarmonics() >> index);
+    }
+    
+    /** Get all of the tables in a single buffer. 
+     Each table takes twice the table length. */
+    PLONK_INLINE_LOW const Buffer& getTables() const throw()
+    {
+        return this->getInternal()->tables;
+    }
+    
+    /** Get a pointer to the samples of a particular table. 
+     The table is repeated so the next getTableLength() samples are also valid. */
+    PLONK_INLINE_LOW const SampleType* getTableSamples (const int index) const throw()
+    {
+        plonk_assert ((index >= 0) && (index < this->getNumTables()));
+        return this->getTables().getArray() + index * this->getTableLength() * 2;
+    }
+    
+    /** Get a copy of a particular table as a Wavetable. */
+    WavetableType getTable (const int index) const throw()
+    {
+        return WavetableType (Buffer::withArray (this->getTableLength(), this->getTableSamples (index)));
+    }
+    
+    /** Choose the table for a particular frequency.
+     This is the table with the most harmonics that are all below the Nyquist 
+     frequency. The frequency is usually the highest frequency in a block. */
+    PLONK_INLINE_LOW int selectTable (const double frequency, const double sampleRate) const throw()
+    {
+        return selectTable (this->getNumHarmonics(), this->getNumTables(), frequency, sampleRate);
+    }
+    
+    /** Choose the table for a particular frequency given the size of a bank. 
+     @see selectTable */
+    static PLONK_INLINE_LOW int selectTable (const int numHarmonics, const int numTables, 
+                                             const double frequency, const double sampleRate) throw()
+    {
+        const double limit = sampleRate / (2.0 * plonk::abs (frequency));
+        const int lastTable = numTables - 1;
+        int index = 0;
+        
+        while ((index < lastTable) && (double (numHarmonics >> index) > limit))
+            ++index;
+        
+        return index;
+    }
+    
+    /** Creates a bank from harmonic weights. 
+     The number of harmonics is the length of the weights but this is limited 
+     to one less than half the size. The size must be a power of 2. */
+    static WavetableBankBase harmonic (const int size, Buffer const& weights) throw()
+    {
+        plonk_assert (Bits::isPowerOf2 (size));
+        plonk_assert (weights.length() > 0);
+        
+        typedef NumericalArray<float> FloatBuffer;
+        
+        const int halfSize = size / 2;
+        const int numHarmonics = plonk::min (weights.length(), halfSize - 1);
+        
+        int numTables = 1;
+        
+        while ((numHarmonics >> numTables) > 0)
+            ++numTables;
+        
+        FFTEngineBase<float> fft (size);
+        FloatBuffer spectrum (FloatBuffer::newClear (size));
+        FloatBuffer table (FloatBuffer::withSize (size));
+        Buffer tables (Buffer::withSize (size * 2 * numTables));
+        
+        float* const spectrumSamples = spectrum.getArray();
+        float* const tableSamples = table.getArray();
+        const double angleIncrement = Math<double>::get2Pi() / size;
+        
+        // the inverse scaling and sign depend on the FFT engine, measure these
+        // by transforming a single sine
+        
+        spectrumSamples[halfSize + 1] = 1.f;
+        fft.inverse (tableSamples, spectrumSamples);
+        
+        double gain = 0.0;
+        int i, j;
+        
+        for (i = 0; i < size; ++i)
+            gain += tableSamples[i] * plonk::sin (angleIncrement * i);
+        
+        gain *= 2.0 / size;
+        plonk_assert (plonk::abs (gain) > 0.0);
+        
+        double scale = 1.0 / gain;
+        
+        for (j = 0; j < numTables; ++j)
+        {
+            const int tableHarmonics = plonk::max (1, numHarmonics >> j);
+            
+            spectrum.zero();
+            
+            for (i = 0; i < tableHarmonics; ++i)
+                spectrumSamples[halfSize + 1 + i] = float (weights.atUnchecked (i));
+            
+            fft.inverse (tableSamples, spectrumSamples);
+            
+            if (j == 0)
+            {
+                double peak = 0.0;
+                
+                for (i = 0; i < size; ++i)
+                    peak = plonk::max (peak, plonk::abs (double (tableSamples[i]) * scale));
+                
+                if (peak > 0.0)
+                    scale /= peak;
+            }
+            
+            SampleType* const bankSamples = tables.getArray() + j * size * 2;
+            
+            for (i = 0; i < size; ++i)
+                bankSamples[i] = bankSamples[i + size] = SampleType (tableSamples[i] * scale);
+        }
+        
+        return WavetableBankBase (new Internal (tables, size, numTables, numHarmonics));
+    }
+    
+    /** Creates a bank with band-limited sawtooth tables.
+     If numHarmonics is 0 as many are used as the size allows. */
+    static WavetableBankBase harmonicSaw (const int size, const int numHarmonics = 0) throw()
+	{
+		return WavetableBankBase::harmonic (size, Buffer::series (getNumHarmonicsForSize (size, numHarmonics), 1, 1)
+                                            .reciprocal());
+	}
+    
+    /** Creates a bank with band-limited square wave tables.
+     If numHarmonics is 0 as many are used as the size allows. */
+    static WavetableBankBase harmonicSquare (const int size, const int numHarmonics = 0) throw()
+	{
+		return WavetableBankBase::harmonic (size, Buffer::series (getNumHarmonicsForSize (size, numHarmonics), 1, 1)
+                                            .reciprocal() * Buffer (SampleType (1), SampleType (0)));
+	}
+    
+    /** Creates a bank with band-limited triangle wave tables.
+     If numHarmonics is 0 as many are used as the size allows. */
+    static WavetableBankBase harmonicTri (const int size, const int numHarmonics = 0) throw()
+	{
+		return WavetableBankBase::harmonic (size, (Buffer::series (getNumHarmonicsForSize (size, numHarmonics), 1, 1)
+                                            .reciprocal() * Buffer (SampleType (1), SampleType (0), SampleType (-1), SampleType (0)))
+                                            .squared());
+	}
+    
+    static const WavetableBankBase& harmonicSaw() throw()
+	{
+		static const WavetableBankBase bank (WavetableBankBase::harmonicSaw (2048));
+        return bank;
+	}
+
+    static const WavetableBankBase& harmonicSquare() throw()
+	{
+		static const WavetableBankBase bank (WavetableBankBase::harmonicSquare (2048));
+        return bank;
+	}
+
+    static const WavetableBankBase& harmonicTri() throw()
+	{
+		static const WavetableBankBase bank (WavetableBankBase::harmonicTri (2048));
+        return bank;
+	}
+    
+    PLONK_OBJECTARROWOPERATOR(WavetableBankBase);
+    
+private:
+    static PLONK_INLINE_LOW int getNumHarmonicsForSize (const int size, const int numHarmonics) throw()
+    {
+        const int maximum = size / 2 - 1;
+        return numHarmonics <= 0 ? maximum : plonk::min (numHarmonics, maximum);
+    }
+};
+
+#endif // PLONK_WAVETABLEBANK_H
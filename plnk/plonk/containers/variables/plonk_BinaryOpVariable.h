@@ -47,6 +47,7 @@ class BinaryOpVariableInternal : public VariableInternalBase<Type>,
                                  public Variable<Type>::Receiver
 {
 public:
+    typedef VariableInternalBase<Type>     Base;
     typedef Variable<Type>                 VariableType;
     typedef typename VariableType::Sender  Sender;
     
@@ -98,6 +99,27 @@ public:
         return result;
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        Type rightValues[Base::ChunkSize];
+        
+        for (int i = 0; i < numValues; i += Base::ChunkSize)
+        {
+            const int numValuesThisTime = plonk::min (int (Base::ChunkSize), numValues - i);
+            Type* const leftValues = values + i;
+            
+            leftOperand.nextValues (leftValues, numValuesThisTime);
+            rightOperand.nextValues (rightValues, numValuesThisTime);
+            NumericalArrayBinaryOp<Type,op>::calcNN (leftValues, leftValues, rightValues, numValuesThisTime);
+        }
+        
+        if ((numValues > 0) && (values[numValues - 1] != this->cachedValue))
+        {
+            this->cachedValue = values[numValues - 1];
+            this->update (Text::getEmpty(), Dynamic::getNull());
+        }
+    }
+    
     void setValue(Type const& /*newValue*/) throw()
     {
         plonk_assertfalse;
@@ -75,6 +75,14 @@ public:
         return plonk::clip (variable.nextValue(), minimum, maximum);
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        variable.nextValues (values, numValues);
+        
+        for (int i = 0; i < numValues; ++i)
+            values[i] = plonk::clip (values[i], minimum, maximum);
+    }
+    
     void setValue (Type const& newValue) throw()
     {
         plonk_assertfalse;
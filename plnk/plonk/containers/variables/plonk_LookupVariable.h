@@ -132,6 +132,21 @@ public:
     {
         return this->getValueAtIndex (this->index.nextValue());
     }
+    
+    void nextValues (ArrayValueType* values, const int numValues) throw()
+    {
+        IndexValueType indices[Base::ChunkSize];
+        
+        for (int i = 0; i < numValues; i += Base::ChunkSize)
+        {
+            const int numValuesThisTime = plonk::min (int (Base::ChunkSize), numValues - i);
+            
+            this->index.nextValues (indices, numValuesThisTime);
+            
+            for (int j = 0; j < numValuesThisTime; ++j)
+                values[i + j] = this->getValueAtIndex (indices[j]);
+        }
+    }
 };
 
 ///=============================================================================
@@ -190,6 +205,21 @@ public:
         return this->getValueAtIndex (this->index.nextValue());
     }
     
+    void nextValues (ArrayValueType* values, const int numValues) throw()
+    {
+        IndexValueType indices[Base::ChunkSize];
+        
+        for (int i = 0; i < numValues; i += Base::ChunkSize)
+        {
+            const int numValuesThisTime = plonk::min (int (Base::ChunkSize), numValues - i);
+            
+            this->index.nextValues (indices, numValuesThisTime);
+            
+            for (int j = 0; j < numValuesThisTime; ++j)
+                values[i + j] = this->getValueAtIndex (indices[j]);
+        }
+    }
+    
 };
 
 
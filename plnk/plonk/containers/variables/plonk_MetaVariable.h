@@ -75,6 +75,12 @@ public:
         return temp.nextValue();
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        VariableType temp = variable.getValue();
+        temp.nextValues (values, numValues);
+    }
+    
     void setValue (Type const& newValue) throw()
     {
         plonk_assertfalse;
@@ -76,6 +76,16 @@ public:
         return this->cachedValue;
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        // each value comes from a different element so this can't be done in blocks
+        for (int i = 0; i < numValues; ++i)
+            values[i] = pattern.wrapAt (index++).nextValue();
+        
+        if (numValues > 0)
+            this->cachedValue = values[numValues - 1];
+    }
+    
     void setValue(Type const& newValue) throw()
     {
         plonk_assertfalse;
@@ -100,6 +100,35 @@ public:
         return result;
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        input.nextValues (values, numValues);
+        
+        bool reachedTarget = false;
+        
+        for (int i = 0; i < numValues; ++i)
+        {
+            const Type nextValue = values[i];
+            
+            if (nextValue != shapeState.targetLevel)
+            {
+                shapeState.targetLevel = nextValue;
+                shapeState.shapeType = shape.nextValue();
+                shapeState.curve = (shapeState.shapeType == Shape::Numerical) ? curve.nextValue() : 0.0f;
+                shapeState.stepsToTarget = plonk::max (1, numSteps.nextValue());
+                Shape::initShape (shapeState);
+            }
+            
+            values[i] = Shape::next (shapeState);
+            
+            if (shapeState.stepsToTarget == TypeUtility<LongLong>::getTypePeak())
+                reachedTarget = true;
+        }
+        
+        if (reachedTarget)
+            this->update (Text::getEmpty(), Dynamic::getNull());
+    }
+    
     void setValue (Type const& newValue) throw()
     {
         plonk_assertfalse;
@@ -47,6 +47,8 @@ class TypeVariableInternal : public VariableInternalBase<Type>,
                              public Variable<OtherType>::Receiver
 {
 public:
+    typedef VariableInternalBase<Type> Base;
+    
     TypeVariableInternal(Variable<OtherType> const& input) throw()
     :   operand (input),
         cachedValue (Type (input.getValue()))
@@ -87,6 +89,27 @@ public:
         return result;
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        OtherType otherValues[Base::ChunkSize];
+        
+        for (int i = 0; i < numValues; i += Base::ChunkSize)
+        {
+            const int numValuesThisTime = plonk::min (int (Base::ChunkSize), numValues - i);
+            
+            operand.nextValues (otherValues, numValuesThisTime);
+            
+            for (int j = 0; j < numValuesThisTime; ++j)
+                values[i + j] = Type (otherValues[j]);
+        }
+        
+        if ((numValues > 0) && (values[numValues - 1] != this->cachedValue))
+        {
+            this->cachedValue = values[numValues - 1];
+            this->update (Text::getEmpty(), Dynamic::getNull());
+        }
+    }
+    
     void setValue(Type const& newValue) throw()
     {
         const OtherType currentValue = operand.getValue();
@@ -91,6 +91,18 @@ public:
         return result;
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        operand.nextValues (values, numValues);
+        NumericalArrayUnaryOp<Type,op>::calc (values, values, numValues);
+        
+        if ((numValues > 0) && (values[numValues - 1] != this->cachedValue))
+        {
+            this->cachedValue = values[numValues - 1];
+            this->update (Text::getEmpty(), Dynamic::getNull());
+        }
+    }
+    
     void setValue(Type const& newValue) throw()
     {
         plonk_assertfalse;
@@ -268,6 +268,14 @@ public:
         return this->getInternal()->nextValue();
     }
     
+    /** Writes the next values to an array.
+     This is equivalent to calling nextValue() for each value but expressions
+     are evaluated a block at a time, one node after another. */
+    PLONK_INLINE_LOW void nextValues (Type* values, const int numValues) throw()
+    {
+        this->getInternal()->nextValues (values, numValues);
+    }
+    
     /** Sets the current value. */
     PLONK_INLINE_LOW void setValue (Type const& newValue) throw()
     {
@@ -47,11 +47,26 @@ template<class Type>
 class VariableInternalBase : public SenderInternal< Variable<Type> >
 {
 public:
+    enum Constants
+    {
+        ChunkSize = 64 ///< The maximum number of values nodes evaluate at once into temporary storage.
+    };
+    
     ~VariableInternalBase() { }
     virtual const Type getValue() const = 0;
     virtual Type* getValuePtr() { return 0; }
     virtual const Type nextValue() = 0;
     virtual void setValue (Type const& newValue) = 0;
+    
+    /** Writes the next numValues values to the array.
+     This gives the same values as calling nextValue() numValues times but 
+     expressions override it to evaluate each node for the whole block. 
+     Receivers are notified of changes at most once per call. */
+    virtual void nextValues (Type* values, const int numValues)
+    {
+        for (int i = 0; i < numValues; ++i)
+            values[i] = this->nextValue();
+    }
 };
 
 
@@ -93,6 +108,14 @@ public:
         return value;
     }
     
+    void nextValues (Type* values, const int numValues) throw()
+    {
+        const Type currentValue = value;
+        
+        for (int i = 0; i < numValues; ++i)
+            values[i] = currentValue;
+    }
+    
     void setValue (Type const& newValue) throw()
     {
         if (value != newValue)
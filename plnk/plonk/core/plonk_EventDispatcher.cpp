@@ -0,0 +1,246 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "plonk_Headers.h"
+
+class EventNames
+{
+public:
+    EventNames() throw()
+    :   lock (Lock::MutexLock)
+    {
+        // in the same order as Event::Messages
+        names.add (Text::getEmpty());
+        names.add (Text::getMessageCuePoint());
+        names.add (Text::getMessageDone());
+        names.add (Text::getMessageAudioFileChanged());
+        names.add (Text::getMessageNumChannelsChanged());
+        names.add (Text::getMessageLooped());
+        names.add (Text::getMessageTrigger());
+        
+        plonk_assert (names.length() == Event::NumMessages);
+    }
+    
+    static EventNames& getDefault() throw()
+    {
+        static EventNames names;
+        return names;
+    }
+    
+    Lock lock;
+    TextArray names;
+};
+
+int Event::intern (Text const& name) throw()
+{
+    EventNames& table = EventNames::getDefault();
+    
+    table.lock.lock();
+    
+    int message = table.names.indexOf (name);
+    
+    if (message < 0)
+    {
+        message = table.names.length();
+        table.names.add (name);
+    }
+    
+    table.lock.unlock();
+    
+    return message;
+}
+
+Text Event::getName (const int message) throw()
+{
+    EventNames& table = EventNames::getDefault();
+    
+    table.lock.lock();
+    const Text name = ((message >= 0) && (message < table.names.length())) ? table.names.atUnchecked (message) : Text::getEmpty();
+    table.lock.unlock();
+    
+    return name;
+}
+
+//------------------------------------------------------------------------------
+
+EventSenderInternal::EventSenderInternal (const int capacity) throw()
+:   ring (ObjectArray<Event>::withSize (Bits::nextPowerOf2 (plonk::max (capacity, 2)))),
+    mask (ring.length() - 1),
+    receiversLock (Lock::MutexLock)
+{
+}
+
+EventSenderInternal::~EventSenderInternal()
+{
+}
+
+int EventSenderInternal::pop (Event* events, const int maximum) throw()
+{
+    const Long r = readIndex.getValueUnchecked();
+    const Long available = writeIndex.getValue() - r;
+    const int count = (int)plonk::min (available, (Long)maximum);
+    
+    for (int i = 0; i < count; ++i)
+        events[i] = ring.atUnchecked ((int)((r + i) & mask));
+    
+    readIndex.setValue (r + count); // a full barrier so the slots are copied before they are reused
+    return count;
+}
+
+void EventSenderInternal::addReceiver (EventReceiver* receiver) throw()
+{
+    plonk_assert (receiver != 0);
+    
+    receiversLock.lock();
+    
+    if (! receivers.contains (receiver))
+    {
+        receivers.add (receiver);
+        numReceivers.setValue (receivers.length());
+    }
+    
+    receiversLock.unlock();
+}
+
+void EventSenderInternal::removeReceiver (EventReceiver* receiver) throw()
+{
+    // blocks until any delivery in progress has finished so the receiver
+    // may be deleted once this returns
+    receiversLock.lock();
+    receivers.removeItem (receiver);
+    numReceivers.setValue (receivers.length());
+    receiversLock.unlock();
+}
+
+void EventSenderInternal::deliver (EventSender const& sender, const Event* events, const int numEvents) throw()
+{
+    receiversLock.lock();
+    
+    const int numReceiversNow = receivers.length();
+    
+    for (int i = 0; i < numReceiversNow; ++i)
+        receivers.atUnchecked (i)->receiveEvents (sender, events, numEvents);
+    
+    receiversLock.unlock();
+}
+
+//------------------------------------------------------------------------------
+
+EventSender::EventSender (const int capacity) throw()
+:   Base (new Internal (capacity))
+{
+    EventDispatcher::getDefault().add (*this);
+}
+
+//------------------------------------------------------------------------------
+
+EventDispatcher::EventDispatcher (const double pollInterval) throw()
+:   Threading::Thread ("EventDispatcher"),
+    interval (pollInterval)
+{
+    start();
+}
+
+EventDispatcher::~EventDispatcher()
+{
+    setShouldExitAndWait();
+    
+    // deliver anything left before releasing the senders
+    dispatch();
+    added.clearAll();
+}
+
+EventDispatcher& EventDispatcher::getDefault() throw()
+{
+    static EventDispatcher dispatcher;
+    return dispatcher;
+}
+
+void EventDispatcher::add (EventSender const& sender) throw()
+{
+    added.push (Element (sender));
+}
+
+void EventDispatcher::dispatch() throw()
+{
+    Element element;
+    
+    while (added.pop (element))
+    {
+        senders.add (element.sender);
+        element.sender = EventSender::getNull();
+    }
+    
+    int i = 0;
+    
+    while (i < senders.length())
+    {
+        EventSender& sender = senders.atUnchecked (i);
+        EventSenderInternal* const internal = sender.getInternal();
+        int numEvents;
+        
+        while ((numEvents = internal->pop (batch, BatchSize)) > 0)
+        {
+            if (internal->hasReceivers())
+                internal->deliver (sender, batch, numEvents);
+        }
+        
+        // only the dispatcher refers to it so nothing more can be posted
+        if ((internal->getRefCount() == 1) && internal->isEmpty())
+            senders.remove (i);
+        else
+            ++i;
+    }
+}
+
+ResultCode EventDispatcher::run() throw()
+{
+    while (! getShouldExit())
+    {
+        dispatch();
+        Threading::sleep (interval);
+    }
+    
+    return 0;
+}
+
+END_PLONK_NAMESPACE
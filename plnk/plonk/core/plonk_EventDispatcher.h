@@ -0,0 +1,319 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_EVENTDISPATCHER_H
+#define PLONK_EVENTDISPATCHER_H
+
+#include "plonk_CoreForwardDeclarations.h"
+#include "plonk_Thread.h"
+#include "plonk_Lock.h"
+
+class EventSender;
+
+/** A small fixed size message for sending from the audio thread.
+ Unlike the Sender/Receiver messages (which use Text and Dynamic) an Event
+ is plain data so posting one never allocates. The message is an integer ID,
+ either one of the predefined Messages or one obtained from intern().
+ @see EventSender, EventReceiver */
+class Event
+{
+public:
+    /** Predefined message IDs.
+     These have the same names as the equivalent Text::getMessage...() 
+     messages. */
+    enum Messages
+    {
+        None = 0,
+        CuePoint,           ///< index is the cue point index, time is the frame
+        Done,
+        AudioFileChanged,
+        NumChannelsChanged, ///< index is the new number of channels
+        Looped,
+        Trigger,
+        NumMessages
+    };
+    
+    Event() throw()
+    :   message (None), index (0), time (0), value (0.0)
+    {
+    }
+    
+    Event (const int m, const int i = 0, const LongLong t = 0, const double v = 0.0) throw()
+    :   message (m), index (i), time (t), value (v)
+    {
+    }
+    
+    /** Returns the ID for a message name, adding it if it is new.
+     This takes a lock so should be called during setup rather than on the
+     audio thread. */
+    static int intern (Text const& name) throw();
+    
+    /** Returns the name for a message ID.
+     This returns an empty Text if the ID is unknown. */
+    static Text getName (const int message) throw();
+    
+    int message;
+    int index;
+    LongLong time;
+    double value;
+};
+
+/** Receives batches of events from EventSender objects. 
+ @see EventSender */
+class EventReceiver
+{
+public:
+    EventReceiver() throw() { }
+    virtual ~EventReceiver() { }
+    
+    /** Called on the EventDispatcher thread with the events posted since the 
+     last batch, in the order they were posted. */
+    virtual void receiveEvents (EventSender const& sender, const Event* events, const int numEvents) throw() = 0;
+};
+
+//------------------------------------------------------------------------------
+
+/** @internal */
+class EventSenderInternal : public SmartPointer
+{
+public:
+    EventSenderInternal (const int capacity) throw();
+    ~EventSenderInternal();
+    
+    /** Adds an event to the ring.
+     This is wait-free but only one thread may post at a time. If the ring is 
+     full the event is dropped and counted. */
+    bool post (Event const& event) throw()
+    {
+        const Long w = writeIndex.getValueUnchecked();
+        
+        if ((w - readIndex.getValue()) > mask)
+        {
+            ++numDropped;
+            return false;
+        }
+        
+        ring.atUnchecked ((int)(w & mask)) = event;
+        writeIndex.setValue (w + 1); // a full barrier so the event is visible before the new index
+        return true;
+    }
+    
+    /** Removes up to maximum events into the array. 
+     Only the dispatcher should call this. */
+    int pop (Event* events, const int maximum) throw();
+    
+    bool isEmpty() const throw()
+    {
+        return readIndex.getValue() == writeIndex.getValue();
+    }
+    
+    bool hasReceivers() const throw()
+    {
+        return numReceivers.getValueUnchecked() > 0;
+    }
+
+    void addReceiver (EventReceiver* receiver) throw();
+    void removeReceiver (EventReceiver* receiver) throw();
+    void deliver (EventSender const& sender, const Event* events, const int numEvents) throw();
+    
+    int getNumDropped() const throw() { return numDropped.getValueUnchecked(); }
+
+private:
+    ObjectArray<Event> ring;
+    const Long mask;
+    AtomicLong writeIndex;
+    AtomicLong readIndex;
+    AtomicInt numDropped;
+    AtomicInt numReceivers;
+    Lock receiversLock;
+    ObjectArray<EventReceiver*> receivers;
+};
+
+/** Posts events from the audio thread for delivery on another thread.
+ Each sender has a preallocated single producer/single consumer ring. The 
+ audio thread writes events into the ring and the EventDispatcher thread 
+ delivers them in batches to the receivers. This means receivers may take
+ locks, allocate or do slow work without affecting the audio thread.
+ 
+ Receivers must be removed before they are deleted. The sender itself is 
+ finally deleted by the dispatcher thread.
+ @see Event, EventReceiver, EventDispatcher */
+class EventSender : public SmartPointerContainer<EventSenderInternal>
+{
+public:
+    typedef EventSenderInternal             Internal;
+    typedef SmartPointerContainer<Internal> Base;
+    
+    enum Constants
+    {
+        DefaultCapacity = 128
+    };
+    
+    static const EventSender& getNull() throw()
+    {
+        static EventSender null;
+        return null;
+    }
+    
+    /** Creates a null sender. 
+     Events posted to a null sender are dropped. */
+    EventSender() throw()
+    :   Base (static_cast<Internal*> (0))
+    {
+    }
+    
+    /** Creates a sender and registers it with the default dispatcher.
+     @param capacity The maximum number of events pending delivery, this is 
+                     rounded up to a power of two. */
+    explicit EventSender (const int capacity) throw();
+    
+    /** @internal */
+    explicit EventSender (Internal* internalToUse) throw() 
+	:	Base (internalToUse)
+	{
+	}
+    
+    EventSender (EventSender const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    EventSender& operator= (EventSender const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Posts an event.
+     This is wait-free and safe to call on the audio thread. It returns false
+     if the event was dropped because the sender is null or its ring is full. */
+    PLONK_INLINE_LOW bool post (Event const& event) throw()
+    {
+        Internal* const internal = this->getInternal();
+        return internal != 0 ? internal->post (event) : false;
+    }
+    
+    PLONK_INLINE_LOW bool post (const int message, const int index = 0, const LongLong time = 0, const double value = 0.0) throw()
+    {
+        return this->post (Event (message, index, time, value));
+    }
+    
+    /** Returns true if any receivers are attached.
+     Use this to avoid preparing events that nobody will receive. */
+    PLONK_INLINE_LOW bool hasReceivers() const throw()
+    {
+        const Internal* const internal = this->getInternal();
+        return internal != 0 ? internal->hasReceivers() : false;
+    }
+    
+    void addReceiver (EventReceiver* receiver) throw()
+    {
+        if (this->getInternal() != 0)
+            this->getInternal()->addReceiver (receiver);
+    }
+    
+    void removeReceiver (EventReceiver* receiver) throw()
+    {
+        if (this->getInternal() != 0)
+            this->getInternal()->removeReceiver (receiver);
+    }
+    
+    /** Returns the number of events dropped because the ring was full. */
+    int getNumDropped() const throw()
+    {
+        const Internal* const internal = this->getInternal();
+        return internal != 0 ? internal->getNumDropped() : 0;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Delivers events from EventSender objects to their receivers.
+ The dispatcher polls its senders on its own thread at a fixed interval so 
+ the audio thread never needs to signal it. Senders that are no longer used
+ elsewhere are released (and so deleted) by the dispatcher thread once their
+ pending events have been delivered. 
+ @see EventSender */
+class EventDispatcher : public Threading::Thread
+{
+public:
+    /** Creates and starts a dispatcher. 
+     @param interval The polling interval in seconds. */
+    EventDispatcher (const double interval = 0.002) throw();
+    ~EventDispatcher();
+    
+    /** Returns a shared dispatcher. 
+     This is created on first use. */
+    static EventDispatcher& getDefault() throw();
+    
+    /** Adds a sender to be polled. 
+     This is lock-free. */
+    void add (EventSender const& sender) throw();
+    
+    /** @internal */
+    ResultCode run() throw();
+    
+private:
+    enum Constants
+    {
+        BatchSize = 64
+    };
+    
+    class Element : public PlonkBase
+    {
+    public:
+        Element() { }
+        Element (EventSender const& s) : sender (s) { }
+        
+        EventSender sender;
+    };
+    
+    const double interval;
+    LockFreeQueue<Element> added;
+    ObjectArray<EventSender> senders;
+    Event batch[BatchSize];
+    
+    void dispatch() throw();
+    
+    EventDispatcher (EventDispatcher const&);
+    EventDispatcher& operator= (EventDispatcher const&);
+};
+
+#endif // PLONK_EVENTDISPATCHER_H
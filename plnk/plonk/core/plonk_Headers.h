@@ -74,10 +74,14 @@
 #include "../containers/plonk_Int24.h"
 #include "../containers/plonk_Fix.h"
 #include "../containers/plonk_Function.h"
+#include "../containers/plonk_RingBuffer.h"
 #include "../containers/plonk_LockFreeQueue.h"
 #include "../containers/plonk_LockFreeStack.h"
 #include "../containers/plonk_ObjectMemoryDeferFree.h"
 #include "../containers/plonk_ObjectMemoryPools.h"
+#include "../containers/plonk_ObjectMemorySlabs.h"
+#include "../core/plonk_TaskExecutor.h"
+#include "../core/plonk_EventDispatcher.h"
 
 #include "../containers/variables/plonk_VariableForwardDeclarations.h"
 #include "../containers/variables/plonk_Variable.h"
@@ -112,6 +116,7 @@
 #include "../fft/plonk_FFTEngine.h"
 #include "../fft/plonk_FFTEngineInternal.h"
 #include "../fft/plonk_FFTBuffers.h"
+#include "../containers/plonk_WavetableBank.h"
 
 #include "../graph/plonk_GraphForwardDeclarations.h"
 
@@ -128,6 +133,7 @@
 #include "../graph/utility/plonk_SampleRate.h"
 #include "../graph/utility/plonk_Bus.h"
 #include "../graph/utility/plonk_TimeStamp.h"
+#include "../graph/utility/plonk_ScratchArena.h"
 #include "../graph/utility/plonk_ProcessInfo.h"
 #include "../graph/utility/plonk_ProcessInfoInternal.h"
 
@@ -152,6 +158,7 @@
 #include "../graph/simple/plonk_BusReadChannel.h"
 #include "../graph/simple/plonk_BusWriteChannel.h"
 #include "../graph/simple/plonk_Mixers.h"
+#include "../graph/simple/plonk_VoicePool.h"
 #include "../graph/simple/plonk_BlockChannel.h"
 #include "../graph/simple/plonk_VariableChannel.h"
 #include "../graph/simple/plonk_RampChannel.h"
@@ -173,6 +180,8 @@
 #include "../graph/filters/plonk_FilterTypes.h"
 #include "../graph/filters/plonk_FilterForms.h"
 #include "../graph/filters/plonk_FilterShapes.h"
+#include "../graph/filters/plonk_FilterCoeffsControl.h"
+#include "../graph/filters/plonk_FilterBank.h"
 #include "../graph/filters/plonk_Filter.h"
 #include "../graph/filters/plonk_FilterCoeffs1Param.h"
 #include "../graph/filters/plonk_FilterCoeffs2Param.h"
@@ -196,6 +205,8 @@
 #include "../graph/delay/plonk_Delay2Param.h"
 #include "../graph/delay/plonk_Delay3Param.h"
 #include "../graph/delay/plonk_Delay4Param.h"
+#include "../graph/delay/plonk_MultiTapDelay.h"
+#include "../graph/delay/plonk_FDNReverb.h"
 
 #include "../graph/control/plonk_EnvelopeChannel.h"
 #include "../graph/control/plonk_TriggerChannel.h"
@@ -208,6 +219,9 @@
 #include "../graph/fft/plonk_ZMulChannel.h"
 #include "../graph/fft/plonk_ConvolveChannel.h"
 
+#include "../graph/utility/plonk_GraphScheduler.h"
+
 #include "../hosts/plonk_AudioHostBase.h"
+#include "../hosts/plonk_OfflineAudioHost.h"
 
 #endif // PLONKHEADERS_H
\ No newline at end of file
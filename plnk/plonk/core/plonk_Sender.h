@@ -70,6 +70,10 @@ public:
     void updateRaw (Text const& message, Dynamic const& payload) throw();
     void updateWeak (Text const& message, Dynamic const& payload) throw();
     
+    /** Returns true if any receivers are attached.
+     Senders can use this to avoid building messages nobody will receive. */
+    bool hasReceivers() const throw();
+    
 private:
     SimpleArray<Receiver*>      rawReceivers;
     SimpleArray<WeakPointer*>   weakReceiverOwners;
@@ -146,6 +150,12 @@ void SenderInternal<SenderContainerBaseType>::removeReceiver (WeakPointer* const
     }
 }
 
+template<class SenderContainerBaseType>
+bool SenderInternal<SenderContainerBaseType>::hasReceivers() const throw()
+{    
+    return (rawReceivers.getInternal()->length() > 0) || (weakReceiverOwners.getInternal()->length() > 0);
+}    
+
 template<class SenderContainerBaseType>
 void SenderInternal<SenderContainerBaseType>::update (Text const& message, Dynamic const& payload) throw()
 {    
@@ -258,8 +258,8 @@ void SmartPointerCounter::incrementRefCount() throw()
         
         plonk_assert ((refCount & PLANK_ATOMIC_XREFCOUNTMAX) != 0); // overflow occurred
         
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
+        success = atom.compareAndSwapRelaxed (ptr, oldExtra,
+                                              ptr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
     } while (! success);
 }
 
@@ -276,12 +276,15 @@ void SmartPointerCounter::decrementRefCount() throw()
         refCount = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) - 1;
         newPtr   = refCount == 0 ? static_cast<SmartPointer*> (0) : oldPtr;
         
-        success = atom.compareAndSwap (oldPtr, oldExtra,
-                                       newPtr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
+        success = atom.compareAndSwapRelease (oldPtr, oldExtra,
+                                              newPtr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
     } while (! success);
     
     if (refCount == 0)
     {
+        // the decrements only release so this must see everything the other 
+        // owners did to the object before it can be deleted
+        AtomicOps::memoryBarrierAcquire();
         delete oldPtr; // might be zero in multithreaded if we inc'd and dec'd again but that's OK
         
         if (PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) == 0)
@@ -308,8 +311,8 @@ void SmartPointerCounter::incrementWeakCount() throw()
         
         plonk_assert ((weakCount & PLANK_ATOMIC_XWEAKCOUNTMAX) != 0); // overflow occurred
         
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
+        success = atom.compareAndSwapRelaxed (ptr, oldExtra,
+                                              ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
     } while (! success);
 }
 
@@ -325,12 +328,15 @@ void SmartPointerCounter::decrementWeakCount() throw()
         oldExtra  = atom.getExtraUnchecked();
         weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) - 1;
         
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
+        success = atom.compareAndSwapRelease (ptr, oldExtra,
+                                              ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
     } while (! success);
     
     if ((weakCount == 0) && (PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) == 0))
+    {
+        AtomicOps::memoryBarrierAcquire();
         delete this;
+    }
 }
 
 int SmartPointerCounter::getWeakCount() const throw()
@@ -355,8 +361,8 @@ void SmartPointerCounter::incrementCounts() throw()
         plonk_assert ((refCount & PLANK_ATOMIC_XREFCOUNTMAX) != 0); // overflow occurred
         plonk_assert ((weakCount & PLANK_ATOMIC_XWEAKCOUNTMAX) != 0); // overflow occurred
 
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
+        success = atom.compareAndSwapRelaxed (ptr, oldExtra,
+                                              ptr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
     } while (! success);
 }
 
@@ -376,12 +382,13 @@ void SmartPointerCounter::decrementCounts() throw()
         
         newPtr    = refCount == 0 ? static_cast<SmartPointer*> (0) : oldPtr;
         
-        success = atom.compareAndSwap (oldPtr, oldExtra,
-                                       newPtr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
+        success = atom.compareAndSwapRelease (oldPtr, oldExtra,
+                                              newPtr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
     } while (! success);
     
     if (refCount == 0)
     {
+        AtomicOps::memoryBarrierAcquire();
         delete oldPtr; // might be zero in multithreaded if we inc'd and dec'd again but that's OK
         
         if (weakCount == 0)
@@ -0,0 +1,309 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "plonk_Headers.h"
+
+TaskExecutor::Deque::Deque() throw()
+{
+    for (int i = 0; i < Size; ++i)
+        jobs[i] = 0;
+}
+
+TaskExecutor::Deque::~Deque()
+{
+}
+
+bool TaskExecutor::Deque::push (Job* job) throw()
+{
+    const int b = bottom.getValueUnchecked();
+    const int t = top.getValue();
+    
+    if ((b - t) >= Size)
+        return false;
+    
+    jobs[b & Mask] = job;
+    bottom.setValue (b + 1); // a full barrier so the job is visible before the new bottom
+    return true;
+}
+
+TaskExecutor::Job* TaskExecutor::Deque::pop() throw()
+{
+    const int b = bottom.getValueUnchecked() - 1;
+    bottom.setValue (b);
+    
+    const int t = top.getValue();
+    
+    if (t > b)
+    {
+        bottom.setValue (b + 1); // empty
+        return 0;
+    }
+    
+    Job* job = jobs[b & Mask];
+    
+    if (t == b)
+    {
+        // the last job, race any thieves for it
+        if (! top.compareAndSwap (t, t + 1))
+            job = 0;
+        
+        bottom.setValue (b + 1);
+    }
+    
+    return job;
+}
+
+TaskExecutor::Job* TaskExecutor::Deque::steal() throw()
+{
+    const int t = top.getValue();
+    AtomicOps::memoryBarrier();
+    const int b = bottom.getValue();
+    
+    if (t >= b)
+        return 0;
+    
+    Job* job = jobs[t & Mask];
+    
+    return top.compareAndSwap (t, t + 1) ? job : 0;
+}
+
+//------------------------------------------------------------------------------
+
+TaskExecutor::Worker::Worker (TaskExecutor& o, const int i) throw()
+:   Threading::Thread ("TaskExecutor Worker"),
+    owner (o),
+    index (i),
+    priority (-1)
+{
+}
+
+ResultCode TaskExecutor::Worker::run() throw()
+{
+    int idle = 0;
+    
+    while (! getShouldExit())
+    {
+        const int requestedPriority = owner.priority.getValueUnchecked();
+        
+        if (requestedPriority != priority)
+        {
+            setPriority (requestedPriority);
+            priority = requestedPriority;
+        }
+        
+        Job* job = owner.next (index);
+        
+        if (job != 0)
+        {
+            owner.run (job);
+            idle = 0;
+        }
+        else if (++idle < SpinCount)
+        {
+            Threading::yield();
+        }
+        else
+        {
+            ++owner.numSleeping;
+            
+            // check again in case a job was submitted before we were counted as sleeping
+            job = owner.next (index);
+            
+            if (job != 0)
+            {
+                --owner.numSleeping;
+                owner.run (job);
+                idle = 0;
+            }
+            else
+            {
+                owner.event.wait (0.01);
+                --owner.numSleeping;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+
+TaskExecutor::TaskExecutor (const int numThreads) throw()
+:   priority (50),
+    event (Lock::MutexLock)
+{
+    const int count = numThreads > 0 ? numThreads : plonk::max (1, Threading::getNumCores() - 1);
+    
+    for (int i = 0; i < count; ++i)
+        workers.add (new Worker (*this, i));
+    
+    // start once all the workers exist as they steal from each other
+    for (int i = 0; i < count; ++i)
+        workers.atUnchecked (i)->start();
+}
+
+TaskExecutor::~TaskExecutor()
+{
+    const int numWorkers = workers.length();
+    int i;
+    
+    for (i = 0; i < numWorkers; ++i)
+        workers.atUnchecked (i)->setShouldExit();
+    
+    // the flag is already set so just wake the workers until they have exited
+    for (i = 0; i < numWorkers; ++i)
+    {
+        Worker* const worker = workers.atUnchecked (i);
+        
+        while (worker->isRunning())
+        {
+            event.signal();
+            Threading::sleep (0.000001);
+        }
+    }
+    
+    for (i = 0; i < numWorkers; ++i)
+        delete workers.atUnchecked (i);
+    
+    // any jobs still queued were not ended so are still owned by their users
+    injected.clearAll();
+}
+
+TaskExecutor& TaskExecutor::getDefault() throw()
+{
+    static TaskExecutor executor;
+    return executor;
+}
+
+int TaskExecutor::getNumThreads() const throw()
+{
+    return workers.length();
+}
+
+void TaskExecutor::submit (Job* job) throw()
+{
+    plonk_assert (job != 0);
+    
+    // only the first request since the job last ran needs to queue it
+    if (++job->pending == 1)
+        enqueue (job);
+}
+
+void TaskExecutor::end (Job* job) throw()
+{
+    plonk_assert (job != 0);
+    
+    // the job may be deleted by a worker as soon as the flag is set
+    if ((job->pending += EndFlag) == EndFlag)
+        enqueue (job);
+}
+
+void TaskExecutor::requestPriority (const int newPriority) throw()
+{
+    priority.setIfLarger (newPriority);
+}
+
+void TaskExecutor::enqueue (Job* job) throw()
+{
+    const Threading::ID currentThreadID = Threading::getCurrentThreadID();
+    const int numWorkers = workers.length();
+    bool done = false;
+    
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        Worker* worker = workers.atUnchecked (i);
+        
+        if (worker->getID() == currentThreadID)
+        {
+            done = worker->deque.push (job);
+            break;
+        }
+    }
+    
+    if (! done)
+        injected.push (Element (job));
+    
+    if (numSleeping.getValueUnchecked() > 0)
+        event.signal();
+}
+
+TaskExecutor::Job* TaskExecutor::next (const int index) throw()
+{
+    Job* job = workers.atUnchecked (index)->deque.pop();
+    
+    if (job != 0)
+        return job;
+    
+    job = injected.pop().job;
+    
+    if (job != 0)
+        return job;
+    
+    const int numWorkers = workers.length();
+    
+    for (int i = 1; (i < numWorkers) && (job == 0); ++i)
+        job = workers.atUnchecked ((index + i) % numWorkers)->deque.steal();
+    
+    return job;
+}
+
+void TaskExecutor::run (Job* job) throw()
+{
+    for (;;)
+    {
+        const int requests = job->pending.getValue();
+        
+        if (requests & EndFlag)
+        {
+            delete job;
+            return;
+        }
+        
+        job->perform();
+        
+        // any requests made while performing mean it needs to run again
+        if (job->pending.compareAndSwap (requests, 0))
+            return;
+    }
+}
+
+END_PLONK_NAMESPACE
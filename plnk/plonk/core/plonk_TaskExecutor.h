@@ -0,0 +1,173 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_TASKEXECUTOR_H
+#define PLONK_TASKEXECUTOR_H
+
+#include "plonk_CoreForwardDeclarations.h"
+#include "plonk_Thread.h"
+#include "plonk_Lock.h"
+
+
+/** A bounded pool of threads for running background jobs.
+ This is used by the Task units so that many tasks share a few threads rather
+ than each having a thread of their own. 
+ 
+ Each worker thread has its own work-stealing deque: jobs submitted from a 
+ worker (e.g., a Task rendering a graph containing another Task) go onto that
+ worker's deque, other submissions go onto a shared lock-free queue. Idle 
+ workers take from their own deque, then the shared queue, then steal from 
+ the other workers.
+ 
+ A job is only ever run by one worker at a time. Submitting a job that is
+ already queued or running just makes sure it runs once more so submit() 
+ is cheap enough to call on the audio thread each block. 
+ @see InputTaskUnit */
+class TaskExecutor
+{
+public:
+    /** A job for the TaskExecutor.
+     Inherit from this and implement perform(). Once submitted to an executor
+     the job must only be destroyed by calling TaskExecutor::end(). */
+    class Job
+    {
+    public:
+        Job() throw() { }
+        virtual ~Job() { }
+        
+        /** Does the work for the job. 
+         This should do all of the work currently available. */
+        virtual void perform() throw() = 0;
+        
+    private:
+        AtomicInt pending;
+        friend class TaskExecutor;
+    };
+    
+    /** Creates an executor.
+     @param numThreads The number of worker threads, if this is zero one less 
+                       than the number of cores is used (with a minimum of one). */
+    TaskExecutor (const int numThreads = 0) throw();
+    ~TaskExecutor();
+    
+    /** Returns a shared executor. 
+     This is created on first use. */
+    static TaskExecutor& getDefault() throw();
+    
+    /** Requests that the job is run. 
+     This is safe to call from any thread. Queuing the job is lock-free but if
+     a worker is sleeping it is woken by signalling an event which briefly 
+     takes a mutex. */
+    void submit (Job* job) throw();
+    
+    /** Requests that the job is deleted.
+     The job is deleted by one of the workers once it is not running. The job
+     must not be used by the caller after this call. */
+    void end (Job* job) throw();
+    
+    /** Raises the priority of the worker threads.
+     This is never lowered as the threads are shared between jobs. */
+    void requestPriority (const int priority) throw();
+    
+    int getNumThreads() const throw();
+    
+private:
+    class Element : public PlonkBase
+    {
+    public:
+        Element() : job (0) { }
+        Element (Job* j) : job (j) { }
+        
+        Job* job;
+    };
+    
+    /** A fixed size Chase-Lev deque. 
+     Only the owning worker pushes and pops, any thread may steal. */
+    class Deque
+    {
+    public:
+        Deque() throw();
+        ~Deque();
+        
+        bool push (Job* job) throw();
+        Job* pop() throw();
+        Job* steal() throw();
+        
+    private:
+        enum Constants { Size = 256, Mask = Size - 1 };
+        
+        AtomicInt top;
+        AtomicInt bottom;
+        Job* volatile jobs[Size];
+    };
+    
+    class Worker : public Threading::Thread
+    {
+    public:
+        Worker (TaskExecutor& owner, const int index) throw();
+        ResultCode run() throw();
+        
+        Deque deque;
+        
+    private:
+        TaskExecutor& owner;
+        const int index;
+        int priority;
+    };
+    
+    enum Constants
+    {
+        EndFlag = 1 << 30,
+        SpinCount = 64
+    };
+    
+    ObjectArray<Worker*> workers;
+    LockFreeQueue<Element> injected;
+    AtomicInt priority;
+    AtomicInt numSleeping;
+    Lock event;
+    
+    void enqueue (Job* job) throw();
+    Job* next (const int index) throw();
+    void run (Job* job) throw();
+    
+    TaskExecutor (TaskExecutor const&);
+    TaskExecutor& operator= (TaskExecutor const&);
+};
+
+#endif // PLONK_TASKEXECUTOR_H
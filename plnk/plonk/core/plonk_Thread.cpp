@@ -72,6 +72,11 @@ Threading::ID Threading::getCurrentThreadID() throw()
     return pl_ThreadCurrentID();
 }
 
+int Threading::getNumCores() throw()
+{
+    return pl_ThreadNumCores();
+}
+
 static AtomicValue<Threading::ID>& plonk_getAudioThreadIDRef() throw()
 {
     static AtomicValue<Threading::ID> audioThreadID;
@@ -209,6 +214,11 @@ bool Threading::Thread::setPriorityAudio (const int blockSize, const double samp
     return pl_Thread_SetPriorityAudio (getPeerRef(), blockSize, sampleRate) == PlankResult_OK;
 }
 
+bool Threading::Thread::setAffinity (const int core) throw()
+{
+    return pl_Thread_SetAffinity (getPeerRef(), core) == PlankResult_OK;
+}
+
 Threading::ID Threading::Thread::getID() throw()
 {
     return pl_Thread_GetID (getPeerRef());
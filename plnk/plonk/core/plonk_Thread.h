@@ -56,6 +56,9 @@ public:
     /** Get the calling thread ID. */
     static Threading::ID getCurrentThreadID() throw();
     
+    /** Get the number of processor cores available. */
+    static int getNumCores() throw();
+    
     static Threading::ID getAudioThreadID() throw(); // there will be more that one audio thread when going multicore, not really only one actual "audio thread"
     static bool setAudioThreadID (const Threading::ID theID) throw();
     static bool currentThreadIsAudioThread() throw();
@@ -130,6 +133,11 @@ public:
         bool setPriority (const int priority) throw();
         bool setPriorityAudio (const int blockSize, const double sampleRate) throw();
         
+        /** Pins the thread to a processor core.
+         This may be called before start() in which case the affinity is 
+         applied once the thread is running. Not all platforms support this. */
+        bool setAffinity (const int core) throw();
+        
         /** Get this thread's ID. */
         Threading::ID getID() throw();
         
@@ -56,6 +56,39 @@ static RNG& getConvolveRNG()
 
 template<class SampleType> class FFTBuffersBase;
 
+/** A run of equally sized partitions of an impulse response.
+ These are used for non-uniform convolution where each stage uses a larger
+ FFT than the one before and starts further into the impulse response. */
+template<class SampleType>
+class FFTPartitionsStage
+{
+public:
+    typedef NumericalArray2D<SampleType>    BuffersType;
+    typedef FFTEngineBase<SampleType>       FFTEngineType;
+    
+    FFTPartitionsStage() throw()
+    :   offset (0),
+        numPartitions (0)
+    {
+    }
+    
+    FFTPartitionsStage (FFTEngineType const& fftEngineToUse,
+                        const int offsetToUse,
+                        const int numPartitionsToUse,
+                        BuffersType const& spectraToUse) throw()
+    :   fftEngine (fftEngineToUse),
+        offset (offsetToUse),
+        numPartitions (numPartitionsToUse),
+        spectra (spectraToUse)
+    {
+    }
+    
+    FFTEngineType fftEngine;    ///< The engine, the partition size is its halfLength().
+    int offset;                 ///< The offset of the first partition in the impulse response.
+    int numPartitions;          ///< The number of partitions in this stage.
+    BuffersType spectra;        ///< The partitions for each channel, each is the length of the FFT.
+};
+
 template<class SampleType>
 class FFTBuffersInternal : public SmartPointer
 {
@@ -65,12 +98,21 @@ public:
     typedef NumericalArray2D<SampleType>    BuffersType;
     typedef FFTEngineBase<SampleType>       FFTEngineType;
     typedef SignalBase<SampleType>          SignalType;
+    typedef FFTPartitionsStage<SampleType>  PartitionsType;
+    typedef ObjectArray<PartitionsType>     PartitionsArrayType;
+    
+    enum Constants
+    {
+        NumHeadDivisions = 4,
+        NumStagePartitions = 4
+    };
 
     
     FFTBuffersInternal (FFTEngineType const& fftEngineToUse, BuffersType const& sourceBuffers) throw()
     :   fftEngine (fftEngineToUse),
         originalLength (0),
-        numDivisions (0)
+        numDivisions (0),
+        partitionsMaxFFTSize (0)
     {
         setBuffersInternal (sourceBuffers);
         initProcessBuffers();
@@ -80,7 +122,8 @@ public:
     FFTBuffersInternal (FFTEngineType const& fftEngineToUse, SignalType const& sourceSignal) throw()
     :   fftEngine (fftEngineToUse),
         originalLength (0),
-        numDivisions (0)
+        numDivisions (0),
+        partitionsMaxFFTSize (0)
     {
         setSignalInternal (sourceSignal);
         initProcessBuffers();
@@ -248,6 +291,19 @@ public:
         return countDownStart.atUnchecked (channel);
     }
     
+    PartitionsArrayType getPartitions (const int maxFFTSize) throw()
+    {
+        AutoLock lock (partitionsLock);
+        
+        if (maxFFTSize != partitionsMaxFFTSize)
+        {
+            partitions = createPartitions (maxFFTSize);
+            partitionsMaxFFTSize = maxFFTSize;
+        }
+        
+        return partitions;
+    }
+    
     friend class FFTBuffersBase<SampleType>;
     
 private:
@@ -261,6 +317,109 @@ private:
     {
         return processBuffers.atUnchecked (channel).getArray();
     }
+    
+    /** Splits the impulse response into stages of increasing partition size.
+     The first stage uses the existing divisions, the rest are transformed
+     from the impulse response recovered from those divisions. */
+    PartitionsArrayType createPartitions (const int maxFFTSize) throw()
+    {
+        PartitionsArrayType result;
+        
+        if (originalLength <= 0)
+            return result;
+        
+        const int fftSize = (int) fftEngine.length();
+        const int headSize = (int) fftEngine.halfLength();
+        const int maxPartitionSize = maxFFTSize / 2;
+        
+        if ((maxPartitionSize <= headSize) || (numDivisions <= NumHeadDivisions))
+        {
+            result.add (PartitionsType (fftEngine, 0, numDivisions, fftBuffers));
+            return result;
+        }
+        
+        result.add (PartitionsType (fftEngine, 0, NumHeadDivisions, fftBuffers));
+        
+        // the divisions were transformed with this engine so undo any scaling it applies
+        BufferType tempBuffer = BufferType::newClear (fftSize);
+        BufferType transformBuffer = BufferType::withSize (fftSize);
+        SampleType* const tempSamples = tempBuffer.getArray();
+        SampleType* const transformSamples = transformBuffer.getArray();
+        
+        tempSamples[0] = SampleType (1);
+        fftEngine.forward (transformSamples, tempSamples);
+        fftEngine.inverse (tempSamples, transformSamples);
+        const SampleType gain = SampleType (1) / tempSamples[0];
+        
+        const int numChannels = fftBuffers.length();
+        const int impulseLength = numDivisions * headSize;
+        BuffersType impulses;
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            BufferType impulse = BufferType::withSize (impulseLength);
+            SampleType* impulseSamples = impulse.getArray();
+            
+            for (int division = 0; division < numDivisions; ++division)
+            {
+                fftEngine.inverse (tempSamples, getDivision (channel, division));
+                
+                for (int i = 0; i < headSize; ++i)
+                    impulseSamples[i] = tempSamples[i] * gain;
+                
+                impulseSamples += headSize;
+            }
+            
+            impulses.add (impulse);
+        }
+        
+        int offset = NumHeadDivisions * headSize;
+        int partitionSize = headSize * 2;
+        
+        while (offset < impulseLength)
+        {
+            partitionSize = plonk::min (partitionSize, maxPartitionSize);
+            
+            const int stageFFTSize = partitionSize * 2;
+            int numPartitions = (impulseLength - offset + partitionSize - 1) / partitionSize;
+            
+            if (partitionSize < maxPartitionSize)
+                numPartitions = plonk::min (numPartitions, int (NumStagePartitions));
+            
+            FFTEngineType stageEngine (stageFFTSize);
+            BufferType stageTempBuffer = BufferType::withSize (stageFFTSize);
+            SampleType* const stageTempSamples = stageTempBuffer.getArray();
+            BuffersType spectra;
+            
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                BufferType spectrum = BufferType::withSize (numPartitions * stageFFTSize);
+                SampleType* spectrumSamples = spectrum.getArray();
+                const SampleType* const impulseSamples = impulses.atUnchecked (channel).getArray();
+                
+                for (int partition = 0; partition < numPartitions; ++partition)
+                {
+                    const int start = offset + partition * partitionSize;
+                    const int dataLength = plonk::max (0, plonk::min (partitionSize, impulseLength - start));
+                    
+                    BufferType::copyData (stageTempSamples, impulseSamples + start, dataLength);
+                    BufferType::zeroData (stageTempSamples + dataLength, stageFFTSize - dataLength);
+                    
+                    stageEngine.forward (spectrumSamples, stageTempSamples);
+                    spectrumSamples += stageFFTSize;
+                }
+                
+                spectra.add (spectrum);
+            }
+            
+            result.add (PartitionsType (stageEngine, offset, numPartitions, spectra));
+            
+            offset += numPartitions * partitionSize;
+            partitionSize *= 2;
+        }
+        
+        return result;
+    }
 
 
     FFTBuffersInternal (BufferType const& singleFFTBuffer,
@@ -270,7 +429,8 @@ private:
     :   fftBuffers (singleFFTBuffer),
         fftEngine (fftEngineToUse),
         originalLength (originalLengthToUse),
-        numDivisions (numDivisionsToUse)
+        numDivisions (numDivisionsToUse),
+        partitionsMaxFFTSize (0)
     {
     }
     
@@ -280,6 +440,10 @@ private:
     Ints countDownStart;
     int originalLength;
     int numDivisions;
+    
+    PartitionsArrayType partitions;
+    int partitionsMaxFFTSize;
+    Lock partitionsLock;
 };
 
 //------------------------------------------------------------------------------
@@ -300,6 +464,7 @@ public:
     typedef NumericalArray2D<SampleType>            BuffersType;
     typedef FFTEngineBase<SampleType>               FFTEngineType;
     typedef SignalBase<SampleType>                  SignalType;
+    typedef typename Internal::PartitionsArrayType  PartitionsArrayType;
 
     FFTBuffersBase() throw()
     :	Base (new Internal (FFTEngine(), BuffersType()))
@@ -443,6 +608,16 @@ public:
         return this->getInternal()->getCountDownStart (channel);
     }
     
+    /** Get the impulse response split into stages of increasing partition size.
+     The first stage uses the divisions of this buffer, the others double in 
+     size up to half of maxFFTSize. These are created on first use and cached, 
+     this involves many FFTs so should be done before the buffers are used 
+     on the audio thread. @see ConvolveUnit::NonUniform */
+    PartitionsArrayType getPartitions (const int maxFFTSize) throw()
+    {
+        return this->getInternal()->getPartitions (maxFFTSize);
+    }
+    
 };
 
 //#if PLONK_INSTANTIATE_TEMPLATES
@@ -494,6 +494,54 @@ private:
     AudioFileMetaDataIOFlags (bool);
 };
 
+/** Fused conversion between packed PCM file data and samples.
+ The generic version does nothing and returns false so callers fall back to
+ swapping the data and converting it element by element. The float version
+ converts 16, 24 and 32-bit PCM in either byte order in a single pass. */
+template<class SampleType>
+class AudioFileConverter
+{
+public:
+    static PLONK_INLINE_LOW bool decode (SampleType* const dst, const void* const src, const int bytesPerSample, const bool isBigEndian, const bool applyScaling, const int numItems) throw()
+    {
+        (void)dst; (void)src; (void)bytesPerSample; (void)isBigEndian; (void)applyScaling; (void)numItems;
+        return false;
+    }
+    
+    static PLONK_INLINE_LOW bool encode (void* const dst, const SampleType* const src, const int bytesPerSample, const bool isBigEndian, const int numItems) throw()
+    {
+        (void)dst; (void)src; (void)bytesPerSample; (void)isBigEndian; (void)numItems;
+        return false;
+    }
+};
+
+template<>
+class AudioFileConverter<float>
+{
+public:
+    static PLONK_INLINE_LOW bool decode (float* const dst, const void* const src, const int bytesPerSample, const bool isBigEndian, const bool applyScaling, const int numItems) throw()
+    {
+        switch (bytesPerSample)
+        {
+            case 2: pl_VectorDecodePCM16F_NN (dst, src, isBigEndian, applyScaling ? 1.0f / PLANK_SHORTPEAK_F : 1.0f, numItems); return true;
+            case 3: pl_VectorDecodePCM24F_NN (dst, src, isBigEndian, applyScaling ? 1.0f / PLANK_INT24PEAK_F : 1.0f, numItems); return true;
+            case 4: pl_VectorDecodePCM32F_NN (dst, src, isBigEndian, applyScaling ? 1.0f / PLANK_INTPEAK_F : 1.0f, numItems); return true;
+            default: return false;
+        }
+    }
+    
+    static PLONK_INLINE_LOW bool encode (void* const dst, const float* const src, const int bytesPerSample, const bool isBigEndian, const int numItems) throw()
+    {
+        switch (bytesPerSample)
+        {
+            case 2: pl_VectorEncodePCM16F_NN (dst, src, isBigEndian, PLANK_SHORTPEAK_F, numItems); return true;
+            case 3: pl_VectorEncodePCM24F_NN (dst, src, isBigEndian, PLANK_INT24PEAK_F, numItems); return true;
+            case 4: pl_VectorEncodePCM32F_NN (dst, src, isBigEndian, PLANK_INTPEAK_F, numItems); return true;
+            default: return false;
+        }
+    }
+};
+
 
 
 #endif // PLONK_AUDIOFILE_H
@@ -53,7 +53,7 @@ AudioFileReaderInternal::AudioFileReaderInternal() throw()
     pl_AudioFileReader_Init (getPeerRef());
 }
 
-AudioFileReaderInternal::AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw()
+AudioFileReaderInternal::AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped) throw()
 :   readBuffer (Chars::withSize ((bufferSize > 0) ? bufferSize : AudioFile::DefaultBufferSize)),
     numFramesPerBuffer (0),
     newPositionOnNextRead (-1),
@@ -62,15 +62,16 @@ AudioFileReaderInternal::AudioFileReaderInternal (const char* path, const int bu
     audioFileChanged (false),
     defaultNumChannels (0)
 {
-    init (path, metaDataIOFlags);
+    init (path, metaDataIOFlags, mapped);
 }
 
-ResultCode AudioFileReaderInternal::init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw()
+ResultCode AudioFileReaderInternal::init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped) throw()
 {
     plonk_assert (path != 0);
     
     pl_AudioFileReader_Init (getPeerRef());
-    ResultCode result = pl_AudioFileReader_OpenInternal (getPeerRef(), path, metaDataIOFlags.getValue());
+    ResultCode result = mapped ? pl_AudioFileReader_OpenMapped (getPeerRef(), path, metaDataIOFlags.getValue())
+                               : pl_AudioFileReader_OpenInternal (getPeerRef(), path, metaDataIOFlags.getValue());
     
     const int bytesPerFrame = getBytesPerFrame();
     
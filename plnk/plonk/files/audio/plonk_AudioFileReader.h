@@ -56,7 +56,7 @@ public:
     typedef AudioFileReader Container;
 
     AudioFileReaderInternal() throw();
-    AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
+    AudioFileReaderInternal (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped = false) throw();
     AudioFileReaderInternal (ByteArray const& bytes, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
     AudioFileReaderInternal (FilePathArray const& paths, const AudioFile::MultiFileTypes multiMode, const int bufferSize) throw();
     AudioFileReaderInternal (FilePathArray const& paths, IntVariable const& indexRef, const int bufferSize) throw();
@@ -98,6 +98,9 @@ public:
     template<class SampleType>
     void readFrames (NumericalArray<SampleType>& data, const bool applyScaling, const bool deinterleave, IntVariable& numLoops) throw();
     
+    template<class SampleType>
+    int readFrames (SampleType* const data, const int dataLength, const bool applyScaling, const bool deinterleave, IntVariable& numLoops) throw();
+    
     template<class SampleType>
     PLONK_INLINE_LOW void initSignal (SignalBase<SampleType>& signal, const int numFrames) const throw()
     {
@@ -140,7 +143,7 @@ public:
     PLONK_INLINE_LOW const PlankAudioFileReaderRef getPeerRef() const { return const_cast<const PlankAudioFileReaderRef> (&peer); }
 
 private:
-    ResultCode init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
+    ResultCode init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped = false) throw();
     ResultCode init (ByteArray const& bytes, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
 
     template<class Type>
@@ -153,6 +156,20 @@ private:
         if (dataIsBigEndian) Endian::swap (data, numItems);
 #endif
     }
+    
+    /** Determines if samples accessed in place can be converted without copying,
+     i.e., they need no byte swapping and are suitably aligned for their type. */
+    static PLONK_INLINE_LOW bool canConvertInPlace (const void* data, const int bytesPerSample, const bool dataIsBigEndian) throw()
+    {
+#if PLONK_BIGENDIAN
+        const bool isNativeEndian = (bytesPerSample == 1) || dataIsBigEndian;
+#endif
+#if PLONK_LITTLEENDIAN
+        const bool isNativeEndian = (bytesPerSample == 1) || ! dataIsBigEndian;
+#endif
+        const uintptr_t alignment = (bytesPerSample == 3) ? 1 : bytesPerSample;
+        return isNativeEndian && ((reinterpret_cast<uintptr_t> (data) & (alignment - 1)) == 0);
+    }
 
     PlankAudioFileReader peer;
     Chars readBuffer;
@@ -174,6 +191,20 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
                                           const bool applyScaling, 
                                           const bool deinterleave,
                                           IntVariable& numLoops) throw()
+{
+    const int dataLength = data.length();
+    const int dataIndex = readFrames (data.getArray(), dataLength, applyScaling, deinterleave, numLoops);
+    
+    if (dataIndex < dataLength)
+        data.setSize (dataIndex, true);
+}
+
+template<class SampleType>
+int AudioFileReaderInternal::readFrames (SampleType* const data,
+                                         const int dataLength,
+                                         const bool applyScaling, 
+                                         const bool deinterleave,
+                                         IntVariable& numLoops) throw()
 {        
     typedef NumericalArray<SampleType> Buffer;
     
@@ -182,10 +213,9 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
     this->audioFileChanged   = false;
     ResultCode result        = PlankResult_OK;
     
-    const int dataLength     = data.length();
     int dataRemaining        = dataLength;
     
-    SampleType* dataArray = data.getArray();
+    SampleType* dataArray = data;
     void* const readBufferArray = readBuffer.getArray();
     
     int encoding = getEncoding();
@@ -235,7 +265,14 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             break; // not enough data left for one frame
 
         int framesRead;
-        result = pl_AudioFileReader_ReadFrames (getPeerRef(), PLANK_FALSE, framesToRead, readBufferArray, &framesRead);
+        const void* directArray = 0;
+        
+        // mapped and memory files can be converted straight from the file data
+        if (pl_AudioFileReader_CanReadFramesDirect (getPeerRef()))
+            result = pl_AudioFileReader_ReadFramesDirect (getPeerRef(), framesToRead, &directArray, &framesRead);
+        else
+            result = pl_AudioFileReader_ReadFrames (getPeerRef(), PLANK_FALSE, framesToRead, readBufferArray, &framesRead);
+        
         plonk_assert ((result == PlankResult_OK) ||
                       (result == PlankResult_FileEOF) ||
                       (result == PlankResult_AudioFileFrameFormatChanged) ||
@@ -246,55 +283,72 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             const int samplesRead = framesRead * channels;
             plonk_assert (samplesRead <= dataRemaining);
             
-            if (isPCM)
+            void* convertArray = readBufferArray;
+            
+            // common formats are swapped, sign extended and scaled in one pass
+            const bool decoded = isPCM && AudioFileConverter<SampleType>::decode (dataArray, 
+                                                                                  directArray != 0 ? directArray : readBufferArray, 
+                                                                                  bytesPerSample, isBigEndian, applyScaling, 
+                                                                                  samplesRead);
+            
+            if ((directArray != 0) && ! decoded)
+            {
+                // the in-place data is never written since it needs no swapping
+                if (canConvertInPlace (directArray, bytesPerSample, isBigEndian))
+                    convertArray = const_cast<void*> (directArray);
+                else
+                    Chars::copyData (static_cast<Char*> (readBufferArray), static_cast<const Char*> (directArray), samplesRead * bytesPerSample);
+            }
+            
+            if (isPCM && ! decoded)
             {            
                 if (bytesPerSample == 2)
                 {
-                    Short* const convertBuffer = static_cast<Short*> (readBufferArray); 
+                    Short* const convertBuffer = static_cast<Short*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 3)
                 {
-                    Int24* const convertBuffer = static_cast<Int24*> (readBufferArray); 
+                    Int24* const convertBuffer = static_cast<Int24*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 4)
                 {
-                    Int* const convertBuffer = static_cast<Int*> (readBufferArray); 
+                    Int* const convertBuffer = static_cast<Int*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 1)
                 {
-                    Char* const convertBuffer = static_cast<Char*> (readBufferArray); 
+                    Char* const convertBuffer = static_cast<Char*> (convertArray); 
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else
                 {
                     plonk_assertfalse;
-                    return;
+                    return dataIndex;
                 }
             }
             else if (isFloat)
             {
                 if (bytesPerSample == 4)
                 {
-                    Float* const convertBuffer = static_cast<Float*> (readBufferArray); 
+                    Float* const convertBuffer = static_cast<Float*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 8)
                 {
-                    Double* const convertBuffer = static_cast<Double*> (readBufferArray); 
+                    Double* const convertBuffer = static_cast<Double*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else
                 {
                     plonk_assertfalse;
-                    return;
+                    return dataIndex;
                 }
             }
             
@@ -365,12 +419,11 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
     }
     
 exit:
-    if (dataIndex < dataLength)
-        data.setSize (dataIndex, true);
-    
     this->hitEndOfFile       = (result == PlankResult_FileEOF);
     this->numChannelsChanged = (result == PlankResult_AudioFileFrameFormatChanged);
     this->audioFileChanged   = (result == PlankResult_AudioFileChanged);
+    
+    return dataIndex;
 }
 
 
@@ -432,6 +485,17 @@ public:
 	{
 	}
     
+    /** Creates an audio file reader that maps the file into memory.
+     Uncompressed files (WAV, AIFF, CAF, W64) are then converted directly from the
+     mapped data rather than being read into the intermediate buffer first. Other
+     files, or files that can't be mapped, are opened as usual.
+     @param path        The path of the file to read.
+     @param bufferSize  The buffer size to use when the data needs to be copied. */
+    static AudioFileReader mapped (FilePath const& path, const int bufferSize = 0, UnsignedInt const& metaDataIOFlags = AudioFile::MetaDataIOFlagsNone) throw()
+    {
+        return AudioFileReader (new Internal (path.fullpath().getArray(), bufferSize, AudioFileMetaDataIOFlags (metaDataIOFlags), true));
+    }
+    
     /** Creates an audio file reader from the given path.
      @param path        The path of the file to read.
      @param bufferSize  The buffer size to use when reading. */
@@ -713,6 +777,19 @@ public:
         getInternal()->readFrames (data, true, false, numLoops);
     }
     
+    /** Read frames into memory owned by the caller and apply scaling. 
+     This is the same as the NumericalArray version but, since the length of 
+     the memory can't be changed, the amount read is returned instead.
+     @param data        The memory to read interleaved frames into.
+     @param dataLength  The number of samples (not frames) to read.
+     @param numLoops    How many loops to read, 0 means infinite loops. 
+     @return The number of samples read. */
+    template<class SampleType>
+    PLONK_INLINE_LOW int readFrames (SampleType* const data, const int dataLength, IntVariable& numLoops) throw()
+    {
+        return getInternal()->readFrames (data, dataLength, true, false, numLoops);
+    }
+    
     /** Read frames into a pre-allocated NumericalArray without scaling. 
      @param data    The NumericalArray object to read interleaved frames into. 
      @param numLoops    How many loops to read, 0 means infinite loops. */
@@ -449,6 +449,36 @@ public:
         pl_AudioFileWriter_Close (&peer);
     }
     
+    bool startAsync (const int blockFrames, const int numBlocks) throw()
+    {
+        return pl_AudioFileWriter_StartAsync (&peer, blockFrames, numBlocks) == PlankResult_OK;
+    }
+    
+    bool isAsync() throw()
+    {
+        return pl_AudioFileWriter_IsAsync (&peer);
+    }
+    
+    void flushAsync() throw()
+    {
+        pl_AudioFileWriter_FlushAsync (&peer);
+    }
+    
+    float getAsyncLoad() throw()
+    {
+        return pl_AudioFileWriter_GetAsyncLoad (&peer);
+    }
+    
+    LongLong getAsyncDroppedFrames() throw()
+    {
+        return pl_AudioFileWriter_GetAsyncDroppedFrames (&peer);
+    }
+    
+    ResultCode getAsyncResult() throw()
+    {
+        return pl_AudioFileWriter_GetAsyncResult (&peer);
+    }
+    
     bool writeFrames (const int numFrames, const SampleType* frameData) throw()
     {
         return pl_AudioFileWriter_WriteFrames (&peer, true, numFrames, frameData) == PlankResult_OK;
@@ -472,14 +502,26 @@ public:
         SampleType* const nativeSamples = buffer.getArray();
         const OtherType* sourceSamples = frames.getArray();
         const int nativeSamplesLength = buffer.length();
+        const int encoding = peer.formatInfo.encoding;
+        const bool isPCM = (encoding & PLANKAUDIOFILE_ENCODING_PCM_FLAG) && (peer.formatInfo.bytesPerFrame == int (sizeof (SampleType)) * numChannels);
+        const bool isBigEndian = encoding & PLANKAUDIOFILE_ENCODING_BIGENDIAN_FLAG;
         
         int numSamplesRemainaing = frames.length();
         
         while (numSamplesRemainaing > 0)
         {
             const int numSamplesThisTime = plonk::min (nativeSamplesLength, numSamplesRemainaing);
-            NumericalArrayConverter<SampleType, OtherType>::convertScaled (nativeSamples, sourceSamples, numSamplesThisTime);
-            success = pl_AudioFileWriter_WriteFrames (&peer, true, numSamplesThisTime / numChannels, nativeSamples) == PlankResult_OK;
+            
+            // common formats are scaled, clipped and put in file byte order in one pass
+            if (isPCM && AudioFileConverter<OtherType>::encode (nativeSamples, sourceSamples, sizeof (SampleType), isBigEndian, numSamplesThisTime))
+            {
+                success = pl_AudioFileWriter_WriteFrames (&peer, false, numSamplesThisTime / numChannels, nativeSamples) == PlankResult_OK;
+            }
+            else
+            {
+                NumericalArrayConverter<SampleType, OtherType>::convertScaled (nativeSamples, sourceSamples, numSamplesThisTime);
+                success = pl_AudioFileWriter_WriteFrames (&peer, true, numSamplesThisTime / numChannels, nativeSamples) == PlankResult_OK;
+            }
             
             if (! success) break;
             
@@ -664,6 +706,50 @@ public:
     {
         this->getInternal()->close();
     }
+    
+    /** Hand the encoding and file writes to a background thread.
+     Call this after the file is opened. From then on writeFrames() only copies 
+     the frames into a preallocated ring of blocks so it won't block on the 
+     encoder, and each writer started this way encodes on its own thread. 
+     If the ring is full the frames that don't fit are dropped and writeFrames() 
+     returns false. close() waits for the queued frames to be written.
+     @param blockFrames The number of frames in each block, or 0 for the default.
+     @param numBlocks   The number of blocks in the ring, or 0 for the default. */
+    bool startAsync (const int blockFrames = 0, const int numBlocks = 0) throw()
+    {
+        return this->getInternal()->startAsync (blockFrames, numBlocks);
+    }
+    
+    /** Determines if the frames are being written on a background thread. */
+    bool isAsync() const throw()
+    {
+        return this->getInternal()->isAsync();
+    }
+    
+    /** Pass a partly filled block to the background thread. */
+    void flushAsync() throw()
+    {
+        this->getInternal()->flushAsync();
+    }
+    
+    /** Get the proportion of the background ring in use, from 0 to 1. 
+     This rises towards 1 when the encoder isn't keeping up. */
+    float getAsyncLoad() const throw()
+    {
+        return this->getInternal()->getAsyncLoad();
+    }
+    
+    /** Get the number of frames dropped because the background ring was full. */
+    LongLong getAsyncDroppedFrames() const throw()
+    {
+        return this->getInternal()->getAsyncDroppedFrames();
+    }
+    
+    /** Get the result of the last failed write on the background thread. */
+    ResultCode getAsyncResult() const throw()
+    {
+        return this->getInternal()->getAsyncResult();
+    }
 
     bool isReady() const throw()
     {
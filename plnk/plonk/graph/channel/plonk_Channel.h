@@ -193,6 +193,8 @@ public:
     
     PLONK_INLINE_LOW ChannelBase getChannel (const int index) throw()                 { return ChannelBase (this->getInternal()->getChannel (index)); }
     PLONK_INLINE_LOW ChannelBase operator[] (const int index) throw()                 { return ChannelBase (this->getInternal()->getChannel (index)); }
+    
+    PLONK_INLINE_LOW EventSender getEventSender() throw()                             { return this->getInternal()->getEventSender(); }
 
     PLONK_INLINE_LOW const TimeStamp& getNextTimeStamp() const throw()                { return this->getInternal()->getNextTimeStamp(); }
     PLONK_INLINE_LOW bool shouldBeDeletedNow (TimeStamp const& time) const throw()    { return this->getInternal()->shouldBeDeletedNow (time); }
@@ -227,14 +229,35 @@ public:
 
     PLONK_INLINE_LOW void process (ProcessInfo& info, const int channel) throw()
     {        
-        if (this->needsToProcess (info))
+        Internal* const internal = this->getInternal();
+        const LongLong sampleClock = info.getSampleClock();
+        
+        // with a sample clock the integer comparison avoids the time stamp arithmetic
+        const bool clocked = (sampleClock >= 0) && internal->usesSampleClock (info.getSampleClockRate());
+        const LongLong nextSampleClock = internal->getNextSampleClock();
+        const bool needsToProcess = (clocked && (nextSampleClock >= 0)) ? (sampleClock >= nextSampleClock) : this->needsToProcess (info);
+        
+        if (needsToProcess)
         {
-            this->getInternal()->process (info, channel);
-            this->getInternal()->setLastTimeStamp (info.getTimeStamp());
-            this->getInternal()->updateTimeStamp();
+            internal->process (info, channel);
+            
+            if (clocked)
+            {
+                internal->updateSampleClock (info.getTimeStamp(), sampleClock);
+            }
+            else
+            {
+                internal->setLastTimeStamp (info.getTimeStamp());
+                internal->updateTimeStamp();
+            }
             
             if (info.getShouldDelete() == true)
-                this->getInternal()->setExpiryTimeStamp (this->getInternal()->getNextTimeStamp());
+                internal->setExpiryTimeStamp (internal->getNextTimeStamp());
+        }
+        else if (info.getPreRendered() && internal->wasMarkedForDeletionAt (info.getTimeStamp()))
+        {
+            // rendered by the GraphScheduler, pass on its deletion request
+            info.setShouldDelete();
         }
     }
     
@@ -165,6 +165,28 @@ public:
     virtual void setOverlap (DoubleVariable const& newOverlap) = 0;
     
     virtual ChannelInternalBase* getChannel (const int index) = 0;
+    
+    /** Copies the input channels that this channel sums independently.
+     Channels that return @c true from hasParallelInputs() write each of their
+     input channels, along with the channel index each is processed with, so 
+     that the GraphScheduler can render them concurrently. No more than 
+     @e maximum items are written and this must not allocate.
+     @return The number of input channels, this may be more than @e maximum. */
+    virtual int getParallelInputs (ChannelType* channels, int* channelIndices, const int maximum) throw()
+    {
+        (void)channels;
+        (void)channelIndices;
+        (void)maximum;
+        return 0;
+    }
+    
+    /** Returns the sender for this channel's realtime events.
+     Channels that post Event objects (e.g., FilePlay cue points) override this,
+     others return a null sender. @see EventSender */
+    virtual EventSender getEventSender() throw()
+    {
+        return EventSender::getNull();
+    }
             
     virtual void initValue (SampleType const& value) throw()
     {
@@ -49,11 +49,16 @@ ChannelInternalCore::ChannelInternalCore (Inputs const& inputsToUse,
 :   lastTimeStamp (-1, 0.0),
     nextTimeStamp (TimeStamp::getZero()),
     expiryTimeStamp (TimeStamp::getMaximum()),
+    nextSampleClock (-1),
+    sampleClockRatio (0),
+    sampleClockRate (0.0),
+    nextTimeStampPending (false),
     inputs (inputsToUse),
     blockSize (blockSizeToUse),
     sampleRate (sampleRateToUse),
     overlap (inputs.containsKey (IOKey::OverlapMake) ? getInputAs<DoubleVariable> (IOKey::OverlapMake) : Math<DoubleVariable>::get1())
 {
+    resolveInputs();
     cacheSampleDurationTicks();
     
     plonk_assert (blockSize.getValue() >= 0);
@@ -61,6 +66,32 @@ ChannelInternalCore::ChannelInternalCore (Inputs const& inputsToUse,
     plonk_assert (overlap.getValue() <= 1.0);
 }
 
+void ChannelInternalCore::resolveInputs() throw()
+{
+    const ObjectArray<int>& keys = inputs.getKeys();
+    const int numKeys = keys.length();
+    
+    plonk_assert (numKeys < 256); // the slots are bytes
+    
+    // the slots only go up to the largest key used so are small, 
+    // the index is stored rather than the item so replacing an item is safe
+    int maxKey = -1;
+    
+    for (int i = 0; i < numKeys; ++i)
+        maxKey = plonk::max (maxKey, keys.atUnchecked (i));
+    
+    inputSlots.setSize (maxKey + 1, false);
+    inputSlots.zero();
+    
+    for (int i = 0; i < numKeys; ++i)
+    {
+        const int key = keys.atUnchecked (i);
+        
+        if (key >= 0)
+            inputSlots.atUnchecked (key) = UnsignedChar (i + 1);
+    }
+}
+
 void ChannelInternalCore::updateTimeStamp() throw()
 {
     if (this->lastTimeStamp >= TimeStamp::getZero()) // would like to avoid this condition..
@@ -68,6 +99,10 @@ void ChannelInternalCore::updateTimeStamp() throw()
         const double blockDuration = this->getBlockDurationInTicks();
         this->setNextTimeStamp (this->lastTimeStamp + blockDuration);
     }
+    else
+    {
+        nextSampleClock = -1;
+    }
 }
 
 void ChannelInternalCore::setLabel (Text const& newId) throw()
@@ -84,11 +119,13 @@ void ChannelInternalCore::setSampleRateInternal (SampleRate const& newSampleRate
 {
     sampleRate = newSampleRate;
     cacheSampleDurationTicks();
+    sampleClockRate = 0.0; // recalculate the ratio on the next render
 }
 
 void ChannelInternalCore::setOverlapInternal (DoubleVariable const& newOverlap) throw()
 {
     overlap = newOverlap;
+    sampleClockRate = 0.0;
 }
 
 void ChannelInternalCore::cacheSampleDurationTicks() const throw()
@@ -96,6 +133,30 @@ void ChannelInternalCore::cacheSampleDurationTicks() const throw()
     cachedSampleDurationTicks = TimeStamp::getTicks() / sampleRate.getValue(); 
 }
 
+void ChannelInternalCore::cacheSampleClockRatio (const double newSampleClockRate) throw()
+{
+    const double channelSampleRate = sampleRate.getValue();
+    
+    sampleClockRate = newSampleClockRate;
+    sampleClockRatio = 0;
+    
+    if (channelSampleRate == 0.0)
+    {
+        sampleClockRatio = -1; // a constant, renders once only
+    }
+    else if ((channelSampleRate > 0.0) && (newSampleClockRate >= channelSampleRate) && (overlap.getValue() == 1.0))
+    {
+        const double ratio = newSampleClockRate / channelSampleRate;
+        const LongLong integerRatio = LongLong (ratio + 0.5);
+        
+        if (double (integerRatio) == ratio)
+            sampleClockRatio = integerRatio;
+    }
+    
+    if (sampleClockRatio == 0)
+        nextSampleClock = -1;
+}
+
 TextArray ChannelInternalCore::getInputNames() const throw()
 {
     return IOKey::collectNames (this->getInputKeys());
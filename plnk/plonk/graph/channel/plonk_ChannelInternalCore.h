@@ -71,23 +71,44 @@ public:
     
     typedef struct ChannelData<ChannelInternalCore> Data;
     typedef InputDictionary                         Inputs;    
+    typedef Dynamic::GenericContainer               InputSlot;
     
     ChannelInternalCore (Inputs const& inputs,
                          BlockSize const& blockSize, 
                          SampleRate const& sampleRate) throw();
     virtual ~ChannelInternalCore() { }
     
-    const TimeStamp& getNextTimeStamp() const throw() { return nextTimeStamp; }
+    const TimeStamp& getNextTimeStamp() const throw();
     void setNextTimeStamp (TimeStamp const& newTimeStamp) throw();
     void setLastTimeStamp (TimeStamp const& newTimeStamp) throw();
     void setExpiryTimeStamp (TimeStamp const& newTimeStamp) throw();
     bool shouldBeDeletedNow (TimeStamp const& time) const throw();
+    bool wasMarkedForDeletionAt (TimeStamp const& time) const throw();
     
     PLONK_INLINE_HIGH const Inputs& getInputs() const throw()                                      { return this->inputs; }
     PLONK_INLINE_HIGH Inputs& getInputs() throw()                                                  { return this->inputs; }
     
-    template<class Type> PLONK_INLINE_MID const Type& getInputAs (const int key) const throw()    { return this->inputs[key].asUnchecked<Type>(); }
-    template<class Type> PLONK_INLINE_MID Type& getInputAs (const int key) throw()                { return this->inputs[key].asUnchecked<Type>(); }
+    template<class Type> 
+    PLONK_INLINE_MID const Type& getInputAs (const int key) const throw()
+    {
+        plonk_assert (TypeUtility<Type>::getTypeCode() == this->inputs[key].getTypeCode());
+        return reinterpret_cast<const Type&> (*this->getInputSlot (key));
+    }
+    
+    template<class Type> 
+    PLONK_INLINE_MID Type& getInputAs (const int key) throw()
+    {
+        plonk_assert (TypeUtility<Type>::getTypeCode() == this->inputs[key].getTypeCode());
+        return reinterpret_cast<Type&> (*this->getInputSlot (key));
+    }
+    
+    /** Resolves each input key to the index of its item in the inputs dictionary.
+     getInputAs() then indexes the dictionary directly rather than searching 
+     it on every call. This is done on construction. Replacing an item or 
+     changing the value of a variable input (e.g., to patch in a new unit) 
+     doesn't need this. If keys are added to or removed from the dictionary 
+     the affected inputs fall back to searching until this is called again. */
+    void resolveInputs() throw();
     
     const BlockSize& getBlockSize() const throw()    { return blockSize; }
     const SampleRate& getSampleRate() const throw()  { return sampleRate; }    
@@ -99,6 +120,21 @@ public:
     double getSampleDurationInTicks() const throw()  { return cachedSampleDurationTicks; }
     double getBlockDurationInTicks() const throw();
     void updateTimeStamp() throw();
+    
+    /** Returns @c true if this channel can be timed by a sample clock at the given rate. 
+     This requires the clock rate to be an integer multiple of this channel's 
+     sample rate and no overlap. Constant channels (with a zero sample rate) 
+     render only once so can always use the sample clock. */
+    bool usesSampleClock (const double sampleClockRate) throw();
+    
+    /** The sample clock value at which this channel next needs to render. 
+     This is -1 if this is unknown, for example when the channel was last 
+     rendered without a sample clock, and the time stamp must be checked. */
+    LongLong getNextSampleClock() const throw()   { return nextSampleClock; }
+    
+    /** Updates the timing after rendering at the given sample clock. 
+     The next time stamp is only calculated if it is needed. */
+    void updateSampleClock (TimeStamp const& time, const LongLong sampleClock) throw();
         
     virtual bool isNull() const throw()                 { return false; }
     virtual bool isConstant() const throw()             { return false; }
@@ -109,6 +145,26 @@ public:
     virtual double getLatency() const throw()           { return 0.0;   }
     virtual int getNumChannels() const throw()          { return 1; }
     
+    /** Returns @c false if this channel's inputs may be changed while it is running.
+     The GraphScheduler will not render subgraphs containing such channels 
+     on its worker threads. */
+    virtual bool hasStaticInputs() const throw()        { return true; }
+    
+    /** Returns @c true if this channel sums independent inputs (i.e., a mixer).
+     The GraphScheduler may then render the channels from 
+     ChannelInternalBase::getParallelInputs() concurrently. This must not 
+     change while the channel is running. */
+    virtual bool hasParallelInputs() const throw()      { return false; }
+    
+    /** Returns a value that changes whenever the parallel inputs change. 
+     Mixers whose inputs are fixed return zero. The GraphScheduler checks 
+     this once per block on the audio thread. */
+    virtual int getParallelInputsVersion() const throw() { return 0; }
+    
+    /** Returns the channel that does the processing for this channel.
+     Proxy channels return their owner. */
+    virtual ChannelInternalCore* getProcessingInternal() throw() { return this; }
+    
     virtual Text getLabel() const throw()               { return identifier; }  // virtual due to proxies
     virtual void setLabel (Text const& newId) throw();                          // virtual due to proxies
 
@@ -135,15 +191,39 @@ protected:
 private:    
     Text identifier;
     TimeStamp lastTimeStamp;
-    TimeStamp nextTimeStamp;
+    mutable TimeStamp nextTimeStamp;
     TimeStamp expiryTimeStamp;
+    LongLong nextSampleClock;
+    LongLong sampleClockRatio;
+    double sampleClockRate;
+    mutable bool nextTimeStampPending;
     Inputs inputs;
+    UnsignedChars inputSlots;
     BlockSize blockSize;
     SampleRate sampleRate;
     DoubleVariable overlap;
     mutable double cachedSampleDurationTicks;
     
     void cacheSampleDurationTicks() const throw();
+    void cacheSampleClockRatio (const double newSampleClockRate) throw();
+    
+    /** The slots are indexed by key and hold one more than the index of the 
+     key in the inputs dictionary, or zero if it isn't an input. The key is 
+     checked at that index in case the keys have changed since. Keys without 
+     a valid slot fall back to the dictionary which returns a null item as before. */
+    PLONK_INLINE_HIGH InputSlot* getInputSlot (const int key) const throw()
+    {
+        if ((key >= 0) && (key < inputSlots.length()))
+        {
+            const int index = int (inputSlots.atUnchecked (key)) - 1;
+            const ObjectArray<int>& keys = this->inputs.getKeys();
+            
+            if ((index >= 0) && (index < keys.length()) && (keys.atUnchecked (index) == key))
+                return const_cast<InputSlot*> (&this->inputs.atIndexUnchecked (index).getItem());
+        }
+        
+        return const_cast<InputSlot*> (&this->inputs[key].getItem());
+    }
     
     ChannelInternalCore();
     ChannelInternalCore (const ChannelInternalCore&);
@@ -152,10 +232,23 @@ private:
 
 //------------------------------------------------------------------------------
 
+PLONK_INLINE_HIGH const TimeStamp& ChannelInternalCore::getNextTimeStamp() const throw()
+{
+    if (nextTimeStampPending)
+    {
+        nextTimeStamp = lastTimeStamp + this->getBlockDurationInTicks();
+        nextTimeStampPending = false;
+    }
+    
+    return nextTimeStamp;
+}
+
 PLONK_INLINE_HIGH void ChannelInternalCore::setNextTimeStamp (TimeStamp const& time) throw()
 {
 //    plonk_assert ((nextTimeStamp.isInfinite() && time.isInfinite()) || (time > nextTimeStamp)); // gone backwards or wraparound
     nextTimeStamp = time;
+    nextTimeStampPending = false;
+    nextSampleClock = -1;
 }
 
 PLONK_INLINE_HIGH void ChannelInternalCore::setLastTimeStamp (TimeStamp const& time) throw()
@@ -174,6 +267,28 @@ PLONK_INLINE_HIGH bool ChannelInternalCore::shouldBeDeletedNow (TimeStamp const&
     return time >= expiryTimeStamp;
 }
 
+PLONK_INLINE_HIGH bool ChannelInternalCore::wasMarkedForDeletionAt (TimeStamp const& time) const throw()
+{
+    return (lastTimeStamp == time) && (expiryTimeStamp == this->getNextTimeStamp());
+}
+
+PLONK_INLINE_HIGH bool ChannelInternalCore::usesSampleClock (const double clockRate) throw()
+{
+    if (clockRate != sampleClockRate)
+        this->cacheSampleClockRatio (clockRate);
+    
+    return sampleClockRatio != 0;
+}
+
+PLONK_INLINE_HIGH void ChannelInternalCore::updateSampleClock (TimeStamp const& time, const LongLong sampleClock) throw()
+{
+    plonk_assert (time.isFinite());
+    lastTimeStamp = time;
+    nextTimeStampPending = true;
+    nextSampleClock = (sampleClockRatio > 0) ? sampleClock + LongLong (this->getBlockSize().getValue()) * sampleClockRatio 
+                                             : TypeUtility<LongLong>::getTypePeak();
+}
+
 PLONK_INLINE_MID double ChannelInternalCore::getBlockDurationInTicks() const throw()
 { 
     return this->getSampleDurationInTicks() * double (this->getBlockSize().getValue()) * overlap.getValue();
@@ -112,6 +112,11 @@ public:
     
     bool isProxy() const throw() { return true; }
     
+    ChannelInternalCore* getProcessingInternal() throw()
+    {
+        return owner.getInternal();
+    }
+    
     InternalBase* getChannel (const int /*index*/) throw()
     {
         return this;
@@ -122,6 +127,14 @@ public:
         return owner.getNumChannels();
     }
     
+    EventSender getEventSender() throw()
+    {
+        InternalBase* proxyOwner 
+            = static_cast<InternalBase*> (owner.getInternal());
+        
+        return proxyOwner->getEventSender();
+    }
+    
     void initChannel (const int channel) throw()
     {        
         InternalBase* proxyOwner 
@@ -108,14 +108,31 @@ class TaskBufferInternal : public SmartPointer
 public:
     typedef NumericalArray<SampleType> Buffer;
     typedef LockFreeQueue<TaskMessage> TaskMessages;
+    typedef ObjectArray<Event>         Events;
+    
+    enum Constants
+    {
+        MaxEvents = 32
+    };
     
     TaskBufferInternal (const int size) throw()
-    :   buffer (Buffer::newClear (size))
+    :   buffer (Buffer::newClear (size)),
+        events (Events::withSize (MaxEvents)),
+        numEvents (0)
+    {
+    }
+    
+    /** Stores an event with the buffer, events beyond MaxEvents are dropped. */
+    PLONK_INLINE_LOW void addEvent (Event const& event) throw()
     {
+        if (numEvents < MaxEvents)
+            events.atUnchecked (numEvents++) = event;
     }
     
     Buffer buffer;
-    TaskMessages messages;
+    TaskMessages messages;  // only used if the task channel has Receiver objects
+    Events events;          // preallocated so the audio thread never frees anything
+    int numEvents;
 };
 
 template<class SampleType>
@@ -161,35 +178,53 @@ public:
     
     //--------------------------------------------------------------------------
     
-    class InputTask :  public Threading::Thread, public Channel::Receiver
+    /** Renders the input into a queue of buffers on a TaskExecutor.
+     The audio thread returns each buffer it has used, which submits the
+     task to render the next one. */
+    class InputTask :  public TaskExecutor::Job, public Channel::Receiver
     {
     public:
         typedef LockFreeQueue<TaskBuffer> TaskBufferQueue;
         
-        InputTask (InputTaskChannelInternal* o) throw()
-        :   Threading::Thread (Text ("InputTaskChannelInternal::Thread[" + Text (*(LongLong*)&o) + Text ("]"))),
-            weakOwner (ChannelType (static_cast<ChannelInternalType*> (o))),
-            event (Lock::MutexLock),
-            inputEnded (0)
+        InputTask (InputTaskChannelInternal* o, EventSender const& eventSender) throw()
+        :   weakOwner (ChannelType (static_cast<ChannelInternalType*> (o))),
+            executor (TaskExecutor::getDefault()),
+            events (eventSender),
+            activeBuffers (TaskBufferQueue::withCapacity (o->getState().numBuffers, true)),
+            freeBuffers (TaskBufferQueue::withCapacity (o->getState().numBuffers, true)),
+            inputEnded (0),
+            hasFilledBuffers (false),
+            forwardMessages (false)
         {
         }
         
-        void changed (ChannelType const& source, Text const& message, Dynamic const& payload) throw()
+        ~InputTask()
         {
-            TaskMessage tm (message, payload);
-            currentTaskBuffer.getInternal()->messages.push (tm);
+            freeBuffers.clearAll();
+            activeBuffers.clearAll();
         }
         
-        void fillBuffers() throw()
+        /** Called on the task thread by the input's channels.
+         Messages are converted to events here so the audio thread only
+         needs to copy them to the owner's EventSender. */
+        void changed (ChannelType const& source, Text const& message, Dynamic const& payload) throw()
         {
-            ChannelType ownerChannel (weakOwner.fromWeak());
+            (void)source;
             
-            plonk_assert (ownerChannel.isNotNull());
-            
-            InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
+            if (events.hasReceivers())
+                currentTaskBuffer.getInternal()->addEvent (toEvent (message, payload));
             
+            if (forwardMessages)
+            {
+                TaskMessage tm (message, payload);
+                currentTaskBuffer.getInternal()->messages.push (tm);
+            }
+        }
+        
+        void fillBuffers (InputTaskChannelInternal* owner) throw()
+        {
             Data& data = owner->getState();
-            setPriority (data.priority);
+            executor.requestPriority (data.priority);
             
             const int numBuffers = owner->getState().numBuffers;
             
@@ -200,100 +235,85 @@ public:
             
             for (int i = 0; i < numBuffers; ++i)
                 activeBuffers.push (TaskBuffer (bufferSize));
+            
+            hasFilledBuffers = true;
+        }
+        
+        void start() throw()
+        {
+            executor.submit (this);
         }
         
-        ResultCode run() throw()
+        void perform() throw()
         {
-            fillBuffers();
+            ChannelType ownerChannel (weakOwner.fromWeak());
             
-            Threading::yield();
-                
-            while (! getShouldExit())
+            if (ownerChannel.isNull())
+                return;
+            
+            InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
+            
+            if (! hasFilledBuffers)
+                fillBuffers (owner);
+            
+            ProcessInfo& info (owner->getProcessInfo());
+            UnitType& inputUnit (owner->getInputAsUnit (IOKey::Generic));
+            
+            const int numChannels = owner->getNumChannels();
+            const int blockSize = owner->getBlockSize().getValue();
+            
+            plonk_assert (inputUnit.channelsHaveSameBlockSize());
+            
+            forwardMessages = owner->hasReceivers();
+            
+            // render all the buffers returned by the audio thread so far
+            while (inputEnded.getValueUnchecked() == 0)
             {
-                ChannelType ownerChannel (weakOwner.fromWeak());
-                
-                if (ownerChannel.isNull())
-                    break;
-                
-                InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
-                ProcessInfo& info (owner->getProcessInfo());
-
-                UnitType& inputUnit (owner->getInputAsUnit (IOKey::Generic));
-                
                 if (inputUnit.shouldBeDeletedNow (info))
                 {
                     inputEnded.setValue (1);
-                    Threading::sleep (0.01);
-                    continue;
+                    break;
                 }
                 
-                const int numChannels = owner->getNumChannels();
-                const int blockSize = owner->getBlockSize().getValue();
-                const int numFreeBuffers = freeBuffers.length();
+                if (! freeBuffers.pop (currentTaskBuffer))
+                    break;
                 
-                plonk_assert (inputUnit.channelsHaveSameBlockSize());
-
-                if (numFreeBuffers > 0)
-                {                                        
-                    currentTaskBuffer = freeBuffers.pop(); // nothing else pops so must be still available
-                    Buffer& buffer = currentTaskBuffer.getInternal()->buffer;
-                    buffer.setSize (blockSize * numChannels, false);
+                Buffer& buffer = currentTaskBuffer.getInternal()->buffer;
+                buffer.setSize (blockSize * numChannels, false);
+                
+                SampleType* bufferSamples = buffer.getArray();
+                info.getScratch().reset();
+                
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const Buffer& inputBuffer (inputUnit.process (info, channel));                    
+                    const SampleType* inputSamples = inputBuffer.getArray();
+                    const int inputBufferLength = inputBuffer.length();
                     
-                    SampleType* bufferSamples = buffer.getArray();
-
-                    for (int channel = 0; channel < numChannels; ++channel)
+                    if (buffer.length() == (numChannels * inputBufferLength))
                     {
-                        const Buffer& inputBuffer (inputUnit.process (info, channel));                    
-                        const SampleType* inputSamples = inputBuffer.getArray();
-                        const int inputBufferLength = inputBuffer.length();
-                                                
-                        if (buffer.length() == (numChannels * inputBufferLength))
-                        {
-                            NumericalArray<SampleType>::copyData (bufferSamples, inputSamples, inputBufferLength);
-                            bufferSamples += inputBufferLength;
-                        }
-                        else
-                        {
-                            // probably got deleted..?
-                            buffer.zero();
-                            break;
-                        }
+                        NumericalArray<SampleType>::copyData (bufferSamples, inputSamples, inputBufferLength);
+                        bufferSamples += inputBufferLength;
+                    }
+                    else
+                    {
+                        // probably got deleted..?
+                        buffer.zero();
+                        break;
                     }
-                    
-                    activeBuffers.push (currentTaskBuffer);
-                    currentTaskBuffer = TaskBuffer::getNull();
-
-                    plonk_assert (inputUnit.channelsHaveSameSampleRate());
-                    info.offsetTimeStamp (owner->getSampleRate().getSampleDurationInTicks() * blockSize);
                 }
                 
-                if (numFreeBuffers == 1)
-                {
-                    event.wait (0.5);
-                }
-                else if (numFreeBuffers < (activeBuffers.length() * 2))
-                {
-                    Threading::sleep (owner->getBlockDurationInTicks() * TimeStamp::getReciprocalTicks());
-                }
-                else
-                {
-                    Threading::yield();
-                }
+                activeBuffers.push (currentTaskBuffer);
+                currentTaskBuffer = TaskBuffer::getNull();
+                
+                plonk_assert (inputUnit.channelsHaveSameSampleRate());
+                info.offsetTimeStamp (owner->getSampleRate().getSampleDurationInTicks() * blockSize);
             }
-            
-            freeBuffers.clearAll();
-            activeBuffers.clearAll();
-            
-            delete this;
-            
-            return PlankResult_ThreadWasDeleted;
         }
                 
         void end() throw()
         {
-            Lock e = this->event; // take a shared copy of the event
-            setShouldExit();      // this might delete this object before the next line
-            e.signal();           // or this will proceed past the wait, or be harmless if the thread died already
+            executor.end (this); // will delete the task once it is not running
         }
     
         PLONK_INLINE_LOW bool pop (TaskBuffer& buffer) throw()
@@ -304,8 +324,9 @@ public:
         PLONK_INLINE_LOW void push (TaskBuffer const& buffer) throw()
         {
             buffer.getInternal()->messages.clear();
+            buffer.getInternal()->numEvents = 0;
             freeBuffers.push (buffer);
-            event.signal();
+            executor.submit (this);
         }
         
         PLONK_INLINE_LOW bool inputHasEnded() const throw()
@@ -315,11 +336,36 @@ public:
     
     private:
         WeakChannelType weakOwner;
+        TaskExecutor& executor;
+        EventSender events;
         TaskBufferQueue activeBuffers;
         TaskBufferQueue freeBuffers;
         TaskBuffer currentTaskBuffer;
-        Lock event;
         AtomicInt inputEnded;
+        bool hasFilledBuffers;
+        bool forwardMessages;
+        
+        static Event toEvent (Text const& message, Dynamic const& payload) throw()
+        {
+            Event event (Event::intern (message));
+            
+            switch (payload.getTypeCode())
+            {
+                case TypeCode::IntVariable:
+                    event.index = payload.asUnchecked<IntVariable>().getValue();
+                    break;
+                case TypeCode::FloatVariable:
+                    event.value = payload.asUnchecked<FloatVariable>().getValue();
+                    break;
+                case TypeCode::DoubleVariable:
+                    event.value = payload.asUnchecked<DoubleVariable>().getValue();
+                    break;
+                default:
+                    break;
+            }
+            
+            return event;
+        }
     };
     
     //--------------------------------------------------------------------------
@@ -332,7 +378,8 @@ public:
     :   Internal (numChannelsInSource (inputs), 
                   inputs, data, blockSize, sampleRate,
                   channels),
-        task (new InputTask (this))
+        events (EventSender::DefaultCapacity),
+        task (new InputTask (this, events))
     {
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         inputUnit.addReceiverToChannels (task);
@@ -353,7 +400,7 @@ public:
     {
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         inputUnit.removeReceiverFromChannels (task);
-        task->end(); // will delete the task when its thread exits
+        task->end(); // will delete the task when it is not running
         task = 0;
     }
             
@@ -367,6 +414,21 @@ public:
         const IntArray keys (IOKey::Generic);
         return keys;
     }    
+    
+    /** Returns the sender for the messages from the input's channels. 
+     Message names are mapped to IDs using Event::intern(), IntVariable 
+     payloads are passed as the index and FloatVariable and DoubleVariable
+     payloads as the value. */
+    EventSender getEventSender() throw()
+    {
+        return events;
+    }
+    
+    bool hasStaticInputs() const throw()
+    {
+        // the input is rendered by a TaskExecutor
+        return false;
+    }
         
     void initChannel (const int channel) throw()
     {               
@@ -386,6 +448,13 @@ public:
         }
         else if (task->inputHasEnded())
         {
+            // the last buffers may hold messages, e.g., a Done message
+            while (task->pop (taskBuffer))
+            {
+                sendMessages (taskBuffer);
+                task->push (taskBuffer);
+            }
+            
             endTask();
             zeroOutput (numChannels);
         }
@@ -410,10 +479,7 @@ public:
             
             buffer.zero();
             
-            TaskMessage taskMessage;
-            while (taskBuffer.getInternal()->messages.pop (taskMessage))
-                this->update (taskMessage.getMessage(), taskMessage.getPayload());
-            
+            sendMessages (taskBuffer);
             task->push (taskBuffer);
         }
         else
@@ -434,7 +500,22 @@ public:
     
     ProcessInfo& getProcessInfo() throw() { return info; }
     
+    /** Sends the messages stored with a buffer by the task. */
+    void sendMessages (TaskBuffer& taskBuffer) throw()
+    {
+        const Event* const bufferEvents = taskBuffer.getInternal()->events.getArray();
+        const int numEvents = taskBuffer.getInternal()->numEvents;
+        
+        for (int i = 0; i < numEvents; ++i)
+            events.post (bufferEvents[i]);
+        
+        TaskMessage taskMessage;
+        while (taskBuffer.getInternal()->messages.pop (taskMessage))
+            this->update (taskMessage.getMessage(), taskMessage.getPayload());
+    }
+    
 private:
+    EventSender events;
     InputTask* task;
 
     ProcessInfo info; // private info for this object as we're running out of sync with everything else
@@ -463,7 +544,8 @@ private:
  @par @par Inputs:
  - input: (input, multi) the input unit to defer to a separate task
  - numBuffers: (int) the number of buffers to queue, also affects latency
- - priority: (int) the priority of the task (0-100, 100 is highest)
+ - priority: (int) the priority of the task (0-100, 100 is highest), tasks share the
+   threads of TaskExecutor::getDefault() so this raises the priority of those threads
  - preferredBlockSize: the preferred output block size 
  - preferredSampleRate: the preferred output sample rate
 
@@ -64,5 +64,11 @@ template<class SampleType, Interp::TypeCode InterpTypeCode = Interp::Linear> cla
 template<class SampleType, Interp::TypeCode InterpTypeCode = Interp::Linear> class AllpassFFFBUnit;
 template<class SampleType, Interp::TypeCode InterpTypeCode = Interp::Linear> class AllpassDecayUnit;
 
+template<class SampleType, Interp::TypeCode InterpTypeCode = Interp::Linear> class MultiTapDelayChannelInternal;
+template<class SampleType, Interp::TypeCode InterpTypeCode = Interp::Linear> class MultiTapDelayUnit;
+
+template<class SampleType> class FDNReverbChannelInternal;
+template<class SampleType> class FDNReverbUnit;
+
 
 #endif // PLONK_DELAYFORWARDDECLARATIONS_H
\ No newline at end of file
@@ -0,0 +1,515 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_FDNREVERB_H
+#define PLONK_FDNREVERB_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "plonk_DelayForwardDeclarations.h"
+
+/** Feedback matrices for the FDNReverb unit. */
+class FDNReverbMatrix
+{
+public:
+    enum Type
+    {
+        Hadamard,       ///< A scaled Hadamard matrix, every line feeds every other line equally.
+        Householder     ///< I - 2/N, cheaper mixing that favours each line's own feedback.
+    };
+};
+
+/** Damps the delay lines of an FDN reverb.
+ Each line has a one-pole lowpass y = a * w with w = x + p * w1. This is the
+ general version, processing one line at a time. */
+template<class SampleType>
+class FDNReverbDamping
+{
+public:
+    static PLONK_INLINE_LOW void process (SampleType* const* rows, const SampleType* gains, const SampleType* poles, SampleType* state, const int numLines, const int length) throw()
+    {
+        for (int i = 0; i < numLines; ++i)
+        {
+            SampleType* const samples = rows[i];
+            const SampleType a = gains[i];
+            const SampleType p = poles[i];
+            SampleType w1 = state[i * 2];
+            
+            for (int j = 0; j < length; ++j)
+            {
+                w1 = samples[j] + p * w1;
+                samples[j] = a * w1;
+            }
+            
+            state[i * 2] = w1;
+        }
+    }
+};
+
+/** Damps the delay lines of an FDN reverb.
+ Four lines at a time occupy the SIMD lanes of the two-pole, two-zero kernel
+ with the unused coefficients at zero. */
+template<>
+class FDNReverbDamping<float>
+{
+public:
+    static PLONK_INLINE_LOW void process (float* const* rows, const float* gains, const float* poles, float* state, const int numLines, const int length) throw()
+    {
+        static const float zero = 0.f;
+        const float* coeffs[PLANK_VFILTER_LANES * PLANK_VFILTER_NUMCOEFFS];
+        
+        plonk_assert ((numLines % PLANK_VFILTER_LANES) == 0);
+        
+        for (int i = 0; i < numLines; i += PLANK_VFILTER_LANES)
+        {
+            for (int j = 0; j < PLANK_VFILTER_LANES; ++j)
+            {
+                coeffs[0 * PLANK_VFILTER_LANES + j] = gains + i + j;    // a0
+                coeffs[1 * PLANK_VFILTER_LANES + j] = &zero;            // a1
+                coeffs[2 * PLANK_VFILTER_LANES + j] = &zero;            // a2
+                coeffs[3 * PLANK_VFILTER_LANES + j] = poles + i + j;    // b1
+                coeffs[4 * PLANK_VFILTER_LANES + j] = &zero;            // b2
+            }
+            
+            pl_VectorBiquadP2Z2x4F_NN (rows + i, rows + i, coeffs, 0, state + i * 2, length);
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+PLONK_CHANNELDATA_DECLARE(FDNReverbChannelInternal,SampleType)
+{    
+    ChannelInternalCore::Data base;
+    int numLines;
+    int matrix;
+    SampleType size;
+};      
+
+/** Feedback delay network reverb processor. 
+ All the delay lines are processed together a block at a time. Each line's 
+ length is at least the block size so a whole block can be read from every 
+ line before it is damped, mixed through the feedback matrix and written back. 
+ Working a line-length row at a time means the matrix is only vector adds and 
+ multiplies, and the damping filters step four lines at once. */
+template<class SampleType>
+class FDNReverbChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(FDNReverbChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(FDNReverbChannelInternal,SampleType)    Data;
+    typedef ChannelBase<SampleType>                                         ChannelType;
+    typedef ObjectArray<ChannelType>                                        ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                      Internal;
+    typedef UnitBase<SampleType>                                            UnitType;
+    typedef InputDictionary                                                 Inputs;
+    typedef NumericalArray<SampleType>                                      Buffer;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
+    typedef NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop> AddOp;
+    typedef NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::subop> SubOp;
+    typedef NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::mulop> MulOp;
+    typedef NumericalArrayMulAdd<SampleType>                                MulAddOp;
+    typedef FDNReverbDamping<SampleType>                                    Damping;
+    
+    enum OutputIndices { LeftOutput, RightOutput, NumOutputs };
+    enum Limits { MinimumLines = 4, MaximumLines = 32 };
+    
+    FDNReverbChannelInternal (Inputs const& inputs, 
+                              Data const& data, 
+                              BlockSize const& blockSize,
+                              SampleRate const& sampleRate,
+                              ChannelArrayType& channels) throw()
+    :   Internal (NumOutputs, inputs, data, blockSize, sampleRate, channels),
+        currentDecay (0),
+        currentFrequency (0)
+    {
+    }
+    
+    Text getName() const throw()
+    {
+        return "FDN Reverb";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Decay, IOKey::Frequency);
+        return keys;
+    }    
+    
+    void initChannel (const int channel) throw()
+    {        
+        const UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (inputUnit.getBlockSize (0),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (inputUnit.getSampleRate (0),
+                                                     this->getSampleRate()));
+            
+            this->setOverlap (inputUnit.getOverlap (0));
+            
+            const Data& data = this->getState();
+            const int numLines = data.numLines;
+            const int blockSize = this->getBlockSize().getValue();
+            
+            plonk_assert (Bits::isPowerOf2 (numLines) && numLines >= MinimumLines && numLines <= MaximumLines);
+            
+            lineLengths = IntArray::newClear (numLines);
+            linePositions = IntArray::newClear (numLines);
+            
+            int totalLength = 0;
+            
+            for (int i = 0; i < numLines; ++i)
+            {
+                lineLengths.put (i, getLineLength (i, numLines, data.size, data.base.sampleRate, blockSize));
+                totalLength += lineLengths.atUnchecked (i);
+            }
+            
+            lines = Buffer::newClear (totalLength);
+            rows = Buffer::newClear ((numLines + 2) * blockSize);
+            gains = Buffer::newClear (numLines);
+            poles = Buffer::newClear (numLines);
+            state = Buffer::newClear (numLines * 2);
+            currentDecay = SampleType (0);
+            currentFrequency = SampleType (0);
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }    
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        const Data& data = this->getState();
+        
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        UnitType& decayUnit (this->getInputAsUnit (IOKey::Decay));
+        UnitType& frequencyUnit (this->getInputAsUnit (IOKey::Frequency));
+        
+        const Buffer& inputBuffer (inputUnit.process (info, 0));
+        const Buffer& decayBuffer (decayUnit.process (info, 0));
+        const Buffer& frequencyBuffer (frequencyUnit.process (info, 0));
+        
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        plonk_assert (inputBuffer.length() == outputBufferLength);
+        plonk_assert (outputBufferLength <= this->getBlockSize().getValue());
+        
+        const int numLines = data.numLines;
+        SampleType* lineRows[MaximumLines];
+        SampleType* const inputRow = rows.getArray() + numLines * outputBufferLength;
+        SampleType* spareRow = inputRow + outputBufferLength;
+        SampleType* const leftOutputSamples = this->getOutputSamples (LeftOutput);
+        SampleType* const rightOutputSamples = this->getOutputSamples (RightOutput);
+        int i, j, k, h;
+        
+        updateCoeffs (decayBuffer.atUnchecked (0), frequencyBuffer.atUnchecked (0), data.base.sampleRate);
+        
+        // read a block from each line, the oldest samples are where we write
+        for (i = 0; i < numLines; ++i)
+        {
+            lineRows[i] = rows.getArray() + i * outputBufferLength;
+            readLine (i, lineRows[i], outputBufferLength);
+        }
+        
+        Damping::process (lineRows, gains.getArray(), poles.getArray(), state.getArray(), numLines, outputBufferLength);
+        
+        // even lines to the left and odd lines to the right
+        const SampleType outputGain = SampleType (1) / SampleType (plonk::sqrt (double (numLines / 2)));
+        MulOp::calcN1 (leftOutputSamples, lineRows[0], outputGain, outputBufferLength);
+        MulOp::calcN1 (rightOutputSamples, lineRows[1], outputGain, outputBufferLength);
+        
+        for (i = 2; i < numLines; i += 2)
+        {
+            MulAddOp::calcN1N (leftOutputSamples, lineRows[i], outputGain, leftOutputSamples, outputBufferLength);
+            MulAddOp::calcN1N (rightOutputSamples, lineRows[i + 1], outputGain, rightOutputSamples, outputBufferLength);
+        }
+        
+        SampleType feedbackScale;
+        
+        if (data.matrix == FDNReverbMatrix::Householder)
+        {
+            // M = I - 2/N, so each line less 2/N times the sum of all lines
+            Memory::copy (spareRow, lineRows[0], outputBufferLength * sizeof (SampleType));
+            
+            for (i = 1; i < numLines; ++i)
+                AddOp::calcNN (spareRow, spareRow, lineRows[i], outputBufferLength);
+            
+            const SampleType sumScale = SampleType (-2) / SampleType (numLines);
+            
+            for (i = 0; i < numLines; ++i)
+                MulAddOp::calcN1N (lineRows[i], spareRow, sumScale, lineRows[i], outputBufferLength);
+            
+            feedbackScale = SampleType (1);
+        }
+        else
+        {
+            // fast Walsh-Hadamard transform, the difference of each pair goes
+            // to the spare row which then takes the place of the second line
+            for (h = 1; h < numLines; h *= 2)
+            {
+                for (j = 0; j < numLines; j += h * 2)
+                {
+                    for (k = j; k < j + h; ++k)
+                    {
+                        SampleType* const difference = spareRow;
+                        SubOp::calcNN (difference, lineRows[k], lineRows[k + h], outputBufferLength);
+                        AddOp::calcNN (lineRows[k], lineRows[k], lineRows[k + h], outputBufferLength);
+                        spareRow = lineRows[k + h];
+                        lineRows[k + h] = difference;
+                    }
+                }
+            }
+            
+            feedbackScale = SampleType (1) / SampleType (plonk::sqrt (double (numLines)));
+        }
+        
+        // the input is added to every line, flipping the sign of alternate 
+        // lines' feedback keeps the matrix orthogonal but decorrelates them
+        const SampleType inputGain = SampleType (1) / SampleType (plonk::sqrt (double (numLines)));
+        MulOp::calcN1 (inputRow, inputBuffer.getArray(), inputGain, outputBufferLength);
+        
+        for (i = 0; i < numLines; ++i)
+        {
+            MulAddOp::calcN1N (lineRows[i], lineRows[i], (i & 1) ? -feedbackScale : feedbackScale, inputRow, outputBufferLength);
+            writeLine (i, lineRows[i], outputBufferLength);
+        }
+    }
+    
+private:
+    Buffer lines;
+    Buffer rows;
+    Buffer gains;
+    Buffer poles;
+    Buffer state;
+    IntArray lineLengths;
+    IntArray linePositions;
+    SampleType currentDecay;
+    SampleType currentFrequency;
+    
+    static bool isPrime (const int value) throw()
+    {
+        if (value < 2)
+            return false;
+        
+        for (int i = 2; i * i <= value; ++i)
+            if ((value % i) == 0)
+                return false;
+        
+        return true;
+    }
+    
+    // lengths spread exponentially between roughly 23ms and 83ms at size 1
+    // rounded up to primes so that no two lines share a common period
+    static int getLineLength (const int index, const int numLines, const SampleType size, const double sampleRate, const int blockSize) throw()
+    {
+        const double shortest = 0.0231;
+        const double longest = 0.0827;
+        const double position = double (index) / double (numLines - 1);
+        const double duration = shortest * plonk::pow (longest / shortest, position) * double (size);
+        
+        int length = plonk::max (int (duration * sampleRate), blockSize, 2);
+        
+        while (! isPrime (length))
+            ++length;
+        
+        return length;
+    }
+    
+    void updateCoeffs (const SampleType decay, const SampleType frequency, const double sampleRate) throw()
+    {
+        if ((decay == currentDecay) && (frequency == currentFrequency))
+            return;
+        
+        currentDecay = decay;
+        currentFrequency = frequency;
+        
+        const double nyquist = sampleRate * 0.5;
+        const double cutoff = plonk::clip (double (frequency), 1.0, nyquist);
+        const double pole = cutoff >= nyquist ? 0.0 : plonk::exp (-Math<double>::get2Pi() * cutoff / sampleRate);
+        const int numLines = lineLengths.length();
+        
+        for (int i = 0; i < numLines; ++i)
+        {
+            const double duration = double (lineLengths.atUnchecked (i)) / sampleRate;
+            const double gain = decay > SampleType (0) ? plonk::decayFeedback (duration, double (decay)) : 0.0;
+            
+            gains.put (i, SampleType (gain * (1.0 - pole)));
+            poles.put (i, SampleType (pole));
+        }
+    }
+    
+    PLONK_INLINE_LOW SampleType* getLineSamples (const int index) throw()
+    {
+        SampleType* samples = lines.getArray();
+        
+        for (int i = 0; i < index; ++i)
+            samples += lineLengths.atUnchecked (i);
+        
+        return samples;
+    }
+    
+    void readLine (const int index, SampleType* row, const int numSamples) throw()
+    {
+        const SampleType* const samples = getLineSamples (index);
+        const int length = lineLengths.atUnchecked (index);
+        const int position = linePositions.atUnchecked (index);
+        const int numSamplesToEnd = plonk::min (length - position, numSamples);
+        
+        plonk_assert (numSamples <= length);
+        
+        Memory::copy (row, samples + position, numSamplesToEnd * sizeof (SampleType));
+        
+        if (numSamplesToEnd < numSamples)
+            Memory::copy (row + numSamplesToEnd, samples, (numSamples - numSamplesToEnd) * sizeof (SampleType));
+    }
+    
+    void writeLine (const int index, const SampleType* row, const int numSamples) throw()
+    {
+        SampleType* const samples = getLineSamples (index);
+        const int length = lineLengths.atUnchecked (index);
+        const int position = linePositions.atUnchecked (index);
+        const int numSamplesToEnd = plonk::min (length - position, numSamples);
+        
+        Memory::copy (samples + position, row, numSamplesToEnd * sizeof (SampleType));
+        
+        if (numSamplesToEnd < numSamples)
+            Memory::copy (samples, row + numSamplesToEnd, (numSamples - numSamplesToEnd) * sizeof (SampleType));
+        
+        linePositions.put (index, (position + numSamples) % length);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Feedback delay network reverb.
+ 
+ A bank of delay lines whose outputs are damped, mixed through an orthogonal
+ feedback matrix and fed back into the lines. Each input channel drives its own
+ network and produces a pair of outputs, the even lines are summed to the left
+ and the odd lines to the right. The output is the reverberation only, mix in
+ the dry signal separately.
+ 
+ @par Factory functions:
+ - ar (input, decay=2, damping=5000, size=1, numLines=8, matrix=FDNReverbMatrix::Hadamard, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ 
+ @par Inputs:
+ - input: (unit, multi) the unit to which reverb is applied, each channel generates a pair of outputs
+ - decay: (unit, multi) the time in seconds for the reverb to decay by 60dB at low frequencies, read once per block
+ - damping: (unit, multi) the cutoff frequency in Hertz of the lowpass filter in each line's feedback, read once per block
+ - size: (real) scales the delay line lengths, 1 gives lines from about 23ms to 83ms
+ - numLines: (int) the number of delay lines, a power of 2 from 4 to 32 (8 or 16 are usual)
+ - matrix: (FDNReverbMatrix::Type) the feedback matrix, Hadamard or Householder
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup DelayUnits */
+template<class SampleType>
+class FDNReverbUnit
+{
+public:    
+    typedef FDNReverbChannelInternal<SampleType>    FDNReverbInternal;
+    typedef typename FDNReverbInternal::Data        Data;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("FDNReverb", "A feedback delay network reverb.",
+                         
+                         // outputs
+                         2, 
+                         IOKey::LeftOperand,    Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::RightOperand,   Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,        Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::Decay,          Measure::Seconds,   2.0,                IOLimit::Minimum,   Measure::Seconds,   0.0,
+                         IOKey::Frequency,      Measure::Hertz,     5000.0,             IOLimit::Clipped,   Measure::SampleRateRatio,   0.0, 0.5,
+                         IOKey::TimeScale,      Measure::Factor,    1.0,                IOLimit::Minimum,   Measure::Factor,    0.0,
+                         IOKey::Multiply,       Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::Add,            Measure::None,      0.0,                IOLimit::None,
+                         IOKey::BlockSize,      Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate,     Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }
+    
+    static UnitType ar (UnitType const& input,
+                        UnitType const& decay = SampleType (2),
+                        UnitType const& damping = SampleType (5000),
+                        const SampleType size = SampleType (1),
+                        const int numLines = 8,
+                        const FDNReverbMatrix::Type matrix = FDNReverbMatrix::Hadamard,
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {             
+        const int lines = plonk::clip (Bits::nextPowerOf2 (numLines), 
+                                       int (FDNReverbInternal::MinimumLines), 
+                                       int (FDNReverbInternal::MaximumLines));
+        const Data data = { { -1.0, -1.0 }, lines, int (matrix), size };
+        const int numInputChannels = input.getNumChannels();
+        UnitType result (UnitType::emptyWithAllocatedSize (numInputChannels * 2));
+        
+        for (int i = 0; i < numInputChannels; ++i)
+        {
+            Inputs inputs;
+            inputs.put (IOKey::Generic, input[i]);
+            inputs.put (IOKey::Decay, decay[i]);
+            inputs.put (IOKey::Frequency, damping[i]);
+            
+            result.add (UnitType::template proxiesFromInputs<FDNReverbInternal> (inputs,
+                                                                               data,
+                                                                               preferredBlockSize,
+                                                                               preferredSampleRate));
+        }
+        
+        return UnitType::applyMulAdd (result, mul, add);
+    }
+};
+
+typedef FDNReverbUnit<PLONK_TYPE_DEFAULT> FDNReverb;
+
+
+#endif // PLONK_FDNREVERB_H
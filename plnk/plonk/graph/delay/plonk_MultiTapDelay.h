@@ -0,0 +1,375 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_MULTITAPDELAY_H
+#define PLONK_MULTITAPDELAY_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "plonk_DelayForwardDeclarations.h"
+
+PLONK_CHANNELDATA_DECLARE(MultiTapDelayChannelInternal,SampleType)
+{    
+    typedef typename TypeUtility<SampleType>::IndexType DurationType;
+    
+    ChannelInternalCore::Data base;
+    DurationType maximumDuration;
+    int writePosition;
+};      
+
+//------------------------------------------------------------------------------
+
+/** Multi-tap delay processor. 
+ The input is written once to a single circular buffer and each channel of the 
+ duration input reads its own interpolated tap from it. Rather than mirroring 
+ every write into three copies of the buffer the whole block is written first 
+ and only the few samples the interpolator reads past either end are copied 
+ into guard regions once per block. */
+template<class SampleType, Interp::TypeCode InterpTypeCode>
+class MultiTapDelayChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(MultiTapDelayChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(MultiTapDelayChannelInternal,SampleType)    Data;
+    typedef ChannelBase<SampleType>                                             ChannelType;
+    typedef ObjectArray<ChannelType>                                            ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                          Internal;
+    typedef UnitBase<SampleType>                                                UnitType;
+    typedef InputDictionary                                                     Inputs;
+    typedef NumericalArray<SampleType>                                          Buffer;
+    
+    typedef typename TypeUtility<SampleType>::IndexType                         DurationType;
+    typedef UnitBase<DurationType>                                              DurationUnitType;
+    typedef NumericalArray<DurationType>                                        DurationBufferType;
+    typedef InterpSelect<SampleType,DurationType,InterpTypeCode>                InterpSelectType;
+    typedef typename InterpSelectType::InterpType                               InterpType;
+        
+    MultiTapDelayChannelInternal (Inputs const& inputs, 
+                                  Data const& data, 
+                                  BlockSize const& blockSize,
+                                  SampleRate const& sampleRate,
+                                  ChannelArrayType& channels) throw()
+    :   Internal (getNumChannelsFromInputs (inputs), // one proxy per tap
+                  inputs, data, blockSize, sampleRate, channels),
+        bufferSamples (0),
+        bufferLength (0)
+    {
+    }
+    
+    Text getName() const throw()
+    {
+        return "Multi-tap Delay";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Duration);
+        return keys;
+    }    
+    
+    void initChannel (const int channel) throw()
+    {        
+        const UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (inputUnit.getBlockSize (channel),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (inputUnit.getSampleRate (channel),
+                                                     this->getSampleRate()));
+            
+            this->setOverlap (inputUnit.getOverlap (channel));
+            
+            Data& data = this->getState();
+            
+            // a whole block is written before the taps are read so the block 
+            // must not reach the oldest sample the longest tap needs
+            bufferLength = int (data.maximumDuration * data.base.sampleRate + 0.5) + this->getBlockSize().getValue();
+            
+            circularBuffer = Buffer::newClear (getLeadGuardLength() + bufferLength + getTailGuardLength());
+            bufferSamples = circularBuffer.getArray() + getLeadGuardLength();
+            data.writePosition = 0;
+            
+            for (int i = 0; i < this->getNumChannels(); ++i)
+                this->initProxyValue (i, SampleType (0));
+        }
+    }    
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        Data& data = this->getState();
+        
+        UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        const Buffer& inputBuffer (inputUnit.process (info, 0));
+        DurationUnitType& durationUnit = ChannelInternalCore::getInputAs<DurationUnitType> (IOKey::Duration);
+        
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        plonk_assert (inputBuffer.length() == outputBufferLength);
+        plonk_assert (outputBufferLength <= this->getBlockSize().getValue());
+        
+        const int writePosition = data.writePosition;
+        
+        write (inputBuffer.getArray(), outputBufferLength, writePosition);
+        
+        const int numChannels = this->getNumChannels();
+        
+        for (int i = 0; i < numChannels; ++i)
+        {
+            const DurationBufferType& durationBuffer (durationUnit.process (info, i));
+            
+            read (this->getOutputSamples (i), outputBufferLength, 
+                  durationBuffer.getArray(), durationBuffer.length(), 
+                  writePosition, data.base.sampleRate, data.maximumDuration);
+        }
+        
+        data.writePosition = (writePosition + outputBufferLength) % bufferLength;
+    }
+    
+private:
+    Buffer circularBuffer;
+    SampleType* bufferSamples;
+    int bufferLength;
+    
+    // samples the interpolator reads before and after its index
+    static PLONK_INLINE_LOW int getLeadGuardLength() throw()
+    {
+        return InterpType::getOffset();
+    }
+    
+    // one extra in case an index rounds up to exactly the buffer length
+    static PLONK_INLINE_LOW int getTailGuardLength() throw()
+    {
+        return InterpType::getExtension() - InterpType::getOffset() + 1;
+    }
+    
+    static PLONK_INLINE_LOW int getNumChannelsFromInputs (Inputs const& inputs) throw()
+    {
+        return inputs[IOKey::Duration].template asUnchecked<DurationUnitType>().getNumChannels();
+    }
+    
+    void write (const SampleType* inputSamples, const int numSamples, const int writePosition) throw()
+    {
+        const int numSamplesToEnd = plonk::min (bufferLength - writePosition, numSamples);
+        const int leadGuardLength = getLeadGuardLength();
+        const int tailGuardLength = getTailGuardLength();
+        int i;
+        
+        Memory::copy (bufferSamples + writePosition, inputSamples, numSamplesToEnd * sizeof (SampleType));
+        
+        if (numSamplesToEnd < numSamples)
+            Memory::copy (bufferSamples, inputSamples + numSamplesToEnd, (numSamples - numSamplesToEnd) * sizeof (SampleType));
+        
+        for (i = 1; i <= leadGuardLength; ++i)
+            bufferSamples[-i] = bufferSamples[bufferLength - i];
+        
+        for (i = 0; i < tailGuardLength; ++i)
+            bufferSamples[bufferLength + i] = bufferSamples[i];
+    }
+    
+    PLONK_INLINE_LOW SampleType tap (const int position, const DurationType durationInSamples) const throw()
+    {
+        DurationType readPosition = DurationType (position) - durationInSamples;
+        
+        if (readPosition < DurationType (0))
+            readPosition += DurationType (bufferLength);
+        
+        return InterpType::lookup (bufferSamples, readPosition);
+    }
+    
+    void read (SampleType* outputSamples, const int outputBufferLength, 
+               const DurationType* durationSamples, const int durationBufferLength,
+               const int writePosition, const double sampleRate, const DurationType maximumDuration) const throw()
+    {
+        const DurationType durationToSamples = DurationType (sampleRate);
+        int position = writePosition;
+        int i;
+        
+        if (durationBufferLength == outputBufferLength)
+        {
+            for (i = 0; i < outputBufferLength; ++i)
+            {
+                plonk_assert (durationSamples[i] >= DurationType (0) && durationSamples[i] <= maximumDuration);
+                outputSamples[i] = tap (position, durationSamples[i] * durationToSamples);
+                
+                if (++position == bufferLength)
+                    position = 0;
+            }
+        }
+        else if (durationBufferLength == 1)
+        {
+            plonk_assert (durationSamples[0] >= DurationType (0) && durationSamples[0] <= maximumDuration);
+            const DurationType durationInSamples = durationSamples[0] * durationToSamples;
+            
+            for (i = 0; i < outputBufferLength; ++i)
+            {
+                outputSamples[i] = tap (position, durationInSamples);
+                
+                if (++position == bufferLength)
+                    position = 0;
+            }
+        }
+        else
+        {
+            double durationPosition = 0.0;
+            const double durationIncrement = double (durationBufferLength) / double (outputBufferLength);
+            
+            for (i = 0; i < outputBufferLength; ++i)
+            {
+                const DurationType duration = durationSamples[int (durationPosition)];
+                plonk_assert (duration >= DurationType (0) && duration <= maximumDuration);
+                outputSamples[i] = tap (position, duration * durationToSamples);
+                durationPosition += durationIncrement;
+                
+                if (++position == bufferLength)
+                    position = 0;
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Multi-tap delay processor. 
+ 
+ Any number of taps read from one delay buffer, the input is written to the 
+ buffer only once per sample however many taps there are. Each channel of the
+ duration input is a separate tap and produces one output channel.
+ 
+ @par Factory functions:
+ - ar (input, durations, maximumDuration=1, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ 
+ @par Inputs:
+ - input: (unit, multi) the unit to which delay is applied, if this has more than one channel the durations are shared between the input channels in turn
+ - durations: (unit, multi) the tap durations in seconds, one channel per tap
+ - maximumDuration: (real) the maximum delay time of any tap in seconds
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup DelayUnits */
+template<class SampleType, Interp::TypeCode InterpTypeCode>
+class MultiTapDelayUnit
+{
+public:    
+    typedef MultiTapDelayChannelInternal<SampleType,InterpTypeCode>     MultiTapDelayInternal;
+    typedef typename MultiTapDelayInternal::Data                        Data;
+    typedef ChannelBase<SampleType>                                     ChannelType;
+    typedef UnitBase<SampleType>                                        UnitType;
+    typedef InputDictionary                                             Inputs;
+    typedef NumericalArray2D<ChannelType,UnitType>                      UnitArrayType;
+
+    typedef typename MultiTapDelayInternal::DurationType                DurationType;
+    typedef UnitBase<DurationType>                                      DurationUnitType;
+    typedef ChannelBase<DurationType>                                   DurationChannelType;
+    typedef NumericalArray2D<DurationChannelType,DurationUnitType>      DurationUnitArrayType;
+
+    typedef MultiTapDelayUnit<SampleType, Interp::Lagrange3>            HQ;
+    typedef MultiTapDelayUnit<SampleType, Interp::None>                 N;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("MultiTapDelay", "A delay with any number of taps reading one buffer.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,            Measure::None,      0.0,                IOLimit::None,                         
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,            Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::Duration,           Measure::Seconds,   IOInfo::NoDefault,  IOLimit::Minimum,   Measure::Seconds,   0.0,
+                         IOKey::MaximumDuration,    Measure::Seconds,   1.0,                IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::Multiply,           Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::Add,                Measure::None,      0.0,                IOLimit::None,
+                         IOKey::BlockSize,          Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate,         Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }
+    
+    static UnitType ar (UnitType const& input,
+                        DurationUnitType const& durations,
+                        const DurationType maximumDuration = DurationType (1.0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {             
+        const Data data = { { -1.0, -1.0 }, DurationType (maximumDuration + 0.01), 0 };
+        const int numInputChannels = input.getNumChannels();
+        
+        if (numInputChannels == 1)
+        {
+            Inputs inputs;
+            inputs.put (IOKey::Generic, input);
+            inputs.put (IOKey::Duration, durations);
+            
+            const UnitType mainUnit = UnitType::template proxiesFromInputs<MultiTapDelayInternal> (inputs,
+                                                                                                   data, 
+                                                                                                   preferredBlockSize, 
+                                                                                                   preferredSampleRate);
+            return UnitType::applyMulAdd (mainUnit, mul, add);
+        }
+        else
+        {
+            DurationUnitArrayType durationsGrouped = durations.deinterleave (numInputChannels);
+            UnitArrayType resultGrouped;
+            
+            for (int i = 0; i < numInputChannels; ++i)
+            {
+                Inputs inputs;
+                inputs.put (IOKey::Generic, input[i]);
+                inputs.put (IOKey::Duration, durationsGrouped.wrapAt (i));
+                
+                resultGrouped.add (UnitType::template proxiesFromInputs<MultiTapDelayInternal> (inputs,
+                                                                                                data,
+                                                                                                preferredBlockSize,
+                                                                                                preferredSampleRate));
+            }
+            
+            return UnitType::applyMulAdd (resultGrouped.interleave(), mul, add);
+        }
+    }
+};
+
+typedef MultiTapDelayUnit<PLONK_TYPE_DEFAULT> MultiTapDelay;
+
+
+#endif // PLONK_MULTITAPDELAY_H
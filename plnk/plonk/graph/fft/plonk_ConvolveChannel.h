@@ -113,7 +113,7 @@ public:
 
     enum Constants
     {
-        NumProcessBuffers = 6
+        NumProcessBuffers = 4
     };
     
     ConvolveHelper (const int maxFFTSizeToAllow) throw()
@@ -124,10 +124,8 @@ public:
         
         fftAltBuffer0      = processBuffersBase + maxFFTSize * 0;
         fftAltBuffer1      = processBuffersBase + maxFFTSize * 1;
-        fftTransformBuffer = processBuffersBase + maxFFTSize * 2;
-        fftOverlapBuffer   = processBuffersBase + maxFFTSize * 3;
-        fftTempBuffer      = processBuffersBase + maxFFTSize * 4;
-        fftCalcBuffer      = processBuffersBase + maxFFTSize * 5;
+        fftOverlapBuffer   = processBuffersBase + maxFFTSize * 2;
+        fftTempBuffer      = processBuffersBase + maxFFTSize * 3;
     }
     
     void reset (FFTBuffersType const& newIRBuffers, const int /*channel*/) throw()
@@ -156,7 +154,7 @@ public:
     }
     
     template<class OutputFunctionType, class InputFunctionType>
-    void process (SampleType* outputSamples, const SampleType* inputSamples, const int outputBufferLength, const int channel) throw()
+    void process (SampleType* outputSamples, const SampleType* inputSamples, const int outputBufferLength, const int channel, ScratchArena& scratch) throw()
     {
         FFTEngineType& fftEngine (irBuffers.getFFTEngine());
         const int numDivisions = irBuffers.getNumDivisions();
@@ -246,6 +244,10 @@ public:
             
             if (countDown == 0)
             {
+                // only needed until it is mixed into the overlap buffer
+                ScratchArena::Scope scope (scratch);
+                SampleType* const fftTransformBuffer = scope.allocate<SampleType> (fftSize);
+                
                 divisionsRead = plonk::min (divisionsRead + 1, numDivisions);
                 
                 const SampleType* const irSamples      = irBufferBase;
@@ -291,10 +293,8 @@ private:
     
     SampleType* fftAltBuffer0;
     SampleType* fftAltBuffer1;
-    SampleType* fftTransformBuffer;
     SampleType* fftOverlapBuffer;
     SampleType* fftTempBuffer;
-    SampleType* fftCalcBuffer;
     
     int divisionsCurrent;
     int divisionsWritten;
@@ -310,6 +310,281 @@ private:
 
 //------------------------------------------------------------------------------
 
+/** A non-uniform partitioned convolver.
+ The start of the impulse response is convolved on the audio thread using the
+ FFT size of the FFTBuffers (so the latency is the same as ConvolveHelper). 
+ The rest is split into stages of increasingly large partitions which are 
+ convolved by jobs on the shared TaskExecutor. A stage with a partition size 
+ of P starts far enough into the impulse response that its job has a whole 
+ P samples to run before its output is needed. If it has not finished by then
+ the audio thread waits for it, or does the work itself if it has not started.
+ @see FFTBuffersBase::getPartitions() */
+template<class SampleType>
+class NonUniformConvolveHelper
+{
+public:
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef FFTEngineBase<SampleType>                               FFTEngineType;
+    typedef FFTBuffersBase<SampleType>                              FFTBuffersType;
+    typedef FFTPartitionsStage<SampleType>                          PartitionsType;
+    typedef ObjectArray<PartitionsType>                             PartitionsArrayType;
+    
+    /** One stage of uniform partitioned convolution (using overlap-save). */
+    class Stage : public TaskExecutor::Job
+    {
+    public:
+        Stage (PartitionsType const& partitions, const int channel, Buffer const& inputRingToUse, const int latency) throw()
+        :   fftEngine (partitions.fftEngine),
+            spectra (partitions.spectra.atUnchecked (channel)),
+            inputRing (inputRingToUse),
+            partitionSize ((int) fftEngine.halfLength()),
+            numPartitions (partitions.numPartitions),
+            outputOffset (partitions.offset + latency),
+            submitOffset (plonk::max (partitionSize, outputOffset - partitionSize)),
+            slot (0),
+            delayLine (Buffer::newClear (numPartitions * (int) fftEngine.length())),
+            window (Buffer::withSize ((int) fftEngine.length())),
+            accumulator (Buffer::withSize ((int) fftEngine.length())),
+            transform (Buffer::withSize ((int) fftEngine.length())),
+            output (Buffer::newClear ((int) fftEngine.length()))
+        {
+        }
+        
+        void perform() throw()
+        {
+            while ((completed.getValue() < submitted.getValue()) && busy.compareAndSwap (0, 1))
+            {
+                processPending();
+                busy.setValue (0);
+            }
+        }
+        
+        /** Marks the blocks due to start at this time as ready to process. 
+         Returns true if there is a new block. */
+        PLONK_INLINE_LOW bool update (const LongLong time) throw()
+        {
+            const LongLong blockTime = time - submitOffset;
+            
+            if ((blockTime < 0) || ((blockTime % partitionSize) != 0))
+                return false;
+            
+            submitted.setValue (int (blockTime / partitionSize) + 1);
+            return true;
+        }
+        
+        /** Adds this stage's output to dst, waiting for the block if needed. */
+        PLONK_INLINE_LOW void accumulate (SampleType* const dst, const LongLong time, const int numSamples) throw()
+        {
+            const LongLong outputTime = time - outputOffset;
+            
+            if (outputTime < 0)
+                return;
+            
+            if ((outputTime % partitionSize) == 0)
+                waitForBlock (int (outputTime / partitionSize));
+            
+            const int outputMask = output.length() - 1;
+            accumulateSamples (dst, output.getArray() + int (time & outputMask), numSamples);
+        }
+        
+        void processPending() throw()
+        {
+            int block = completed.getValueUnchecked();
+            const int last = submitted.getValue();
+            
+            while (block < last)
+            {
+                processBlock (block);
+                completed.setValue (++block);
+            }
+        }
+        
+    private:
+        FFTEngineType fftEngine;
+        const Buffer spectra;
+        const Buffer inputRing;
+        const int partitionSize;
+        const int numPartitions;
+        const int outputOffset;
+        const int submitOffset;
+        int slot;
+        Buffer delayLine;
+        Buffer window;
+        Buffer accumulator;
+        Buffer transform;
+        Buffer output;
+        AtomicInt submitted;
+        AtomicInt completed;
+        AtomicInt busy;
+        
+        void waitForBlock (const int block) throw()
+        {
+            while (completed.getValue() <= block)
+            {
+                if (busy.compareAndSwap (0, 1))
+                {
+                    processPending();
+                    busy.setValue (0);
+                }
+                else Threading::yield();
+            }
+        }
+        
+        void processBlock (const int block) throw()
+        {
+            const int fftSize = partitionSize * 2;
+            const int inputMask = inputRing.length() - 1;
+            const int outputMask = output.length() - 1;
+            const SampleType* const inputSamples = inputRing.getArray();
+            SampleType* const windowSamples = window.getArray();
+            SampleType* const accumulatorSamples = accumulator.getArray();
+            SampleType* const transformSamples = transform.getArray();
+            SampleType* const outputSamples = output.getArray();
+            SampleType* const delayLineSamples = delayLine.getArray();
+            
+            // the previous and current block of input
+            const LongLong inputStart = LongLong (block - 1) * partitionSize;
+            
+            for (int i = 0; i < fftSize; ++i)
+                windowSamples[i] = inputSamples[int ((inputStart + i) & inputMask)];
+            
+            fftEngine.forward (delayLineSamples + slot * fftSize, windowSamples);
+            zeroSamples (accumulatorSamples, fftSize);
+            
+            const SampleType* spectraSamples = spectra.getArray();
+            
+            for (int i = 0; i < numPartitions; ++i)
+            {
+                const int delaySlot = (slot - i) < 0 ? (slot - i + numPartitions) : (slot - i);
+                complexMultiplyAccumulate (accumulatorSamples, delayLineSamples + delaySlot * fftSize, spectraSamples, partitionSize);
+                spectraSamples += fftSize;
+            }
+            
+            fftEngine.inverse (transformSamples, accumulatorSamples);
+            
+            // the second half is the output for the current block
+            const LongLong outputStart = LongLong (block) * partitionSize + outputOffset;
+
+            for (int i = 0; i < partitionSize; ++i)
+                outputSamples[int ((outputStart + i) & outputMask)] = transformSamples[partitionSize + i];
+            
+            slot = (slot + 1) == numPartitions ? 0 : (slot + 1);
+        }
+    };
+    
+    NonUniformConvolveHelper (const int maxFFTSizeToAllow) throw()
+    :   maxFFTSize (maxFFTSizeToAllow),
+        executor (TaskExecutor::getDefault()),
+        blockSize (0),
+        time (0)
+    {
+    }
+    
+    ~NonUniformConvolveHelper()
+    {
+        endStages();
+    }
+    
+    void reset (FFTBuffersType const& newIRBuffers, const int channel) throw()
+    {
+        endStages();
+        
+        irBuffers = newIRBuffers;
+        time = 0;
+        
+        const PartitionsArrayType partitions = irBuffers.getPartitions (maxFFTSize);
+        const int numStages = partitions.length();
+        
+        // channels the IR doesn't have are silent, as with ConvolveHelper
+        if ((numStages == 0) || (channel >= irBuffers.getNumChannels()))
+            return;
+        
+        const PartitionsType& last = partitions.atUnchecked (numStages - 1);
+        blockSize = (int) irBuffers.getFFTEngine().halfLength();
+        
+        // enough input for the window of the last stage's block up to the time it is due
+        const int inputLength = last.offset + blockSize * 2 + (int) last.fftEngine.length();
+        inputRing = Buffer::newClear (Bits::nextPowerOf2 (inputLength));
+        
+        for (int i = 0; i < numStages; ++i)
+            stages.add (new Stage (partitions.atUnchecked (i), channel, inputRing, blockSize));
+    }
+    
+    template<class OutputFunctionType, class InputFunctionType>
+    void process (SampleType* outputSamples, const SampleType* inputSamples, const int outputBufferLength, const int /*channel*/, ScratchArena& scratch) throw()
+    {
+        const int numStages = stages.length();
+        
+        if (numStages == 0)
+        {
+            zeroSamples (outputSamples, outputBufferLength);
+            return;
+        }
+        
+        const int inputMask = inputRing.length() - 1;
+        SampleType* const inputRingSamples = inputRing.getArray();
+        
+        ScratchArena::Scope scope (scratch);
+        SampleType* const outputBufferSamples = scope.allocate<SampleType> (plonk::min (outputBufferLength, blockSize));
+        int samplesRemaining = outputBufferLength;
+        
+        while (samplesRemaining > 0)
+        {
+            // hops never cross a block boundary so never wrap the rings
+            const int hop = plonk::min (samplesRemaining, blockSize - int (time & (blockSize - 1)));
+            
+            InputFunctionType::calc (inputRingSamples + int (time & inputMask), inputSamples, hop);
+            zeroSamples (outputBufferSamples, hop);
+            
+            for (int i = 0; i < numStages; ++i)
+                stages.atUnchecked (i)->accumulate (outputBufferSamples, time, hop);
+            
+            OutputFunctionType::calc (outputSamples, outputBufferSamples, hop);
+            
+            inputSamples     += hop;
+            outputSamples    += hop;
+            samplesRemaining -= hop;
+            time             += hop;
+            
+            if ((time & (blockSize - 1)) == 0)
+            {
+                // the head is done here, the rest on the executor
+                if (stages.atUnchecked (0)->update (time))
+                    stages.atUnchecked (0)->processPending();
+                
+                for (int i = 1; i < numStages; ++i)
+                {
+                    Stage* const stage = stages.atUnchecked (i);
+                    
+                    if (stage->update (time))
+                        executor.submit (stage);
+                }
+            }
+        }
+    }
+    
+private:
+    const int maxFFTSize;
+    TaskExecutor& executor;
+    ObjectArray<Stage*> stages;
+    Buffer inputRing;
+    int blockSize;
+    LongLong time;
+    
+    FFTBuffersType irBuffers;
+    
+    void endStages() throw()
+    {
+        for (int i = 0; i < stages.length(); ++i)
+            executor.end (stages.atUnchecked (i));
+        
+        stages.clear();
+    }
+};
+
+//------------------------------------------------------------------------------
+
 struct ConvolveChannelData
 {
     ChannelInternalCore::Data base;
@@ -322,14 +597,14 @@ struct ConvolveChannelData
 //------------------------------------------------------------------------------
 
 /** Convolve channel. */
-template<class SampleType>
+template<class SampleType, class ConvolveHelperType>
 class ConvolveChannelInternal : public ProxyOwnerChannelInternal<SampleType, ConvolveChannelData>
 {
 public:
     typedef ConvolveChannelData                                     Data;
     typedef ChannelBase<SampleType>                                 ChannelType;
     typedef ObjectArray<ChannelType>                                ChannelArrayType;
-    typedef ConvolveChannelInternal<SampleType>                     ConvolveInternal;
+    typedef ConvolveChannelInternal<SampleType,ConvolveHelperType>  ConvolveInternal;
     typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
     typedef ChannelInternalBase<SampleType>                         InternalBase;
     typedef UnitBase<SampleType>                                    UnitType;
@@ -338,7 +613,6 @@ public:
     typedef FFTEngineBase<SampleType>                               FFTEngineType;
     typedef FFTBuffersBase<SampleType>                              FFTBuffersType;
     typedef Variable<FFTBuffersType&>                               FFTBuffersVariableType;
-    typedef ConvolveHelper<SampleType>                              ConvolveHelperType;
     
     ConvolveChannelInternal (Inputs const& inputs,
                              Data const& data,
@@ -350,7 +624,8 @@ public:
         thisSync (0),
         fadePreviousInputSamplesRemaining (0),
         fadePreviousOutputSamplesRemaining (0),
-        holdPreviousOutputSamplesRemaining (0)
+        holdPreviousOutputSamplesRemaining (0),
+        preparer (0)
     {
     }
     
@@ -358,6 +633,10 @@ public:
     {
         for (int i = 0; i < convolveHelpers.length(); ++i)
             delete convolveHelpers.atUnchecked (i);
+        
+        // this deletes it once any helpers it is building are done
+        if (preparer != 0)
+            TaskExecutor::getDefault().end (preparer);
     }
     
     Text getName() const throw()
@@ -391,12 +670,11 @@ public:
             for (int i = 0; i < numChannels; ++i)
             {
                 ConvolverPair* convolvePair = new ConvolverPair (fftSize);
-                convolvePair->currentConvolver->reset (irBuffers, channel);
+                convolvePair->currentConvolver->reset (irBuffers, i);
                 convolveHelpers.add (convolvePair);
             }
             
-            if (data.fadeSamples > 0)
-                fadeBuffer = Buffer::withSize (data.fadeSamples);
+            preparer = new Preparer (numChannels, fftSize);
                 
             IntVariable& sync = ChannelInternalCore::getInputAs<IntVariable> (IOKey::Sync);
             thisSync = sync.getValue();
@@ -428,10 +706,11 @@ public:
             {
                 if (fadePreviousInputSamplesRemaining != 0)
                 {
-                    SampleType* const fadeBufferSamples = fadeBuffer.getArray();
-                    
                     numSamplesThisTime = plonk::min (fadePreviousInputSamplesRemaining, numSamplesRemaining);
                     
+                    ScratchArena::Scope scope (info.getScratch());
+                    SampleType* const fadeBufferSamples = scope.allocate<SampleType> (numSamplesThisTime);
+                    
                     for (int channel = 0; channel < numChannels; ++channel)
                     {
                         const Buffer& inputBuffer (inputUnit.process (info, channel));
@@ -449,10 +728,10 @@ public:
                         ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
                         
                         // process faded input through previous
-                        convolvePair.previousConvolver->template process<MoveSamples, MoveSamples> (outputSamples, fadeBufferSamples, numSamplesThisTime, channel);
+                        convolvePair.previousConvolver->template process<MoveSamples, MoveSamples> (outputSamples, fadeBufferSamples, numSamplesThisTime, channel, info.getScratch());
 
                         // accumulate current as normal
-                        convolvePair.currentConvolver->template process<AccumulateSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel);
+                        convolvePair.currentConvolver->template process<AccumulateSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel, info.getScratch());
                     }
                     
                     level = channelLevel;
@@ -474,10 +753,10 @@ public:
                         ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
 
                         // process silence through previous
-                        convolvePair.previousConvolver->template process<MoveSamples, MoveZeroSamples> (outputSamples, 0, numSamplesThisTime, channel);
+                        convolvePair.previousConvolver->template process<MoveSamples, MoveZeroSamples> (outputSamples, 0, numSamplesThisTime, channel, info.getScratch());
                         
                         // accumulate current as normal
-                        convolvePair.currentConvolver->template process<AccumulateSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel);
+                        convolvePair.currentConvolver->template process<AccumulateSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel, info.getScratch());
                     }
                     
                     holdPreviousOutputSamplesRemaining -= numSamplesThisTime;
@@ -502,7 +781,7 @@ public:
                         ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
 
                         // process silence through previous
-                        convolvePair.previousConvolver->template process<MoveSamples, MoveZeroSamples> (outputSamples, 0, numSamplesThisTime, channel);
+                        convolvePair.previousConvolver->template process<MoveSamples, MoveZeroSamples> (outputSamples, 0, numSamplesThisTime, channel, info.getScratch());
                         
                         channelLevel = level;
                         channelSlope = slope;
@@ -511,7 +790,7 @@ public:
                         fadeSamples (outputSamples, channelLevel, channelSlope, numSamplesThisTime);
                         
                         // accumulate current as normal
-                        convolvePair.currentConvolver->template process<AccumulateSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel);
+                        convolvePair.currentConvolver->template process<AccumulateSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel, info.getScratch());
                     }
                     
                     level = channelLevel;
@@ -520,8 +799,12 @@ public:
                     fadePreviousOutputSamplesRemaining -= numSamplesThisTime;
                 }
             }
-            else if (currentIRBuffers == newIRBuffers)
+            else if (! preparer->isReady())
             {
+                // helpers for a new IR are built off the audio thread and swapped in when ready
+                if (! (currentIRBuffers == newIRBuffers) && preparer->isIdle())
+                    preparer->request (newIRBuffers);
+                
                 numSamplesThisTime = numSamplesRemaining;
                 
                 for (int channel = 0; channel < numChannels; ++channel)
@@ -532,21 +815,28 @@ public:
                     plonk_assert (outputBufferLength == inputBuffer.length());
                     
                     ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
-                    convolvePair.currentConvolver->template process<MoveSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel);
+                    convolvePair.currentConvolver->template process<MoveSamples, MoveSamples> (outputSamples, inputSamples, numSamplesThisTime, channel, info.getScratch());
                 }
             }
             else
             {
+                const FFTBuffersType& preparedIRBuffers (preparer->getIRBuffers());
+                
                 for (int channel = 0; channel < numChannels; ++channel)
                 {
                     ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
-                    convolvePair.currentConvolver.swapWith (convolvePair.previousConvolver);
+                    ConvolveHelperType*& prepared = preparer->getHelper (channel);
+                    ConvolveHelperType* const retired = convolvePair.previousConvolver;
+                    
+                    convolvePair.previousConvolver = convolvePair.currentConvolver;
+                    convolvePair.currentConvolver  = prepared;
+                    prepared                       = retired; // the preparer deletes this
                 }
                 
                 fadePreviousInputSamplesRemaining  = data.fadeSamples;
                 holdPreviousOutputSamplesRemaining = data.keepPreviousTail
                                                    ? (int) currentIRBuffers.getNumDivisions() * (int) currentIRBuffers.getFFTEngine().halfLength()
-                                                   : (int) newIRBuffers.getFFTEngine().halfLength(); // minimum to avoid a gap due to latency
+                                                   : (int) preparedIRBuffers.getFFTEngine().halfLength(); // minimum to avoid a gap due to latency
                 fadePreviousOutputSamplesRemaining = data.fadeSamples;
                 
                 if (fadePreviousInputSamplesRemaining > 0)
@@ -555,13 +845,8 @@ public:
                     slope = level / fadePreviousInputSamplesRemaining;
                 }
                 
-                currentIRBuffers = newIRBuffers;
-                
-                for (int channel = 0; channel < numChannels; ++channel)
-                {
-                    ConvolverPair& convolvePair = *convolveHelpers.atUnchecked (channel);
-                    convolvePair.currentConvolver->reset (newIRBuffers, channel);
-                }
+                currentIRBuffers = preparedIRBuffers;
+                preparer->setIdle();
                 
                 //... and back round again...
             }
@@ -605,7 +890,6 @@ private:
 
     //--------------------------------------------------------------------------
     
-    Buffer fadeBuffer;
     FFTBuffersType currentIRBuffers;
     int thisSync;
     
@@ -623,11 +907,79 @@ private:
         {
         }
         
-        ScopedPointerContainer<ConvolveHelperType> currentConvolver;
-        ScopedPointerContainer<ConvolveHelperType> previousConvolver;
+        ~ConvolverPair()
+        {
+            delete currentConvolver;
+            delete previousConvolver;
+        }
+        
+        ConvolveHelperType* currentConvolver;
+        ConvolveHelperType* previousConvolver;
+    };
+    
+    /** Builds the helpers for a new IR on the shared TaskExecutor.
+     Helpers allocate and the non-uniform ones compute the IR partitions, so 
+     this keeps that off the audio thread. The audio thread only touches the
+     helpers and IR here when the preparer is idle or ready, the job only when
+     a request is pending. Helpers swapped out are handed back to be deleted
+     by the next request or when the preparer is ended. */
+    class Preparer : public TaskExecutor::Job
+    {
+    public:
+        Preparer (const int numChannels, const int fftSizeToUse) throw()
+        :   fftSize (fftSizeToUse)
+        {
+            for (int i = 0; i < numChannels; ++i)
+                helpers.add (0);
+        }
+        
+        ~Preparer()
+        {
+            for (int i = 0; i < helpers.length(); ++i)
+                delete helpers.atUnchecked (i);
+        }
+        
+        void perform() throw()
+        {
+            if (state.getValue() != Requested)
+                return;
+            
+            for (int i = 0; i < helpers.length(); ++i)
+            {
+                delete helpers.atUnchecked (i);
+                
+                ConvolveHelperType* const helper = new ConvolveHelperType (fftSize);
+                helper->reset (irBuffers, i);
+                helpers.atUnchecked (i) = helper;
+            }
+            
+            state.setValue (Ready);
+        }
+        
+        void request (FFTBuffersType const& newIRBuffers) throw()
+        {
+            irBuffers = newIRBuffers;
+            state.setValue (Requested);
+            TaskExecutor::getDefault().submit (this);
+        }
+        
+        PLONK_INLINE_LOW bool isIdle() const throw()                          { return state.getValue() == Idle; }
+        PLONK_INLINE_LOW bool isReady() const throw()                         { return state.getValue() == Ready; }
+        PLONK_INLINE_LOW void setIdle() throw()                               { state.setValue (Idle); }
+        PLONK_INLINE_LOW const FFTBuffersType& getIRBuffers() const throw()   { return irBuffers; }
+        PLONK_INLINE_LOW ConvolveHelperType*& getHelper (const int channel) throw() { return helpers.atUnchecked (channel); }
+        
+    private:
+        enum States { Idle, Requested, Ready };
+        
+        const int fftSize;
+        FFTBuffersType irBuffers;
+        ObjectArray<ConvolveHelperType*> helpers;
+        AtomicInt state;
     };
     
     ObjectArray<ConvolverPair*> convolveHelpers;
+    Preparer* preparer;
 };
 
 
@@ -638,8 +990,13 @@ private:
  
  Latency is half the FFT size.
  
+ For long impulse responses ConvolveUnit::NonUniform keeps this latency but
+ uses larger partitions further into the impulse response, processed on 
+ background threads.
+ 
  @par Factory functions:
  - ar (input, fftBuffers)
+ - NonUniform::ar (input, fftBuffers, maxFFTSize=16384)
  
  @par Inputs:
  - input: (unit, multi) the unit to convolve
@@ -696,6 +1053,45 @@ public:
                                                                        BlockSize::noPreference(),
                                                                        SampleRate::noPreference());
     }
+    
+    /** Non-uniform partitioned convolution.
+     The first few partitions use the FFT size of the fftBuffers, later ones 
+     double in size up to maxFFTSize and are processed on the TaskExecutor. 
+     The partitions of the fftBuffers passed in are prepared here, if they 
+     are changed later call FFTBuffersBase::getPartitions() with the same 
+     maxFFTSize before setting them to avoid doing this on the audio thread. */
+    class NonUniform
+    {
+    public:
+        typedef ConvolveChannelInternal<SampleType,NonUniformConvolveHelper<SampleType> >   ConvolveInternal;
+        
+        static PLONK_INLINE_LOW UnitType ar (UnitType const& input,
+                                             FFTBuffersVariableType const& fftBuffers,
+                                             const int maxFFTSize = 16384,
+                                             const bool keepPreviousTail = false,
+                                             const int numChannels = 0,
+                                             const int fadeSamples = 64,
+                                             IntVariable const& sync = IntVariable()) throw()
+        {
+            plonk_assert ((fadeSamples % 4) == 0);
+            plonk_assert (Bits::isPowerOf2 (maxFFTSize));
+            
+            FFTBuffersType irBuffers (fftBuffers.getValue());
+            irBuffers.getPartitions (maxFFTSize);
+            
+            Inputs inputs;
+            inputs.put (IOKey::Generic, input);
+            inputs.put (IOKey::FFTBuffers, fftBuffers);
+            inputs.put (IOKey::Sync, sync);
+            
+            Data data = { { -1.0, -1.0 }, numChannels, maxFFTSize, fadeSamples, keepPreviousTail };
+            
+            return UnitType::template proxiesFromInputs<ConvolveInternal> (inputs,
+                                                                           data,
+                                                                           BlockSize::noPreference(),
+                                                                           SampleRate::noPreference());
+        }
+    };
 };
 
 
@@ -41,6 +41,7 @@
 
 #include "../channel/plonk_ChannelInternalCore.h"
 #include "plonk_FilterForwardDeclarations.h"
+#include "plonk_FilterBank.h"
 
 
 /** A generic FIR/IIR filter. */
@@ -171,7 +172,9 @@ public:
                          IOKey::End);
     }
                 
-    /** Create a generic filter from the coefficients. */
+    /** Create a generic filter from the coefficients. 
+     Where the form supports it (see FilterFormLanes) and there are enough 
+     channels the filter is created as a FilterBankChannelInternal. */
     static UnitType ar (UnitType const& input,
                         UnitType const& coeffs, 
                         UnitType const& mul = SampleType (1),
@@ -188,6 +191,11 @@ public:
         plonk_assert ((numCoeffChannels % requiredCoeffs) == 0);
         
         const int numOutputChannels = plonk::max (input.getNumChannels(), numCoeffChannels / requiredCoeffs);
+        
+        if (FilterBankUnit<FormType>::canUse (input, numOutputChannels))
+            return FilterBankUnit<FormType>::ar (input, coeffs, numOutputChannels, mul, add, 
+                                                 preferredBlockSize, preferredSampleRate);
+        
         UnitType result (UnitType::withSize (numOutputChannels));
         
         Data data;
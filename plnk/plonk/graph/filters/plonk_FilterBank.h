@@ -0,0 +1,358 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_FILTERBANK_H
+#define PLONK_FILTERBANK_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "plonk_FilterForwardDeclarations.h"
+
+/** Describes whether a filter form can be processed in SIMD lanes.
+ Forms with NumLanes greater than zero provide a static process() function
+ that steps the filters of NumLanes channels together. 
+ @see FilterBankChannelInternal */
+template<class FormType>
+class FilterFormLanes
+{
+public:
+    enum { NumLanes = 0 };
+};
+
+template<>
+class FilterFormLanes< FilterForm<float, FilterFormType::P2Z2> >
+{
+public:
+    enum { NumLanes = PLANK_VFILTER_LANES };
+    
+    static PLONK_INLINE_LOW void process (float* const* results, const float* const* inputs, const float* const* coeffs, const int coeffStride, float* state, const int length) throw()
+    {
+        pl_VectorBiquadP2Z2x4F_NN (results, inputs, coeffs, coeffStride, state, length);
+    }
+    
+    static PLONK_INLINE_LOW bool isConstant (const float* samples, const int length) throw()
+    {
+        return pl_VectorIsConstantF_N (samples, length);
+    }
+};
+
+template<>
+class FilterFormLanes< FilterForm<float, FilterFormType::B2> >
+{
+public:
+    enum { NumLanes = PLANK_VFILTER_LANES };
+    
+    static PLONK_INLINE_LOW void process (float* const* results, const float* const* inputs, const float* const* coeffs, const int coeffStride, float* state, const int length) throw()
+    {
+        pl_VectorBiquadB2x4F_NN (results, inputs, coeffs, coeffStride, state, length);
+    }
+    
+    static PLONK_INLINE_LOW bool isConstant (const float* samples, const int length) throw()
+    {
+        return pl_VectorIsConstantF_N (samples, length);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class FormType> class FilterBankChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(FilterBankChannelInternal,FormType)
+{
+    ChannelInternalCore::Data base;
+    int numChannels;
+};
+
+/** A multichannel second order filter.
+ Rather than running a separate recursion per channel the channels are 
+ processed in groups of FilterFormLanes<FormType>::NumLanes, each channel in 
+ the group occupying one SIMD lane. A group is processed this way when all of
+ its inputs are at the output rate and its coefficients are either fixed for 
+ the block or at the output rate. Other groups (and any remaining channels) 
+ fall back to the scalar FilterForm process. All the channels share one block
+ size and sample rate so the input channels must all have the same ones
+ (see hasUniformRate()). */
+template<class FormType>
+class FilterBankChannelInternal 
+:   public ProxyOwnerChannelInternal<typename FormType::SampleDataType, 
+                                     PLONK_CHANNELDATA_NAME(FilterBankChannelInternal,FormType)>
+{
+public:
+    typedef typename FormType::SampleDataType                           SampleType;
+    typedef PLONK_CHANNELDATA_NAME(FilterBankChannelInternal,FormType)  Data;
+    typedef typename FormType::Data                                     FormData;
+    typedef FilterFormLanes<FormType>                                   Lanes;
+    typedef ChannelBase<SampleType>                                     ChannelType;
+    typedef ObjectArray<ChannelType>                                    ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                  Internal;
+    typedef UnitBase<SampleType>                                        UnitType;
+    typedef InputDictionary                                             Inputs;
+    typedef NumericalArray<SampleType>                                  Buffer;
+    
+    enum Constants
+    {
+        NumLanes = Lanes::NumLanes,
+        NumCoeffs = FormType::NumCoeffs
+    };
+        
+    FilterBankChannelInternal (Inputs const& inputs, 
+                               Data const& data, 
+                               BlockSize const& blockSize,
+                               SampleRate const& sampleRate,
+                               ChannelArrayType& channels) throw()
+    :   Internal (data.numChannels, inputs, data, blockSize, sampleRate, channels)
+    {
+        plonk_assert (NumLanes > 0);
+        
+        const int numGroups = (data.numChannels + NumLanes - 1) / NumLanes;
+        states = Buffer::newClear (numGroups * NumLanes * 2);
+    }
+            
+    Text getName() const throw()
+    {
+        return "Filter Bank (" + FormType::getName() + ")";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Coeffs);
+        return keys;
+    }    
+        
+    /** Returns @c true if all the channels of the input have the same 
+     block size, sample rate and overlap. */
+    static bool hasUniformRate (UnitType const& input) throw()
+    {
+        const int numChannels = input.getNumChannels();
+        
+        for (int i = 1; i < numChannels; ++i)
+        {
+            if ((input.getBlockSize (i).getValue() != input.getBlockSize (0).getValue()) ||
+                (input.getSampleRate (i).getValue() != input.getSampleRate (0).getValue()) ||
+                (input.getOverlap (i).getValue() != input.getOverlap (0).getValue()))
+                return false;
+        }
+        
+        return true;
+    }
+    
+    void initChannel (const int channel) throw()
+    {        
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            const UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+            plonk_assert (hasUniformRate (inputUnit));
+
+            this->setBlockSize (BlockSize::decide (inputUnit.getBlockSize (0),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (inputUnit.getSampleRate (0),
+                                                     this->getSampleRate()));
+            
+            this->setOverlap (inputUnit.getOverlap (0));
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }    
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        const int numChannels = this->getNumChannels();
+        SampleType* const stateSamples = states.getArray();
+        int channel, lane;
+        
+        for (channel = 0; (channel + NumLanes) <= numChannels; channel += NumLanes)
+        {
+            SampleType* const groupState = stateSamples + channel * 2;
+            
+            if (! processLanes (info, channel, groupState))
+            {
+                for (lane = 0; lane < NumLanes; ++lane)
+                    processChannel (info, channel + lane, groupState[lane], groupState[NumLanes + lane]);
+            }
+        }
+        
+        for (lane = 0; channel < numChannels; ++channel, ++lane)
+        {
+            SampleType* const groupState = stateSamples + (channel - lane) * 2;
+            processChannel (info, channel, groupState[lane], groupState[NumLanes + lane]);
+        }
+    }
+    
+private:
+    Buffer states; // y1[NumLanes], y2[NumLanes] per group of channels
+    
+    bool processLanes (ProcessInfo& info, const int firstChannel, SampleType* const groupState) throw()
+    {
+        UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        UnitType& coeffsUnit = this->getInputAsUnit (IOKey::Coeffs);
+        
+        const int outputLength = this->getOutputBuffer (firstChannel).length();
+        SampleType* outputSamples[NumLanes];
+        const SampleType* inputSamples[NumLanes];
+        const SampleType* coeffSamples[NumCoeffs * NumLanes];
+        int coeffLength = 0;
+        int i, lane, coeff;
+        
+        for (lane = 0; lane < NumLanes; ++lane)
+        {
+            const int channel = firstChannel + lane;
+            const Buffer& inputBuffer (inputUnit.process (info, channel));
+            
+            if (inputBuffer.length() != outputLength)
+                return false;
+            
+            inputSamples[lane] = inputBuffer.getArray();
+            outputSamples[lane] = this->getOutputSamples (channel);
+            
+            for (coeff = 0; coeff < NumCoeffs; ++coeff)
+            {
+                const Buffer& coeffBuffer (coeffsUnit.process (info, NumCoeffs * channel + coeff));
+                
+                if (coeffLength == 0)
+                    coeffLength = coeffBuffer.length();
+                else if (coeffBuffer.length() != coeffLength)
+                    return false;
+                
+                coeffSamples[coeff * NumLanes + lane] = coeffBuffer.getArray();
+            }
+        }
+        
+        if ((coeffLength != 1) && (coeffLength != outputLength))
+            return false;
+        
+        // coefficient generators often fill the block with the same values
+        int coeffStride = 0;
+        
+        for (i = 0; (i < NumCoeffs * NumLanes) && (coeffStride == 0); ++i)
+            coeffStride = Lanes::isConstant (coeffSamples[i], coeffLength) ? 0 : 1;
+        
+        Lanes::process (outputSamples, inputSamples, coeffSamples, coeffStride, groupState, outputLength);
+        
+        for (i = 0; i < NumLanes * 2; ++i)
+            groupState[i] = zap (groupState[i]);
+        
+        return true;
+    }
+    
+    void processChannel (ProcessInfo& info, const int channel, SampleType& y1, SampleType& y2) throw()
+    {
+        FormData data;
+        data.y1 = y1;
+        data.y2 = y2;
+        
+        FormType::process (this->getOutputSamples (channel),
+                           this->getOutputBuffer (channel).length(), 
+                           this->getInputAsUnit (IOKey::Generic), 
+                           this->getInputAsUnit (IOKey::Coeffs), 
+                           data,
+                           info, 
+                           channel);
+        
+        y1 = data.y1;
+        y2 = data.y2;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Creates a FilterBankChannelInternal for forms that support SIMD lanes.
+ Used by FilterUnit when there are enough channels to fill the lanes. */
+template<class FormType, bool HasLanes = (FilterFormLanes<FormType>::NumLanes > 0)>
+class FilterBankUnit
+{
+public:
+    typedef typename FormType::SampleDataType       SampleType;
+    typedef UnitBase<SampleType>                    UnitType;
+
+    static PLONK_INLINE_LOW bool canUse (UnitType const& /*input*/, const int /*numChannels*/) throw()
+    {
+        return false;
+    }
+    
+    static UnitType ar (UnitType const& /*input*/,
+                        UnitType const& /*coeffs*/, 
+                        const int /*numChannels*/,
+                        UnitType const& /*mul*/,
+                        UnitType const& /*add*/,
+                        BlockSize const& /*preferredBlockSize*/,
+                        SampleRate const& /*preferredSampleRate*/) throw()
+    {
+        return UnitType::getNull();
+    }
+};
+
+template<class FormType>
+class FilterBankUnit<FormType, true>
+{
+public:
+    typedef typename FormType::SampleDataType       SampleType;
+    typedef FilterBankChannelInternal<FormType>     FilterBankInternal;
+    typedef typename FilterBankInternal::Data       Data;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    
+    /** Mixed rate inputs use the per-channel filters so each channel runs at its input's rate. */
+    static PLONK_INLINE_LOW bool canUse (UnitType const& input, const int numChannels) throw()
+    {
+        return (numChannels >= FilterFormLanes<FormType>::NumLanes) && FilterBankInternal::hasUniformRate (input);
+    }
+
+    static UnitType ar (UnitType const& input,
+                        UnitType const& coeffs, 
+                        const int numChannels,
+                        UnitType const& mul,
+                        UnitType const& add,
+                        BlockSize const& preferredBlockSize,
+                        SampleRate const& preferredSampleRate) throw()
+    {
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::Coeffs, coeffs);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+        
+        Data data = { { -1.0, -1.0 }, numChannels };
+        
+        return UnitType::template proxiesFromInputs<FilterBankInternal> (inputs, 
+                                                                         data, 
+                                                                         preferredBlockSize, 
+                                                                         preferredSampleRate);
+    }
+};
+
+
+#endif // PLONK_FILTERBANK_H
@@ -41,6 +41,7 @@
 
 #include "../channel/plonk_ChannelInternalCore.h"
 #include "plonk_FilterForwardDeclarations.h"
+#include "plonk_FilterCoeffsControl.h"
 
 
 
@@ -141,6 +142,7 @@ public:
         
         data.filterSampleRate = sampleRate;
         data.filterSampleDuration = 1.0 / sampleRate;
+        data.controlReset = true;
     }
     
     void process (ProcessInfo& info, const int /*channel*/) throw()
@@ -157,6 +159,14 @@ public:
         const SampleType* const param0Samples = param0Buffer.getArray();
         const int param0Length = param0Buffer.length();
         
+        if (data.controlInterval > 0)
+        {
+            const SampleType* const params[] = { param0Samples };
+            const int paramLengths[] = { param0Length };
+            this->processControl (params, paramLengths, outputLength);
+            return;
+        }
+        
         if (outputLength == param0Length)
         {
             for (i = 0; i < outputLength; ++i)
@@ -203,6 +213,16 @@ public:
         }
     }
     
+    void processControl (const SampleType* const* params, const int* paramLengths, const int outputLength) throw()
+    {
+        SampleType* outputs[FormType::NumCoeffs];
+        
+        for (int j = 0; j < FormType::NumCoeffs; ++j)
+            outputs[j] = this->getOutputSamples (j);
+        
+        FilterCoeffsControl<ShapeType>::process (this->getState(), outputs, outputLength, params, paramLengths);
+    }
+    
 private:
     IntArray inputKeys;
 };
@@ -222,6 +242,7 @@ public:
     typedef typename ShapeType::FormType                    FormType;
     
     typedef FilterCoeffs1ParamChannelInternal<ShapeType>    FilterCoeffsInternal;
+    typedef FilterCoeffsControl<ShapeType>                  FilterCoeffsControlType;
     typedef ChannelBase<SampleType>                         ChannelType;
     typedef ChannelInternal<SampleType,Data>                Internal;
     typedef UnitBase<SampleType>                            UnitType;
@@ -247,11 +268,17 @@ public:
     }
     
     
-    /** Filter coefficients from one control parameter. */
+    /** Filter coefficients from one control parameter. 
+     If @c controlInterval is greater than zero the coefficients are calculated
+     at most once per interval and interpolated in between, @c controlTolerance
+     is the relative change in a parameter needed to cause a recalculation.
+     @see FilterCoeffsControl */
     static UnitType ar (UnitType const& param0,
                         SampleRates const filterSampleRates = SampleRate::getDefault(),
                         BlockSize const& preferredBlockSize = BlockSize::noPreference(),
-                        SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+                        SampleRate const& preferredSampleRate = SampleRate::noPreference(),
+                        const int controlInterval = 0,
+                        const double controlTolerance = 0.0) throw()
     {                
         const IntArray inputKeys = ShapeType::getInputKeys();
         
@@ -266,9 +293,27 @@ public:
         Memory::zero (data);
         data.base.sampleRate = -1.0;
         data.base.sampleDuration = -1.0;
+        data.controlInterval = plonk::max (controlInterval, 0);
+        data.controlTolerance = controlTolerance;
         
         for (int i = 0; i < numChannels; ++i)
         {
+            // channels with the same inputs share a generator
+            int shared = 0;
+            
+            while ((shared < i) &&
+                   ! (FilterCoeffsControlType::isSameInput (param0.wrapAt (shared), param0.wrapAt (i)) &&
+                      (filterSampleRates.wrapAt (shared).getValue() == filterSampleRates.wrapAt (i).getValue())))
+                ++shared;
+            
+            if (shared < i)
+            {
+                for (int j = 0; j < FormType::NumCoeffs; ++j)
+                    result.add (result.atUnchecked (shared * FormType::NumCoeffs + j));
+                
+                continue;
+            }
+            
             Inputs inputs;
             inputs.put (inputKeys.atUnchecked (0), param0[i]);
             inputs.put (IOKey::FilterSampleRate, filterSampleRates.wrapAt (i));
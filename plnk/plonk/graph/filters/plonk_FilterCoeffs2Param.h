@@ -41,6 +41,7 @@
 
 #include "../channel/plonk_ChannelInternalCore.h"
 #include "plonk_FilterForwardDeclarations.h"
+#include "plonk_FilterCoeffsControl.h"
 
 
 
@@ -143,6 +144,7 @@ public:
 
         data.filterSampleRate = filterSampleRate.getValue();
         data.filterSampleDuration = 1.0 / data.filterSampleRate;
+        data.controlReset = true;
     }
     
     void process (ProcessInfo& info, const int /*channel*/) throw()
@@ -163,6 +165,14 @@ public:
         const int param0BufferLength = param0Buffer.length();
         const int param1BufferLength = param1Buffer.length();
         
+        if (data.controlInterval > 0)
+        {
+            const SampleType* const params[] = { param0Samples, param1Samples };
+            const int paramLengths[] = { param0BufferLength, param1BufferLength };
+            this->processControl (params, paramLengths, outputBufferLength);
+            return;
+        }
+        
         if (outputBufferLength == param0BufferLength)
         {
             if (outputBufferLength == param1BufferLength)
@@ -255,6 +265,16 @@ public:
         }
     }
     
+    void processControl (const SampleType* const* params, const int* paramLengths, const int outputLength) throw()
+    {
+        SampleType* outputs[FormType::NumCoeffs];
+        
+        for (int j = 0; j < FormType::NumCoeffs; ++j)
+            outputs[j] = this->getOutputSamples (j);
+        
+        FilterCoeffsControl<ShapeType>::process (this->getState(), outputs, outputLength, params, paramLengths);
+    }
+    
 private:
     IntArray inputKeys;
 };
@@ -274,6 +294,7 @@ public:
     typedef typename ShapeType::FormType                    FormType;
         
     typedef FilterCoeffs2ParamChannelInternal<ShapeType>    FilterCoeffsInternal;
+    typedef FilterCoeffsControl<ShapeType>                  FilterCoeffsControlType;
     typedef ChannelBase<SampleType>                         ChannelType;
     typedef ChannelInternal<SampleType,Data>                Internal;
     typedef UnitBase<SampleType>                            UnitType;
@@ -301,12 +322,18 @@ public:
     
     
     /** Filter coefficients from two control parameters. 
-     This will generally be for some of the second order filters (e.g., with frequency and Q controls). */
+     This will generally be for some of the second order filters (e.g., with frequency and Q controls). 
+     If @c controlInterval is greater than zero the coefficients are calculated
+     at most once per interval and interpolated in between, @c controlTolerance
+     is the relative change in a parameter needed to cause a recalculation.
+     @see FilterCoeffsControl */
     static UnitType ar (UnitType const& param0,
                         UnitType const& param1,
                         SampleRates const filterSampleRates = SampleRate::getDefault(),
                         BlockSize const& preferredBlockSize = BlockSize::noPreference(),
-                        SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+                        SampleRate const& preferredSampleRate = SampleRate::noPreference(),
+                        const int controlInterval = 0,
+                        const double controlTolerance = 0.0) throw()
     {                
         const IntArray inputKeys = ShapeType::getInputKeys();
         
@@ -321,9 +348,28 @@ public:
         Memory::zero (data);
         data.base.sampleRate = -1.0;
         data.base.sampleDuration = -1.0;
+        data.controlInterval = plonk::max (controlInterval, 0);
+        data.controlTolerance = controlTolerance;
 
         for (int i = 0; i < numChannels; ++i)
         {
+            // channels with the same inputs share a generator
+            int shared = 0;
+            
+            while ((shared < i) &&
+                   ! (FilterCoeffsControlType::isSameInput (param0.wrapAt (shared), param0.wrapAt (i)) &&
+                      FilterCoeffsControlType::isSameInput (param1.wrapAt (shared), param1.wrapAt (i)) &&
+                      (filterSampleRates.wrapAt (shared).getValue() == filterSampleRates.wrapAt (i).getValue())))
+                ++shared;
+            
+            if (shared < i)
+            {
+                for (int j = 0; j < FormType::NumCoeffs; ++j)
+                    result.add (result.atUnchecked (shared * FormType::NumCoeffs + j));
+                
+                continue;
+            }
+            
             Inputs inputs;
             inputs.put (inputKeys.atUnchecked (0), param0[i]);
             inputs.put (inputKeys.atUnchecked (1), param1[i]);
@@ -41,6 +41,7 @@
 
 #include "../channel/plonk_ChannelInternalCore.h"
 #include "plonk_FilterForwardDeclarations.h"
+#include "plonk_FilterCoeffsControl.h"
 
 
 
@@ -146,6 +147,7 @@ public:
 
         data.filterSampleRate = filterSampleRate.getValue();
         data.filterSampleDuration = 1.0 / data.filterSampleRate;
+        data.controlReset = true;
     }
     
     void process (ProcessInfo& info, const int /*channel*/) throw()
@@ -171,6 +173,14 @@ public:
         const int param1BufferLength = param1Buffer.length();
         const int param2BufferLength = param2Buffer.length();
         
+        if (data.controlInterval > 0)
+        {
+            const SampleType* const params[] = { param0Samples, param1Samples, param2Samples };
+            const int paramLengths[] = { param0BufferLength, param1BufferLength, param2BufferLength };
+            this->processControl (params, paramLengths, outputBufferLength);
+            return;
+        }
+        
         if (outputBufferLength == param0BufferLength)
         {
             if ((outputBufferLength == param1BufferLength) &&
@@ -354,6 +364,16 @@ public:
         }
     }
     
+    void processControl (const SampleType* const* params, const int* paramLengths, const int outputLength) throw()
+    {
+        SampleType* outputs[FormType::NumCoeffs];
+        
+        for (int j = 0; j < FormType::NumCoeffs; ++j)
+            outputs[j] = this->getOutputSamples (j);
+        
+        FilterCoeffsControl<ShapeType>::process (this->getState(), outputs, outputLength, params, paramLengths);
+    }
+    
 private:
     IntArray inputKeys;
 };
@@ -373,6 +393,7 @@ public:
     typedef typename ShapeType::FormType                    FormType;
         
     typedef FilterCoeffs3ParamChannelInternal<ShapeType>    FilterCoeffsInternal;
+    typedef FilterCoeffsControl<ShapeType>                  FilterCoeffsControlType;
     typedef ChannelBase<SampleType>                         ChannelType;
     typedef ChannelInternal<SampleType,Data>                Internal;
     typedef UnitBase<SampleType>                            UnitType;
@@ -401,13 +422,19 @@ public:
     
     
     /** Filter coefficients from three control parameters. 
-     This will generally be for some of the second order filters (e.g., peak notch or the shelving filters). */
+     This will generally be for some of the second order filters (e.g., peak notch or the shelving filters). 
+     If @c controlInterval is greater than zero the coefficients are calculated
+     at most once per interval and interpolated in between, @c controlTolerance
+     is the relative change in a parameter needed to cause a recalculation.
+     @see FilterCoeffsControl */
     static UnitType ar (UnitType const& param0,
                         UnitType const& param1,
                         UnitType const& param2,
                         SampleRates const filterSampleRates = SampleRate::getDefault(),
                         BlockSize const& preferredBlockSize = BlockSize::noPreference(),
-                        SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+                        SampleRate const& preferredSampleRate = SampleRate::noPreference(),
+                        const int controlInterval = 0,
+                        const double controlTolerance = 0.0) throw()
     {                
         const IntArray inputKeys = ShapeType::getInputKeys();
         
@@ -422,9 +449,29 @@ public:
         Memory::zero (data);
         data.base.sampleRate = -1.0;
         data.base.sampleDuration = -1.0;
+        data.controlInterval = plonk::max (controlInterval, 0);
+        data.controlTolerance = controlTolerance;
 
         for (int i = 0; i < numChannels; ++i)
         {
+            // channels with the same inputs share a generator
+            int shared = 0;
+            
+            while ((shared < i) &&
+                   ! (FilterCoeffsControlType::isSameInput (param0.wrapAt (shared), param0.wrapAt (i)) &&
+                      FilterCoeffsControlType::isSameInput (param1.wrapAt (shared), param1.wrapAt (i)) &&
+                      FilterCoeffsControlType::isSameInput (param2.wrapAt (shared), param2.wrapAt (i)) &&
+                      (filterSampleRates.wrapAt (shared).getValue() == filterSampleRates.wrapAt (i).getValue())))
+                ++shared;
+            
+            if (shared < i)
+            {
+                for (int j = 0; j < FormType::NumCoeffs; ++j)
+                    result.add (result.atUnchecked (shared * FormType::NumCoeffs + j));
+                
+                continue;
+            }
+            
             Inputs inputs;
             inputs.put (inputKeys.atUnchecked (0), param0[i]);
             inputs.put (inputKeys.atUnchecked (1), param1[i]);
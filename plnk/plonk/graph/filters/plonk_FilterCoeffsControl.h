@@ -0,0 +1,147 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_FILTERCOEFFSCONTROL_H
+#define PLONK_FILTERCOEFFSCONTROL_H
+
+#include "plonk_FilterForwardDeclarations.h"
+#include "plonk_FilterShapes.h"
+
+/** Control rate filter coefficient calculation.
+ Used by the filter coefficient units when their control interval is non-zero
+ (by default the coefficients are calculated for every sample where the 
+ parameters are audio rate). The parameters are sampled at the end of each 
+ interval and the coefficients recalculated only if a parameter has changed 
+ by more than the tolerance, relative to its value at the last calculation. 
+ The coefficients are interpolated linearly across each interval. */
+template<class ShapeType>
+class FilterCoeffsControl
+{
+public:
+    typedef typename ShapeType::SampleDataType  SampleType;
+    typedef typename ShapeType::Data            Data;
+    typedef typename ShapeType::FormType        FormType;
+    typedef typename Data::CalcType             CalcType;
+    typedef ChannelBase<SampleType>             ChannelType;
+    
+    enum Constants
+    {
+        NumCoeffs = FormType::NumCoeffs,
+        NumParams = ShapeType::NumParams
+    };
+    
+    static void process (Data& data,
+                         SampleType* const* outputs,
+                         const int outputLength,
+                         const SampleType* const* params,
+                         const int* paramLengths) throw()
+    {
+        CalcType values[NumParams];
+        CalcType previous[NumCoeffs];
+        int i, j, p;
+        
+        for (int start = 0; start < outputLength; start += data.controlInterval)
+        {
+            const int length = plonk::min (data.controlInterval, outputLength - start);
+            const int end = start + length - 1;
+            const bool reset = data.controlReset;
+            bool recalculate = reset;
+            
+            for (p = 0; p < NumParams; ++p)
+            {
+                values[p] = params[p][int ((double (end) * double (paramLengths[p])) / double (outputLength))];
+                
+                if (plonk::abs (values[p] - data.params[p]) > (data.controlTolerance * plonk::abs (data.params[p])))
+                    recalculate = true;
+            }
+            
+            if (recalculate)
+            {
+                for (j = 0; j < NumCoeffs; ++j)
+                    previous[j] = data.coeffs[j];
+                
+                for (p = 0; p < NumParams; ++p)
+                    data.params[p] = values[p];
+                
+                ShapeType::calculate (data);
+                data.controlReset = false;
+                
+                // the previous coefficients are zero or stale after a reset so start from the new ones
+                if (reset)
+                {
+                    for (j = 0; j < NumCoeffs; ++j)
+                        previous[j] = data.coeffs[j];
+                }
+            }
+            
+            for (j = 0; j < NumCoeffs; ++j)
+            {
+                SampleType* const samples = outputs[j] + start;
+                const CalcType coeff = data.coeffs[j];
+                
+                if (recalculate && (length > 1))
+                {
+                    const CalcType increment = (coeff - previous[j]) / CalcType (length);
+                    
+                    for (i = 0; i < length - 1; ++i)
+                        samples[i] = SampleType (previous[j] + increment * CalcType (i + 1));
+                    
+                    samples[i] = SampleType (coeff);
+                }
+                else
+                {
+                    for (i = 0; i < length; ++i)
+                        samples[i] = SampleType (coeff);
+                }
+            }
+        }
+    }
+    
+    /** Whether two parameter inputs will always produce the same coefficients.
+     The filter coefficient units share one generator between such channels. */
+    static bool isSameInput (ChannelType const& a, ChannelType const& b) throw()
+    {
+        if (a.getInternal() == b.getInternal())
+            return true;
+        
+        return a.isConstant() && b.isConstant() && (a.getValue() == b.getValue());
+    }
+};
+
+
+#endif // PLONK_FILTERCOEFFSCONTROL_H
@@ -53,6 +53,10 @@ struct FilterShapeData
     
     CalcType coeffs[NumCoeffs];
     CalcType params[NumParams];
+    
+    int controlInterval;        // 0 to calculate for every sample
+    CalcType controlTolerance;
+    bool controlReset;
 };          
 
 template<class SampleType, signed Form, signed Shape>
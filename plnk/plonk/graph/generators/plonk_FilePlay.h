@@ -79,7 +79,8 @@ public:
     :   Internal (decideNumChannels (inputs, data), 
                   inputs, data, blockSize, sampleRate,
                   channels),
-        zero (0)
+        zero (0),
+        events (EventSender::DefaultCapacity)
     {
 //        AudioFileReader& file = this->getInputAsAudioFileReader (IOKey::AudioFileReader);
 //        file.setOwner (this);
@@ -101,6 +102,13 @@ public:
         const IntArray keys (IOKey::AudioFileReader, IOKey::Loop);
         return keys;
     }    
+    
+    /** Returns the sender for cue point, done and file change events.
+     Cue point events have the cue index and the frame position. */
+    EventSender getEventSender() throw()
+    {
+        return events;
+    }
         
     void initChannel (const int channel) throw()
     {       
@@ -114,7 +122,6 @@ public:
                 fileSampleRate = file.getDefaultSampleRate();
 
             this->setSampleRate (SampleRate::decide (fileSampleRate, this->getSampleRate()));
-            buffer.setSize (this->getBlockSize().getValue() * file.getNumChannels(), false);
         }
         
         this->initProxyValue (channel, 0);
@@ -181,7 +188,11 @@ public:
                 {
                     if (cue.getFramePosition (file.getSampleRate()) == filePosition)
                     {
-                        this->update (Text::getMessageCuePoint(), Text (cue.getLabel()));
+                        if (events.hasReceivers())
+                            events.post (Event::CuePoint, data.cueIndex, filePosition);
+                        
+                        if (this->hasReceivers())
+                            this->update (Text::getMessageCuePoint(), Text (cue.getLabel()));
                         
                         ++data.cueIndex;
                         cue = cuePoints[data.cueIndex];
@@ -207,12 +218,14 @@ public:
                 }
             }
             
-            buffer.setSize (bufferSize, false);
-            file.readFrames (buffer, zero);
+            // the interleaved frames are only needed until they're copied to the outputs
+            ScratchArena::Scope scope (info.getScratch());
+            SampleType* const readBuffer = scope.allocate<SampleType> (bufferSize);
+            
+            const int bufferAvailable = file.readFrames (readBuffer, bufferSize, zero);
             const bool changedNumChannels = file.didNumChannelsChange();
             const bool audioFileChanged = file.didAudioFileChange();
             const bool hitEOF = file.didHitEOF();
-            const int bufferAvailable = buffer.length();
             
             if ((bufferAvailable == 0) || data.done)
             {
@@ -240,7 +253,7 @@ public:
                     const int outputBufferLength = outputBuffer.length() - offset;
                     const int outputLengthToWrite = plonk::min (bufferFramesAvailable, outputBufferLength);
                     
-                    const SampleType* bufferSamples = buffer.getArray() + ((unsigned int)channel % (unsigned int)fileNumChannels);
+                    const SampleType* bufferSamples = readBuffer + ((unsigned int)channel % (unsigned int)fileNumChannels);
                     
                     for (int i = 0; i < outputLengthToWrite; ++i, bufferSamples += fileNumChannels)
                         outputSamples[i] = *bufferSamples;
@@ -257,6 +270,7 @@ public:
                 else if (! data.done)
                 {
                     data.done = true;
+                    events.post (Event::Done, 0, file.getFramePosition());
                     this->update (Text::getMessageDone(), Dynamic::getNull());
                 }
                 
@@ -274,7 +288,7 @@ public:
                     const int outputBufferLength = outputBuffer.length() - offset;
                     const int outputLengthToWrite = plonk::min (bufferFramesAvailable, outputBufferLength);
                     
-                    const SampleType* bufferSamples = buffer.getArray() + ((unsigned int)channel % (unsigned int)fileNumChannels);
+                    const SampleType* bufferSamples = readBuffer + ((unsigned int)channel % (unsigned int)fileNumChannels);
                     
                     for (int i = 0; i < outputLengthToWrite; ++i, bufferSamples += fileNumChannels)
                         outputSamples[i] = *bufferSamples;
@@ -285,10 +299,20 @@ public:
             }
             
             if (audioFileChanged)
-                this->update (Text::getMessageAudioFileChanged(), file);
+            {
+                events.post (Event::AudioFileChanged, 0, file.getFramePosition());
+                
+                if (this->hasReceivers())
+                    this->update (Text::getMessageAudioFileChanged(), file);
+            }
                 
             if (changedNumChannels)
-                this->update (Text::getMessageNumChannelsChanged(), IntVariable (fileNumChannels));
+            {
+                events.post (Event::NumChannelsChanged, fileNumChannels, file.getFramePosition());
+                
+                if (this->hasReceivers())
+                    this->update (Text::getMessageNumChannelsChanged(), IntVariable (fileNumChannels));
+            }
         }
         
         if (data.done && data.deleteWhenDone)
@@ -296,8 +320,439 @@ public:
     }
 
 private:
-    Buffer buffer; // might need to use a signal...
     IntVariable zero;
+    EventSender events;
+    
+    static const int decideNumChannels (Inputs const& inputs, Data const& data) throw()
+    {
+        if (data.numChannels > 0)
+        {
+            return data.numChannels;
+        }
+        else
+        {
+            const AudioFileReader& file = inputs[IOKey::AudioFileReader].asUnchecked<AudioFileReader>();
+            return file.getNumChannels();
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class SampleType> class FileStreamChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(FileStreamChannelInternal,SampleType)
+{    
+    ChannelInternalCore::Data base;
+    int numChannels;
+    int readAhead;
+    
+    bool done;//:1;
+    bool deleteWhenDone;//:1;
+};
+
+//------------------------------------------------------------------------------
+
+/** Streaming file player generator. 
+ The file is read ahead of the play position by a job on the shared 
+ TaskExecutor into a lock-free ring buffer so the audio thread only copies. */
+template<class SampleType>
+class FileStreamChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(FileStreamChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(FileStreamChannelInternal,SampleType)    Data;
+    typedef ChannelBase<SampleType>                                         ChannelType;
+    typedef ObjectArray<ChannelType>                                        ChannelArrayType;
+    typedef FileStreamChannelInternal<SampleType>                           FileStreamInternal;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                      Internal;
+    typedef UnitBase<SampleType>                                            UnitType;
+    typedef InputDictionary                                                 Inputs;
+    typedef NumericalArray<SampleType>                                      Buffer;
+    
+    /** A message from the reader to be sent once playback reaches a frame. 
+     The type is one of the Event::Messages IDs. */
+    class StreamEvent : public PlonkBase
+    {
+    public:
+        StreamEvent() throw() : frame (0), type (Event::None), value (0) { }
+        StreamEvent (const LongLong f, const int t, const int v = 0, Text const& l = Text::getEmpty()) throw()
+        :   frame (f), type (t), value (v), label (l)
+        {
+        }
+        
+        LongLong frame;
+        int type;
+        int value;
+        Text label;
+    };
+    
+    /** Reads the file into the ring, this runs on the TaskExecutor. 
+     All of the loop and cue point handling happens here so reads continue
+     across loop boundaries without waiting for the audio thread. */
+    class Streamer : public TaskExecutor::Job
+    {
+    public:
+        Streamer (AudioFileReader const& fileToUse, 
+                  IntVariable const& loopCountToUse,
+                  const int numChannelsToUse,
+                  const int readAhead) throw()
+        :   file (fileToUse),
+            loopCount (loopCountToUse),
+            zero (0),
+            numChannels (numChannelsToUse),
+            capacity (Bits::nextPowerOf2 (plonk::max (readAhead, int (MinimumCapacity)))),
+            chunkSize (plonk::max (capacity / 4, int (MinimumCapacity) / 4)),
+            cueIndex (0),
+            framesWritten (0),
+            framesRead (0),
+            done (false)
+        {
+            ring.setSize (capacity * numChannels, false);
+            ring.zero();
+        }
+        
+        /** Fills the free space in the ring. */
+        void perform() throw()
+        {
+            while (! done)
+            {
+                const int space = capacity - ((writePosition.getValueUnchecked() - readPosition.getValue()) & PositionMask);
+                
+                if (space < plonk::min (chunkSize, capacity / 2))
+                    break;
+                
+                const int framesToWrite = readChunk (plonk::min (space, chunkSize));
+                
+                if (framesToWrite == 0)
+                    break;
+                
+                writePosition.setValue ((writePosition.getValueUnchecked() + framesToWrite) & PositionMask);
+            }
+        }
+        
+        /** The number of frames ready to play, call only from the audio thread. */
+        PLONK_INLINE_LOW int getNumFramesAvailable() const throw()
+        {
+            return (writePosition.getValue() - readPosition.getValueUnchecked()) & PositionMask;
+        }
+        
+        /** Copies frames from the ring to the output buffers, call only from the audio thread. */
+        void copyFrames (FileStreamInternal& owner, const int offset, const int numFrames) throw()
+        {
+            const int start = int (framesRead & (capacity - 1));
+            const int firstFrames = plonk::min (numFrames, capacity - start);
+            
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                SampleType* const outputSamples = owner.getOutputSamples (channel) + offset;
+                const SampleType* const ringSamples = ring.getArray() + channel * capacity;
+
+                Buffer::copyData (outputSamples, ringSamples + start, firstFrames);
+                Buffer::copyData (outputSamples + firstFrames, ringSamples, numFrames - firstFrames);
+            }
+            
+            framesRead += numFrames;
+            readPosition.setValue (int (framesRead & PositionMask));
+        }
+        
+        PLONK_INLINE_LOW LongLong getFramesRead() const throw() { return framesRead; }
+        PLONK_INLINE_LOW LockFreeQueue<StreamEvent>& getEvents() throw() { return events; }
+        
+    private:
+        enum Constants
+        {
+            MinimumCapacity = 1024,
+            PositionMask = (1 << 30) - 1
+        };
+        
+        AudioFileReader file;
+        IntVariable loopCount;
+        IntVariable zero;
+        Buffer buffer;
+        Buffer ring;
+        const int numChannels;
+        const int capacity;
+        const int chunkSize;
+        int cueIndex;
+        LongLong framesWritten;
+        LongLong framesRead;
+        bool done;
+        AtomicInt writePosition;
+        AtomicInt readPosition;
+        LockFreeQueue<StreamEvent> events;
+        
+        void loopOrFinish() throw()
+        {
+            if ((loopCount.getValue() == 0) || (loopCount.getValue() > 1))
+            {
+                file.resetFramePosition();
+                cueIndex = 0;
+                
+                if (loopCount.getValue() > 1)
+                    loopCount.setValue (loopCount.getValue() - 1);
+            }
+            else
+            {
+                done = true;
+                events.push (StreamEvent (framesWritten, Event::Done));
+            }
+        }
+        
+        int readChunk (const int framesToRead) throw()
+        {
+            const int fileNumChannels = file.getNumChannels();
+            int bufferSize = framesToRead * fileNumChannels;
+            
+            const LongLong numFrames = file.getNumFrames();
+            LongLong filePosition = file.getFramePosition();
+            bool willHitEOF = false;
+            
+            if (numFrames > 0)
+            {
+                LongLong framesRemaining = numFrames - filePosition;
+                
+                if (framesRemaining == 0)
+                {
+                    loopOrFinish();
+                    
+                    if (done)
+                        return 0;
+                    
+                    filePosition = file.getFramePosition();
+                    framesRemaining = numFrames - filePosition;
+                }
+                
+                if (framesRemaining <= LongLong (framesToRead))
+                {
+                    bufferSize = int (plonk::min (LongLong (bufferSize), framesRemaining * fileNumChannels));
+                    willHitEOF = true;
+                }
+            }
+            
+            const AudioFileMetaData metaData = file.getMetaData();
+            
+            if (metaData.isNotNull())
+            {
+                const AudioFileCuePointArray cuePoints = metaData.getCuePoints();
+                AudioFileCuePoint cue = cuePoints[cueIndex];
+                
+                bool renderToNextCue = false;
+                
+                if (cue.isNotNull())
+                {
+                    if (cue.getFramePosition (file.getSampleRate()) == filePosition)
+                    {
+                        events.push (StreamEvent (framesWritten, Event::CuePoint, cueIndex, Text (cue.getLabel())));
+                        
+                        ++cueIndex;
+                        cue = cuePoints[cueIndex];
+                        
+                        if (cue.isNotNull())
+                            renderToNextCue = true;
+                    }
+                    else
+                    {
+                        renderToNextCue = true;
+                    }
+                    
+                    if (renderToNextCue)
+                    {
+                        const LongLong framesToNextCue = cue.getFramePosition (file.getSampleRate()) - filePosition;
+                        
+                        if (framesToNextCue < LongLong (bufferSize / fileNumChannels))
+                        {
+                            bufferSize = int (plonk::min (LongLong (bufferSize), framesToNextCue * fileNumChannels));
+                            willHitEOF = false;
+                        }
+                    }
+                }
+            }
+            
+            buffer.setSize (bufferSize, false);
+            file.readFrames (buffer, zero);
+            
+            if (file.didAudioFileChange())
+                events.push (StreamEvent (framesWritten, Event::AudioFileChanged));
+            
+            if (file.didNumChannelsChange())
+                events.push (StreamEvent (framesWritten, Event::NumChannelsChanged, fileNumChannels));
+            
+            const bool hitEOF = file.didHitEOF();
+            const int bufferFramesAvailable = buffer.length() / fileNumChannels;
+            const int start = int (framesWritten & (capacity - 1));
+            
+            for (int i = 0; i < bufferFramesAvailable; ++i)
+            {
+                const SampleType* const bufferSamples = buffer.getArray() + i * fileNumChannels;
+                const int ringIndex = (start + i) & (capacity - 1);
+                
+                for (int channel = 0; channel < numChannels; ++channel)
+                    ring.getArray()[channel * capacity + ringIndex] = bufferSamples[(unsigned int)channel % (unsigned int)fileNumChannels];
+            }
+            
+            framesWritten += bufferFramesAvailable;
+
+            if ((bufferFramesAvailable > 0) && (willHitEOF || hitEOF))
+                loopOrFinish();
+            
+            return bufferFramesAvailable;
+        }
+    };
+    
+    FileStreamChannelInternal (Inputs const& inputs, 
+                               Data const& data, 
+                               BlockSize const& blockSize,
+                               SampleRate const& sampleRate,
+                               ChannelArrayType& channels) throw()
+    :   Internal (decideNumChannels (inputs, data), 
+                  inputs, data, blockSize, sampleRate,
+                  channels),
+        executor (TaskExecutor::getDefault()),
+        streamer (new Streamer (this->getInputAsAudioFileReader (IOKey::AudioFileReader),
+                                this->template getInputAs<IntVariable> (IOKey::LoopCount),
+                                this->getNumChannels(),
+                                data.readAhead)),
+        events (EventSender::DefaultCapacity),
+        hasPendingEvent (false)
+    {
+        executor.submit (streamer);
+    }
+    
+    ~FileStreamChannelInternal()
+    {
+        executor.end (streamer);
+    }
+            
+    Text getName() const throw()
+    {
+        return "File Stream";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::AudioFileReader, IOKey::Loop);
+        return keys;
+    }    
+    
+    /** Returns the sender for cue point, done and file change events.
+     Cue point events have the cue index and the frame position. */
+    EventSender getEventSender() throw()
+    {
+        return events;
+    }
+        
+    void initChannel (const int channel) throw()
+    {       
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            const AudioFileReader& file = this->getInputAsAudioFileReader (IOKey::AudioFileReader);
+
+            double fileSampleRate = file.getSampleRate();
+            
+            if (fileSampleRate <= 0.0)
+                fileSampleRate = file.getDefaultSampleRate();
+
+            this->setSampleRate (SampleRate::decide (fileSampleRate, this->getSampleRate()));
+        }
+        
+        this->initProxyValue (channel, 0);
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        Data& data = this->getState();
+        
+        const int numChannels = this->getNumChannels();
+        const int blockSize = this->getBlockSize().getValue();
+        int offset = 0;
+        
+        while (offset < blockSize)
+        {
+            if (! hasPendingEvent)
+                hasPendingEvent = streamer->getEvents().pop (pendingEvent);
+            
+            if (hasPendingEvent && (pendingEvent.frame <= streamer->getFramesRead()))
+            {
+                sendEvent (data);
+                hasPendingEvent = false;
+                continue;
+            }
+            
+            int framesToCopy = plonk::min (blockSize - offset, streamer->getNumFramesAvailable());
+            
+            if (hasPendingEvent)
+                framesToCopy = int (plonk::min (LongLong (framesToCopy), pendingEvent.frame - streamer->getFramesRead()));
+            
+            if (framesToCopy <= 0)
+                break;
+            
+            streamer->copyFrames (*this, offset, framesToCopy);
+            offset += framesToCopy;
+        }
+        
+        if (offset < blockSize)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                SampleType* const outputSamples = this->getOutputSamples (channel);
+                
+                for (int i = offset; i < blockSize; ++i)
+                    outputSamples[i] = SampleType (0);
+            }
+        }
+        
+        if (! data.done)
+            executor.submit (streamer);
+        
+        if (data.done && data.deleteWhenDone)
+            info.setShouldDelete();
+    }
+
+private:
+    typedef typename FileStreamInternal::Streamer StreamerType;
+    
+    TaskExecutor& executor;
+    StreamerType* const streamer;
+    EventSender events;
+    StreamEvent pendingEvent;
+    bool hasPendingEvent;
+    
+    void sendEvent (Data& data) throw()
+    {
+        if (pendingEvent.type == Event::Done)
+        {
+            if (data.done)
+                return;
+            
+            data.done = true;
+        }
+        
+        if (events.hasReceivers())
+            events.post (pendingEvent.type, pendingEvent.value, pendingEvent.frame);
+        
+        // the Text/Dynamic messages are only built if someone is listening
+        if (! this->hasReceivers())
+            return;
+        
+        switch (pendingEvent.type)
+        {
+            case Event::CuePoint:
+                this->update (Text::getMessageCuePoint(), pendingEvent.label);
+                break;
+            case Event::Done:
+                this->update (Text::getMessageDone(), Dynamic::getNull());
+                break;
+            case Event::AudioFileChanged:
+                this->update (Text::getMessageAudioFileChanged(), this->getInputAsAudioFileReader (IOKey::AudioFileReader));
+                break;
+            case Event::NumChannelsChanged:
+                this->update (Text::getMessageNumChannelsChanged(), IntVariable (pendingEvent.value));
+                break;
+            default:
+                break;
+        }
+    }
     
     static const int decideNumChannels (Inputs const& inputs, Data const& data) throw()
     {
@@ -322,7 +777,8 @@ private:
  The sample rate of the unit is by default set to the sample rate of the audio file.
  
  NB This should not be used directly in a real-time audio thread. It should
- be wrapped in a TaskUnit which buffers the audio on a separate thread.
+ be wrapped in a TaskUnit which buffers the audio on a separate thread or
+ FilePlay::Stream should be used instead.
  
  @par Factory functions:
  - ar (file, loopCount=0, mul=1, add=0, allowAutoDelete=true, preferredBlockSize=default, preferredSampleRate=noPref)
@@ -399,6 +855,52 @@ public:
         } 
         else return UnitType::getNull();
     }
+    
+    /** A file player that streams from disk on a background thread.
+     The file is read ahead into a ring buffer by a job on the shared 
+     TaskExecutor so, unlike ar(), this is safe to use directly in a real-time 
+     audio thread. Looping and cue points are handled by the reader so reading
+     continues across loop boundaries. If the reader falls behind the output 
+     is silent until it catches up. 
+     
+     @par Factory functions:
+     - ar (file, loopCount=0, readAhead=32768, mul=1, add=0, allowAutoDelete=true, preferredBlockSize=default, preferredSampleRate=noPref)
+     
+     @par Inputs:
+     - readAhead: (int) the number of frames to read ahead (rounded up to a power of 2) */
+    class Stream
+    {
+    public:
+        typedef FileStreamChannelInternal<SampleType>       FileStreamInternal;
+        typedef typename FileStreamInternal::Data           Data;
+        
+        static UnitType ar (AudioFileReader const& file,
+                            IntVariable const& loopCount = 0,
+                            const int readAhead = 32768,
+                            UnitType const& mul = SampleType (1),
+                            UnitType const& add = SampleType (0),
+                            const bool deleteWhenDone = true,
+                            BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                            SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+        {             
+            if (file.isReady() && ! file.isOwned())
+            {            
+                Inputs inputs;
+                inputs.put (IOKey::AudioFileReader, file);
+                inputs.put (IOKey::LoopCount, loopCount);
+                inputs.put (IOKey::Multiply, mul);
+                inputs.put (IOKey::Add, add);
+                
+                Data data = { { -1.0, -1.0 }, file.getDefaultNumChannels(), readAhead, false, deleteWhenDone };
+                
+                return UnitType::template proxiesFromInputs<FileStreamInternal> (inputs, 
+                                                                                 data, 
+                                                                                 preferredBlockSize, 
+                                                                                 preferredSampleRate);
+            } 
+            else return UnitType::getNull();
+        }
+    };
         
     /** A simple file player to handle buffering and sample rate conversion.
      This just adds a Task and Resample unit to the chain to buffer the 
@@ -52,6 +52,19 @@ PLONK_CHANNELDATA_DECLARE(TableChannelInternal,SampleType)
     FrequencyType currentPosition;
 };      
 
+template<class SampleType> class TableBankChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(TableBankChannelInternal,SampleType)
+{    
+    typedef typename TypeUtility<SampleType>::IndexType FrequencyType;
+
+    ChannelInternalCore::Data base;
+    FrequencyType currentPosition;
+    int tableLength;
+    int numTables;
+    int numHarmonics;
+};      
+
 //------------------------------------------------------------------------------
 
 /** Wavetable oscillator. */
@@ -304,15 +317,209 @@ private:
 
 //------------------------------------------------------------------------------
 
+/** Linear interpolating table lookup for a block.
+ The float version uses the Plank SIMD kernels. */
+template<class SampleType>
+class TableLookupLinear
+{
+public:
+    typedef typename TypeUtility<SampleType>::IndexType     FrequencyType;
+    typedef InterpLinear<SampleType,FrequencyType>          InterpType;
+
+    static PLONK_INLINE_LOW FrequencyType findMaximumFrequency (const FrequencyType* const frequencySamples, const int frequencyBufferLength) throw()
+    {
+        FrequencyType maximumFrequency (0);
+        
+        for (int i = 0; i < frequencyBufferLength; ++i)
+            maximumFrequency = plonk::max (maximumFrequency, plonk::abs (frequencySamples[i]));
+        
+        return maximumFrequency;
+    }
+
+    static PLONK_INLINE_LOW void process (SampleType* const outputSamples, const int outputBufferLength,
+                                          const SampleType* const tableSamples, const int tableLength,
+                                          FrequencyType& position,
+                                          const FrequencyType* const frequencySamples, const int frequencyBufferLength,
+                                          const FrequencyType tableLengthOverSampleRate) throw()
+    {
+        const FrequencyType length = FrequencyType (tableLength);
+        const FrequencyType table0 (0);
+        FrequencyType currentPosition = position;
+        double frequencyPosition = 0.0;
+        const double frequencyIncrement = double (frequencyBufferLength) / double (outputBufferLength);
+        const int frequencyStride = (frequencyBufferLength == outputBufferLength) ? 1 : 0;
+        int i;
+        
+        for (i = 0; i < outputBufferLength; ++i) 
+        {
+            const int frequencyIndex = (frequencyBufferLength == 1) ? 0 : frequencyStride ? i : int (frequencyPosition);
+            
+            outputSamples[i] = InterpType::lookup (tableSamples, currentPosition);
+            currentPosition += frequencySamples[frequencyIndex] * tableLengthOverSampleRate;
+            
+            if (currentPosition >= length)
+                currentPosition -= length;
+            else if (currentPosition < table0)	
+                currentPosition += length;                
+            
+            frequencyPosition += frequencyIncrement;
+        }
+        
+        position = currentPosition;
+    }
+};
+
+template<>
+class TableLookupLinear<float>
+{
+public:
+    typedef float FrequencyType;
+    
+    static PLONK_INLINE_LOW FrequencyType findMaximumFrequency (const FrequencyType* const frequencySamples, const int frequencyBufferLength) throw()
+    {
+        return pl_VectorMaxAbsF_N (frequencySamples, frequencyBufferLength);
+    }
+    
+    static PLONK_INLINE_LOW void process (float* const outputSamples, const int outputBufferLength,
+                                          const float* const tableSamples, const int tableLength,
+                                          FrequencyType& position,
+                                          const FrequencyType* const frequencySamples, const int frequencyBufferLength,
+                                          const FrequencyType tableLengthOverSampleRate) throw()
+    {
+        if (frequencyBufferLength == outputBufferLength)
+        {
+            pl_VectorTableLinearF_NN (outputSamples, tableSamples, tableLength, &position, 
+                                      frequencySamples, tableLengthOverSampleRate, outputBufferLength);
+        }
+        else if (frequencyBufferLength == 1)
+        {
+            pl_VectorTableLinearF_N1 (outputSamples, tableSamples, tableLength, &position, 
+                                      frequencySamples[0], tableLengthOverSampleRate, outputBufferLength);
+        }
+        else
+        {
+            double frequencyPosition = 0.0;
+            const double frequencyIncrement = double (frequencyBufferLength) / double (outputBufferLength);
+            int i;
+            
+            for (i = 0; i < outputBufferLength; ++i)
+            {
+                pl_VectorTableLinearF_N1 (outputSamples + i, tableSamples, tableLength, &position, 
+                                          frequencySamples[int (frequencyPosition)], tableLengthOverSampleRate, 1);
+                frequencyPosition += frequencyIncrement;
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Band-limited wavetable oscillator using a WavetableBank. 
+ The table is chosen each block from the highest absolute frequency in the 
+ block, the tables are phase aligned so switching table only changes which
+ harmonics are present. */
+template<class SampleType>
+class TableBankChannelInternal 
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(TableBankChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(TableBankChannelInternal,SampleType) Data;
+    typedef ChannelBase<SampleType>                                     ChannelType;
+    typedef TableBankChannelInternal<SampleType>                        TableBankInternal;
+    typedef ChannelInternal<SampleType,Data>                            Internal;
+    typedef ChannelInternalBase<SampleType>                             InternalBase;
+    typedef UnitBase<SampleType>                                        UnitType;
+    typedef InputDictionary                                             Inputs;
+    typedef NumericalArray<SampleType>                                  Buffer;
+    typedef WavetableBankBase<SampleType>                               WavetableBankType;
+    
+    typedef typename TypeUtility<SampleType>::IndexType         FrequencyType;
+    typedef UnitBase<FrequencyType>                             FrequencyUnitType;
+    typedef NumericalArray<FrequencyType>                       FrequencyBufferType;
+    typedef TableLookupLinear<SampleType>                       LookupType;
+
+    TableBankChannelInternal (Inputs const& inputs, 
+                              Data const& data, 
+                              BlockSize const& blockSize,
+                              SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate)
+    {
+    }
+            
+    Text getName() const throw()
+    {
+        return "Table Bank";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Buffer, 
+                             IOKey::Frequency);
+        return keys;
+    }    
+    
+    InternalBase* getChannel (const int index) throw()
+    {
+        const Inputs channelInputs = this->getInputs().getChannel (index);
+        return new TableBankInternal (channelInputs, 
+                                      this->getState(), 
+                                      this->getBlockSize(), 
+                                      this->getSampleRate());
+    }
+    
+    void initChannel (const int channel) throw()
+    {        
+        const FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        
+        this->setBlockSize (BlockSize::decide (frequencyUnit.getBlockSize (channel),
+                                               this->getBlockSize()));
+        this->setSampleRate (SampleRate::decide (frequencyUnit.getSampleRate (channel),
+                                                 this->getSampleRate()));
+        
+        this->setOverlap (frequencyUnit.getOverlap (channel));
+        
+        this->initValue (this->getState().currentPosition);
+    }    
+    
+    void process (ProcessInfo& info, const int channel) throw()
+    {        
+        Data& data = this->getState();
+
+        FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        const FrequencyBufferType& frequencyBuffer (frequencyUnit.process (info, channel));
+        
+        const FrequencyType* const frequencySamples = frequencyBuffer.getArray();
+        const int frequencyBufferLength = frequencyBuffer.length();
+        
+        const FrequencyType maximumFrequency = LookupType::findMaximumFrequency (frequencySamples, frequencyBufferLength);
+        const int tableIndex = WavetableBankType::selectTable (data.numHarmonics, data.numTables, 
+                                                               maximumFrequency, data.base.sampleRate);
+        
+        const Buffer& tables (this->getInputAsBuffer (IOKey::Buffer));
+        const SampleType* const tableSamples = tables.getArray() + tableIndex * data.tableLength * 2;
+        
+        LookupType::process (this->getOutputSamples(), this->getOutputBuffer().length(),
+                             tableSamples, data.tableLength,
+                             data.currentPosition,
+                             frequencySamples, frequencyBufferLength,
+                             FrequencyType (data.tableLength * data.base.sampleDuration));
+    }
+};
+
+//------------------------------------------------------------------------------
+
 
 /** Wavetable oscillator. 
  
  @par Factory functions:
  - ar (table, frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
  - kr (table, frequency=440, mul=1, add=0) 
+ - ar (bank, frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (bank, frequency=440, mul=1, add=0) 
  
  @par Inputs:
  - table: (wavetable) the wavetable to use for the oscillator
+ - bank: (wavetablebank) band-limited tables, one is chosen per block from the frequency
  - frequency: (unit, multi) the frequency of the oscillator in Hz
  - mul: (unit, multi) the multiplier applied to the output
  - add: (unit, multi) the offset added to the output
@@ -332,6 +539,9 @@ public:
     typedef UnitBase<SampleType>                    UnitType;
     typedef InputDictionary                         Inputs;
     typedef WavetableBase<SampleType>               WavetableType;
+    typedef TableBankChannelInternal<SampleType>    TableBankInternal;
+    typedef typename TableBankInternal::Data        BankData;
+    typedef WavetableBankBase<SampleType>           WavetableBankType;
     
     typedef typename TableInternal::FrequencyType         FrequencyType;
     typedef typename TableInternal::FrequencyUnitType     FrequencyUnitType;
@@ -394,6 +604,47 @@ public:
                    BlockSize::getControlRateBlockSize(), 
                    SampleRate::getControlRate());
     }        
+    
+    /** Create an audio rate band-limited wavetable oscillator from a WavetableBank. 
+     The table with the most harmonics below the Nyquist frequency is chosen
+     each block so this doesn't need oversampling to avoid aliasing. */
+    static UnitType ar (WavetableBankType const& bank, 
+                        FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {             
+        Inputs inputs;
+        inputs.put (IOKey::Buffer, bank.getTables());
+        inputs.put (IOKey::Frequency, frequency);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+                        
+        BankData data;
+        Memory::zero (data);
+        data.base.sampleRate = -1.0;
+        data.base.sampleDuration = -1.0;
+        data.tableLength = bank.getTableLength();
+        data.numTables = bank.getNumTables();
+        data.numHarmonics = bank.getNumHarmonics();
+        
+        return UnitType::template createFromInputs<TableBankInternal> (inputs, 
+                                                                       data, 
+                                                                       preferredBlockSize, 
+                                                                       preferredSampleRate);
+    }
+    
+    /** Create a control rate band-limited wavetable oscillator from a WavetableBank. */
+    static UnitType kr (WavetableBankType const& bank,
+                        FrequencyUnitType const& frequency, 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return ar (bank, frequency, mul, add, 
+                   BlockSize::getControlRateBlockSize(), 
+                   SampleRate::getControlRate());
+    }        
 };
 
 typedef TableUnit<PLONK_TYPE_DEFAULT> Table;
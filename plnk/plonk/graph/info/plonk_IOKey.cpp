@@ -113,6 +113,9 @@ IOKey::Name IOKey::fromInt (const int value) throw()
         IOKey::Priority,
         IOKey::MaximumDuration,
         IOKey::PreferredNumChannels,
+        IOKey::MaxVoices,
+        IOKey::StealMode,
+        IOKey::ParallelFlag,
     };
     
     if (value == IOKey::End)   
@@ -212,6 +215,9 @@ Text IOKey::getName (const int keyIndex) throw()
         "Priority",
         "Maximum Duration",
         "Preferred Num Channels",
+        "Max Voices",
+        "Steal Mode",
+        "Parallel Flag",
     };
     
     if (keyIndex < 0 || keyIndex >= NumNames)
@@ -296,6 +302,9 @@ IOKey::IOType IOKey::getType (const int keyIndex) throw()
         IOKey::TypeNumerical,
         IOKey::TypeNumerical,       //"Maximum Duration"
         IOKey::TypeNumerical,       //"Preferred NumChannels"
+        IOKey::TypeNumerical,       //"Max Voices"
+        IOKey::TypeNumerical,       //"Steal Mode"
+        IOKey::TypeBool,            //"Parallel Flag"
     };
     
     if (keyIndex < 0 || keyIndex >= IOKey::NumNames)
@@ -381,6 +390,9 @@ Text IOKey::getTypeName (const int keyIndex) throw()
         "Numerical",
         "Numerical",        //"Maximum Duration"
         "Numerical",        //"Preferred NumChannels"
+        "Numerical",        //"Max Voices"
+        "Numerical",        //"Steal Mode"
+        "Bool",             //"Parallel Flag"
     };
     
     if (keyIndex < 0 || keyIndex >= IOKey::NumNames)
@@ -157,6 +157,9 @@ public:
         Priority,
         MaximumDuration,
         PreferredNumChannels,
+        MaxVoices,
+        StealMode,
+        ParallelFlag,
 
         NumNames
     };
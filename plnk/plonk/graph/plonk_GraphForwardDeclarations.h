@@ -52,6 +52,7 @@ class BlockSize;
 class SampleRate;
 class ProcessInfo;
 class ProcessInfoInternal;
+class ScratchArena;
 class TimeStamp;
 class InputDictionary;
 
@@ -73,6 +74,7 @@ template<class SampleType>                                              class Un
 template<class SampleType, class DataType>                              class ProxyOwnerChannelInternal;
 template<class SampleType>                                              class ProxyChannelInternal;
 template<class OwnerType>                                               struct ChannelData;
+template<class SampleType>                                              class GraphSchedulerBase;
         
 // common channels
 template<class SampleType>                                              class ConstantChannelInternal;
@@ -82,8 +84,9 @@ template<class SampleType, PLONK_BINARYOPFUNCTION(SampleType, op)>      class Bi
 template<class SampleType, PLONK_UNARYOPFUNCTION(SampleType, op)>       class UnaryOpChannelInternal;
 template<class SampleType>                                              class MulAddChannelInternal;
 
-template<class SampleType>                                              class ConvolveChannelInternal;
 template<class SampleType>                                              class ConvolveHelper;
+template<class SampleType>                                              class NonUniformConvolveHelper;
+template<class SampleType, class ConvolveHelperType = ConvolveHelper<SampleType> > class ConvolveChannelInternal;
 
 // common units
 template<class SampleType>                                              class MulAddUnit;
@@ -184,6 +187,7 @@ typedef PLONK_UNITBASETYPE<UnitBase<PLONK_TYPE_DEFAULT> >   UnitRaw;
 typedef NumericalArray2D<Channel,Unit>                      Units;
 typedef BusBuffer<PLONK_TYPE_DEFAULT>                       Bus;
 typedef PLONK_BUSARRAYBASETYPE<Bus>                         Busses;
+typedef GraphSchedulerBase<PLONK_TYPE_DEFAULT>              GraphScheduler;
 
 // variable graph objects
 typedef Variable< ChannelBase<float>& >                     FloatChannelVariable;
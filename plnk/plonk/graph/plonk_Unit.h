@@ -937,6 +937,11 @@ public:
     /** Gets the number of channels in this unit. */
     PLONK_INLINE_LOW int getNumChannels() const throw() { return this->length(); }
     
+    /** Returns the realtime event sender for one of the channels.
+     For units where all channels share a sender (e.g., FilePlay) any index
+     gives the same sender. @see EventSender */
+    PLONK_INLINE_LOW EventSender getEventSender (const int index = 0) throw() { return this->wrapAt (index).getEventSender(); }
+    
     /** Returns a unit with the single channel specified.
      This wraps the index so that it is always in range. It is also recursive such that the returned
      channel has in turn stripped out the other multiple channels during the process. */
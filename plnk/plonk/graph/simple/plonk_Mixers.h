@@ -86,6 +86,26 @@ public:
         return keys;
     }    
     
+    bool hasParallelInputs() const throw()
+    {
+        return true;
+    }
+    
+    int getParallelInputs (ChannelType* channels, int* channelIndices, const int maximum) throw()
+    {
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        const int numChannels = inputUnit.getNumChannels();
+        const int count = plonk::min (numChannels, maximum);
+        
+        for (int channel = 0; channel < count; ++channel)
+        {
+            channels[channel] = inputUnit.atUnchecked (channel);
+            channelIndices[channel] = channel;
+        }
+        
+        return numChannels;
+    }
+    
     InternalBase* getChannel (const int /*index*/) throw()
     {
         return this;
@@ -206,6 +226,35 @@ public:
         const IntArray keys (IOKey::Units);
         return keys;
     }    
+    
+    bool hasParallelInputs() const throw()
+    {
+        return true;
+    }
+    
+    int getParallelInputs (ChannelType* channels, int* channelIndices, const int maximum) throw()
+    {
+        UnitsType& units = this->getInputAsUnits (IOKey::Units);
+        const int numChannels = this->getNumChannels();
+        const int numUnits = units.length();
+        int count = 0;
+        
+        for (int unit = 0; unit < numUnits; ++unit)
+        {
+            UnitType& inputUnit (units.atUnchecked (unit));
+            
+            for (int channel = 0; channel < numChannels; ++channel, ++count)
+            {
+                if (count < maximum)
+                {
+                    channels[count] = inputUnit.wrapAt (channel);
+                    channelIndices[count] = channel;
+                }
+            }
+        }
+        
+        return count;
+    }
         
     void initChannel (const int channel) throw()
     {        
@@ -347,6 +396,11 @@ public:
         return keys;
     }
     
+    bool hasStaticInputs() const throw()
+    {
+        return false;
+    }
+    
     static PLONK_INLINE_LOW const UnitType& getDummy() throw()
     {
         // dummy is a marker so we know we've done the whole queue up to the poiunt that we add this dummy marker
@@ -500,6 +554,26 @@ public:
         return keys;
     }    
     
+    bool hasParallelInputs() const throw()
+    {
+        return true;
+    }
+    
+    int getParallelInputs (ChannelType* channels, int* channelIndices, const int maximum) throw()
+    {
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        const int numChannels = inputUnit.getNumChannels();
+        const int count = plonk::min (numChannels, maximum);
+        
+        for (int channel = 0; channel < count; ++channel)
+        {
+            channels[channel] = inputUnit.atUnchecked (channel);
+            channelIndices[channel] = channel;
+        }
+        
+        return numChannels;
+    }
+    
     InternalBase* getChannel (const int /*index*/) throw()
     {
         return this;
@@ -631,6 +705,35 @@ public:
         return keys;
     }    
     
+    bool hasParallelInputs() const throw()
+    {
+        return true;
+    }
+    
+    int getParallelInputs (ChannelType* channels, int* channelIndices, const int maximum) throw()
+    {
+        UnitsType& units = this->getInputAsUnits (IOKey::Units);
+        const int numChannels = this->getNumChannels();
+        const int numUnits = units.length();
+        int count = 0;
+        
+        for (int unit = 0; unit < numUnits; ++unit)
+        {
+            UnitType& inputUnit (units.atUnchecked (unit));
+            
+            for (int channel = 0; channel < numChannels; ++channel, ++count)
+            {
+                if (count < maximum)
+                {
+                    channels[count] = inputUnit.wrapAt (channel);
+                    channelIndices[count] = channel;
+                }
+            }
+        }
+        
+        return count;
+    }
+    
     void initChannel (const int channel) throw()
     {        
         if ((channel % this->getNumChannels()) == 0)
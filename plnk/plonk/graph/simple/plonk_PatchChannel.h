@@ -97,6 +97,11 @@ public:
         const IntArray keys (IOKey::UnitVariable);
         return keys;
     }    
+    
+    bool hasStaticInputs() const throw()
+    {
+        return false;
+    }
         
     void initChannel (const int channel) throw()
     {
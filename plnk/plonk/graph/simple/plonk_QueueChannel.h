@@ -90,6 +90,11 @@ public:
         return keys;
     }
     
+    bool hasStaticInputs() const throw()
+    {
+        return false;
+    }
+    
     void initChannel (const int channel) throw()
     {
         if ((channel % this->getNumChannels()) == 0)
@@ -112,13 +112,10 @@ public:
             SampleType* const outputSamples = this->getOutputSamples();
             const int outputBufferLength = this->getOutputBuffer().length();
             
-            for (int i = 0; i < outputBufferLength; ++i)
-            {
-                value = variable.nextValue();
-                outputSamples[i] = value;
-            }
+            variable.nextValues (outputSamples, outputBufferLength);
             
-            data.currValue = value;
+            if (outputBufferLength > 0)
+                data.currValue = outputSamples[outputBufferLength - 1];
         }
         else
         {
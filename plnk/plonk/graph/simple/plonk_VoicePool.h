@@ -0,0 +1,451 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_VOICEPOOL_H
+#define PLONK_VOICEPOOL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class VoicePoolChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(VoicePoolChannelInternal,SampleType)
+{
+    ChannelInternalCore::Data base;
+    int preferredNumChannels;
+    int maxVoices;
+    int stealMode;
+    bool allowAutoDelete;//:1;
+    bool parallel;//:1;
+};
+
+/** Mix a polyphonic pool of voices to a multichannel unit. 
+ New voices arrive through a lock-free queue but once taken from the queue 
+ they are held in an array owned by the audio thread. This avoids popping and
+ re-pushing every voice each block as the QueueMixer does. Expired voices are
+ compacted out of the array in a single pass. When the pool is full a voice 
+ is stolen (the oldest or the quietest) and faded out over one block. */
+template<class SampleType>
+class VoicePoolChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(VoicePoolChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(VoicePoolChannelInternal,SampleType)         Data;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
+    typedef ChannelBase<SampleType>                                             ChannelType;
+    typedef ObjectArray<ChannelType>                                            ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                          Internal;
+    typedef UnitBase<SampleType>                                                UnitType;
+    typedef ObjectArray<UnitType>                                               VoiceArrayType;
+    typedef InputDictionary                                                     Inputs;
+    typedef NumericalArray<SampleType>                                          Buffer;
+    typedef LockFreeQueue<UnitType>                                             QueueType;
+    
+    enum StealModes
+    {
+        StealNone,      ///< New voices wait in the queue until a voice expires.
+        StealOldest,    ///< The voice that started first is stolen.
+        StealQuietest   ///< The voice with the lowest peak level in the previous block is stolen.
+    };
+    
+    VoicePoolChannelInternal (Inputs const& inputs,
+                              Data const& data,
+                              BlockSize const& blockSize,
+                              SampleRate const& sampleRate,
+                              ChannelArrayType& channels) throw()
+    :   Internal (data.preferredNumChannels > 0 ? data.preferredNumChannels : inputs.getMaxNumChannels(),
+                  inputs, data, blockSize, sampleRate, channels),
+        numVoices (0),
+        numStolen (0),
+        version (0)
+    {
+        // room for a full pool plus one block's worth of voices fading out
+        const int capacity = plonk::max (data.maxVoices, 1) * 2;
+        voices = VoiceArrayType::withSize (capacity);
+        levels = Doubles::newClear (capacity);
+        stolen = IntArray::newClear (capacity);
+    }
+    
+    Text getName() const throw()
+    {
+        return "Voice Pool";
+    }
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::UnitQueue);
+        return keys;
+    }
+    
+    bool hasStaticInputs() const throw()
+    {
+        return false;
+    }
+    
+    bool hasParallelInputs() const throw()
+    {
+        return this->getState().parallel;
+    }
+    
+    int getParallelInputsVersion() const throw()
+    {
+        return version;
+    }
+    
+    int getParallelInputs (ChannelType* channels, int* channelIndices, const int maximum) throw()
+    {
+        // the voice array only changes at the start of process() so the 
+        // scheduler may pre-render the voices from the previous block
+        const int numChannels = this->getNumChannels();
+        int count = 0;
+        
+        for (int voice = 0; voice < numVoices; ++voice)
+        {
+            UnitType& inputUnit (voices.atUnchecked (voice));
+            
+            for (int channel = 0; channel < numChannels; ++channel, ++count)
+            {
+                if (count < maximum)
+                {
+                    channels[count] = inputUnit.wrapAt (channel);
+                    channelIndices[count] = channel;
+                }
+            }
+        }
+        
+        return count;
+    }
+    
+    void initChannel (const int channel) throw()
+    {
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (BlockSize::getDefault(),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (SampleRate::getDefault(),
+                                                     this->getSampleRate()));
+        }
+        
+        SampleType value (0);
+        
+        for (int voice = 0; voice < numVoices; ++voice)
+            value += voices.atUnchecked (voice).getValue (channel);
+
+        this->initProxyValue (channel, value);
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        const Data& data = this->getState();
+        
+        const int numChannels = this->getNumChannels();
+        const bool trackLevels = data.stealMode == StealQuietest;
+        int i, voice, channel;
+        
+        for (channel = 0; channel < numChannels; ++channel)
+            this->getOutputBuffer (channel).zero();
+        
+        this->updateVoices (info);
+        
+        UnitType* const voiceUnits = voices.getArray();
+        double* const voiceLevels = levels.getArray();
+        int* const voiceStolen = stolen.getArray();
+        
+        for (voice = 0; voice < numVoices; ++voice)
+        {
+            UnitType& inputUnit (voiceUnits[voice]);
+            double peak = 0.0;
+            
+            for (channel = 0; channel < numChannels; ++channel)
+            {
+                const Buffer& inputBuffer (inputUnit.process (info, channel));
+                const SampleType* const inputSamples = inputBuffer.getArray();
+                const int inputBufferLength = inputBuffer.length();
+                
+                Buffer& outputBuffer = this->getOutputBuffer (channel);
+                SampleType* const outputSamples = outputBuffer.getArray();
+                const int outputBufferLength = outputBuffer.length();
+                
+                if (voiceStolen[voice])
+                {
+                    // linear fade to silence over this block
+                    double inputPosition = 0.0;
+                    const double inputIncrement = double (inputBufferLength) / double (outputBufferLength);
+                    const SampleType gainIncrement = SampleType (1) / SampleType (outputBufferLength);
+                    SampleType gain (1);
+                    
+                    for (i = 0; i < outputBufferLength; ++i)
+                    {
+                        gain -= gainIncrement;
+                        outputSamples[i] += inputSamples[int (inputPosition)] * gain;
+                        inputPosition += inputIncrement;
+                    }
+                }
+                else if (inputBufferLength == outputBufferLength)
+                {
+                    NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcNN (outputSamples, outputSamples, inputSamples, outputBufferLength);
+                }
+                else if (inputBufferLength == 1)
+                {
+                    NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcN1 (outputSamples, outputSamples, inputSamples[0], outputBufferLength);
+                }
+                else
+                {
+                    double inputPosition = 0.0;
+                    const double inputIncrement = double (inputBufferLength) / double (outputBufferLength);
+                    
+                    for (i = 0; i < outputBufferLength; ++i)
+                    {
+                        outputSamples[i] += inputSamples[int (inputPosition)];
+                        inputPosition += inputIncrement;
+                    }
+                }
+                
+                if (trackLevels)
+                {
+                    for (i = 0; i < inputBufferLength; ++i)
+                        peak = plonk::max (peak, plonk::abs (double (inputSamples[i])));
+                }
+                
+                if (data.allowAutoDelete == false)
+                    info.resetShouldDelete();
+            }
+            
+            voiceLevels[voice] = peak;
+        }
+    }
+    
+private:
+    VoiceArrayType voices;
+    Doubles levels;
+    IntArray stolen;
+    int numVoices;
+    int numStolen;
+    int version;
+    
+    /** Compacts and refills the voice array once per block. 
+     Voices that have expired, or were faded out in the previous block, are 
+     removed keeping the remainder in the order they started. New voices are 
+     then taken from the queue, stealing if the pool is full. */
+    void updateVoices (ProcessInfo const& info) throw()
+    {
+        const Data& data = this->getState();
+        const int maxVoices = plonk::max (data.maxVoices, 1);
+        const int capacity = voices.length();
+        
+        UnitType* const voiceUnits = voices.getArray();
+        double* const voiceLevels = levels.getArray();
+        int* const voiceStolen = stolen.getArray();
+        
+        int voice, live;
+        
+        for (voice = 0, live = 0; voice < numVoices; ++voice)
+        {
+            if (voiceStolen[voice] || voiceUnits[voice].shouldBeDeletedNow (info))
+                continue;
+            
+            if (live != voice)
+            {
+                voiceUnits[live] = voiceUnits[voice];
+                voiceLevels[live] = voiceLevels[voice];
+            }
+            
+            voiceStolen[live] = 0;
+            ++live;
+        }
+        
+        for (voice = live; voice < numVoices; ++voice)
+        {
+            voiceUnits[voice] = UnitType::getNull();
+            voiceStolen[voice] = 0;
+        }
+        
+        if (live != numVoices)
+            ++version;
+        
+        numVoices = live;
+        numStolen = 0;
+        
+        QueueType& queue = this->getInputAsUnitQueue (IOKey::UnitQueue);
+        
+        while ((numVoices < capacity) && (queue.length() > 0))
+        {
+            if ((numVoices - numStolen) >= maxVoices)
+            {
+                const int victim = this->findVictim (data.stealMode);
+                
+                if (victim < 0)
+                    break;
+                
+                voiceStolen[victim] = 1;
+                ++numStolen;
+            }
+            
+            UnitType inputUnit;
+            
+            if (! queue.pop (inputUnit))
+                break;
+            
+            voiceUnits[numVoices] = inputUnit;
+            voiceLevels[numVoices] = -1.0; // not yet measured
+            voiceStolen[numVoices] = 0;
+            ++numVoices;
+            ++version;
+        }
+    }
+    
+    int findVictim (const int stealMode) const throw()
+    {
+        const double* const voiceLevels = levels.getArray();
+        const int* const voiceStolen = stolen.getArray();
+        int voice, victim = -1;
+        
+        // voices that have not rendered a block yet are not candidates, 
+        // if all voices are new the remainder wait in the queue
+        for (voice = 0; voice < numVoices; ++voice)
+        {
+            if (voiceStolen[voice] || (voiceLevels[voice] < 0.0))
+                continue;
+            
+            if (stealMode == StealOldest)
+                return voice;
+            
+            if ((victim < 0) || (voiceLevels[voice] < voiceLevels[victim]))
+                victim = voice;
+        }
+        
+        return (stealMode == StealQuietest) ? victim : -1;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Voice pool. 
+ Mixes a queue of units like the Mixer's queue form but holds the active 
+ voices in an array owned by the audio thread, with an upper limit on the 
+ number of voices.
+ 
+ @par Factory functions:
+ - ar (queue, maxVoices=32, stealMode=StealOldest, parallel=false, allowAutoDelete=false, preferredNumChannels=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ 
+ @par Inputs:
+ - queue: (unit queue) the queue to which new voices are pushed
+ - maxVoices: (int) the maximum number of voices sounding at once
+ - stealMode: (int) what to do with a new voice when the pool is full: StealNone leaves it in the queue, StealOldest or StealQuietest fade out an existing voice over one block
+ - parallel: (bool) allow a GraphScheduler to render the voices on its worker threads
+ - allowAutoDelete: (bool) whether this unit can be casued to be deleted by the unit(s) it contains (off by default as voices are expected to end)
+ - preferredNumChannels: (int) force this unit to have a certain number of channels (0= the maximum channel count in the queue)
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup MathsUnits */
+template<class SampleType>
+class VoicePoolUnit
+{
+public:
+    typedef VoicePoolChannelInternal<SampleType>        VoicePoolInternal;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef LockFreeQueue<UnitType>                     QueueType;
+    
+    enum StealModes
+    {
+        StealNone       = VoicePoolInternal::StealNone,
+        StealOldest     = VoicePoolInternal::StealOldest,
+        StealQuietest   = VoicePoolInternal::StealQuietest
+    };
+
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+
+        return UnitInfo ("Voice Pool", "Mixes a queue of voices down to a multichannel unit with a voice limit.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount,
+                         IOKey::Generic,                 Measure::None,      IOInfo::NoDefault,  IOLimit::None,      IOKey::End,
+                         
+                         // inputs
+                         IOKey::UnitQueue,               Measure::None,
+                         IOKey::MaxVoices,               Measure::Count,     32.0,               IOLimit::Minimum,   Measure::Count,     1.0,
+                         IOKey::StealMode,               Measure::None,      1.0,                IOLimit::None,
+                         IOKey::ParallelFlag,            Measure::Bool,      IOInfo::False,      IOLimit::None,
+                         IOKey::AutoDeleteFlag,          Measure::Bool,      IOInfo::False,      IOLimit::None,
+                         IOKey::PreferredNumChannels,    Measure::Count,     0.0,                IOLimit::None,
+                         IOKey::Multiply,                Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::Add,                     Measure::None,      0.0,                IOLimit::None,
+                         IOKey::BlockSize,               Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate,              Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate voice pool. */
+    static UnitType ar (QueueType const& queue,
+                        const int maxVoices = 32,
+                        const int stealMode = StealOldest,
+                        const bool parallel = false,
+                        const bool allowAutoDelete = false,
+                        const int preferredNumChannels = 0,
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {
+        typedef PLONK_CHANNELDATA_NAME(VoicePoolChannelInternal,SampleType) Data;
+        
+        Inputs inputs;
+        inputs.put (IOKey::UnitQueue, queue);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+        
+        Data data = { { -1.0, -1.0 }, preferredNumChannels, maxVoices, stealMode, allowAutoDelete, parallel };
+        
+        return UnitType::template proxiesFromInputs<VoicePoolInternal> (inputs,
+                                                                        data,
+                                                                        preferredBlockSize,
+                                                                        preferredSampleRate);
+    }
+};
+
+typedef VoicePoolUnit<PLONK_TYPE_DEFAULT> VoicePool;
+
+#endif // PLONK_VOICEPOOL_H
@@ -73,6 +73,12 @@ BlockSize::BlockSize (BlockSize const& copy) throw()
 {
 }        
 
+BlockSize& BlockSize::operator= (BlockSize const& other) throw()
+{
+    Base::operator= (static_cast<Base const&> (other));
+    return *this;
+}
+
 BlockSize::BlockSize (BlockSizeDefault const& copy) throw()
 :	Base (static_cast<Base const&> (copy))
 {
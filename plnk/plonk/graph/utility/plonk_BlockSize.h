@@ -81,6 +81,10 @@ public:
     /** Copy constructor. */
     BlockSize (BlockSize const& copy) throw();
     
+    /** Assignment operator. 
+     This shares the other's value as for Variable. */
+    BlockSize& operator= (BlockSize const& other) throw();
+    
     BlockSize (BlockSizeDefault const& copy) throw();
     BlockSize (BlockSizeNoPreference const& copy) throw();
         
@@ -0,0 +1,1006 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+
+#ifndef PLONK_GRAPHSCHEDULER_H
+#define PLONK_GRAPHSCHEDULER_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../utility/plonk_ProcessInfo.h"
+
+
+/** Renders independent parts of a Unit graph on several threads.
+ The scheduler looks down from the output unit through channels with static
+ inputs until it finds channels that sum independent inputs (i.e., mixers).
+ The subgraphs feeding those inputs are grouped so that no two groups share 
+ a channel or bus and the groups are then rendered by a set of worker threads
+ (and the calling thread) before the calling thread pulls the rest of the 
+ graph as normal. Channels rendered ahead of time are skipped by the usual 
+ time stamp check so the output is the same as the serial render.
+ 
+ Subgraphs containing channels whose inputs can change while running 
+ (e.g., PatchChannel, QueueChannel, TaskChannel) stay on the calling thread,
+ as do subgraphs using a bus that is also used on the calling thread's path.
+ 
+ The plan of groups is built on a separate thread whenever the output unit or
+ the inputs of one of the mixers change (see 
+ ChannelInternalCore::getParallelInputsVersion()). The audio thread only 
+ compares the versions each block and renders serially for the few blocks 
+ it takes to build a new plan. Worker threads wait on an event between blocks.
+ 
+ Alternatively the channels of the output unit itself can be used in place 
+ of the mixer inputs (see setParallelChannels()) so that independent output
+ channels are rendered on separate threads.
+ @see AudioHostBase::setNumRenderThreads() */
+template<class SampleType>
+class GraphSchedulerBase : public PlonkBase
+{
+public:
+    typedef ChannelBase<SampleType>             ChannelType;
+    typedef ChannelInternalBase<SampleType>     InternalBase;
+    typedef UnitBase<SampleType>                UnitType;
+    typedef ObjectArray<ChannelType>            ChannelArrayType;
+    typedef ObjectArray<ChannelInternalCore*>   InternalArray;
+    typedef ObjectArray<void*>                  PointerArray;
+    typedef NumericalArray2D<ChannelType,UnitType> UnitsType;
+    
+    enum Constants
+    {
+        IndexBits = 12,
+        IndexMask = (1 << IndexBits) - 1,
+        MaxGroups = IndexMask,
+        GenerationShift = IndexBits * 2,
+        GenerationMask = 0x7F,
+        SpinCount = 1000,
+        MinCapacity = 64
+    };
+    
+    GraphSchedulerBase() throw()
+    :   builder (0),
+        active (&plans[0]),
+        pending (&plans[1]),
+        renderPlan (0),
+        blockSampleClock (-1),
+        blockSampleClockRate (0.0),
+        generation (0),
+        parallelChannels (false),
+        numHashed (0)
+    {
+    }
+    
+    ~GraphSchedulerBase()
+    {
+        this->stop();
+    }
+    
+    /** Sets the number of worker threads.
+     Zero (the default) disables parallel rendering. This stops any running 
+     workers, call start() to start the new ones. */
+    void setNumThreads (const int numThreads) throw()
+    {
+        plonk_assert (numThreads >= 0);
+        
+        this->stop();
+        
+        for (int i = 0; i < numThreads; ++i)
+            workers.add (new Worker (*this));
+    }
+    
+    PLONK_INLINE_LOW int getNumThreads() const throw() { return workers.length(); }
+    
+    /** Sets whether the channels of the output unit are rendered in parallel.
+     By default the scheduler looks for mixers below the output unit, if this 
+     is @c true each output channel is rendered as a whole instead. Channels 
+     that share any part of their graph are still rendered together. */
+    void setParallelChannels (const bool state) throw()
+    {
+        parallelChannels = state;
+    }
+    
+    PLONK_INLINE_LOW bool getParallelChannels() const throw() { return parallelChannels; }
+    
+    /** Starts the worker threads.
+     Each worker is given audio priority for the given block size and sample 
+     rate and is pinned to a core, leaving the first core for the host's
+     audio thread. If there are more workers than the remaining cores they 
+     share them. A thread to build the plans is also started. */
+    void start (const int blockSize, const double sampleRate) throw()
+    {
+        const int numWorkers = workers.length();
+        
+        if (numWorkers == 0)
+            return;
+        
+        const int numCores = Threading::getNumCores();
+        
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            Worker* worker = workers.atUnchecked (i);
+            
+            if (! worker->isRunning())
+            {
+                worker->setAudioFormat (blockSize, sampleRate);
+                
+                if (numCores > 1)
+                    worker->setAffinity (1 + (i % (numCores - 1)));
+                
+                worker->start();
+                
+                // the running flag is set by the new thread, wait for it so 
+                // an immediate stop() can't delete a worker that is starting
+                while (! worker->isRunning())
+                    Threading::yield();
+            }
+        }
+        
+        if (builder == 0)
+        {
+            builder = new Builder (*this);
+            builder->start();
+            
+            while (! builder->isRunning())
+                Threading::yield();
+        }
+    }
+    
+    /** Stops and deletes the worker threads. */
+    void stop() throw()
+    {
+        const int numWorkers = workers.length();
+        
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            Worker* worker = workers.atUnchecked (i);
+            
+            if (worker->isRunning())
+                exitAndWait (worker);
+            
+            delete worker;
+        }
+        
+        workers.clear();
+        
+        if (builder != 0)
+        {
+            if (builder->isRunning())
+                exitAndWait (builder);
+            
+            delete builder;
+            builder = 0;
+        }
+        
+        buildState.setValue (Idle);
+        this->retire (plans[0]);
+        this->retire (plans[1]);
+    }
+    
+    /** Renders the independent subgraphs of a unit for the current time stamp.
+     This must be called from the audio thread before the unit is processed.
+     @return @c true if anything was rendered in which case the ProcessInfo 
+             passed to the unit should be flagged with setPreRendered(). */
+    bool render (UnitType& unit, ProcessInfo& info) throw()
+    {
+        if ((workers.length() == 0) || (builder == 0))
+            return false;
+        
+        Plan* const plan = this->update (unit);
+        
+        if ((plan == 0) || (plan->numGroups < 2))
+            return false;
+        
+        renderPlan = plan;
+        blockTime = info.getTimeStamp();
+        blockSampleClock = info.getSampleClock();
+        blockSampleClockRate = info.getSampleClockRate();
+        done.setValue (0);
+        generation = (generation + 1) & GenerationMask;
+        claim.setValue ((generation << GenerationShift) | (plan->numGroups << IndexBits));
+        
+        const int numWorkers = workers.length();
+        
+        for (int i = 0; i < numWorkers; ++i)
+            workers.atUnchecked (i)->wakeIfParked();
+        
+        while (this->renderNext (localInfo))
+            ; // the calling thread helps until all groups are claimed
+        
+        while (done.getValue() < plan->numGroups)
+            ; // ..then waits for the workers to finish theirs
+        
+        return true;
+    }
+    
+private:
+    /** The groups to render for a particular graph.
+     The audio thread renders using the active plan while the other plan is 
+     built. The arrays the audio thread fills in are preallocated. */
+    class Plan
+    {
+    public:
+        Plan() throw()
+        :   numCandidates (0),
+            numGroups (0),
+            parallel (false),
+            valid (false)
+        {
+            roots.setSize (MinCapacity, false);
+            roots.clear();
+            candidates.setSize (MinCapacity, false);
+            candidateIndices.setSize (MinCapacity, false);
+        }
+        
+        ChannelArrayType roots;
+        InternalArray fanIns;
+        IntArray versions;
+        ChannelArrayType candidates;
+        IntArray candidateIndices;
+        IntArray groupStarts;
+        IntArray groupItems;
+        int numCandidates;
+        int numGroups;
+        bool parallel;
+        bool valid;
+    };
+    
+    /** The steps to build the pending plan.
+     The audio thread requests Find with the new roots, the Builder finds the 
+     mixers, the audio thread copies their inputs and requests Group (or Grow
+     if the arrays are too small) and the plan is then Ready to swap in. The 
+     previously active plan is then retired on the Builder. */
+    enum BuildStates
+    {
+        Idle,
+        Find,
+        Found,
+        Grow,
+        Group,
+        Ready,
+        Retire
+    };
+    
+    class Worker : public Threading::Thread
+    {
+    public:
+        Worker (GraphSchedulerBase& schedulerToUse) throw()
+        :   Threading::Thread ("GraphScheduler Worker"),
+            scheduler (schedulerToUse),
+            blockSize (0),
+            sampleRate (0.0)
+        {
+        }
+        
+        void setAudioFormat (const int newBlockSize, const double newSampleRate) throw()
+        {
+            blockSize = newBlockSize;
+            sampleRate = newSampleRate;
+        }
+        
+        void wake() throw()
+        {
+            event.signal();
+        }
+        
+        PLONK_INLINE_LOW void wakeIfParked() throw()
+        {
+            if (parked.getValue() != 0)
+                event.signal();
+        }
+        
+        ResultCode run() throw()
+        {
+            if (blockSize > 0)
+                this->setPriorityAudio (blockSize, sampleRate);
+            
+            int idle = 0;
+            
+            while (! this->getShouldExit())
+            {
+                if (scheduler.renderNext (info))
+                {
+                    idle = 0;
+                }
+                else if (++idle >= SpinCount)
+                {
+                    // check again once counted as parked in case a block 
+                    // started in between, the event stays set if it was signalled
+                    parked.setValue (1);
+                    
+                    if (! scheduler.hasWork() && ! this->getShouldExit())
+                        event.wait();
+                    
+                    parked.setValue (0);
+                    idle = 0;
+                }
+            }
+            
+            return 0;
+        }
+        
+    private:
+        GraphSchedulerBase& scheduler;
+        ProcessInfo info;
+        Lock event;
+        AtomicInt parked;
+        int blockSize;
+        double sampleRate;
+    };
+    
+    /** Builds the plans away from the audio thread. */
+    class Builder : public Threading::Thread
+    {
+    public:
+        Builder (GraphSchedulerBase& schedulerToUse) throw()
+        :   Threading::Thread ("GraphScheduler Builder"),
+            scheduler (schedulerToUse)
+        {
+        }
+        
+        void wake() throw()
+        {
+            event.signal();
+        }
+        
+        ResultCode run() throw()
+        {
+            while (! this->getShouldExit())
+            {
+                event.wait();
+                
+                if (! this->getShouldExit())
+                    scheduler.build();
+            }
+            
+            return 0;
+        }
+        
+    private:
+        GraphSchedulerBase& scheduler;
+        Lock event;
+    };
+    
+    /** Sets the exit flag once then wakes the thread until it has exited. 
+     A single wake could be used up before the flag is set and leave the
+     thread waiting on its event. */
+    template<class ThreadType>
+    static void exitAndWait (ThreadType* thread) throw()
+    {
+        thread->setShouldExit();
+        
+        while (thread->isRunning())
+        {
+            thread->wake();
+            Threading::sleep (0.000001);
+        }
+    }
+    
+    typedef ObjectArray<Worker*> WorkerArray;
+    
+    WorkerArray workers;
+    Builder* builder;
+    Plan plans[2];
+    Plan* active;
+    Plan* pending;
+    Plan* renderPlan;
+    AtomicInt buildState;
+    ProcessInfo localInfo;
+    TimeStamp blockTime;
+    LongLong blockSampleClock;
+    double blockSampleClockRate;
+    AtomicInt claim;
+    AtomicInt done;
+    int generation;
+    bool parallelChannels;
+    int numHashed;
+    
+    // used only on the Builder thread
+    PointerArray hashKeys;
+    IntArray hashValues;
+    InternalArray stack;
+    IntArray searching;
+    InternalArray children;
+    PointerArray busses;
+    IntArray parents;
+    IntArray flags;
+    
+    PLONK_INLINE_LOW bool hasWork() const throw()
+    {
+        const int current = claim.getValue();
+        return (current & IndexMask) < ((current >> IndexBits) & IndexMask);
+    }
+    
+    /** Claims and renders the next group for the current block.
+     The claim word packs the block generation, the number of groups and the
+     next group index so a stale claim from a previous block always fails. */
+    bool renderNext (ProcessInfo& renderInfo) throw()
+    {
+        const int current = claim.getValue();
+        const int index = current & IndexMask;
+        const int count = (current >> IndexBits) & IndexMask;
+        
+        if (index >= count)
+            return false;
+        
+        if (! claim.compareAndSwap (current, current + 1))
+            return true; // someone else got it, try again
+        
+        Plan& plan = *renderPlan;
+        
+        renderInfo.setTimeStamp (blockTime);
+        renderInfo.setSampleClock (blockSampleClock, blockSampleClockRate);
+        renderInfo.getScratch().reset();
+        
+        const int end = plan.groupStarts.atUnchecked (index + 1);
+        
+        for (int i = plan.groupStarts.atUnchecked (index); i < end; ++i)
+        {
+            const int item = plan.groupItems.atUnchecked (i);
+            ChannelType& channel = plan.candidates.atUnchecked (item);
+            
+            if (! channel.getInternal()->shouldBeDeletedNow (blockTime))
+                channel.process (renderInfo, plan.candidateIndices.atUnchecked (item));
+            
+            renderInfo.resetShouldDelete();
+        }
+        
+        ++done;
+        return true;
+    }
+    
+    static PLONK_INLINE_LOW bool matchesTiming (ChannelInternalCore* internal, ChannelInternalCore* root) throw()
+    {
+        return (internal->getBlockSize().getValue() == root->getBlockSize().getValue()) &&
+               (internal->getSampleRate().getValue() == root->getSampleRate().getValue()) &&
+               (internal->getOverlap().getValue() == 1.0);
+    }
+    
+    /** Returns the plan to render the unit with, or null if one is being built.
+     Called on the audio thread, this only moves the build along and checks 
+     the active plan is still current. It doesn't allocate or release any 
+     channels. */
+    Plan* update (UnitType& unit) throw()
+    {
+        const int state = buildState.getValue();
+        
+        if (state == Found)
+        {
+            if (this->matchesRoots (*pending, unit))
+                this->request (this->copyCandidates (*pending, unit) ? Group : Grow);
+            else
+                this->request (Retire); // the unit changed while finding
+        }
+        else if (state == Ready)
+        {
+            Plan* const built = pending;
+            pending = active;
+            active = built;
+            this->request (Retire);
+        }
+        
+        if (this->isCurrent (*active, unit))
+            return active;
+        
+        if (state == Idle)
+        {
+            const int numChannels = unit.getNumChannels();
+            
+            pending->roots.setSize (numChannels, false);
+            
+            for (int i = 0; i < numChannels; ++i)
+                pending->roots.atUnchecked (i) = unit.atUnchecked (i);
+            
+            pending->parallel = parallelChannels;
+            this->request (Find);
+        }
+        
+        return 0;
+    }
+    
+    PLONK_INLINE_LOW void request (const int state) throw()
+    {
+        buildState.setValue (state);
+        builder->wake();
+    }
+    
+    bool matchesRoots (Plan const& plan, UnitType& unit) const throw()
+    {
+        const int numChannels = unit.getNumChannels();
+        
+        if (numChannels != plan.roots.length())
+            return false;
+        
+        for (int i = 0; i < numChannels; ++i)
+            if (unit.atUnchecked (i).getInternal() != plan.roots.atUnchecked (i).getInternal())
+                return false;
+        
+        return true;
+    }
+    
+    bool isCurrent (Plan const& plan, UnitType& unit) const throw()
+    {
+        if (! plan.valid || (plan.parallel != parallelChannels) || ! this->matchesRoots (plan, unit))
+            return false;
+        
+        const int numFanIns = plan.fanIns.length();
+        
+        for (int i = 0; i < numFanIns; ++i)
+            if (plan.fanIns.atUnchecked (i)->getParallelInputsVersion() != plan.versions.atUnchecked (i))
+                return false;
+        
+        return true;
+    }
+    
+    /** Copies the mixers' inputs into the plan's preallocated arrays.
+     This is done on the audio thread as the inputs of some mixers (e.g., 
+     VoicePool) are changed there.
+     @return @c false if there was not enough room. */
+    bool copyCandidates (Plan& plan, UnitType& unit) throw()
+    {
+        int i;
+        
+        ChannelType* const channels = plan.candidates.getArray();
+        int* const indices = plan.candidateIndices.getArray();
+        const int capacity = plan.candidates.length();
+        const int numFanIns = plan.fanIns.length();
+        int total = 0;
+        
+        for (i = 0; i < numFanIns; ++i)
+        {
+            InternalBase* const mixer = static_cast<InternalBase*> (plan.fanIns.atUnchecked (i));
+            const int start = plonk::min (total, capacity);
+            
+            plan.versions.atUnchecked (i) = mixer->getParallelInputsVersion();
+            total += mixer->getParallelInputs (channels + start, indices + start, capacity - start);
+        }
+        
+        if (plan.parallel)
+        {
+            const int numChannels = unit.getNumChannels();
+            
+            for (i = 0; i < numChannels; ++i, ++total)
+            {
+                if (total < capacity)
+                {
+                    channels[total] = unit.atUnchecked (i);
+                    indices[total] = i;
+                }
+            }
+        }
+        
+        plan.numCandidates = total;
+        return total <= capacity;
+    }
+    
+    /** Does the step requested by the audio thread on the pending plan. 
+     Called on the Builder thread. */
+    void build() throw()
+    {
+        Plan& plan = *pending;
+        
+        switch (buildState.getValue())
+        {
+            case Find:
+                this->findFanIns (plan);
+                plan.versions.setSize (plan.fanIns.length(), false);
+                buildState.setValue (Found);
+                break;
+                
+            case Grow:
+                plan.candidates.setSize (plan.numCandidates * 2, false);
+                plan.candidateIndices.setSize (plan.numCandidates * 2, false);
+                buildState.setValue (Found);
+                break;
+                
+            case Group:
+                this->buildGroups (plan);
+                plan.valid = true;
+                buildState.setValue (Ready);
+                break;
+                
+            case Retire:
+                this->retire (plan);
+                buildState.setValue (Idle);
+                break;
+                
+            default:
+                break;
+        }
+    }
+    
+    /** Releases the channels held by a plan.
+     This leaves room for twice as many candidates so a growing graph rarely
+     needs the Grow step. */
+    void retire (Plan& plan) throw()
+    {
+        const int capacity = plonk::max (plan.candidates.length(), plan.numCandidates * 2);
+        
+        plan.roots.clear();
+        plan.candidates.clear();
+        plan.candidates.setSize (capacity, false);
+        plan.candidateIndices.setSize (capacity, false);
+        plan.numCandidates = 0;
+        plan.numGroups = 0;
+        plan.valid = false;
+    }
+    
+    /** Walks down from the roots to find the mixers. 
+     Mixers are only looked for through channels of this type with static 
+     inputs running at the roots' rate, as others are not processed exactly 
+     once per block. Every channel and bus on the calling thread's path is 
+     recorded in the table so the groups using them stay on the calling thread.
+     Inputs that may change are not read as the audio thread could be changing
+     them. */
+    void findFanIns (Plan& plan) throw()
+    {
+        int i;
+        
+        plan.fanIns.clear();
+        this->clearHash (64);
+        
+        const int numRoots = plan.roots.length();
+        
+        if ((numRoots == 0) || plan.parallel)
+            return;
+        
+        ChannelInternalCore* const timing = plan.roots.atUnchecked (0).getInternal();
+        
+        stack.clear();
+        searching.clear();
+        
+        for (i = 0; i < numRoots; ++i)
+            this->push (plan.roots.atUnchecked (i).getInternal(), true);
+        
+        while (stack.length() > 0)
+        {
+            ChannelInternalCore* const node = stack.last()->getProcessingInternal();
+            const bool search = searching.last() != 0;
+            stack.setSize (stack.length() - 1, true);
+            searching.setSize (searching.length() - 1, true);
+            
+            if (this->findHash (node) != -1)
+                continue;
+            
+            this->insertHash (node, -2);
+            
+            const bool canSearch = search && matchesTiming (node, timing);
+            
+            if (canSearch && node->hasParallelInputs())
+            {
+                plan.fanIns.add (node);
+                continue;
+            }
+            
+            if (! node->hasStaticInputs())
+                continue;
+            
+            children.clear();
+            busses.clear();
+            node->getInputs().getInternals (children, busses);
+            
+            const int numBusses = busses.length();
+            
+            for (i = 0; i < numBusses; ++i)
+                if (this->findHash (busses.atUnchecked (i)) == -1)
+                    this->insertHash (busses.atUnchecked (i), -2);
+            
+            const int numChildren = children.length();
+            
+            for (i = 0; i < numChildren; ++i)
+                this->push (children.atUnchecked (i), false);
+            
+            // pushed last so these are searched before being reached as above
+            if (canSearch)
+                this->addUnitInputs (node);
+        }
+    }
+    
+    PLONK_INLINE_LOW void push (ChannelInternalCore* node, const bool search) throw()
+    {
+        stack.add (node);
+        searching.add (search ? 1 : 0);
+    }
+    
+    /** Pushes the channels of the inputs of the same sample type to be searched. */
+    void addUnitInputs (ChannelInternalCore* node) throw()
+    {
+        const DynamicArray& items = node->getInputs().getValues();
+        const int numItems = items.length();
+        
+        for (int i = 0; i < numItems; ++i)
+        {
+            const Dynamic& item = items.atUnchecked (i);
+            const int type = item.getTypeCode();
+            
+            if (type == TypeUtility<UnitType>::getTypeCode())
+            {
+                this->addUnit (item.asUnchecked<UnitType>());
+            }
+            else if (type == TypeUtility<UnitsType>::getTypeCode())
+            {
+                const UnitsType& units = item.asUnchecked<UnitsType>();
+                const int numUnits = units.length();
+                
+                for (int j = 0; j < numUnits; ++j)
+                    this->addUnit (units.atUnchecked (j));
+            }
+        }
+    }
+    
+    void addUnit (UnitType const& unit) throw()
+    {
+        const int numChannels = unit.getNumChannels();
+        
+        for (int i = 0; i < numChannels; ++i)
+            this->push (unit.atUnchecked (i).getInternal(), true);
+    }
+    
+    /** Groups the candidates so that no two groups share a channel or bus. 
+     The table still holds the calling thread's path from findFanIns(). */
+    void buildGroups (Plan& plan) throw()
+    {
+        int i, j;
+        
+        const int numCandidates = plan.numCandidates;
+        
+        parents.setSize (numCandidates, false);
+        flags.setSize (numCandidates, false);
+        
+        for (i = 0; i < numCandidates; ++i)
+        {
+            parents.atUnchecked (i) = i;
+            flags.atUnchecked (i) = 0;
+        }
+        
+        ChannelInternalCore* const timing = plan.roots.length() > 0 ? plan.roots.atUnchecked (0).getInternal() : 0;
+        
+        for (i = 0; i < numCandidates; ++i)
+        {
+            ChannelInternalCore* candidate = plan.candidates.atUnchecked (i).getInternal();
+            
+            if ((timing == 0) || ! matchesTiming (candidate, timing))
+                flags.atUnchecked (i) = 1;
+            
+            stack.clear();
+            stack.add (candidate);
+            
+            while (stack.length() > 0)
+            {
+                ChannelInternalCore* node = stack.last()->getProcessingInternal();
+                stack.setSize (stack.length() - 1, true);
+                
+                if (! this->visit (node, i))
+                    continue;
+                
+                // inputs that may change can't be rendered on the workers, 
+                // and can't be read safely from this thread either
+                if (! node->hasStaticInputs())
+                {
+                    flags.atUnchecked (i) = 1;
+                    continue;
+                }
+                
+                children.clear();
+                busses.clear();
+                node->getInputs().getInternals (children, busses);
+                
+                if (children.length() > 0)
+                    stack.add (children);
+                
+                const int numBusses = busses.length();
+                
+                for (j = 0; j < numBusses; ++j)
+                    this->visit (busses.atUnchecked (j), i);
+            }
+        }
+        
+        // collect the groups, leaving those flagged for the calling thread
+        for (i = 0; i < numCandidates; ++i)
+        {
+            const int root = this->findRoot (i);
+            
+            if (flags.atUnchecked (i) != 0)
+                flags.atUnchecked (root) = 1;
+        }
+        
+        IntArray groupOfRoot (IntArray::withSize (numCandidates));
+        IntArray groupSizes;
+        int numGroups = 0;
+        
+        for (i = 0; i < numCandidates; ++i)
+        {
+            const int root = this->findRoot (i);
+            
+            if (flags.atUnchecked (root) != 0)
+                continue;
+            
+            if (root == i)
+            {
+                groupOfRoot.atUnchecked (i) = numGroups < MaxGroups ? numGroups++ : (i % MaxGroups);
+                
+                if (groupSizes.length() < numGroups)
+                    groupSizes.add (0);
+            }
+        }
+        
+        for (i = 0; i < numCandidates; ++i)
+        {
+            const int root = this->findRoot (i);
+            
+            if (flags.atUnchecked (root) == 0)
+                groupSizes.atUnchecked (groupOfRoot.atUnchecked (root))++;
+        }
+        
+        // largest groups first so the smaller ones fill in at the end
+        IntArray order (IntArray::withSize (numGroups));
+        
+        for (i = 0; i < numGroups; ++i)
+        {
+            for (j = i; (j > 0) && (groupSizes.atUnchecked (order.atUnchecked (j - 1)) < groupSizes.atUnchecked (i)); --j)
+                order.atUnchecked (j) = order.atUnchecked (j - 1);
+            
+            order.atUnchecked (j) = i;
+        }
+        
+        IntArray rank (IntArray::withSize (numGroups));
+        plan.groupStarts.setSize (numGroups + 1, false);
+        plan.groupStarts.atUnchecked (0) = 0;
+        
+        for (i = 0; i < numGroups; ++i)
+        {
+            rank.atUnchecked (order.atUnchecked (i)) = i;
+            plan.groupStarts.atUnchecked (i + 1) = plan.groupStarts.atUnchecked (i) + groupSizes.atUnchecked (order.atUnchecked (i));
+        }
+        
+        IntArray fill (plan.groupStarts.copy());
+        plan.groupItems.setSize (plan.groupStarts.atUnchecked (numGroups), false);
+        
+        for (i = 0; i < numCandidates; ++i)
+        {
+            const int root = this->findRoot (i);
+            
+            if (flags.atUnchecked (root) == 0)
+            {
+                const int group = rank.atUnchecked (groupOfRoot.atUnchecked (root));
+                plan.groupItems.atUnchecked (fill.atUnchecked (group)++) = i;
+            }
+        }
+        
+        plan.numGroups = numGroups;
+    }
+    
+    /** Maps a node to a candidate, joining candidates that share it.
+     @return @c true if the node had not been seen before. */
+    bool visit (void* node, const int candidate) throw()
+    {
+        const int owner = this->findHash (node);
+        
+        if (owner == -1)
+        {
+            this->insertHash (node, candidate);
+            return true;
+        }
+        
+        if (owner == -2)
+        {
+            flags.atUnchecked (candidate) = 1; // shared with the main thread's path
+        }
+        else
+        {
+            const int a = this->findRoot (owner);
+            const int b = this->findRoot (candidate);
+            
+            if (a != b)
+                parents.atUnchecked (plonk::max (a, b)) = plonk::min (a, b);
+        }
+        
+        return false;
+    }
+    
+    int findRoot (int index) throw()
+    {
+        while (parents.atUnchecked (index) != index)
+        {
+            parents.atUnchecked (index) = parents.atUnchecked (parents.atUnchecked (index));
+            index = parents.atUnchecked (index);
+        }
+        
+        return index;
+    }
+    
+    // simple open addressing hash from node pointers to candidate indices
+    void clearHash (const int size) throw()
+    {
+        hashKeys.setSize (size, false);
+        hashValues.setSize (size, false);
+        numHashed = 0;
+        
+        for (int i = 0; i < size; ++i)
+            hashKeys.atUnchecked (i) = 0;
+    }
+    
+    static PLONK_INLINE_LOW int hashPointer (const void* pointer, const int mask) throw()
+    {
+        const UnsignedLong bits = (UnsignedLong)pointer;
+        return int ((bits >> 4) ^ (bits >> 12)) & mask;
+    }
+    
+    int findHash (const void* key) const throw()
+    {
+        const int mask = hashKeys.length() - 1;
+        int slot = hashPointer (key, mask);
+        
+        while (hashKeys.atUnchecked (slot) != 0)
+        {
+            if (hashKeys.atUnchecked (slot) == key)
+                return hashValues.atUnchecked (slot);
+            
+            slot = (slot + 1) & mask;
+        }
+        
+        return -1;
+    }
+    
+    void insertHash (void* key, const int value) throw()
+    {
+        if ((numHashed + 1) * 2 > hashKeys.length())
+        {
+            const PointerArray oldKeys (hashKeys.copy());
+            const IntArray oldValues (hashValues.copy());
+            const int oldSize = oldKeys.length();
+            
+            this->clearHash (oldSize * 2);
+            
+            for (int i = 0; i < oldSize; ++i)
+                if (oldKeys.atUnchecked (i) != 0)
+                    this->insertHash (oldKeys.atUnchecked (i), oldValues.atUnchecked (i));
+        }
+        
+        const int mask = hashKeys.length() - 1;
+        int slot = hashPointer (key, mask);
+        
+        while (hashKeys.atUnchecked (slot) != 0)
+            slot = (slot + 1) & mask;
+        
+        hashKeys.atUnchecked (slot) = key;
+        hashValues.atUnchecked (slot) = value;
+        ++numHashed;
+    }
+};
+
+
+
+#endif // PLONK_GRAPHSCHEDULER_H
@@ -167,5 +167,73 @@ void InputDictionary::resetExpiredUnits() throw()
     }
 }
 
+template<class UnitType>
+static void InputDictionary_AddUnitInternals (UnitType const& unit, ObjectArray<ChannelInternalCore*>& channels) throw()
+{
+    const int numChannels = unit.length();
+    
+    for (int i = 0; i < numChannels; ++i)
+        channels.add (unit.atUnchecked (i).getInternal());
+}
+
+template<class UnitsType>
+static void InputDictionary_AddUnitsInternals (UnitsType const& units, ObjectArray<ChannelInternalCore*>& channels) throw()
+{
+    const int numUnits = units.length();
+    
+    for (int i = 0; i < numUnits; ++i)
+        InputDictionary_AddUnitInternals (units.atUnchecked (i), channels);
+}
+
+template<class BussesType>
+static void InputDictionary_AddBussesInternals (BussesType const& busses, ObjectArray<void*>& result) throw()
+{
+    const int numBusses = busses.length();
+    
+    for (int i = 0; i < numBusses; ++i)
+        result.add (busses.atUnchecked (i).getInternal());
+}
+
+void InputDictionary::getInternals (ObjectArray<ChannelInternalCore*>& channels, 
+                                    ObjectArray<void*>& busses) const throw()
+{
+    const DynamicArray& items = this->getValues();
+    const int numItems = items.length();
+    
+    for (int i = 0; i < numItems; ++i)
+    {
+        const Dynamic& item = items.atUnchecked (i);
+        const int type = item.getTypeCode();
+        
+        switch (type)
+        {
+            case TypeCode::FloatUnit:    InputDictionary_AddUnitInternals (item.asUnchecked<FloatUnit>(), channels);        break;
+            case TypeCode::DoubleUnit:   InputDictionary_AddUnitInternals (item.asUnchecked<DoubleUnit>(), channels);       break;
+            case TypeCode::IntUnit:      InputDictionary_AddUnitInternals (item.asUnchecked<IntUnit>(), channels);          break;
+            case TypeCode::ShortUnit:    InputDictionary_AddUnitInternals (item.asUnchecked<ShortUnit>(), channels);        break;
+            case TypeCode::Int24Unit:    InputDictionary_AddUnitInternals (item.asUnchecked<Int24Unit>(), channels);        break;
+            case TypeCode::LongUnit:     InputDictionary_AddUnitInternals (item.asUnchecked<LongUnit>(), channels);         break;
+            case TypeCode::FloatUnits:   InputDictionary_AddUnitsInternals (item.asUnchecked<FloatUnits>(), channels);      break;
+            case TypeCode::DoubleUnits:  InputDictionary_AddUnitsInternals (item.asUnchecked<DoubleUnits>(), channels);     break;
+            case TypeCode::IntUnits:     InputDictionary_AddUnitsInternals (item.asUnchecked<IntUnits>(), channels);        break;
+            case TypeCode::ShortUnits:   InputDictionary_AddUnitsInternals (item.asUnchecked<ShortUnits>(), channels);      break;
+            case TypeCode::Int24Units:   InputDictionary_AddUnitsInternals (item.asUnchecked<Int24Units>(), channels);      break;
+            case TypeCode::LongUnits:    InputDictionary_AddUnitsInternals (item.asUnchecked<LongUnits>(), channels);       break;
+            case TypeCode::FloatBus:     busses.add (item.asUnchecked<FloatBus>().getInternal());                          break;
+            case TypeCode::DoubleBus:    busses.add (item.asUnchecked<DoubleBus>().getInternal());                         break;
+            case TypeCode::IntBus:       busses.add (item.asUnchecked<IntBus>().getInternal());                            break;
+            case TypeCode::ShortBus:     busses.add (item.asUnchecked<ShortBus>().getInternal());                          break;
+            case TypeCode::Int24Bus:     busses.add (item.asUnchecked<Int24Bus>().getInternal());                          break;
+            case TypeCode::LongBus:      busses.add (item.asUnchecked<LongBus>().getInternal());                           break;
+            case TypeCode::FloatBusses:  InputDictionary_AddBussesInternals (item.asUnchecked<FloatBusses>(), busses);     break;
+            case TypeCode::DoubleBusses: InputDictionary_AddBussesInternals (item.asUnchecked<DoubleBusses>(), busses);    break;
+            case TypeCode::IntBusses:    InputDictionary_AddBussesInternals (item.asUnchecked<IntBusses>(), busses);       break;
+            case TypeCode::ShortBusses:  InputDictionary_AddBussesInternals (item.asUnchecked<ShortBusses>(), busses);     break;
+            case TypeCode::Int24Busses:  InputDictionary_AddBussesInternals (item.asUnchecked<Int24Busses>(), busses);     break;
+            case TypeCode::LongBusses:   InputDictionary_AddBussesInternals (item.asUnchecked<LongBusses>(), busses);      break;
+        }
+    }
+}
+
 
 END_PLONK_NAMESPACE
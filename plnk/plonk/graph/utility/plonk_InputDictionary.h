@@ -81,6 +81,12 @@ public:
     
     void resetExpiredUnits() throw();
     
+    /** Appends the channels and busses used by this dictionary to the arrays.
+     This is not recursive but does search each channel of the units. Busses
+     are identified by their internal pointers. */
+    void getInternals (ObjectArray<ChannelInternalCore*>& channels, 
+                       ObjectArray<void*>& busses) const throw();
+    
     PLONK_OBJECTARROWOPERATOR(InputDictionary);
 };
 
@@ -59,11 +59,6 @@ ProcessInfo::ProcessInfo (ProcessInfo const& copy) throw()
 {
 }            
 
-const TimeStamp& ProcessInfo::getTimeStamp() const throw()             
-{ 
-    return this->getInternal()->getTimeStamp(); 
-}
-
 void ProcessInfo::setTimeStamp (const TimeStamp timeStamp) throw()
 {
     this->getInternal()->setTimeStamp (timeStamp);
@@ -74,6 +69,16 @@ void ProcessInfo::offsetTimeStamp (const double offset) throw()
     this->getInternal()->offsetTimeStamp (offset);
 }
 
+void ProcessInfo::setSampleClock (const LongLong sampleClock, const double sampleClockRate) throw()
+{
+    this->getInternal()->setSampleClock (sampleClock, sampleClockRate);
+}
+
+void ProcessInfo::offsetSampleClock (const LongLong offset) throw()
+{
+    this->getInternal()->offsetSampleClock (offset);
+}
+
 void ProcessInfo::setShouldDelete() throw()
 {
     this->getInternal()->setShouldDelete();
@@ -89,4 +94,14 @@ bool ProcessInfo::getShouldDelete() const throw()
     return this->getInternal()->getShouldDelete();
 }
 
+void ProcessInfo::setPreRendered (const bool flag) throw()
+{
+    this->getInternal()->setPreRendered (flag);
+}
+
+bool ProcessInfo::getPreRendered() const throw()
+{
+    return this->getInternal()->getPreRendered();
+}
+
 END_PLONK_NAMESPACE
@@ -80,9 +80,41 @@ public:
     void setTimeStamp (const TimeStamp newSampleNumber) throw();
     
     void offsetTimeStamp (const double offset) throw();
+    
+    /** Get the current sample clock.
+     Hosts may count samples at a single rate alongside the time stamp (see 
+     AudioHostBase::setUseSampleClock()). Channels running at this rate, or an
+     integer division of it, then use this to decide if they need to render 
+     rather than comparing time stamps. This is -1 if there is no sample clock 
+     or the time stamp was changed independently of the clock. */
+    LongLong getSampleClock() const throw();
+    
+    /** Get the rate at which the sample clock counts. */
+    double getSampleClockRate() const throw();
+    
+    /** Attaches a sample clock to the current time stamp.
+     Pass -1 to disable the sample clock. */
+    void setSampleClock (const LongLong sampleClock, const double sampleClockRate) throw();
+    
+    /** Advances the sample clock after the time stamp has been offset. 
+     This reattaches the clock to the new time stamp. */
+    void offsetSampleClock (const LongLong offset) throw();
+    
     void setShouldDelete() throw();
     void resetShouldDelete() throw();
     bool getShouldDelete() const throw();
+    
+    /** Flags that some subgraphs were already rendered for this time stamp.
+     This is set by the GraphScheduler while the host pulls the rest of the
+     graph so that channels skipped by the time stamp gate still report
+     their deletion requests to their parents. */
+    void setPreRendered (const bool flag) throw();
+    bool getPreRendered() const throw();
+    
+    /** Gets the scratch memory for the thread rendering with this info.
+     Channels may borrow transient buffers from this during process() using 
+     a ScratchArena::Scope. */
+    ScratchArena& getScratch() const throw();
         
     PLONK_OBJECTARROWOPERATOR(ProcessInfo);
 };
@@ -46,9 +46,38 @@ BEGIN_PLONK_NAMESPACE
 ProcessInfoInternal::ProcessInfoInternal (const TimeStamp time, 
                                           const bool shouldDeleteToUse) throw()
 :   timeStamp (time),
-    shouldDelete (shouldDeleteToUse)
+    sampleClock (-1),
+    sampleClockBase (-1),
+    sampleClockRate (0.0),
+    shouldDelete (shouldDeleteToUse),
+    preRendered (false)
 {
 }
 
+void ProcessInfoInternal::setTimeStamp (const TimeStamp newTimeStamp) throw()
+{
+    timeStamp = newTimeStamp;
+    
+    // converters set the time stamp of their subgraphs then restore it, only 
+    // the time stamp the clock was attached to may use the sample clock 
+    sampleClock = ((sampleClockBase >= 0) && (timeStamp == sampleClockTimeStamp)) ? sampleClockBase : -1;
+}
+
+void ProcessInfoInternal::setSampleClock (const LongLong newSampleClock, const double newSampleClockRate) throw()
+{
+    plonk_assert ((newSampleClock < 0) || (newSampleClockRate > 0.0));
+    
+    sampleClockTimeStamp = timeStamp;
+    sampleClockBase = newSampleClock;
+    sampleClockRate = newSampleClockRate;
+    sampleClock = newSampleClock;
+}
+
+void ProcessInfoInternal::offsetSampleClock (const LongLong offset) throw()
+{
+    if (sampleClockBase >= 0)
+        this->setSampleClock (sampleClockBase + offset, sampleClockRate);
+}
+
 
 END_PLONK_NAMESPACE
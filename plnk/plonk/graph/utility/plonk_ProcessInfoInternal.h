@@ -43,6 +43,7 @@
 #include "../../containers/plonk_ContainerForwardDeclarations.h"
 #include "../../core/plonk_Sender.h"
 #include "../utility/plonk_ProcessInfo.h"
+#include "../utility/plonk_ScratchArena.h"
 
 class ProcessInfoInternal : public SenderInternal<ProcessInfo>
 {
@@ -51,19 +52,56 @@ public:
                          const bool shouldDelete) throw();
     
     PLONK_INLINE_HIGH const TimeStamp& getTimeStamp() const throw() { return timeStamp; }
-    PLONK_INLINE_HIGH void setTimeStamp (const TimeStamp newTimeStamp) throw() { timeStamp = newTimeStamp;}
-    PLONK_INLINE_HIGH void offsetTimeStamp (const double offset) throw() { timeStamp += offset;}
+    PLONK_INLINE_HIGH void offsetTimeStamp (const double offset) throw() { timeStamp += offset; sampleClock = -1; }
+    void setTimeStamp (const TimeStamp newTimeStamp) throw();
+    
+    PLONK_INLINE_HIGH LongLong getSampleClock() const throw() { return sampleClock; }
+    PLONK_INLINE_HIGH double getSampleClockRate() const throw() { return sampleClockRate; }
+    void setSampleClock (const LongLong newSampleClock, const double newSampleClockRate) throw();
+    void offsetSampleClock (const LongLong offset) throw();
+    
     PLONK_INLINE_HIGH void setShouldDelete() throw() { shouldDelete = true; }
     PLONK_INLINE_HIGH void resetShouldDelete() throw() { shouldDelete = false; }
     PLONK_INLINE_HIGH bool getShouldDelete() const throw() { return shouldDelete; }
+    PLONK_INLINE_HIGH void setPreRendered (const bool flag) throw() { preRendered = flag; }
+    PLONK_INLINE_HIGH bool getPreRendered() const throw() { return preRendered; }
+    PLONK_INLINE_HIGH ScratchArena& getScratch() throw() { return scratch; }
     
 private:
     TimeStamp timeStamp;
+    TimeStamp sampleClockTimeStamp;
+    LongLong sampleClock;
+    LongLong sampleClockBase;
+    double sampleClockRate;
     bool shouldDelete;
+    bool preRendered;
+    ScratchArena scratch;
     
     ProcessInfoInternal();
 };
 
+//------------------------------------------------------------------------------
+
+PLONK_INLINE_HIGH const TimeStamp& ProcessInfo::getTimeStamp() const throw()
+{
+    return this->getInternal()->getTimeStamp();
+}
+
+PLONK_INLINE_HIGH LongLong ProcessInfo::getSampleClock() const throw()
+{
+    return this->getInternal()->getSampleClock();
+}
+
+PLONK_INLINE_HIGH double ProcessInfo::getSampleClockRate() const throw()
+{
+    return this->getInternal()->getSampleClockRate();
+}
+
+PLONK_INLINE_HIGH ScratchArena& ProcessInfo::getScratch() const throw()
+{
+    return this->getInternal()->getScratch();
+}
+
 
 
 #endif // PLONK_PROCESSINFOINTERNAL_H
\ No newline at end of file
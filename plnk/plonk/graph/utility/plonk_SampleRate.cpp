@@ -72,6 +72,12 @@ SampleRate::SampleRate (SampleRate const& copy) throw()
 {
 }        
 
+SampleRate& SampleRate::operator= (SampleRate const& other) throw()
+{
+    Base::operator= (static_cast<Base const&> (other));
+    return *this;
+}
+
 SampleRate::SampleRate (SampleRateDefault const& copy) throw()
 :	Base (static_cast<Base const&> (copy))
 {    
@@ -77,6 +77,10 @@ public:
     /** Copy constructor. */
     SampleRate (SampleRate const& copy) throw();
     
+    /** Assignment operator. 
+     This shares the other's value as for Variable. */
+    SampleRate& operator= (SampleRate const& other) throw();
+    
     SampleRate (SampleRateDefault const& copy) throw();
     SampleRate (SampleRateNoPreference const& copy) throw();
     
@@ -0,0 +1,108 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+
+ScratchArena::ScratchArena() throw()
+:   block (0),
+    capacity (0),
+    position (0),
+    highWaterMark (0),
+    overflow (0)
+{
+}
+
+ScratchArena::~ScratchArena()
+{
+    this->freeOverflow();
+    
+    if (block != 0)
+        Memory::global().free (block);
+}
+
+void ScratchArena::reset() throw()
+{
+    this->freeOverflow();
+    position = 0;
+    
+    if (highWaterMark > capacity)
+    {
+        // round up to whole pages to leave some room to grow
+        const UnsignedLong pageSize = 4096;
+        const UnsignedLong newCapacity = (highWaterMark + (pageSize - 1)) & ~(pageSize - 1);
+        
+        if (block != 0)
+            Memory::global().free (block);
+        
+        block = static_cast<Char*> (Memory::global().allocateBytes (newCapacity));
+        capacity = block != 0 ? newCapacity : 0;
+    }
+}
+
+void* ScratchArena::allocateOverflow (const UnsignedLong size) throw()
+{
+    // each chunk is prefixed with a link to the previous one, padded to keep the alignment
+    Char* const chunk = static_cast<Char*> (Memory::global().allocateBytes (size + Alignment));
+    
+    if (chunk == 0)
+        return 0;
+    
+    *reinterpret_cast<void**> (chunk) = overflow;
+    overflow = chunk;
+    
+    this->setPosition (position + size);
+    return chunk + Alignment;
+}
+
+void ScratchArena::freeOverflow() throw()
+{
+    while (overflow != 0)
+    {
+        void* const next = *static_cast<void**> (overflow);
+        Memory::global().free (overflow);
+        overflow = next;
+    }
+}
+
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,170 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_SCRATCHARENA_H
+#define PLONK_SCRATCHARENA_H
+
+/** A bump allocator for transient buffers used while a channel processes.
+ Each render thread has one of these in its ProcessInfo (see 
+ ProcessInfo::getScratch()) so channels can borrow working memory rather than 
+ keep their own long-lived arrays. Memory is taken from a single block by
+ advancing an offset and handed back in reverse order using Scope so the 
+ arena only ever needs to be as large as the deepest chain of borrowers 
+ rather than the sum of them all.
+ 
+ If a request does not fit the block it is allocated separately and the 
+ amount needed is recorded. The block is regrown to this high-water mark the 
+ next time the arena is reset (hosts reset their arena at the start of each 
+ hardware block) or when the outermost Scope ends, after which the graph 
+ runs without further allocation.
+ 
+ Memory from the arena is not zeroed and must not be kept beyond the call
+ to process() that borrowed it.
+ @see ProcessInfo */
+class ScratchArena
+{
+public:
+    enum Constants
+    {
+        Alignment = 16
+    };
+    
+    /** Borrows memory from an arena and returns it when it goes out of scope. */
+    class Scope
+    {
+    public:
+        Scope (ScratchArena& arenaToUse) throw()
+        :   arena (arenaToUse),
+            mark (arenaToUse.getPosition())
+        {
+        }
+        
+        ~Scope()
+        {
+            arena.rewind (mark);
+        }
+        
+        /** Borrows an uninitialised array of numItems. */
+        template<class Type>
+        PLONK_INLINE_LOW Type* allocate (const int numItems) throw()
+        {
+            return arena.allocate<Type> (numItems);
+        }
+        
+    private:
+        ScratchArena& arena;
+        const UnsignedLong mark;
+        
+        Scope (Scope const&);
+        Scope& operator= (Scope const&);
+    };
+    
+    ScratchArena() throw();
+    ~ScratchArena();
+    
+    /** Borrows an uninitialised array of numItems.
+     This is returned when the enclosing Scope ends or the arena is reset. */
+    template<class Type>
+    PLONK_INLINE_LOW Type* allocate (const int numItems) throw()
+    {
+        plonk_assert (numItems >= 0);
+        return static_cast<Type*> (this->allocateBytes (UnsignedLong (numItems) * sizeof (Type)));
+    }
+    
+    /** Borrows numBytes aligned to the Alignment constant. */
+    PLONK_INLINE_LOW void* allocateBytes (const UnsignedLong numBytes) throw()
+    {
+        const UnsignedLong size = (numBytes + (Alignment - 1)) & ~UnsignedLong (Alignment - 1);
+        const UnsignedLong end = position + size;
+        
+        if (end <= capacity)
+        {
+            void* const ptr = block + position;
+            this->setPosition (end);
+            return ptr;
+        }
+        
+        return this->allocateOverflow (size);
+    }
+    
+    /** Returns all the borrowed memory and regrows the block if it overflowed. 
+     This must not be called while anything is still using the memory. */
+    void reset() throw();
+    
+    /** Gets the current offset into the arena. */
+    PLONK_INLINE_LOW UnsignedLong getPosition() const throw() { return position; }
+    
+    /** Returns any memory borrowed since the position was mark. */
+    PLONK_INLINE_LOW void rewind (const UnsignedLong mark) throw()
+    {
+        plonk_assert (mark <= position);
+        position = mark;
+        
+        if ((mark == 0) && (overflow != 0))
+            this->reset();
+    }
+    
+    /** Gets the size of the block in bytes. */
+    PLONK_INLINE_LOW UnsignedLong getCapacity() const throw() { return capacity; }
+    
+    /** Gets the most memory that has been borrowed at once in bytes. */
+    PLONK_INLINE_LOW UnsignedLong getHighWaterMark() const throw() { return highWaterMark; }
+    
+private:
+    Char* block;
+    UnsignedLong capacity;
+    UnsignedLong position;
+    UnsignedLong highWaterMark;
+    void* overflow;
+    
+    PLONK_INLINE_LOW void setPosition (const UnsignedLong newPosition) throw()
+    {
+        position = newPosition;
+        
+        if (newPosition > highWaterMark)
+            highWaterMark = newPosition;
+    }
+    
+    void* allocateOverflow (const UnsignedLong size) throw();
+    void freeOverflow() throw();
+    
+    ScratchArena (ScratchArena const&);
+    ScratchArena& operator= (ScratchArena const&);
+};
+
+#endif // PLONK_SCRATCHARENA_H
@@ -63,6 +63,7 @@ public:
     :   preferredHostSampleRate (0.0),
         preferredHostBlockSize (0),
         preferredGraphBlockSize (0),
+        useSampleClock (false),
         isRunning (false),
         isPaused (false)
     { 
@@ -109,6 +110,35 @@ public:
      This must be called before startHost() to have any effect. */
     PLONK_INLINE_LOW void setPreferredGraphBlockSize (const int newSize) throw() {  preferredGraphBlockSize = newSize; }
     
+    /** Get the number of extra threads used to render the graph. */
+    PLONK_INLINE_LOW int getNumRenderThreads() const throw() { return scheduler.getNumThreads(); }
+    
+    /** Set the number of extra threads used to render the graph.
+     With one or more threads the independent inputs of mixers in the graph are
+     rendered in parallel, see GraphSchedulerBase. The default is zero which 
+     renders the whole graph on the audio thread.
+     This must be called before startHost() to have any effect. */
+    void setNumRenderThreads (const int numThreads) throw() { scheduler.setNumThreads (numThreads); }
+    
+    /** Set whether the render threads render whole output channels.
+     By default the render threads render the inputs of mixers, with this set
+     each channel of the output unit is rendered on its own thread instead. 
+     This is only useful if the channels are independent. */
+    void setParallelOutputChannels (const bool state) throw() { scheduler.setParallelChannels (state); }
+    
+    /** Get whether the graph is timed using an integer sample clock. */
+    PLONK_INLINE_LOW bool getUseSampleClock() const throw() { return useSampleClock; }
+    
+    /** Set whether the graph is timed using an integer sample clock.
+     By default channels compare time stamps to decide whether they need to 
+     render for each block. With this set the host also counts samples at its 
+     sample rate and channels running at this rate (or at an integer division 
+     of it, e.g., control rate) compare the sample count instead which is much 
+     cheaper. Channels running at other rates or with overlap, and subgraphs 
+     of converters such as Resample, still use the time stamp.
+     This must be called before startHost() to have any effect. */
+    PLONK_INLINE_LOW void setUseSampleClock (const bool state) throw() { useSampleClock = state; }
+    
     /** Set the number of audio inputs required.
      This must be called before startHost() to have any effect. */
     void setNumInputs (const int numInputs) throw();
@@ -137,6 +167,9 @@ protected:
     
     /** Get the output buffers. @internal */
     PLONK_INLINE_LOW BufferArray& getOutputs() throw()                    { return this->outputs; }
+    
+    /** Determine whether the output unit has asked to be deleted. @internal */
+    PLONK_INLINE_LOW bool getOutputShouldBeDeleted() const throw()        { return this->outputUnit.isNotNull() && this->outputUnit.shouldBeDeletedNow (this->info); }
 
     /** Get the name of the audio host. */
     virtual Text getHostName() const = 0;
@@ -188,6 +221,9 @@ protected:
         // must do more checks in case the block sizes are not compatible on this run
         
 
+        // return any scratch memory and grow it if the last block overflowed
+        this->info.getScratch().reset();
+
         // push all the input samples for this hardware frame onto the busses
         for (i = 0; i < numInputs; ++i)
         {
@@ -201,6 +237,7 @@ protected:
         {
             while (blockRemain > 0)
             {            
+                this->info.setPreRendered (this->scheduler.render (this->outputUnit, this->info));
                 this->outputUnit.process (this->info);
                 
                 for (i = 0; i < numOutputs; ++i)
@@ -211,6 +248,7 @@ protected:
                 }
                 
                 this->info.offsetTimeStamp (SampleRate::getDefault().getSampleDurationInTicks() * graphBlockSize);
+                this->info.offsetSampleClock (graphBlockSize);
                 
                 blockRemain -= graphBlockSize;
             }
@@ -221,6 +259,7 @@ protected:
                 BufferType::zeroData (this->outputs.atUnchecked (i), blockRemain);
             
             this->info.offsetTimeStamp (SampleRate::getDefault().getSampleDurationInTicks() * blockRemain);
+            this->info.offsetSampleClock (blockRemain);
         }
         
 #if PLONK_DEBUG
@@ -234,8 +273,20 @@ protected:
     void startHostInternal() throw()
     {
         initFormat();
+        
+        if (useSampleClock)
+        {
+            const double sampleRate = SampleRate::getDefault().getValue();
+            this->info.setSampleClock (LongLong (this->info.getTimeStamp().toSamples (sampleRate) + 0.5), sampleRate);
+        }
+        else
+        {
+            this->info.setSampleClock (-1, 0.0);
+        }
+        
         UnitType graphUnit = constructGraph();
         outputUnit = graphUnit.getBlockSize (0).getValue() == 1 ? graphUnit.ar() : graphUnit;
+        scheduler.start (preferredGraphBlockSize, preferredHostSampleRate);
         hostStarting();
         
         setIsRunning (true);
@@ -253,12 +304,14 @@ private:
     double preferredHostSampleRate;
     int preferredHostBlockSize;
     int preferredGraphBlockSize;
+    bool useSampleClock;
 	AtomicInt isRunning;
     AtomicInt isPaused;
     OptionDictionary otherOptions;
 
     ProcessInfo info;
     UnitType outputUnit;
+    GraphSchedulerBase<SampleType> scheduler;
     BussesType busses;
     ConstBufferArray inputs;
     BufferArray outputs;    
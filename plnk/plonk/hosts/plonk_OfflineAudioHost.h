@@ -0,0 +1,227 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ https://github.com/0x4d52/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-16
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_OFFLINEAUDIOHOST_H
+#define PLONK_OFFLINEAUDIOHOST_H
+
+#include "plonk_AudioHostBase.h"
+
+/** An audio host that renders as fast as possible without an audio device.
+ startHost() renders the graph on the calling thread and returns once the 
+ render has finished. The output is written to an AudioFileWriter if one is 
+ set, otherwise it is kept in memory and can be retrieved with getOutput().
+ 
+ The render stops after the render duration, when the output unit asks to be
+ deleted (if setStopWhenOutputExpires() is set) or when stopHost() is called 
+ (e.g., from another thread). At least one of these must be set up or 
+ the render will run until stopHost() is called.
+ 
+ The audio inputs (if any) are silent.
+ @see AudioHostBase::setNumRenderThreads(), AudioHostBase::setParallelOutputChannels() */
+template<class SampleType>
+class OfflineAudioHostBase : public AudioHostBase<SampleType>
+{
+public:
+    typedef NumericalArray<SampleType*>         BufferArray;
+    typedef NumericalArray<const SampleType*>   ConstBufferArray;
+    typedef NumericalArray<SampleType>          BufferType;
+    typedef NumericalArray2D<SampleType>        BuffersType;
+    typedef AudioFileWriter<SampleType>         AudioFileWriterType;
+    
+    OfflineAudioHostBase() throw()
+    :   renderDuration (0.0),
+        stopWhenOutputExpires (false),
+        numFramesRendered (0),
+        cpuUsage (0.0)
+    {
+        this->setPreferredHostBlockSize (512);
+        this->setPreferredGraphBlockSize (0);
+        this->setPreferredHostSampleRate (44100.0);
+        this->setNumInputs (0);
+        this->setNumOutputs (2);
+    }
+    
+    Text getHostName() const throw()        { return "Offline (" + TypeUtility<SampleType>::getTypeName() + ")"; }
+    Text getNativeHostName() const throw()  { return "None"; }
+    Text getInputName() const throw()       { return "None"; }
+    Text getOutputName() const throw()      { return writer.isReady() ? "File" : "Memory"; }
+    
+    /** The time taken by the last render as a proportion of its duration. */
+    double getCpuUsage() const throw()      { return cpuUsage; }
+    
+    /** Set the length of the render in seconds.
+     Zero (the default) means no limit. This must be called before startHost() 
+     to have any effect. */
+    void setRenderDuration (const double seconds) throw()   { renderDuration = seconds; }
+    double getRenderDuration() const throw()                { return renderDuration; }
+    
+    /** Set whether to stop when the output unit asks to be deleted.
+     This must be called before startHost() to have any effect. */
+    void setStopWhenOutputExpires (const bool state) throw() { stopWhenOutputExpires = state; }
+    bool getStopWhenOutputExpires() const throw()            { return stopWhenOutputExpires; }
+    
+    /** Set the writer for the output.
+     This must have the same number of channels as the host has outputs. If 
+     this is not ready (the default) the output is kept in memory instead. */
+    void setOutputWriter (AudioFileWriterType const& newWriter) throw() { writer = newWriter; }
+    AudioFileWriterType getOutputWriter() const throw()                 { return writer; }
+    
+    /** Get the output of the last render if it was kept in memory. 
+     There is one buffer per output channel. */
+    BuffersType getOutput() const throw() { return output; }
+    
+    /** Get the number of frames rendered by the last render. */
+    LongLong getNumFramesRendered() const throw() { return numFramesRendered; }
+    
+    /** Renders the graph. 
+     This returns when the render has finished. */
+    void startHost() throw()
+    {
+        int i;
+        
+        this->startHostInternal();
+        
+        const int blockSize = this->getPreferredHostBlockSize();
+        const int numInputs = this->getNumInputs();
+        const int numOutputs = this->getNumOutputs();
+        const LongLong maxFrames = renderDuration > 0.0 ? LongLong (renderDuration * this->getPreferredHostSampleRate() + 0.5) : -1;
+        const bool keepOutput = ! writer.isReady();
+        
+        ConstBufferArray& inputs = this->getInputs();
+        BufferArray& outputs = this->getOutputs();
+        
+        const BufferType silence (BufferType::newClear (blockSize));
+        BufferType outputBuffer (BufferType::withSize (blockSize * numOutputs));
+        BufferType interleaveBuffer (BufferType::withSize (keepOutput ? 0 : blockSize * numOutputs));
+        
+        output.clear();
+        
+        if (keepOutput)
+            for (i = 0; i < numOutputs; ++i)
+                output.add (BufferType::withSize (blockSize));
+        
+        numFramesRendered = 0;
+        const double startTime = pl_TimeNow();
+        
+        while (this->getIsRunning() && (numFramesRendered != maxFrames))
+        {
+            for (i = 0; i < numInputs; ++i)
+                inputs.atUnchecked (i) = silence.getArray();
+            
+            for (i = 0; i < numOutputs; ++i)
+                outputs.atUnchecked (i) = outputBuffer.getArray() + i * blockSize;
+            
+            this->process();
+            
+            const int numFrames = maxFrames < 0 ? blockSize : int (plonk::min (LongLong (blockSize), maxFrames - numFramesRendered));
+            
+            if (keepOutput)
+                writeToMemory (outputBuffer, numFrames);
+            else
+                writeToFile (outputBuffer, interleaveBuffer, numFrames);
+            
+            numFramesRendered += numFrames;
+            
+            if (stopWhenOutputExpires && this->getOutputShouldBeDeleted())
+                break;
+        }
+        
+        const double renderTime = pl_TimeNow() - startTime;
+        cpuUsage = numFramesRendered > 0 ? renderTime * this->getPreferredHostSampleRate() / double (numFramesRendered) : 0.0;
+        
+        if (keepOutput)
+            for (i = 0; i < numOutputs; ++i)
+                output.atUnchecked (i).setSize (int (numFramesRendered), true);
+        
+        this->stopHost();
+    }
+    
+    /** Stops the render. 
+     This may be called from another thread to stop a render early. */
+    void stopHost() throw()
+    {
+        if (this->getIsRunning())
+        {
+            this->setIsRunning (false);
+            this->hostStopped();
+        }
+    }
+    
+private:
+    double renderDuration;
+    bool stopWhenOutputExpires;
+    AudioFileWriterType writer;
+    BuffersType output;
+    LongLong numFramesRendered;
+    double cpuUsage;
+    
+    void writeToMemory (BufferType const& outputBuffer, const int numFrames) throw()
+    {
+        const int numOutputs = output.length();
+        const int blockSize = this->getPreferredHostBlockSize();
+        const int start = int (numFramesRendered);
+        
+        for (int i = 0; i < numOutputs; ++i)
+        {
+            BufferType& channel = output.atUnchecked (i);
+            
+            if (channel.length() < (start + numFrames))
+                channel.setSize (channel.length() * 2, true); // at least a block
+            
+            BufferType::copyData (channel.getArray() + start, outputBuffer.getArray() + i * blockSize, numFrames);
+        }
+    }
+    
+    void writeToFile (BufferType const& outputBuffer, BufferType& interleaveBuffer, const int numFrames) throw()
+    {
+        const int numOutputs = this->getNumOutputs();
+        const int blockSize = this->getPreferredHostBlockSize();
+        const SampleType* const outputSamples = outputBuffer.getArray();
+        SampleType* const interleaveSamples = interleaveBuffer.getArray();
+        
+        for (int i = 0; i < numOutputs; ++i)
+            for (int j = 0; j < numFrames; ++j)
+                interleaveSamples[j * numOutputs + i] = outputSamples[i * blockSize + j];
+        
+        writer.writeFrames (numFrames, interleaveSamples);
+    }
+};
+
+typedef OfflineAudioHostBase<PLONK_TYPE_DEFAULT> OfflineAudioHost;
+
+#endif // PLONK_OFFLINEAUDIOHOST_H